@@ -145,6 +145,11 @@ void exceptRowCallback(LambdaExecutor* exec, int64_t exceptionCode, int64_t exce
     exec->numExceptionRows++;
 }
 
+int64_t cancelCheckCallback(LambdaExecutor* exec) {
+    // a Lambda invocation always processes its full input
+    return 0;
+}
+
 aws::lambda_runtime::invocation_request const* g_lambda_req = nullptr;
 
 // how much memory to use for the Lambda??
@@ -325,6 +330,8 @@ tuplex::messages::InvocationResponse lambda_main(aws::lambda_runtime::invocation
         g_compiler->registerSymbol(tstage->writeMemoryCallbackName(), writeRowCallback);
     if(!tstage->exceptionCallbackName().empty())
         g_compiler->registerSymbol(tstage->exceptionCallbackName(), exceptRowCallback);
+    if(!tstage->cancellationCallbackName().empty())
+        g_compiler->registerSymbol(tstage->cancellationCallbackName(), cancelCheckCallback);
     if(!tstage->writeFileCallbackName().empty())
         g_compiler->registerSymbol(tstage->writeFileCallbackName(), writeRowCallback);
     if(!tstage->writeHashCallbackName().empty())
@@ -430,7 +437,7 @@ tuplex::messages::InvocationResponse lambda_main(aws::lambda_runtime::invocation
                 csv->setHeader(header);
                 reader.reset(csv);
             } else if(tstage->inputFormat() == FileFormat::OUTFMT_TEXT) {
-                auto text = new TextReader(userData, reinterpret_cast<codegen::cells_row_f>(syms->functor));
+                auto text = new TextReader(userData, reinterpret_cast<codegen::read_block_f>(syms->functor));
                 // fetch full range for now, later make this optional!
                 // text->setRange(rangeStart, rangeStart + rangeSize);
                 reader.reset(text);
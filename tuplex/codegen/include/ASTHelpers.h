@@ -77,6 +77,15 @@ namespace tuplex {
  */
     extern std::vector<ASTNode *> getForLoopMultiTarget(ASTNode* target);
 
+/*!
+ * normalized representation of the tree below root, i.e. node types, names, literals and operators. Formatting or
+ * comments of the original code do not show up, hence equal keys mean equal ASTs. Used to memoize typing/compilation.
+ * @param root
+ * @param withTypes whether to include the annotated types of each node
+ * @return key, empty string for nullptr
+ */
+    extern std::string structuralKey(ASTNode* root, bool withTypes=false);
+
 /*!
  * error handling for unsupported types
  */
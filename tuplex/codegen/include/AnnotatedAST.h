@@ -202,6 +202,14 @@ namespace tuplex {
              * @return
              */
             std::vector<std::string> typingErrMessages() const { return _typingErrMessages; }
+
+            /*!
+             * key under which typing/code generation results for this AST may be memoized. Covers the tree (incl.
+             * unpacking), type hints, globals and typing flags.
+             * @param withTypes whether to include the types annotated on each node
+             * @return key or empty string if the AST can't be memoized (e.g. carries sample annotations)
+             */
+            std::string memoKey(bool withTypes) const;
         };
     }
 }
@@ -86,6 +86,7 @@ namespace tuplex {
             // flag to check whether freeAll should generate code
             bool _memoryRequested;
             std::unordered_map<std::string, llvm::Function*> _generatedFunctionCache; // store generated helper functions...
+            std::unordered_map<std::string, llvm::Function*> _udfFunctionCache; // UDFs generated into this module, keyed by memo key
 
             // variables to store metadata about globals
 
@@ -131,6 +132,18 @@ namespace tuplex {
             // Returns a builder into which global variable initialization can be inserted.
             llvm::IRBuilder<> getInitGlobalBuilder(const std::string &block_name);
 
+            /*!
+             * returns a UDF function previously generated into this module under the same memo key
+             * @param key memo key of the UDF, see AnnotatedAST::memoKey
+             * @return function or nullptr if not generated yet
+             */
+            llvm::Function* getCachedUDFFunction(const std::string& key) const {
+                auto it = _udfFunctionCache.find(key);
+                return it != _udfFunctionCache.end() ? it->second : nullptr;
+            }
+
+            void cacheUDFFunction(const std::string& key, llvm::Function* func) { _udfFunctionCache[key] = func; }
+
 //            void preOptimize(llvm::Function* func) {
 // run https://github.com/llvm-mirror/llvm/blob/master/lib/Transforms/IPO/PassManagerBuilder.cpp then whatever is in populateFunctionPassManager.
 // if func is nullptr, then simply optimize on all functions. Else, just on a specific one => this should help to make optimization faster...
@@ -22,6 +22,14 @@ namespace tuplex {
      */
     extern ASTNode* parseToAST(const std::string& code);
 
+    /*!
+     * parses a Python3 string into AST using the full ANTLR4 grammar. parseToAST uses this only for syntax outside of
+     * the subset PythonSubsetParser understands.
+     * @param code python code as str
+     * @return nullptr if parse was not successful
+     */
+    extern ASTNode* parseToASTWithANTLR(const std::string& code);
+
 
     extern void printParseTree(const std::string& code, std::ostream& os);
 }
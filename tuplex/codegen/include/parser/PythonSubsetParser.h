@@ -0,0 +1,96 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_PYTHONSUBSETPARSER_H
+#define TUPLEX_PYTHONSUBSETPARSER_H
+
+#include <ASTNodes.h>
+#include <Token.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tuplex {
+
+    /*!
+     * hand-written recursive descent parser for the subset of Python3 the compiler supports. Builds AST nodes directly,
+     * i.e. without the parse tree and adaptive prediction of the ANTLR4 based parser. The produced AST is the same the
+     * ASTBuilderVisitor produces. Any syntax outside of the subset (e.g. classes, keyword arguments, star expressions)
+     * makes parsing fail, so callers can fall back to the full grammar.
+     */
+    class PythonSubsetParser {
+    public:
+        explicit PythonSubsetParser(const std::string& code) : _code(code), _pos(0) {}
+
+        /*!
+         * parses the code
+         * @return AST of the last top-level statement (a lambda expression or function definition for UDFs), nullptr
+         * if the code could not be parsed. Then errorMessage() holds the reason.
+         */
+        ASTNode* parse();
+
+        std::string errorMessage() const { return _errorMessage; }
+
+        /*!
+         * splits Python code into tokens incl. NEWLINE, INDENT, DEDENT markers and a final ENDOFFILE token
+         * @param code python code
+         * @param tokens output
+         * @param errMessage description of the problem if tokenizing failed
+         * @return true on success
+         */
+        static bool tokenize(const std::string& code, std::vector<Token>& tokens, std::string& errMessage);
+
+    private:
+        using NodePtr = std::unique_ptr<ASTNode>;
+
+        std::string _code;
+        std::vector<Token> _tokens;
+        size_t _pos;
+        std::string _errorMessage;
+
+        const Token& peek(size_t offset=0) const;
+        TokenType peekType(size_t offset=0) const { return peek(offset).getType(); }
+        const Token& next() { auto& t = peek(); if(_pos < _tokens.size() - 1) _pos++; return t; }
+        bool accept(TokenType tt);
+        const Token& expect(TokenType tt, const std::string& what);
+        [[noreturn]] void error(const std::string& message) const;
+        [[noreturn]] void unsupported(const std::string& what) const;
+
+        // statements
+        void parseStatement(std::vector<NodePtr>& stmts);
+        void parseSimpleStatement(std::vector<NodePtr>& stmts);
+        NodePtr parseSmallStatement();
+        NodePtr parseExpressionStatement();
+        NodePtr parseFunctionDef();
+        NodePtr parseIf();
+        NodePtr parseFor();
+        NodePtr parseWhile();
+        NodePtr parseSuite();
+        NParameterList* parseParameters(bool lambda);
+
+        // expressions
+        NodePtr parseTest();
+        NodePtr parseLambda();
+        NodePtr parseOrTest();
+        NodePtr parseAndTest();
+        NodePtr parseNotTest();
+        NodePtr parseComparison();
+        NodePtr parseBinary(int level);
+        NodePtr parseFactor();
+        NodePtr parsePower();
+        NodePtr parseAtomExpr();
+        NodePtr parseAtom();
+        NodePtr parseSubscript();
+        NodePtr parseTestList(bool allowStar);
+        NodePtr parseExprList();
+    };
+}
+
+#endif //TUPLEX_PYTHONSUBSETPARSER_H
@@ -276,6 +276,93 @@ namespace tuplex {
         return idTuple;
     }
 
+// helper visitor class for structuralKey
+    class StructuralKeyVisitor : public IPrePostVisitor {
+    private:
+        bool _withTypes;
+        std::string _key;
+
+    protected:
+        void preOrder(ASTNode *node) override;
+
+        void postOrder(ASTNode *node) override { _key += ')'; }
+    public:
+        explicit StructuralKeyVisitor(bool withTypes) : _withTypes(withTypes) {}
+
+        std::string key() const { return _key; }
+    };
+
+    void StructuralKeyVisitor::preOrder(ASTNode *node) {
+        _key += std::to_string(static_cast<int>(node->type()));
+
+        // node specific payload, optional children are marked so different trees never map to the same key
+        switch(node->type()) {
+            case ASTNodeType::Identifier:
+                _key += ":" + static_cast<NIdentifier*>(node)->_name;
+                break;
+            case ASTNodeType::Number:
+                _key += ":" + static_cast<NNumber*>(node)->_value;
+                break;
+            case ASTNodeType::String: {
+                auto value = static_cast<NString*>(node)->value();
+                _key += ":" + std::to_string(value.size()) + ":" + value;
+                break;
+            }
+            case ASTNodeType::Boolean:
+                _key += static_cast<NBoolean*>(node)->_value ? ":T" : ":F";
+                break;
+            case ASTNodeType::BinaryOp:
+                _key += ":" + std::to_string(static_cast<int>(static_cast<NBinaryOp*>(node)->_op));
+                break;
+            case ASTNodeType::UnaryOp:
+                _key += ":" + std::to_string(static_cast<int>(static_cast<NUnaryOp*>(node)->_op));
+                break;
+            case ASTNodeType::Compare:
+                for(auto op : static_cast<NCompare*>(node)->_ops)
+                    _key += ":" + std::to_string(static_cast<int>(op));
+                break;
+            case ASTNodeType::IfElse:
+                _key += static_cast<NIfElse*>(node)->isExpression() ? ":E" : ":S";
+                break;
+            case ASTNodeType::Lambda:
+                _key += static_cast<NLambda*>(node)->isFirstArgTuple() ? ":T" : ":U";
+                break;
+            case ASTNodeType::Function:
+                _key += static_cast<NFunction*>(node)->isFirstArgTuple() ? ":T" : ":U";
+                break;
+            case ASTNodeType::Parameter: {
+                auto param = static_cast<NParameter*>(node);
+                _key += param->_annotation ? ":A" : ":";
+                _key += param->_default ? "D" : "";
+                break;
+            }
+            case ASTNodeType::SliceItem: {
+                auto item = static_cast<NSliceItem*>(node);
+                _key += ":";
+                _key += item->_start ? "1" : "0";
+                _key += item->_end ? "1" : "0";
+                _key += item->_stride ? "1" : "0";
+                break;
+            }
+            default:
+                break;
+        }
+
+        // type ids are unique within the process, so use them instead of the (lengthy) description
+        if(_withTypes)
+            _key += "@" + std::to_string(node->getInferredType().hash());
+        _key += '(';
+    }
+
+    std::string structuralKey(ASTNode *root, bool withTypes) {
+        if(!root)
+            return "";
+
+        StructuralKeyVisitor skv(withTypes);
+        root->accept(skv);
+        return skv.key();
+    }
+
     std::string compileErrorToStr(const CompileError &err) {
         std::string errMsg;
         switch(err) {
@@ -23,6 +23,8 @@
 #include <TypeSystem.h>
 #include <Pipe.h>
 #include <parser/Parser.h>
+#include <ASTHelpers.h>
+#include <ApplyVisitor.h>
 
 #ifndef NDEBUG
 static int g_func_counter = 0;
@@ -606,5 +608,28 @@ namespace tuplex {
                 Logger::instance().defaultLogger().error("unknown ast node of find func returned: " + std::to_string((int)funcRoot->type()));
             }
         }
+
+        std::string AnnotatedAST::memoKey(bool withTypes) const {
+            if(!_root)
+                return "";
+
+            // annotations (e.g. from tracing a sample) steer typing and code generation, yet are not part of the key
+            bool annotated = false;
+            ApplyVisitor av([](const ASTNode* node) { return node->hasAnnotation(); }, [&annotated](ASTNode& node) {
+                annotated = true;
+            });
+            _root->accept(av);
+            if(annotated)
+                return "";
+
+            std::string key = structuralKey(_root, withTypes);
+            key += "|hints:";
+            for(const auto& hint : _typeHints)
+                key += hint.first + "=" + std::to_string(hint.second.hash()) + ",";
+            key += _typesDefined ? "|defined" : "|undefined";
+            key += _allowNumericTypeUnification ? "|unify|" : "|nounify|";
+            key += _globals.desc();
+            return key;
+        }
     }
 }
\ No newline at end of file
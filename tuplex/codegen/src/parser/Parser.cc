@@ -11,15 +11,32 @@
 #include <parser/Parser.h>
 #include <parser/ASTBuilderVisitor.h>
 #include <parser/ASTPrinter.h>
+#include <parser/PythonSubsetParser.h>
 #include <antlr4-runtime/antlr4-runtime.h>
 #include <Python3Parser.h>
 #include <Python3Lexer.h>
 
 namespace tuplex {
 
+    ASTNode* parseToAST(const std::string& code) {
+        // empty code? do not parse...
+        if(code.empty())
+            return nullptr;
+
+        // UDFs are almost always within the subset the compiler supports, parse them directly.
+        // For anything else use the full grammar.
+        PythonSubsetParser parser(code);
+        auto root = parser.parse();
+        if(root)
+            return root;
+
+        Logger::instance().logger("python3 parser").debug("falling back to ANTLR parser: " + parser.errorMessage());
+        return parseToASTWithANTLR(code);
+    }
+
     // this is basically a helper class, the actual lifting is done via
     // antlr4 and a visitor to convert things...
-    ASTNode* parseToAST(const std::string& code) {
+    ASTNode* parseToASTWithANTLR(const std::string& code) {
 
         using namespace std;
         using namespace antlr4;
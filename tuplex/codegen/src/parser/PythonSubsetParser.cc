@@ -0,0 +1,1100 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <parser/PythonSubsetParser.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace tuplex {
+
+    static const std::unordered_map<std::string, TokenType> keywords = {
+            {"False", TokenType::FALSE}, {"None", TokenType::NONE}, {"True", TokenType::TRUE},
+            {"and", TokenType::AND}, {"as", TokenType::AS}, {"assert", TokenType::ASSERT},
+            {"break", TokenType::BREAK}, {"class", TokenType::CLASS}, {"continue", TokenType::CONTINUE},
+            {"def", TokenType::DEF}, {"del", TokenType::DEL}, {"elif", TokenType::ELIF},
+            {"else", TokenType::ELSE}, {"except", TokenType::EXCEPT}, {"finally", TokenType::FINALLY},
+            {"for", TokenType::FOR}, {"from", TokenType::FROM}, {"global", TokenType::GLOBAL},
+            {"if", TokenType::IF}, {"import", TokenType::IMPORT}, {"in", TokenType::IN},
+            {"is", TokenType::IS}, {"lambda", TokenType::LAMBDA}, {"nonlocal", TokenType::NONLOCAL},
+            {"not", TokenType::NOT}, {"or", TokenType::OR}, {"pass", TokenType::PASS},
+            {"raise", TokenType::RAISE}, {"return", TokenType::RETURN}, {"try", TokenType::TRY},
+            {"while", TokenType::WHILE}, {"with", TokenType::WITH}, {"yield", TokenType::YIELD}
+    };
+
+    static inline bool isIdentifierStart(char c) {
+        // non-ascii characters are allowed in identifiers
+        return isalpha(c) || c == '_' || (static_cast<unsigned char>(c) & 0x80);
+    }
+
+    static inline bool isIdentifierChar(char c) {
+        return isIdentifierStart(c) || isdigit(c);
+    }
+
+    static inline bool isStringPrefix(const std::string& s) {
+        std::string lower = s;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        return lower == "r" || lower == "u" || lower == "b" || lower == "f" ||
+               lower == "br" || lower == "rb" || lower == "fr" || lower == "rf";
+    }
+
+    // longest Python operator at position i, UNKNOWN if there is none
+    static TokenType matchOperator(const std::string& code, size_t i, size_t& length) {
+        auto at = [&](size_t offset) { return i + offset < code.length() ? code[i + offset] : '\0'; };
+        // operators op, op= and (for some) opop, opop=
+        auto withAssign = [&](TokenType op, TokenType opAssign) {
+            if(at(1) == '=') {
+                length = 2;
+                return opAssign;
+            }
+            length = 1;
+            return op;
+        };
+        auto doubled = [&](TokenType op, TokenType opAssign, TokenType opop, TokenType opopAssign) {
+            if(at(1) == at(0)) {
+                length = at(2) == '=' ? 3 : 2;
+                return at(2) == '=' ? opopAssign : opop;
+            }
+            return withAssign(op, opAssign);
+        };
+
+        length = 1;
+        switch(at(0)) {
+            case '(': return TokenType::LPAR;
+            case ')': return TokenType::RPAR;
+            case '[': return TokenType::LSQB;
+            case ']': return TokenType::RSQB;
+            case '{': return TokenType::LBRACE;
+            case '}': return TokenType::RBRACE;
+            case ':': return TokenType::COLON;
+            case ',': return TokenType::COMMA;
+            case ';': return TokenType::SEMI;
+            case '~': return TokenType::TILDE;
+            case '.':
+                if(at(1) == '.' && at(2) == '.') {
+                    length = 3;
+                    return TokenType::ELLIPSIS;
+                }
+                return TokenType::DOT;
+            case '+': return withAssign(TokenType::PLUS, TokenType::PLUSEQUAL);
+            case '-':
+                if(at(1) == '>') {
+                    length = 2;
+                    return TokenType::RARROW;
+                }
+                return withAssign(TokenType::MINUS, TokenType::MINEQUAL);
+            case '%': return withAssign(TokenType::PERCENT, TokenType::PERCENTEQUAL);
+            case '&': return withAssign(TokenType::AMPER, TokenType::AMPEREQUAL);
+            case '|': return withAssign(TokenType::VBAR, TokenType::VBAREQUAL);
+            case '^': return withAssign(TokenType::CIRCUMFLEX, TokenType::CIRCUMFLEXEQUAL);
+            case '@': return withAssign(TokenType::AT, TokenType::ATEQUAL);
+            case '=': return withAssign(TokenType::EQUAL, TokenType::EQEQUAL);
+            case '*': return doubled(TokenType::STAR, TokenType::STAREQUAL, TokenType::DOUBLESTAR, TokenType::DOUBLESTAREQUAL);
+            case '/': return doubled(TokenType::SLASH, TokenType::SLASHEQUAL, TokenType::DOUBLESLASH, TokenType::DOUBLESLASHEQUAL);
+            case '<': return doubled(TokenType::LESS, TokenType::LESSEQUAL, TokenType::LEFTSHIFT, TokenType::LEFTSHIFTEQUAL);
+            case '>': return doubled(TokenType::GREATER, TokenType::GREATEREQUAL, TokenType::RIGHTSHIFT, TokenType::RIGHTSHIFTEQUAL);
+            case '!':
+                if(at(1) == '=') {
+                    length = 2;
+                    return TokenType::NOTEQUAL;
+                }
+                return TokenType::UNKNOWN;
+            default:
+                return TokenType::UNKNOWN;
+        }
+    }
+
+    bool PythonSubsetParser::tokenize(const std::string &code, std::vector<Token> &tokens, std::string &errMessage) {
+        std::vector<int> indents{0};
+        int parenDepth = 0;
+        long long line = 0;
+        size_t lineStart = 0;
+        size_t i = 0;
+        const size_t n = code.length();
+        bool atLineStart = true;
+
+        auto fail = [&](const std::string& message) {
+            errMessage = "line " + std::to_string(line + 1) + ": " + message;
+            return false;
+        };
+        auto newLine = [&](size_t pos) {
+            line++;
+            lineStart = pos;
+        };
+
+        while(i < n) {
+            // indentation of a new logical line
+            if(atLineStart) {
+                atLineStart = false;
+                int col = 0;
+                while(i < n) {
+                    if(code[i] == ' ')
+                        col++;
+                    else if(code[i] == '\t')
+                        col = (col / 8 + 1) * 8;
+                    else if(code[i] == '\f')
+                        col = 0;
+                    else
+                        break;
+                    i++;
+                }
+
+                // blank lines and comment lines do not affect indentation
+                if(i >= n)
+                    break;
+                if(code[i] == '#') {
+                    while(i < n && code[i] != '\n' && code[i] != '\r')
+                        i++;
+                }
+                if(i < n && (code[i] == '\n' || code[i] == '\r')) {
+                    if(code[i] == '\r' && i + 1 < n && code[i + 1] == '\n')
+                        i++;
+                    i++;
+                    newLine(i);
+                    atLineStart = true;
+                    continue;
+                }
+                if(i >= n)
+                    break;
+
+                if(col > indents.back()) {
+                    indents.push_back(col);
+                    tokens.emplace_back(TokenType::INDENT, line, 0, "");
+                } else {
+                    while(col < indents.back()) {
+                        indents.pop_back();
+                        tokens.emplace_back(TokenType::DEDENT, line, 0, "");
+                    }
+                    if(col != indents.back())
+                        return fail("unindent does not match any outer indentation level");
+                }
+            }
+
+            char c = code[i];
+            long long col = static_cast<long long>(i - lineStart);
+
+            // whitespace & comments
+            if(c == ' ' || c == '\t' || c == '\f') {
+                i++;
+                continue;
+            }
+            if(c == '#') {
+                while(i < n && code[i] != '\n' && code[i] != '\r')
+                    i++;
+                continue;
+            }
+
+            // explicit line joining
+            if(c == '\\') {
+                size_t j = i + 1;
+                if(j < n && code[j] == '\r')
+                    j++;
+                if(j < n && code[j] == '\n')
+                    j++;
+                if(j == i + 1)
+                    return fail("unexpected character after line continuation character");
+                i = j;
+                newLine(i);
+                continue;
+            }
+
+            if(c == '\n' || c == '\r') {
+                if(c == '\r' && i + 1 < n && code[i + 1] == '\n')
+                    i++;
+                i++;
+                // implicit line joining within brackets
+                if(parenDepth == 0) {
+                    tokens.emplace_back(TokenType::NEWLINE, line, col, "\n");
+                    atLineStart = true;
+                }
+                newLine(i);
+                continue;
+            }
+
+            // identifiers and keywords, a name directly followed by a quote is a string prefix
+            size_t stringStart = i;
+            if(isIdentifierStart(c)) {
+                while(i < n && isIdentifierChar(code[i]))
+                    i++;
+                auto name = code.substr(stringStart, i - stringStart);
+                if(!(i < n && (code[i] == '\'' || code[i] == '"') && isStringPrefix(name))) {
+                    auto it = keywords.find(name);
+                    tokens.emplace_back(it != keywords.end() ? it->second : TokenType::IDENTIFIER, line, col, name);
+                    continue;
+                }
+            }
+
+            // strings, the raw token incl. prefix and quotes is kept
+            if(i < n && (code[i] == '\'' || code[i] == '"')) {
+                char quote = code[i];
+                bool triple = i + 2 < n && code[i + 1] == quote && code[i + 2] == quote;
+                i += triple ? 3 : 1;
+                bool closed = false;
+                while(i < n) {
+                    if(code[i] == '\\') {
+                        if(i + 1 < n && code[i + 1] == '\n')
+                            newLine(i + 2);
+                        i += 2;
+                        continue;
+                    }
+                    if(code[i] == quote && (!triple || (i + 2 < n && code[i + 1] == quote && code[i + 2] == quote))) {
+                        i += triple ? 3 : 1;
+                        closed = true;
+                        break;
+                    }
+                    if(code[i] == '\n' || code[i] == '\r') {
+                        if(!triple)
+                            return fail("EOL while scanning string literal");
+                        if(code[i] == '\n')
+                            newLine(i + 1);
+                    }
+                    i++;
+                }
+                if(!closed)
+                    return fail("EOF while scanning string literal");
+                tokens.emplace_back(TokenType::STRING, line, col, code.substr(stringStart, i - stringStart));
+                continue;
+            }
+
+            // numbers, the raw token is kept
+            if(isdigit(c) || (c == '.' && i + 1 < n && isdigit(code[i + 1]))) {
+                size_t start = i;
+                auto digits = [&]() {
+                    while(i < n && (isdigit(code[i]) || code[i] == '_'))
+                        i++;
+                };
+                if(c == '0' && i + 1 < n && strchr("xXoObB", code[i + 1])) {
+                    i += 2;
+                    while(i < n && (isxdigit(code[i]) || code[i] == '_'))
+                        i++;
+                } else {
+                    digits();
+                    if(i < n && code[i] == '.') {
+                        i++;
+                        digits();
+                    }
+                    if(i < n && (code[i] == 'e' || code[i] == 'E')) {
+                        size_t j = i + 1;
+                        if(j < n && (code[j] == '+' || code[j] == '-'))
+                            j++;
+                        if(j < n && isdigit(code[j])) {
+                            i = j;
+                            digits();
+                        }
+                    }
+                    if(i < n && (code[i] == 'j' || code[i] == 'J'))
+                        i++;
+                }
+                tokens.emplace_back(TokenType::NUMBER, line, col, code.substr(start, i - start));
+                continue;
+            }
+
+            // operators & delimiters
+            size_t length = 0;
+            auto tt = matchOperator(code, i, length);
+            if(tt == TokenType::UNKNOWN)
+                return fail(std::string("invalid character '") + c + "'");
+            if(tt == TokenType::LPAR || tt == TokenType::LSQB || tt == TokenType::LBRACE)
+                parenDepth++;
+            if(tt == TokenType::RPAR || tt == TokenType::RSQB || tt == TokenType::RBRACE) {
+                if(--parenDepth < 0)
+                    return fail("unmatched '" + code.substr(i, 1) + "'");
+            }
+            tokens.emplace_back(tt, line, col, code.substr(i, length));
+            i += length;
+        }
+
+        if(parenDepth > 0)
+            return fail("unexpected EOF, bracket was never closed");
+
+        // make sure the last line is terminated and all blocks are closed
+        if(!tokens.empty() && tokens.back().getType() != TokenType::NEWLINE)
+            tokens.emplace_back(TokenType::NEWLINE, line, static_cast<long long>(n - lineStart), "\n");
+        while(indents.size() > 1) {
+            indents.pop_back();
+            tokens.emplace_back(TokenType::DEDENT, line, 0, "");
+        }
+        tokens.emplace_back(TokenType::ENDOFFILE, line, 0, "");
+        return true;
+    }
+
+    ASTNode* PythonSubsetParser::parse() {
+        _errorMessage.clear();
+        _tokens.clear();
+        _pos = 0;
+
+        if(!tokenize(_code, _tokens, _errorMessage))
+            return nullptr;
+
+        try {
+            std::vector<NodePtr> stmts;
+            while(peekType() != TokenType::ENDOFFILE) {
+                if(accept(TokenType::NEWLINE))
+                    continue;
+                parseStatement(stmts);
+            }
+
+            if(stmts.empty()) {
+                _errorMessage = "no statement found";
+                return nullptr;
+            }
+
+            // like the ANTLR based builder, return the last statement (i.e. the function definition or lambda)
+            return stmts.back().release();
+        } catch(const std::runtime_error& e) {
+            _errorMessage = e.what();
+            return nullptr;
+        }
+    }
+
+    const Token& PythonSubsetParser::peek(size_t offset) const {
+        assert(!_tokens.empty());
+        return _tokens[std::min(_pos + offset, _tokens.size() - 1)];
+    }
+
+    bool PythonSubsetParser::accept(TokenType tt) {
+        if(peekType() != tt)
+            return false;
+        next();
+        return true;
+    }
+
+    const Token& PythonSubsetParser::expect(TokenType tt, const std::string &what) {
+        if(peekType() != tt)
+            error("expected " + what);
+        return next();
+    }
+
+    void PythonSubsetParser::error(const std::string &message) const {
+        auto& t = peek();
+        auto found = t.getType() == TokenType::ENDOFFILE ? std::string("end of input") :
+                     t.getType() == TokenType::NEWLINE ? std::string("end of line") :
+                     t.getType() == TokenType::INDENT ? std::string("indent") :
+                     t.getType() == TokenType::DEDENT ? std::string("dedent") : "'" + t.getRawToken() + "'";
+        throw std::runtime_error("line " + std::to_string(t.getLineNumber() + 1) + ": " + message + ", found " + found);
+    }
+
+    void PythonSubsetParser::unsupported(const std::string &what) const {
+        throw std::runtime_error("line " + std::to_string(peek().getLineNumber() + 1) + ": " + what + " not supported");
+    }
+
+    static std::unique_ptr<ASTNode> makeBinaryOp(std::unique_ptr<ASTNode> left, TokenType op, std::unique_ptr<ASTNode> right) {
+        // nodes get linked directly, the constructors of NBinaryOp etc. would deep copy their children
+        auto binop = new NBinaryOp();
+        binop->_left = left.release();
+        binop->_op = op;
+        binop->_right = right.release();
+        return std::unique_ptr<ASTNode>(binop);
+    }
+
+    static std::unique_ptr<ASTNode> makeUnaryOp(TokenType op, std::unique_ptr<ASTNode> operand) {
+        auto unop = new NUnaryOp();
+        unop->_op = op;
+        unop->_operand = operand.release();
+        return std::unique_ptr<ASTNode>(unop);
+    }
+
+    // token types which may start an expression, used to detect trailing commas
+    static bool startsExpression(TokenType tt) {
+        switch(tt) {
+            case TokenType::IDENTIFIER:
+            case TokenType::NUMBER:
+            case TokenType::STRING:
+            case TokenType::NONE:
+            case TokenType::TRUE:
+            case TokenType::FALSE:
+            case TokenType::LPAR:
+            case TokenType::LSQB:
+            case TokenType::LBRACE:
+            case TokenType::PLUS:
+            case TokenType::MINUS:
+            case TokenType::TILDE:
+            case TokenType::NOT:
+            case TokenType::LAMBDA:
+            case TokenType::ELLIPSIS:
+            case TokenType::STAR:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // ------------------------------------------------------------------------------------------------------------
+    // statements
+
+    void PythonSubsetParser::parseStatement(std::vector<NodePtr> &stmts) {
+        switch(peekType()) {
+            case TokenType::DEF:
+                stmts.emplace_back(parseFunctionDef());
+                break;
+            case TokenType::IF:
+                stmts.emplace_back(parseIf());
+                break;
+            case TokenType::FOR:
+                stmts.emplace_back(parseFor());
+                break;
+            case TokenType::WHILE:
+                stmts.emplace_back(parseWhile());
+                break;
+            case TokenType::CLASS:
+            case TokenType::TRY:
+            case TokenType::WITH:
+            case TokenType::AT:
+                unsupported("'" + peek().getRawToken() + "' statement");
+            case TokenType::INDENT:
+                error("unexpected indent");
+            default:
+                parseSimpleStatement(stmts);
+                break;
+        }
+    }
+
+    void PythonSubsetParser::parseSimpleStatement(std::vector<NodePtr> &stmts) {
+        stmts.emplace_back(parseSmallStatement());
+        while(accept(TokenType::SEMI)) {
+            if(peekType() == TokenType::NEWLINE)
+                break;
+            stmts.emplace_back(parseSmallStatement());
+        }
+        expect(TokenType::NEWLINE, "end of statement");
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseSmallStatement() {
+        auto endOfStatement = [this]() {
+            return peekType() == TokenType::NEWLINE || peekType() == TokenType::SEMI;
+        };
+
+        switch(peekType()) {
+            case TokenType::RETURN: {
+                next();
+                NodePtr value;
+                if(!endOfStatement())
+                    value = parseTestList(false);
+                auto ret = new NReturn();
+                ret->_expression = value.release();
+                return NodePtr(ret);
+            }
+            case TokenType::BREAK:
+                next();
+                return NodePtr(new NBreak());
+            case TokenType::CONTINUE:
+                next();
+                return NodePtr(new NContinue());
+            case TokenType::ASSERT: {
+                next();
+                auto expr = parseTest();
+                NodePtr errExpr;
+                if(accept(TokenType::COMMA))
+                    errExpr = parseTest();
+                auto a = new NAssert();
+                a->_expression = expr.release();
+                a->_errorExpression = errExpr.release();
+                return NodePtr(a);
+            }
+            case TokenType::RAISE: {
+                next();
+                NodePtr expr, fromExpr;
+                if(!endOfStatement()) {
+                    expr = parseTest();
+                    if(accept(TokenType::FROM))
+                        fromExpr = parseTest();
+                }
+                auto r = new NRaise();
+                r->_expression = expr.release();
+                r->_fromExpression = fromExpr.release();
+                return NodePtr(r);
+            }
+            case TokenType::PASS:
+            case TokenType::DEL:
+            case TokenType::GLOBAL:
+            case TokenType::NONLOCAL:
+            case TokenType::IMPORT:
+            case TokenType::FROM:
+            case TokenType::YIELD:
+                unsupported("'" + peek().getRawToken() + "' statement");
+            default:
+                return parseExpressionStatement();
+        }
+    }
+
+    static TokenType augmentedOperator(TokenType tt) {
+        switch(tt) {
+            case TokenType::PLUSEQUAL: return TokenType::PLUS;
+            case TokenType::MINEQUAL: return TokenType::MINUS;
+            case TokenType::STAREQUAL: return TokenType::STAR;
+            case TokenType::SLASHEQUAL: return TokenType::SLASH;
+            case TokenType::PERCENTEQUAL: return TokenType::PERCENT;
+            case TokenType::AMPEREQUAL: return TokenType::AMPER;
+            case TokenType::VBAREQUAL: return TokenType::VBAR;
+            case TokenType::CIRCUMFLEXEQUAL: return TokenType::CIRCUMFLEX;
+            case TokenType::LEFTSHIFTEQUAL: return TokenType::LEFTSHIFT;
+            case TokenType::RIGHTSHIFTEQUAL: return TokenType::RIGHTSHIFT;
+            case TokenType::DOUBLESTAREQUAL: return TokenType::DOUBLESTAR;
+            case TokenType::DOUBLESLASHEQUAL: return TokenType::DOUBLESLASH;
+            case TokenType::ATEQUAL: return TokenType::AT;
+            default: return TokenType::UNKNOWN;
+        }
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseExpressionStatement() {
+        auto first = parseTestList(true);
+
+        if(peekType() == TokenType::COLON)
+            unsupported("annotated assignment");
+
+        // x += y is represented as x = x + y
+        auto op = augmentedOperator(peekType());
+        if(op != TokenType::UNKNOWN) {
+            next();
+            if(peekType() == TokenType::YIELD)
+                unsupported("yield expression");
+            auto value = parseTestList(false);
+            auto binop = makeBinaryOp(NodePtr(first->clone()), op, std::move(value));
+            auto assign = new NAssign();
+            assign->_target = first.release();
+            assign->_value = binop.release();
+            return NodePtr(assign);
+        }
+
+        std::vector<NodePtr> exprs;
+        exprs.emplace_back(std::move(first));
+        while(accept(TokenType::EQUAL)) {
+            if(peekType() == TokenType::YIELD)
+                unsupported("yield expression");
+            exprs.emplace_back(parseTestList(true));
+        }
+
+        // a = b = c is nested as a = (b = c)
+        auto node = std::move(exprs.back());
+        exprs.pop_back();
+        while(!exprs.empty()) {
+            auto assign = new NAssign();
+            assign->_target = exprs.back().release();
+            assign->_value = node.release();
+            exprs.pop_back();
+            node.reset(assign);
+        }
+        return node;
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseFunctionDef() {
+        expect(TokenType::DEF, "'def'");
+        auto name = expect(TokenType::IDENTIFIER, "function name");
+        std::unique_ptr<NParameterList> params(parseParameters(false));
+        if(peekType() == TokenType::RARROW)
+            unsupported("return annotation");
+        expect(TokenType::COLON, "':'");
+        auto suite = parseSuite();
+
+        auto func = new NFunction();
+        func->_name = new NIdentifier(name.getRawToken());
+        func->_parameters = params.release();
+        func->_suite = suite.release();
+        return NodePtr(func);
+    }
+
+    NParameterList* PythonSubsetParser::parseParameters(bool lambda) {
+        // lambda x, y=2: ... or def f(x, y: int=2): ...
+        std::unique_ptr<NParameterList> params(new NParameterList());
+        if(!lambda)
+            expect(TokenType::LPAR, "'('");
+        auto end = lambda ? TokenType::COLON : TokenType::RPAR;
+        while(peekType() != end) {
+            if(peekType() == TokenType::STAR || peekType() == TokenType::DOUBLESTAR)
+                unsupported("starred parameters");
+            auto name = expect(TokenType::IDENTIFIER, "parameter name");
+            std::unique_ptr<NParameter> param(new NParameter());
+            param->_identifier = new NIdentifier(name.getRawToken());
+            if(!lambda && accept(TokenType::COLON))
+                param->_annotation = parseTest().release();
+            if(accept(TokenType::EQUAL))
+                param->_default = parseTest().release();
+            params->_args.push_back(param.release());
+            if(!accept(TokenType::COMMA))
+                break;
+        }
+        if(!lambda)
+            expect(TokenType::RPAR, "')'");
+        return params.release();
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseSuite() {
+        std::vector<NodePtr> stmts;
+        if(accept(TokenType::NEWLINE)) {
+            expect(TokenType::INDENT, "an indented block");
+            while(!accept(TokenType::DEDENT)) {
+                if(peekType() == TokenType::ENDOFFILE)
+                    error("expected dedent");
+                parseStatement(stmts);
+            }
+        } else {
+            parseSimpleStatement(stmts);
+        }
+
+        auto suite = new NSuite();
+        suite->_statements.reserve(stmts.size());
+        for(auto& stmt : stmts)
+            suite->_statements.push_back(stmt.release());
+        return NodePtr(suite);
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseIf() {
+        std::vector<std::pair<NodePtr, NodePtr>> branches;
+        expect(TokenType::IF, "'if'");
+        do {
+            auto test = parseTest();
+            expect(TokenType::COLON, "':'");
+            auto suite = parseSuite();
+            branches.emplace_back(std::move(test), std::move(suite));
+        } while(accept(TokenType::ELIF));
+
+        NodePtr node;
+        if(accept(TokenType::ELSE)) {
+            expect(TokenType::COLON, "':'");
+            node = parseSuite();
+        }
+
+        // elif branches are nested into the else branch of the previous condition
+        for(auto it = branches.rbegin(); it != branches.rend(); ++it) {
+            auto ifelse = new NIfElse();
+            ifelse->_expression = it->first.release();
+            ifelse->_then = it->second.release();
+            ifelse->_else = node.release();
+            node.reset(ifelse);
+        }
+        return node;
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseFor() {
+        expect(TokenType::FOR, "'for'");
+        auto target = parseExprList();
+        expect(TokenType::IN, "'in'");
+        auto iter = parseTestList(false);
+        expect(TokenType::COLON, "':'");
+        auto body = parseSuite();
+        NodePtr elseSuite;
+        if(accept(TokenType::ELSE)) {
+            expect(TokenType::COLON, "':'");
+            elseSuite = parseSuite();
+        }
+
+        auto loop = new NFor();
+        loop->target = target.release();
+        loop->expression = iter.release();
+        loop->suite_body = body.release();
+        loop->suite_else = elseSuite.release();
+        return NodePtr(loop);
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseWhile() {
+        expect(TokenType::WHILE, "'while'");
+        auto test = parseTest();
+        expect(TokenType::COLON, "':'");
+        auto body = parseSuite();
+        NodePtr elseSuite;
+        if(accept(TokenType::ELSE)) {
+            expect(TokenType::COLON, "':'");
+            elseSuite = parseSuite();
+        }
+
+        auto loop = new NWhile();
+        loop->expression = test.release();
+        loop->suite_body = body.release();
+        loop->suite_else = elseSuite.release();
+        return NodePtr(loop);
+    }
+
+    // ------------------------------------------------------------------------------------------------------------
+    // expressions
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseTestList(bool allowStar) {
+        std::vector<NodePtr> elements;
+        bool hasComma = false;
+        do {
+            if(peekType() == TokenType::STAR)
+                unsupported(allowStar ? "star expression in assignment" : "star expression");
+            elements.emplace_back(parseTest());
+            if(!accept(TokenType::COMMA))
+                break;
+            hasComma = true;
+        } while(startsExpression(peekType()));
+
+        if(!hasComma)
+            return std::move(elements.front());
+
+        auto tuple = new NTuple();
+        for(auto& el : elements)
+            tuple->_elements.push_back(el.release());
+        return NodePtr(tuple);
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseExprList() {
+        // targets of for loops and comprehensions
+        std::vector<NodePtr> targets;
+        bool hasComma = false;
+        do {
+            if(peekType() == TokenType::STAR)
+                unsupported("star expression");
+            targets.emplace_back(parseBinary(0));
+            if(!accept(TokenType::COMMA))
+                break;
+            hasComma = true;
+        } while(peekType() != TokenType::IN);
+
+        if(!hasComma)
+            return std::move(targets.front());
+
+        auto tuple = new NTuple();
+        for(auto& t : targets)
+            tuple->_elements.push_back(t.release());
+        return NodePtr(tuple);
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseTest() {
+        if(peekType() == TokenType::LAMBDA)
+            return parseLambda();
+
+        auto expr = parseOrTest();
+        if(accept(TokenType::IF)) {
+            auto cond = parseOrTest();
+            expect(TokenType::ELSE, "'else'");
+            auto elseExpr = parseTest();
+            // the expression flag can only be set via the (copying) constructor
+            return NodePtr(new NIfElse(cond.get(), expr.get(), elseExpr.get(), true));
+        }
+        return expr;
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseLambda() {
+        expect(TokenType::LAMBDA, "'lambda'");
+        std::unique_ptr<NParameterList> params(parseParameters(true));
+        expect(TokenType::COLON, "':'");
+        auto body = parseTest();
+
+        auto lambda = new NLambda();
+        lambda->_arguments = params.release();
+        lambda->_expression = body.release();
+        return NodePtr(lambda);
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseOrTest() {
+        auto left = parseAndTest();
+        while(accept(TokenType::OR))
+            left = makeBinaryOp(std::move(left), TokenType::OR, parseAndTest());
+        return left;
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseAndTest() {
+        auto left = parseNotTest();
+        while(accept(TokenType::AND))
+            left = makeBinaryOp(std::move(left), TokenType::AND, parseNotTest());
+        return left;
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseNotTest() {
+        if(accept(TokenType::NOT))
+            return makeUnaryOp(TokenType::NOT, parseNotTest());
+        return parseComparison();
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseComparison() {
+        auto left = parseBinary(0);
+        std::unique_ptr<NCompare> cmp;
+        while(true) {
+            auto op = TokenType::UNKNOWN;
+            switch(peekType()) {
+                case TokenType::LESS:
+                case TokenType::GREATER:
+                case TokenType::EQEQUAL:
+                case TokenType::GREATEREQUAL:
+                case TokenType::LESSEQUAL:
+                case TokenType::NOTEQUAL:
+                case TokenType::IN:
+                    op = next().getType();
+                    break;
+                case TokenType::NOT:
+                    if(peekType(1) == TokenType::IN) {
+                        next(); next();
+                        op = TokenType::NOTIN;
+                    }
+                    break;
+                case TokenType::IS:
+                    unsupported("'is' comparison");
+                default:
+                    break;
+            }
+            if(op == TokenType::UNKNOWN)
+                break;
+
+            // a < b < c is a single comparison node
+            auto right = parseBinary(0);
+            if(!cmp) {
+                cmp.reset(new NCompare());
+                cmp->_left = left.release();
+            }
+            cmp->_ops.push_back(op);
+            cmp->_comps.push_back(right.release());
+        }
+        return cmp ? NodePtr(cmp.release()) : std::move(left);
+    }
+
+    // binary operators from lowest to highest precedence, all left associative
+    static const std::vector<std::vector<TokenType>> binaryOperatorLevels = {
+            {TokenType::VBAR},
+            {TokenType::CIRCUMFLEX},
+            {TokenType::AMPER},
+            {TokenType::LEFTSHIFT, TokenType::RIGHTSHIFT},
+            {TokenType::PLUS, TokenType::MINUS},
+            {TokenType::STAR, TokenType::SLASH, TokenType::PERCENT, TokenType::DOUBLESLASH, TokenType::AT}
+    };
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseBinary(int level) {
+        if(level == static_cast<int>(binaryOperatorLevels.size()))
+            return parseFactor();
+
+        auto left = parseBinary(level + 1);
+        const auto& ops = binaryOperatorLevels[level];
+        while(std::find(ops.begin(), ops.end(), peekType()) != ops.end()) {
+            auto op = next().getType();
+            left = makeBinaryOp(std::move(left), op, parseBinary(level + 1));
+        }
+        return left;
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseFactor() {
+        // unary operations +, -, ~
+        auto tt = peekType();
+        if(tt == TokenType::PLUS || tt == TokenType::MINUS || tt == TokenType::TILDE) {
+            next();
+            return makeUnaryOp(tt, parseFactor());
+        }
+        return parsePower();
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parsePower() {
+        auto base = parseAtomExpr();
+        if(accept(TokenType::DOUBLESTAR))
+            return makeBinaryOp(std::move(base), TokenType::DOUBLESTAR, parseFactor());
+        return base;
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseAtomExpr() {
+        auto atom = parseAtom();
+        while(true) {
+            if(accept(TokenType::DOT)) {
+                // attribute
+                NIdentifier attribute(expect(TokenType::IDENTIFIER, "attribute name").getRawToken());
+                atom.reset(new NAttribute(atom.get(), &attribute));
+            } else if(accept(TokenType::LPAR)) {
+                // call, only positional arguments are supported
+                std::vector<NodePtr> args;
+                while(peekType() != TokenType::RPAR) {
+                    if(peekType() == TokenType::STAR || peekType() == TokenType::DOUBLESTAR)
+                        unsupported("starred arguments");
+                    if(peekType() == TokenType::IDENTIFIER && peekType(1) == TokenType::EQUAL)
+                        unsupported("keyword arguments");
+                    args.emplace_back(parseTest());
+                    if(peekType() == TokenType::FOR)
+                        unsupported("generator expression");
+                    if(!accept(TokenType::COMMA))
+                        break;
+                }
+                expect(TokenType::RPAR, "')'");
+
+                auto id = dynamic_cast<NIdentifier*>(atom.get());
+                if(!args.empty() && id && id->_name == "range") {
+                    auto range = new NRange();
+                    for(auto& arg : args)
+                        range->_positionalArguments.push_back(arg.release());
+                    atom.reset(range);
+                } else {
+                    auto call = new NCall(atom.get());
+                    for(auto& arg : args)
+                        call->_positionalArguments.push_back(arg.release());
+                    atom.reset(call);
+                }
+            } else if(accept(TokenType::LSQB)) {
+                // subscript or slice
+                auto subscript = parseSubscript();
+                if(peekType() == TokenType::COMMA)
+                    unsupported("multiple subscripts");
+                expect(TokenType::RSQB, "']'");
+                if(subscript->type() == ASTNodeType::SliceItem) {
+                    auto slice = new NSlice();
+                    slice->_value = atom.release();
+                    slice->_slices.push_back(subscript.release());
+                    atom.reset(slice);
+                } else {
+                    auto sub = new NSubscription();
+                    sub->_value = atom.release();
+                    sub->_expression = subscript.release();
+                    atom.reset(sub);
+                }
+            } else {
+                break;
+            }
+        }
+        return atom;
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseSubscript() {
+        // test | [test] ':' [test] [':' [test]]
+        NodePtr start, end, stride;
+        auto endOfSlice = [this]() {
+            return peekType() == TokenType::COLON || peekType() == TokenType::RSQB || peekType() == TokenType::COMMA;
+        };
+
+        if(peekType() != TokenType::COLON) {
+            start = parseTest();
+            if(peekType() != TokenType::COLON)
+                return start;
+        }
+        expect(TokenType::COLON, "':'");
+        if(!endOfSlice())
+            end = parseTest();
+        if(accept(TokenType::COLON) && !endOfSlice())
+            stride = parseTest();
+
+        auto item = new NSliceItem();
+        item->_start = start.release();
+        item->_end = end.release();
+        item->_stride = stride.release();
+        return NodePtr(item);
+    }
+
+    PythonSubsetParser::NodePtr PythonSubsetParser::parseAtom() {
+        auto& tok = peek();
+        switch(tok.getType()) {
+            case TokenType::IDENTIFIER:
+                next();
+                return NodePtr(new NIdentifier(tok.getRawToken()));
+            case TokenType::NUMBER:
+                next();
+                return NodePtr(new NNumber(tok.getRawToken()));
+            case TokenType::STRING: {
+                // adjacent string literals are concatenated
+                std::string raw;
+                while(peekType() == TokenType::STRING)
+                    raw += next().getRawToken();
+                return NodePtr(new NString(raw));
+            }
+            case TokenType::NONE:
+                next();
+                return NodePtr(new NNone());
+            case TokenType::TRUE:
+                next();
+                return NodePtr(new NBoolean(true));
+            case TokenType::FALSE:
+                next();
+                return NodePtr(new NBoolean(false));
+            case TokenType::ELLIPSIS:
+                unsupported("ellipsis");
+            case TokenType::LPAR: {
+                // parenthesized expression or tuple
+                next();
+                if(accept(TokenType::RPAR))
+                    return NodePtr(new NTuple());
+                if(peekType() == TokenType::YIELD)
+                    unsupported("yield expression");
+                std::vector<NodePtr> elements;
+                bool hasComma = false;
+                while(true) {
+                    if(peekType() == TokenType::STAR)
+                        unsupported("star expression");
+                    elements.emplace_back(parseTest());
+                    if(peekType() == TokenType::FOR)
+                        unsupported("generator expression");
+                    if(!accept(TokenType::COMMA))
+                        break;
+                    hasComma = true;
+                    if(peekType() == TokenType::RPAR)
+                        break;
+                }
+                expect(TokenType::RPAR, "')'");
+                if(!hasComma)
+                    return std::move(elements.front());
+                auto tuple = new NTuple();
+                for(auto& el : elements)
+                    tuple->_elements.push_back(el.release());
+                return NodePtr(tuple);
+            }
+            case TokenType::LSQB: {
+                // list or list comprehension
+                next();
+                if(accept(TokenType::RSQB))
+                    return NodePtr(new NList());
+                if(peekType() == TokenType::STAR)
+                    unsupported("star expression");
+                auto first = parseTest();
+                if(accept(TokenType::FOR)) {
+                    auto target = parseExprList();
+                    if(target->type() != ASTNodeType::Identifier)
+                        unsupported("multiple targets in comprehension");
+                    expect(TokenType::IN, "'in'");
+                    auto iter = parseOrTest();
+                    if(peekType() == TokenType::FOR || peekType() == TokenType::IF)
+                        unsupported("multiple generators or conditions in comprehension");
+                    expect(TokenType::RSQB, "']'");
+
+                    auto generator = new NComprehension();
+                    generator->target = static_cast<NIdentifier*>(target.release());
+                    generator->iter = iter.release();
+                    auto comprehension = new NListComprehension();
+                    comprehension->expression = first.release();
+                    comprehension->generators.push_back(generator);
+                    return NodePtr(comprehension);
+                }
+
+                std::vector<NodePtr> elements;
+                elements.emplace_back(std::move(first));
+                while(accept(TokenType::COMMA) && peekType() != TokenType::RSQB) {
+                    if(peekType() == TokenType::STAR)
+                        unsupported("star expression");
+                    elements.emplace_back(parseTest());
+                }
+                expect(TokenType::RSQB, "']'");
+                auto list = new NList();
+                for(auto& el : elements)
+                    list->_elements.push_back(el.release());
+                return NodePtr(list);
+            }
+            case TokenType::LBRACE: {
+                // dictionary, sets are not supported
+                next();
+                std::vector<std::pair<NodePtr, NodePtr>> pairs;
+                while(peekType() != TokenType::RBRACE) {
+                    if(peekType() == TokenType::DOUBLESTAR)
+                        unsupported("dictionary unpacking");
+                    if(peekType() == TokenType::STAR)
+                        unsupported("star expression");
+                    auto key = parseTest();
+                    if(peekType() != TokenType::COLON)
+                        unsupported("set");
+                    next();
+                    auto value = parseTest();
+                    if(peekType() == TokenType::FOR)
+                        unsupported("dictionary comprehension");
+                    pairs.emplace_back(std::move(key), std::move(value));
+                    if(!accept(TokenType::COMMA))
+                        break;
+                }
+                expect(TokenType::RBRACE, "'}'");
+                auto dict = new NDictionary();
+                for(auto& p : pairs)
+                    dict->_pairs.emplace_back(p.first.release(), p.second.release());
+                return NodePtr(dict);
+            }
+            default:
+                error("invalid syntax");
+        }
+    }
+}
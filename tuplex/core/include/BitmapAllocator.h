@@ -13,8 +13,28 @@
 
 #include <thread>
 #include <atomic>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 namespace tuplex {
+
+    /*!
+     * how the memory arena of an executor is obtained. Per default via malloc, else via an anonymous mapping which can
+     * be backed by huge pages, bound to a NUMA node and faulted in ahead of use.
+     */
+    struct ArenaPolicy {
+        bool hugePages; //! use explicit huge pages (MAP_HUGETLB) if reserved, else transparent huge pages
+        bool prefault; //! touch free blocks in a background thread, so first use does not page fault
+        bool pinThreads; //! pin executor threads to a CPU each and place their arena on the CPU's NUMA node
+
+        ArenaPolicy() : hugePages(false), prefault(false), pinThreads(false) {}
+
+        bool useMapping() const { return hugePages || prefault || pinThreads; }
+    };
+
     // implement a bitmap allocator according to https://eatplayhate.me/2010/09/04/memory-management-from-the-ground-up-2-foundations/
     class BitmapAllocator {
     private:
@@ -38,6 +58,53 @@ namespace tuplex {
         size_t _numBlocks;
         size_t _blockSize;
 
+        ArenaPolicy _policy;
+        bool _mapped; // arena obtained via mmap instead of malloc
+        size_t _pageSize;
+        std::thread _prefaultThread;
+        std::atomic_bool _stopPrefault;
+
+        uint8_t* mapArena() {
+            void* ptr = MAP_FAILED;
+            _pageSize = sysconf(_SC_PAGESIZE);
+#ifdef MAP_HUGETLB
+            // explicit huge pages need to be reserved by the system, if not available use regular pages
+            const size_t hugePageSize = 2 * 1024 * 1024;
+            if(_policy.hugePages && _arenaSize % hugePageSize == 0) {
+                ptr = mmap(nullptr, _arenaSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if(ptr != MAP_FAILED)
+                    _pageSize = hugePageSize;
+            }
+#endif
+            if(ptr == MAP_FAILED) {
+                ptr = mmap(nullptr, _arenaSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if(ptr == MAP_FAILED)
+                    return nullptr;
+#ifdef MADV_HUGEPAGE
+                if(_policy.hugePages)
+                    madvise(ptr, _arenaSize, MADV_HUGEPAGE);
+#endif
+            }
+            _mapped = true;
+            return (uint8_t*)ptr;
+        }
+
+        void prefaultBlocks() {
+            // blocks are faulted under the lock and only when free, so no partition in use is touched
+            for(size_t i = 0; i < _numBlocks && !_stopPrefault; ++i) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if(_bitmap[i] != FREE_BLOCK)
+                    continue;
+                uint8_t* ptr = _arena + _blockSize * i;
+#ifdef MADV_POPULATE_WRITE
+                if(0 == madvise(ptr, _blockSize, MADV_POPULATE_WRITE))
+                    continue;
+#endif
+                for(size_t offset = 0; offset < _blockSize; offset += _pageSize)
+                    ((volatile uint8_t*)ptr)[offset] = 0;
+            }
+        }
+
 // debug
 //        void print_bitmap() {
 //            for(int i = 0; i <_numBlocks; i++) {
@@ -54,7 +121,8 @@ namespace tuplex {
 //        }
     public:
 
-        BitmapAllocator(size_t size, const size_t blockSize) {
+        BitmapAllocator(size_t size, const size_t blockSize, const ArenaPolicy& policy=ArenaPolicy()) : _policy(policy),
+        _mapped(false), _pageSize(4096), _stopPrefault(false) {
             std::lock_guard<std::mutex> lock(_mutex);
 
             // check whether multiple
@@ -73,20 +141,25 @@ namespace tuplex {
             // for simplicity bitmap is large (decrease later)
             // @TODO
             _bitmap = (unsigned char*)::malloc(_numBlocks);
-            _arena = (uint8_t*)::malloc(_arenaSize);
+            _arena = _policy.useMapping() ? mapArena() : (uint8_t*)::malloc(_arenaSize);
 
             std::stringstream ss;
             ss<<"allocated bitmap managed memory region ("
               <<sizeToMemString(_arenaSize)<<", "
-              <<sizeToMemString(_blockSize)<<" block size)";
+              <<sizeToMemString(_blockSize)<<" block size";
+            if(_mapped)
+                ss<<", "<<sizeToMemString(_pageSize)<<" pages";
+            ss<<")";
             Logger::instance().logger("memory").info(ss.str());
 
             if(!_bitmap || !_arena) {
                 Logger::instance().logger("memory").error("could not allocate memory");
                 if(_bitmap)
                     ::free(_bitmap);
-                if(_arena)
+                if(_arena && !_mapped)
                     ::free(_arena);
+                if(_arena && _mapped)
+                    munmap(_arena, _arenaSize);
 
                 exit(1);
             }
@@ -97,15 +170,50 @@ namespace tuplex {
         }
 
         ~BitmapAllocator() {
+            _stopPrefault = true;
+            if(_prefaultThread.joinable())
+                _prefaultThread.join();
+
             std::lock_guard<std::mutex> lock(_mutex);
 
             // make sure memory regions are not used somewhere else...
             if(_bitmap)
                 ::free(_bitmap);
-            if(_arena)
-                ::free(_arena);
+            if(_arena) {
+                if(_mapped)
+                    munmap(_arena, _arenaSize);
+                else
+                    ::free(_arena);
+            }
+        }
+
+        /*!
+         * prefers NUMA node for pages of the arena not yet faulted in. No-op for malloc'ed arenas or non-Linux systems.
+         * @return true if the policy was set
+         */
+        bool bindToNode(int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+            const int mpolPreferred = 1; // MPOL_PREFERRED, numaif.h is not required
+            if(!_mapped || node < 0 || node >= 64)
+                return false;
+            unsigned long nodeMask = 1ul << node;
+            return 0 == syscall(SYS_mbind, (uint8_t*)_arena, _arenaSize, mpolPreferred, &nodeMask, 8 * sizeof(nodeMask) + 1, 0);
+#else
+            return false;
+#endif
         }
 
+        /*!
+         * starts faulting in free blocks in the background if requested by the policy (only once)
+         */
+        void startPrefault() {
+            if(!_mapped || !_policy.prefault || _prefaultThread.joinable())
+                return;
+            _prefaultThread = std::thread(&BitmapAllocator::prefaultBlocks, this);
+        }
+
+        const ArenaPolicy& policy() const { return _policy; }
+
         // returns nullptr if alloc failed or size = 0!
         void* alloc(const size_t size) {
             std::lock_guard<std::mutex> lock(_mutex);
@@ -20,6 +20,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <vector>
+#include <unordered_set>
 #include <iterator>
 #include <ContextOptions.h>
 #include <JITCompiler.h>
@@ -71,6 +72,13 @@ namespace tuplex {
 
         std::shared_ptr<JobMetrics> _lastJobMetrics;
 
+        // computes shared once, then runs the actions given by indices reading from the in-memory result (used by runAll)
+        void executeShared(LogicalOperator* shared,
+                           const std::vector<size_t>& indices,
+                           const std::vector<LogicalOperator*>& actions,
+                           const std::vector<std::unordered_set<LogicalOperator*>>& ancestors,
+                           std::vector<std::shared_ptr<ResultSet>>& results);
+
     protected:
         inline int getNextDataSetID() { return _datasetIDGenerator++; };
 
@@ -230,6 +238,22 @@ namespace tuplex {
          * @return reference to newly created dataset.
          */
         DataSet& fromPartitions(const Schema& schema, const std::vector<Partition*>& partitions, const std::vector<std::string>& columns);
+
+        /*!
+         * executes multiple deferred actions (cf. DataSet::deferTake, DataSet::deferTofile) as one batch. An operator
+         * reading from files shared by several actions (e.g. the csv source) is computed only once and materialized
+         * like DataSet::cache, i.e. its rows are kept in memory (or spilled) until all actions using it finished.
+         * @param actions datasets returned by the deferred actions
+         * @return result set for each action, in order (empty for file output)
+         */
+        std::vector<std::shared_ptr<ResultSet>> runAll(const std::vector<DataSet*>& actions);
+
+        /*!
+         * with tuplex.scheduler.multiJob, actions called on different threads run as separate jobs at the same time.
+         * Sets the weight of the jobs the calling thread starts, they get a share of the executors in proportion to it.
+         * @param weight positive number, per default each job has weight 1.0
+         */
+        void setJobWeight(double weight);
     };
     // needed for template mechanism to work
 #include <DataSet.h>
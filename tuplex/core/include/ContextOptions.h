@@ -52,10 +52,21 @@ namespace tuplex {
         bool OPT_SHARED_OBJECT_PROPAGATION() const { return stringToBool(_store.at("tuplex.optimizer.sharedObjectPropagation")); }
         bool OPT_FILTER_PUSHDOWN() const { return stringToBool(_store.at("tuplex.optimizer.filterPushdown")); }
         bool OPT_OPERATOR_REORDERING() const { return stringToBool(_store.at("tuplex.optimizer.operatorReordering")); }
+        bool OPT_DEAD_COLUMN_ELIMINATION() const { return stringToBool(_store.at("tuplex.optimizer.deadColumnElimination")); } //! whether to drop UDF outputs and withColumn operators which are never used later on. Outputs which may raise are still computed
         bool OPT_MERGE_EXCEPTIONS_INORDER() const { return stringToBool(_store.at("tuplex.optimizer.mergeExceptionsInOrder")); }
+        bool CSV_EXACT_SPLITS() const { return stringToBool(_store.at("tuplex.csv.exactSplits")); } //! whether to compute row-aligned input splits via a quote parity pre-pass instead of guessing row starts (required when quoted fields contain newlines)
         bool CSV_PARSER_SELECTION_PUSHDOWN() const; //! whether to use selection pushdown in the parser. If false, then full data will be serialized.
         bool INTERLEAVE_IO() const { return stringToBool(_store.at("tuplex.interleaveIO")); } //! whether to first load, compute, then write or use IO thread to interleave IO work with compute work for faster speeds.
+        bool CONCURRENT_STAGES() const { return stringToBool(_store.at("tuplex.concurrentStages")); } //! whether independent stages of a plan (e.g. both sides of a join) may execute at the same time, sharing the executors
+        size_t AOT_COMPILE_THREADS() const { return std::stoi(_store.at("tuplex.aotCompileThreads")); } //! number of threads compiling later stages of a job while the first ones execute, 0 to compile each stage right before it runs. Ignored with tuplex.scheduler.multiJob
+        bool MULTI_JOB() const { return stringToBool(_store.at("tuplex.scheduler.multiJob")); } //! whether jobs started from several threads may run at the same time, sharing the executors by their weights
+        size_t JOB_MEMORY_QUOTA() const; //! with tuplex.scheduler.multiJob, bytes of executor memory a single job may hold in partitions before its own ones get evicted, 0 for no limit
+        bool ADAPTIVE_SPLITS() const { return stringToBool(_store.at("tuplex.adaptiveSplits")); } //! whether to size input splits and output partitions of file input stages based on the throughput measured for the first wave of tasks
+        size_t HOT_KEY_ROWS() const { return std::stoi(_store.at("tuplex.hotKeyRows")); } //! estimated number of rows after which a join or aggregateByKey key found in the sample counts as heavy hitter, whose bucket tasks keep outside of the hash table. 0 to disable, also disables shrinking input splits of skewed join probes
+        size_t HOT_KEY_SKETCH_SIZE() const { return std::stoi(_store.at("tuplex.hotKeySketchSize")); } //! number of counters of the sketch finding heavy hitters in the sample
+        bool STREAM_FILE_OUTPUT() const { return stringToBool(_store.at("tuplex.streamFileOutput")); } //! whether tasks write their own part files directly instead of collecting all output in memory first. Rows resolved on the slow path go to part files after the streamed ones, i.e. are not in input order. Not used with a limit, numParts or splitSize.
         bool RESOLVE_WITH_INTERPRETER_ONLY() const { return stringToBool(_store.at("tuplex.resolveWithInterpreterOnly")); }
+        double LISTING_CACHE_TTL() const { return std::stod(_store.at("tuplex.listingCacheTTL")); } //! seconds directory listings are cached across glob queries, 0 to disable
 
 
         // AWS backend parameters
@@ -67,6 +78,7 @@ namespace tuplex {
         size_t AWS_LAMBDA_MEMORY() const { return std::stoi(_store.at("tuplex.aws.lambdaMemory")); } // 1536MB
         size_t AWS_LAMBDA_TIMEOUT() const { return std::stoi(_store.at("tuplex.aws.lambdaTimeout"));  } // 5min?
         bool AWS_REQUESTER_PAY() const { return stringToBool(_store.at("tuplex.aws.requesterPay")); }
+        size_t AWS_LISTING_PARALLELISM() const { return std::stoi(_store.at("tuplex.aws.listingParallelism")); } //! concurrent list requests when expanding S3 patterns
 
         // access parameters via their getter functions
         size_t RUNTIME_MEMORY() const;                        //! in bytes how much memory should be given to UDFs (soft limit)
@@ -74,10 +86,14 @@ namespace tuplex {
         size_t PARTITION_SIZE() const;                        //! Size of a partition in bytes, equals task size (i.e. how much
                                                         //! memory a thread is processing at a time)
         size_t EXECUTOR_MEMORY() const;                       //! how much memory to use for data computations
+        bool EXECUTOR_HUGE_PAGES() const { return stringToBool(_store.at("tuplex.executorHugePages")); } //! whether to back executor memory with huge pages
+        bool EXECUTOR_PREFAULT() const { return stringToBool(_store.at("tuplex.executorPrefault")); } //! whether to fault in executor memory in the background at start-up
+        bool EXECUTOR_PIN_THREADS() const { return stringToBool(_store.at("tuplex.executorPinThreads")); } //! whether to pin executor threads to CPUs and place their memory on the local NUMA node
 
         size_t DRIVER_MEMORY() const; //! how much memory to use for the driver? I.e. place where results + parallelized data is stored
 
         size_t READ_BUFFER_SIZE() const;
+        size_t INPUT_CACHE_SIZE() const; //! bytes of remote input blocks cached in the scratch dir, 0 to disable
 
         unsigned int EXECUTOR_COUNT() const;                //! how many threads to use for multithreaded execution
 
@@ -112,7 +128,11 @@ namespace tuplex {
 
         size_t WEBUI_EXCEPTION_DISPLAY_LIMIT() const;
 
+        bool METRICS_ENDPOINT() const { return stringToBool(_store.at("tuplex.metrics.enable")); } //! whether to serve Prometheus metrics via http://127.0.0.1:<tuplex.metrics.port>/metrics
+        uint16_t METRICS_PORT() const { return std::stoi(_store.at("tuplex.metrics.port")); }
+
         size_t INPUT_SPLIT_SIZE() const; //! maximum size of an input file, before it is split. 0 means no splitting
+        size_t PREFETCH_MEMORY() const; //! maximum bytes of input loaded ahead of tasks when interleaving IO, on top of the executor memory
 
         inline std::string AWS_SCRATCH_DIR() const {
             return get("tuplex.aws.scratchDir");
@@ -279,6 +279,30 @@ namespace tuplex {
                    os);
         }
 
+        /*!
+         * deferred version of take, i.e. adds the action without executing it. Run it (together with other
+         * deferred actions) via Context::runAll, which reads inputs shared among the actions only once.
+         * @param numElements how many rows to take, negative numbers for all rows
+         * @return dataset representing the action
+         */
+        virtual DataSet& deferTake(int64_t numElements=-1);
+
+        /*!
+         * deferred version of tofile, i.e. adds the action without executing it. Cf. deferTake
+         */
+        virtual DataSet& deferTofile(FileFormat fmt,
+                                     const URI &uri,
+                                     const UDF &udf,
+                                     size_t fileCount,
+                                     size_t shardSize,
+                                     const std::unordered_map<std::string, std::string> &outputOptions,
+                                     size_t limit = std::numeric_limits<size_t>::max());
+
+        DataSet& deferTocsv(const URI &uri,
+                            const std::unordered_map<std::string, std::string> &outputOptions = defaultCSVOutputOptions()) {
+            return deferTofile(FileFormat::OUTFMT_CSV, uri, UDF(""), 0, 0, outputOptions, std::numeric_limits<size_t>::max());
+        }
+
         // some handy functions to complete the API:
         // --> input/output types
         // --> exceptions: I.e. somehow it should be possible to retrieve the exception rows + types?
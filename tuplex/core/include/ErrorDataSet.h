@@ -61,6 +61,16 @@ namespace tuplex {
                             size_t limit,
                             std::ostream& os) override;
 
+        // nothing to execute, runAll falls back to collect
+        DataSet& deferTake(int64_t numElements) override { return *this; }
+        DataSet& deferTofile(FileFormat fmt,
+                             const URI& uri,
+                             const UDF& udf,
+                             size_t fileCount,
+                             size_t shardSize,
+                             const std::unordered_map<std::string, std::string>& outputOptions,
+                             size_t limit) override { return *this; }
+
         DataSet& join(const DataSet& other, option<std::string> leftColumn, option<std::string> rightColumn,
                       option<std::string> leftPrefix, option<std::string> leftSuffix,
                       option<std::string> rightPrefix, option<std::string> rightSuffix) override  {
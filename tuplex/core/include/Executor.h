@@ -18,11 +18,13 @@
 #include <VirtualFileSystem.h>
 #include <Timer.h>
 #include <list>
+#include <unordered_map>
 #include <boost/thread/shared_mutex.hpp>
 #include <mt/ThreadPool.h>
 #include <BitmapAllocator.h>
 #include <Schema.h>
 #include "HistoryServerConnector.h"
+#include "RuntimeMetrics.h"
 #include "physical/IExecutorTask.h"
 
 namespace tuplex {
@@ -49,6 +51,8 @@ namespace tuplex {
         std::vector<IExecutorTask*> _completedTasks;
         std::atomic_int _numPendingTasks;
         std::atomic_int _numCompletedTasks;
+        std::atomic<int64_t> _jobID; //! job the tasks belong to, -1 if not tracked
+        std::atomic<double> _jobWeight; //! share of the executors the job gets relative to other jobs
     public:
 
         WorkQueue();
@@ -63,6 +67,7 @@ namespace tuplex {
         void addTask(IExecutorTask* task) {
             if(!task)
                 return;
+            RuntimeMetrics::instance().taskQueued();
             _queue.enqueue(task);
             _numPendingTasks.fetch_add(1, std::memory_order_release);
         }
@@ -73,10 +78,19 @@ namespace tuplex {
 
         size_t numCompletedTasks() const { return _numCompletedTasks; }
 
+        //! approximate number of tasks no executor has started yet
+        size_t numQueuedTasks() const { return _queue.size_approx(); }
+
         /*!
-         * stop working on this queue & dump all tasks
+         * associates tasks added to this queue with a job. Partitions allocated while working on them are
+         * accounted to the job.
+         * @param jobID job id, -1 to reset
+         * @param weight share of the executors relative to other jobs
          */
-        void cancel();
+        void setJob(int64_t jobID, double weight=1.0) { _jobID = jobID; _jobWeight = weight; }
+
+        int64_t jobID() const { return _jobID; }
+        double jobWeight() const { return _jobWeight; }
 
         /*!
          * blocking work on one task. To be called from any worker thread
@@ -145,9 +159,6 @@ namespace tuplex {
 
         size_t maxMemory() { return _allocator.size(); }
 
-        // currently used memory
-        size_t usedMemory();
-
         // make this maybe abstract.. --> i.e. throw out partitions based on some strategy...
         BitmapAllocator _allocator;
 
@@ -170,7 +181,18 @@ namespace tuplex {
         URI getPartitionURI(Partition* partition) const;
 
         // no locks used within
-        void evictLRUPartition();
+        // evicts the least recently used unlocked partition (of job jobID if not -1), false if there is none
+        bool evictLRUPartition(int64_t jobID=-1);
+
+        // no locks used within, bytes held in memory by partitions of job jobID
+        size_t jobMemory(int64_t jobID) const;
+
+        // no locks used within, updates the bytes held in memory by the job of partition when it enters/leaves _partitions
+        void trackJobMemory(const Partition* partition, bool inMemory);
+        std::unordered_map<int64_t, size_t> _jobMemory; //! job id -> bytes of its partitions in _partitions
+
+        size_t _jobMemoryQuota; //! max bytes of partitions a single job may hold in memory, 0 for no limit
+        std::atomic_size_t _numQuotaEvictions; //! partitions evicted because their job exceeded its quota
 
         // perform this in separate thread
         // TaskQueue
@@ -188,6 +210,9 @@ namespace tuplex {
          */
         void worker();
 
+        // pins the calling thread to a CPU based on the thread number and binds the arena to the CPU's NUMA node
+        void pinToCPU();
+
         // another memory pool for python runtime memory as needed by the compiled UDFs
         size_t _runTimeMemory;
         size_t _runTimeMemoryDefaultBlockSize;
@@ -202,7 +227,8 @@ namespace tuplex {
                 const size_t runTimeMemory,
                 const size_t runTimeMemoryDefaultBlockSize,
                 URI cache_path,
-                const std::string& name = "");
+                const std::string& name = "",
+                const ArenaPolicy& arenaPolicy = ArenaPolicy());
 
         Executor(const Executor& other) = delete;
         Executor& operator = (const Executor& other) = delete;
@@ -236,6 +262,23 @@ namespace tuplex {
 
         void setThreadNumber(size_t threadNumber) { _threadNumber = threadNumber; }
 
+        /*!
+         * limits the memory each job may hold in partitions of this executor. If exceeded, partitions of the
+         * allocating job get evicted instead of the ones of other jobs.
+         * @param quota bytes, 0 for no limit
+         */
+        void setJobMemoryQuota(size_t quota) { _jobMemoryQuota = quota; }
+
+        //! number of partitions evicted so far because their job exceeded its memory quota
+        size_t numQuotaEvictions() const { return _numQuotaEvictions; }
+
+        /*!
+         * job on whose behalf the calling thread allocates partitions, set while working on tasks of a job's queue
+         */
+        static int64_t currentJob();
+
+        static void setCurrentJob(int64_t jobID);
+
         /*!
          * load partition from disk
          * @param partition
@@ -285,6 +328,10 @@ namespace tuplex {
         void release();
 
         size_t memorySize() const { return _allocator.size(); }
+        //! bytes held by partitions of this executor, safe to call from other threads
+        size_t usedMemory();
+        //! partitions held by this executor, in memory or evicted to disk. Safe to call from other threads
+        size_t numPartitions();
         size_t blockSize() const { return _allocator.blockSize(); }
         size_t runTimeMemorySize() const { return _runTimeMemory; }
         size_t runTimeMemoryDefaultBlockSize() const { return _runTimeMemoryDefaultBlockSize; }
@@ -38,6 +38,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <mutex>
 
 #include <Utils.h>
 #include <CodegenHelper.h>
@@ -303,6 +304,7 @@ namespace tuplex {
 
             // with addressof a C++ function can be hacked into this.
             // however may lead to hard to debug bugs!
+            std::lock_guard<std::mutex> lock(_mutex);
             _customSymbols[Name] = JITEvaluatedSymbol(addr, JITSymbolFlags::Exported);
         }
 
@@ -317,6 +319,9 @@ namespace tuplex {
         // custom symbols
         std::unordered_map<std::string, llvm::JITEvaluatedSymbol> _customSymbols;
 
+        // protects dylibs & custom symbols, so stages can be compiled from multiple threads
+        std::mutex _mutex;
+
     };
 #endif
 }
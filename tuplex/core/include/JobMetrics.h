@@ -27,7 +27,10 @@ namespace tuplex {
         double _llvm_optimization_time_s = 0.0;
         double _llvm_compilation_time_s = 0.0;
         double _total_compilation_time_s = 0.0;
+        double _hidden_compilation_time_s = 0.0;
         double _sampling_time_s = 0.0;
+        size_t _file_scan_count = 0; //! stages reading input files, counted over all jobs of the context
+        size_t _ahead_of_time_stage_count = 0; //! stages compiled on a background thread
 
         // numbers per stage, can get combined in case.
         struct StageMetrics {
@@ -38,6 +41,11 @@ namespace tuplex {
             double slow_path_time_s = 0.0;
             double fast_path_per_row_time_ns = 0.0;
             double slow_path_per_row_time_ns = 0.0;
+            double start_time_s = 0.0; //! steady clock, i.e. only comparable among stages
+            double end_time_s = 0.0;
+            size_t slow_path_compiled_row_count = 0; //! rows resolved by the compiled general-case path
+            size_t slow_path_interpreter_row_count = 0; //! rows resolved by the interpreter
+            size_t tasks_stopped_early = 0; //! tasks which left their input early (output limit reached or SIGINT)
             // size_t fast_path_input_row_count;
             // size_t fast_path_output_row_count;
             // size_t slow_path_input_row_count;
@@ -70,6 +78,10 @@ namespace tuplex {
             totalExceptionCount = 0;
         }
 
+        inline const std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t>& getExceptionCounts() const {
+            return _exception_counts;
+        }
+
         inline std::unordered_map<std::string, size_t> getOperatorExceptionCounts(int64_t operatorID) const {
             std::unordered_map<std::string, size_t> counts;
             for(const auto& keyval : _exception_counts) {
@@ -110,33 +122,47 @@ namespace tuplex {
             _total_compilation_time_s = time;
         }
         /*!
+        * setter for compilation time hidden behind execution, i.e. stages compiled ahead of time
+        * @param time a double representing hidden compilation time in s
+        */
+        void setHiddenCompilationTime(double time) {
+            _hidden_compilation_time_s = time;
+        }
+        /*!
         * getter for logical optimization time
         * @returns a double representing logical optimization time in s
         */    
-        double getLogicalOptimizationTime() {
+        double getLogicalOptimizationTime() const {
             return _logical_optimization_time_s;
         }
         /*!
         * getter for llvm optimization time
         * @returns a double representing llvm optimization time in s
         */ 
-        double getLLVMOptimizationTime() {
+        double getLLVMOptimizationTime() const {
             return _llvm_optimization_time_s;
         }
         /*!
         * getter for compilation time via llvm
         * @returns a double representing compilation time via llvm in s
         */   
-        double getLLVMCompilationTime() {
+        double getLLVMCompilationTime() const {
             return _llvm_compilation_time_s;
         }
         /*!
         * getter for total compilation time
         * @returns a double representing total compilation time in s
         */   
-        double getTotalCompilationTime() {
+        double getTotalCompilationTime() const {
             return _total_compilation_time_s;
         }
+        /*!
+        * getter for compilation time hidden behind execution
+        * @returns a double representing compilation time in s that did not delay any stage
+        */
+        double getHiddenCompilationTime() const {
+            return _hidden_compilation_time_s;
+        }
 
         /*!
          * set slow path timing info
@@ -172,6 +198,77 @@ namespace tuplex {
             it->fast_path_per_row_time_ns = fast_path_per_row_time_ns;
         }
 
+        /*!
+         * set how many rows the slow path of a stage resolved in compiled code and in the interpreter
+         * @param stageNo
+         * @param compiled_row_count rows resolved by the compiled general-case path
+         * @param interpreter_row_count rows resolved by the interpreter
+         */
+        void setSlowPathRowCounts(int stageNo, size_t compiled_row_count, size_t interpreter_row_count) {
+            auto it = get_or_create_stage_metrics(stageNo);
+            it->slow_path_compiled_row_count = compiled_row_count;
+            it->slow_path_interpreter_row_count = interpreter_row_count;
+        }
+
+        /*!
+         * set how many tasks of a stage stopped before processing all of their input
+         * @param stageNo
+         * @param num_tasks tasks stopped because the output limit was reached or the job got interrupted
+         */
+        void setTasksStoppedEarly(int stageNo, size_t num_tasks) {
+            auto it = get_or_create_stage_metrics(stageNo);
+            it->tasks_stopped_early = num_tasks;
+        }
+
+        //! tasks which stopped before processing all of their input, over all stages
+        size_t getTasksStoppedEarly() const {
+            size_t count = 0;
+            for(const auto& m : _stage_metrics)
+                count += m.tasks_stopped_early;
+            return count;
+        }
+
+        //! rows resolved by the compiled general-case path, over all stages
+        size_t getSlowPathCompiledRowCount() const {
+            size_t count = 0;
+            for(const auto& m : _stage_metrics)
+                count += m.slow_path_compiled_row_count;
+            return count;
+        }
+
+        //! rows resolved by the interpreter, over all stages
+        size_t getSlowPathInterpreterRowCount() const {
+            size_t count = 0;
+            for(const auto& m : _stage_metrics)
+                count += m.slow_path_interpreter_row_count;
+            return count;
+        }
+
+        /*!
+         * set when a stage started and finished executing
+         * @param stageNo
+         * @param start_time_s steady clock time in s when the stage started
+         * @param end_time_s steady clock time in s when the stage was done
+         */
+        void setStageTimes(int stageNo, double start_time_s, double end_time_s) {
+            auto it = get_or_create_stage_metrics(stageNo);
+            it->start_time_s = start_time_s;
+            it->end_time_s = end_time_s;
+        }
+
+        /*!
+         * get when a stage started and finished executing
+         * @param stageNo
+         * @return steady clock times in s, (0, 0) if the stage did not execute
+         */
+        std::pair<double, double> getStageTimes(int stageNo) const {
+            auto it = std::find_if(_stage_metrics.begin(), _stage_metrics.end(),
+                                   [stageNo](const StageMetrics& m) { return m.stageNo == stageNo; });
+            if(it == _stage_metrics.end())
+                return std::make_pair(0.0, 0.0);
+            return std::make_pair(it->start_time_s, it->end_time_s);
+        }
+
         /*!
          * set sampling time in s for specific operator
          * @param time
@@ -180,6 +277,41 @@ namespace tuplex {
             _sampling_time_s = time;
         }
 
+        /*!
+         * get sampling time in s
+         */
+        double getSamplingTime() const {
+            return _sampling_time_s;
+        }
+
+        /*!
+         * count a stage which reads its input from files
+         */
+        void addFileScan() {
+            _file_scan_count++;
+        }
+
+        /*!
+         * get how many stages read their input from files, over all jobs run by the context
+         */
+        size_t getFileScanCount() const {
+            return _file_scan_count;
+        }
+
+        /*!
+         * count a stage whose code was compiled on a background thread, i.e. ahead of time
+         */
+        void addAheadOfTimeStage() {
+            _ahead_of_time_stage_count++;
+        }
+
+        /*!
+         * get how many stages were compiled on a background thread, over all jobs run by the context
+         */
+        size_t getAheadOfTimeStageCount() const {
+            return _ahead_of_time_stage_count;
+        }
+
         /*!
          * create json representation of all datapoints
          * @return string in json format
@@ -192,7 +324,10 @@ namespace tuplex {
             ss<<"\"llvm_optimization_time_s\":"<<_llvm_optimization_time_s<<",";
             ss<<"\"llvm_compilation_time_s\":"<<_llvm_compilation_time_s<<",";
             ss<<"\"total_compilation_time_s\":"<<_total_compilation_time_s<<",";
+            ss<<"\"hidden_compilation_time_s\":"<<_hidden_compilation_time_s<<",";
             ss<<"\"sampling_time_s\":"<<_sampling_time_s<<",";
+            ss<<"\"file_scan_count\":"<<_file_scan_count<<",";
+            ss<<"\"ahead_of_time_stage_count\":"<<_ahead_of_time_stage_count<<",";
 
             // per stage numbers
             ss<<"\"stages\":[";
@@ -204,7 +339,12 @@ namespace tuplex {
                 ss<<"\"fast_path_per_row_time_ns\":"<<s.fast_path_per_row_time_ns<<",";
                 ss<<"\"slow_path_wall_time_s\":"<<s.slow_path_wall_time_s<<",";
                 ss<<"\"slow_path_time_s\":"<<s.slow_path_time_s<<",";
-                ss<<"\"slow_path_per_row_time_ns\":"<<s.slow_path_per_row_time_ns;
+                ss<<"\"slow_path_per_row_time_ns\":"<<s.slow_path_per_row_time_ns<<",";
+                ss<<"\"slow_path_compiled_row_count\":"<<s.slow_path_compiled_row_count<<",";
+                ss<<"\"slow_path_interpreter_row_count\":"<<s.slow_path_interpreter_row_count<<",";
+                ss<<"\"tasks_stopped_early\":"<<s.tasks_stopped_early<<",";
+                ss<<"\"start_time_s\":"<<s.start_time_s<<",";
+                ss<<"\"end_time_s\":"<<s.end_time_s;
                 ss<<"}";
                 if(s.stageNo != _stage_metrics.back().stageNo)
                     ss<<",";
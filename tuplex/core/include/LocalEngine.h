@@ -61,6 +61,7 @@ namespace tuplex {
          * @param size size in bytes that each executor should have
          * @param blockSize size of individual blocks used (can be used for coarse or fine grained parallelism)
          * @param cache_path directory where subfolders will be created for all executors to be started
+         * @param arenaPolicy how newly started executors obtain their memory (reused executors keep theirs)
          * @return array of executor references
          */
         std::vector<Executor*> getExecutors(const size_t num,
@@ -68,7 +69,8 @@ namespace tuplex {
                                             const size_t blockSize,
                                             const size_t runTimeMemory,
                                             const size_t runTimeMemoryDefaultBlockSize,
-                const URI& cache_path);
+                const URI& cache_path,
+                const ArenaPolicy& arenaPolicy=ArenaPolicy());
 
         /*!
          * releases executors (invoked by context)
@@ -0,0 +1,52 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_METRICSSERVER_H
+#define TUPLEX_METRICSSERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace tuplex {
+
+    /*!
+     * minimal HTTP server on localhost answering GET /metrics with RuntimeMetrics in Prometheus text format.
+     * Requests are handled one after another on a single background thread, enough for periodic scraping.
+     */
+    class MetricsServer {
+    public:
+        /*!
+         * binds to 127.0.0.1:port and starts serving. Throws std::runtime_error if the port can't be bound.
+         * @param port port to listen on, 0 to let the OS pick one (see port())
+         */
+        explicit MetricsServer(uint16_t port);
+
+        ~MetricsServer();
+
+        MetricsServer(const MetricsServer& other) = delete;
+        MetricsServer& operator = (const MetricsServer& other) = delete;
+
+        //! port the server listens on
+        uint16_t port() const { return _port; }
+
+    private:
+        int _fd;
+        uint16_t _port;
+        std::atomic_bool _done;
+        std::thread _thread;
+
+        void serve();
+        void handleConnection(int fd);
+    };
+}
+
+#endif //TUPLEX_METRICSSERVER_H
@@ -41,6 +41,7 @@ namespace tuplex {
         size_t _size;
 
         int64_t         _dataSetID; //! identifies dataset to which this partition belongs to
+        int64_t         _jobID; //! job which allocated this partition, -1 if not tracked
 
         uniqueid_t  _uuid;
         Executor* const   _owner; // who owns this partition?
@@ -92,6 +93,7 @@ namespace tuplex {
                                          _bytesWritten(0),
                                          _schema(schema),
                                          _dataSetID(dataSetID),
+                                         _jobID(-1),
                                          _swappedToFile(false) {
             // memory MUST point to a valid location
             assert(memory);
@@ -186,6 +188,8 @@ namespace tuplex {
 
         void makeImmortal() { _immortal = true; }
 
+        void makeMortal() { _immortal = false; }
+
         /*!
          * swaps out contents by saving them to a swap file
          * @param allocator allocator on which arena was allocated
@@ -241,6 +245,10 @@ namespace tuplex {
 
         void setDataSetID(const int64_t id) { _dataSetID = id; }
 
+        int64_t getJobID() const { return _jobID; }
+
+        void setJobID(const int64_t id) { _jobID = id; }
+
         Schema schema() const { return _schema; }
 
         void setSchema(const Schema& schema) {
@@ -0,0 +1,159 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_RUNTIMEMETRICS_H
+#define TUPLEX_RUNTIMEMETRICS_H
+
+#include <atomic>
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <ExceptionCodes.h>
+#include <physical/TaskTypes.h>
+
+namespace tuplex {
+
+    class JobMetrics;
+    class ConcurrentExceptionCounts;
+
+    /*!
+     * histogram with fixed bucket bounds, observations only touch atomics.
+     */
+    class MetricsHistogram {
+    public:
+        explicit MetricsHistogram(std::vector<double> bounds);
+
+        /*!
+         * add one observation
+         * @param value e.g. duration in s
+         */
+        void observe(double value);
+
+        /*!
+         * write histogram in Prometheus text format, i.e. cumulative buckets, sum and count
+         * @param os stream to write to
+         * @param name metric name
+         * @param labels optional labels without braces, e.g. type="resolve"
+         */
+        void write(std::ostream& os, const std::string& name, const std::string& labels="") const;
+    private:
+        std::vector<double> _bounds;
+        std::unique_ptr<std::atomic<uint64_t>[]> _counts; //! non-cumulative, last one is +Inf
+        std::atomic<uint64_t> _sumNanos; //! values are stored scaled by 1e9, sufficient for durations
+    };
+
+    /*!
+     * process wide counters/gauges/histograms of the execution engine. Executor threads update them without taking
+     * locks, the metrics endpoint reads a (not necessarily consistent) snapshot via toPrometheusText.
+     */
+    class RuntimeMetrics {
+    public:
+        static RuntimeMetrics& instance();
+
+        // called from the work queues, i.e. executor threads
+        void taskQueued() { _tasksQueued.fetch_add(1, std::memory_order_relaxed); }
+        void taskDequeued() { _tasksQueued.fetch_sub(1, std::memory_order_relaxed); }
+        void taskStarted() { _tasksRunning.fetch_add(1, std::memory_order_relaxed); }
+
+        /*!
+         * records a finished task
+         * @param type type of the task
+         * @param seconds how long executing the task took
+         */
+        void taskFinished(TaskType type, double seconds);
+
+        /*!
+         * records the time it took to compile a stage
+         * @param seconds
+         */
+        void stageCompiled(double seconds);
+
+        /*!
+         * records the metrics of a finished job, i.e. its exception counts and compile/optimization times
+         * @param metrics
+         */
+        void jobFinished(const JobMetrics& metrics);
+
+        /*!
+         * registers a gauge whose value is computed when metrics are read, e.g. memory usage of executors.
+         * Values of gauges with the same name get summed up, gauges with the same name and key only once (e.g. an
+         * executor shared by several contexts).
+         * @param owner used to remove the gauge again
+         * @param name metric name
+         * @param help description
+         * @param func returns the current value, must be callable from any thread
+         * @param key identifies what is measured, nullptr to always count the gauge
+         */
+        void addGauge(const void* owner, const std::string& name, const std::string& help, std::function<double()> func,
+                      const void* key=nullptr);
+
+        /*!
+         * removes all gauges registered by owner
+         */
+        void removeGauges(const void* owner);
+
+        /*!
+         * registers the exception counts of a running stage, they get read together with the other metrics. Stages
+         * running concurrently are summed up by exception class.
+         * @param owner used to remove the counts again
+         * @param counts must stay valid until removed
+         */
+        void addStageExceptionCounts(const void* owner, const ConcurrentExceptionCounts* counts);
+
+        /*!
+         * removes the exception counts registered by owner
+         */
+        void removeStageExceptionCounts(const void* owner);
+
+        /*!
+         * all metrics in Prometheus text exposition format (version 0.0.4)
+         */
+        std::string toPrometheusText() const;
+
+    private:
+        RuntimeMetrics();
+
+        static const size_t NUM_TASK_TYPES = 5;
+        static const size_t MAX_EXCEPTION_CODE = 256;
+
+        static size_t taskTypeIndex(TaskType type);
+
+        std::atomic<int64_t> _tasksQueued;
+        std::atomic<int64_t> _tasksRunning;
+        std::array<std::atomic<uint64_t>, NUM_TASK_TYPES> _tasksCompleted;
+        std::vector<std::unique_ptr<MetricsHistogram>> _taskLatency; //! one per task type
+        MetricsHistogram _compileTime;
+        std::atomic<uint64_t> _jobsCompleted;
+        std::array<std::atomic<uint64_t>, MAX_EXCEPTION_CODE> _exceptions; //! indexed by exception code
+
+        // times of the last finished job
+        std::atomic<double> _lastLogicalOptimizationTime;
+        std::atomic<double> _lastLLVMOptimizationTime;
+        std::atomic<double> _lastLLVMCompilationTime;
+        std::atomic<double> _lastTotalCompilationTime;
+        std::atomic<double> _lastSamplingTime;
+
+        struct Gauge {
+            const void* owner;
+            std::string name;
+            std::string help;
+            std::function<double()> func;
+            const void* key;
+        };
+        mutable std::mutex _gaugeMutex; //! only guards (un)registering and reading of gauges & stage counts, not the updates above
+        std::vector<Gauge> _gauges;
+        std::vector<std::pair<const void*, const ConcurrentExceptionCounts*>> _stageExceptionCounts;
+    };
+}
+
+#endif //TUPLEX_RUNTIMEMETRICS_H
@@ -46,6 +46,9 @@ namespace tuplex {
 
         static bool _compilationEnabled; // globally
         static bool _allowNumericTypeUnification; // globally
+        static bool _memoizationEnabled; // globally
+
+        bool hintInputSchemaWithoutMemo(const Schema& schema, bool removeBranches, bool printErrors);
 
         /*!
          * checks whether any active branch has a PyObject typing => this would imply
@@ -161,6 +164,21 @@ namespace tuplex {
          */
         void rewriteParametersInAST(const std::unordered_map<size_t, size_t>& rewriteMap);
 
+        /*!
+         * replaces outputs of a lambda which are not used later on with constants of the same type, so they are not
+         * computed anymore while the output type stays the same. Outputs whose expressions may raise are kept, hence
+         * the rewritten UDF produces the same exceptions as the interpreted fallback.
+         * @param used one flag per element of the returned tuple, a single flag if no tuple literal is returned
+         * @return true if the AST got rewritten
+         */
+        bool replaceUnusedOutputsWithConstants(const std::vector<bool>& used);
+
+        /*!
+         * conservative check whether calling the UDF may raise an exception, i.e. true unless the UDF is a lambda
+         * built from operations known not to fail.
+         */
+        bool mayRaise() const;
+
         inline bool allowNumericTypeUnification() const {
             return empty() ? false : getAnnotatedAST().allowNumericTypeUnification();
         }
@@ -230,6 +248,27 @@ namespace tuplex {
          */
         static void disableNumericTypeUnification() { _allowNumericTypeUnification = false; }
 
+        /*!
+         * memoize typing and code generation, i.e. UDFs with the same AST typed with the same input schema reuse
+         * the typed AST of the first one. Generated functions get reused within the same LLVM module.
+         */
+        static void enableMemoization() { _memoizationEnabled = true; }
+
+        /*!
+         * disable memoization, i.e. each UDF gets typed and compiled on its own
+         */
+        static void disableMemoization() { _memoizationEnabled = false; }
+
+        /*!
+         * drops all memoized typed ASTs
+         */
+        static void clearMemo();
+
+        /*!
+         * number of memoized typed ASTs
+         */
+        static size_t memoSize();
+
         // make sure it is ONE kind...
         // --> else rewrite is required...
         // general rewrite would reduce problem to tupleMode...
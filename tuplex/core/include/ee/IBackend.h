@@ -23,6 +23,7 @@ namespace tuplex {
 
     class IBackend;
     class PhysicalStage;
+    class Context;
     class Executor;
 
     class IBackend {
@@ -31,13 +32,32 @@ namespace tuplex {
         virtual Executor* driver() = 0;
         virtual void execute(PhysicalStage* stage) = 0;
 
+        /*!
+         * executes stages which do not depend on each other, e.g. the build and probe inputs of a join.
+         * Default is to execute them one after another, backends may run them concurrently.
+         * @param stages independent stages, each one executes its own predecessors first
+         * @param context Context on which to execute the stages
+         */
+        virtual void executeStages(const std::vector<PhysicalStage*>& stages, const Context& context);
+
+        /*!
+         * called before the stages of a plan get executed, e.g. to compile them ahead of time. Default does nothing.
+         * @param stages all stages of the plan, predecessors before the stages depending on them
+         */
+        virtual void prepareStages(const std::vector<PhysicalStage*>& stages) {}
+
+        /*!
+         * called after the stages passed to prepareStages were executed (or execution failed)
+         */
+        virtual void finishStages() {}
+
         virtual ~IBackend() {} // virtual destructor needed b.c. of smart pointers
     };
 
     inline std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> merge_ecounts(std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> lhs,
-            std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> rhs) {
+            const std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t>& rhs) {
         // go over lhs copy and merge rhs values in
-        for(auto keyval : rhs) {
+        for(const auto& keyval : rhs) {
             auto it = lhs.find(keyval.first);
             if(it == lhs.end())
                 lhs[keyval.first] = keyval.second;
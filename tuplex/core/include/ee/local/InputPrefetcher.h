@@ -0,0 +1,122 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_INPUTPREFETCHER_H
+#define TUPLEX_INPUTPREFETCHER_H
+
+#include <URI.h>
+#include <VirtualFileSystem.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tuplex {
+
+    /*!
+     * loads input ranges ahead of the tasks processing them, i.e. interleaves IO with compute. Dedicated IO threads
+     * read the registered ranges in order into memory. Tasks acquire their range when they start: if it is (being)
+     * loaded they receive it as in-memory file, else (IO threads are behind) they read the file themselves.
+     * Memory of loaded but not yet released ranges is bounded, IO threads pause when the budget is exhausted.
+     */
+    class InputPrefetcher {
+    public:
+        InputPrefetcher() = delete;
+        InputPrefetcher(const InputPrefetcher& other) = delete;
+
+        /*!
+         * @param numThreads number of IO threads
+         * @param memoryBudget maximum number of bytes held in loaded ranges at a time
+         */
+        InputPrefetcher(size_t numThreads, size_t memoryBudget);
+
+        // stops IO threads, acquired files may outlive the prefetcher
+        ~InputPrefetcher();
+
+        /*!
+         * registers a range to load, must be called before start()
+         * @param uri input file
+         * @param fileSize size of the input file
+         * @param offset first byte to load
+         * @param length number of bytes to load (clamped to the file size)
+         * @return id of the range, used with acquire(...)
+         */
+        size_t add(const URI& uri, size_t fileSize, size_t offset, size_t length);
+
+        /*!
+         * starts IO threads
+         */
+        void start();
+
+        /*!
+         * returns the loaded range as file (waits if it is currently being loaded). The range's memory is released
+         * when the file is destroyed.
+         * @param id range id
+         * @return file or nullptr, if the range has not been loaded yet or loading failed.
+         */
+        std::unique_ptr<VirtualFile> acquire(size_t id);
+
+        size_t numHits() const { return _hits; }
+        size_t numMisses() const { return _misses; }
+        size_t bytesLoaded() const { return _bytesLoaded; }
+        double stallTime() const { return _stallTime / 1000000.0; } // s tasks waited for ranges being loaded
+    private:
+        enum class State {
+            PENDING,
+            LOADING,
+            LOADED,
+            FAILED,
+            ACQUIRED
+        };
+
+        struct Range {
+            URI uri;
+            size_t fileSize;
+            size_t offset;
+            size_t length; ///! bytes accounted against the budget
+            size_t bytesLoaded;
+            State state;
+            std::shared_ptr<uint8_t> data;
+        };
+
+        /*!
+         * synchronization and memory accounting, shared with the buffers of acquired files which release their bytes
+         * when destroyed, possibly after the prefetcher.
+         */
+        struct SharedState {
+            std::mutex mutex;
+            std::condition_variable cv;
+            size_t memoryUsed = 0;
+
+            void release(size_t numBytes);
+        };
+
+        size_t _numThreads;
+        size_t _memoryBudget;
+
+        std::shared_ptr<SharedState> _state;
+        std::vector<Range> _ranges; // guarded by _state->mutex once started
+        size_t _next; // next range to check for loading
+        bool _done;
+        std::vector<std::thread> _threads;
+
+        std::atomic<size_t> _hits;
+        std::atomic<size_t> _misses;
+        std::atomic<size_t> _bytesLoaded;
+        std::atomic<size_t> _stallTime; // in us
+
+        void worker();
+        bool load(Range& range);
+    };
+}
+
+#endif //TUPLEX_INPUTPREFETCHER_H
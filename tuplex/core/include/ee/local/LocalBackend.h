@@ -21,6 +21,13 @@
 #include <numeric>
 #include <physical/TransformTask.h>
 #include <physical/ResolveTask.h>
+#include "InputPrefetcher.h"
+#include <MetricsServer.h>
+#include <atomic>
+#include <mutex>
+#include <future>
+#include <thread>
+#include <unordered_map>
 
 namespace tuplex {
 
@@ -45,6 +52,51 @@ namespace tuplex {
         Executor* driver() override; // for local execution
 
         void execute(PhysicalStage* stage) override;
+
+        /*!
+         * with tuplex.concurrentStages, runs each of the independent stages on its own thread. Their tasks (load &
+         * transform, resolve, probe, write) share the executors, everything else (compilation, merging task results)
+         * is done one stage at a time.
+         */
+        void executeStages(const std::vector<PhysicalStage*>& stages, const Context& context) override;
+
+        /*!
+         * with tuplex.aotCompileThreads > 0, starts compiling the transform stages on background threads
+         * while the first stage executes. Compile jobs belong to the backend, hence with tuplex.scheduler.multiJob
+         * each stage is compiled right before it runs instead.
+         */
+        void prepareStages(const std::vector<PhysicalStage*>& stages) override;
+
+        void finishStages() override;
+
+        /*!
+         * with tuplex.scheduler.multiJob, sets the weight of jobs started from the calling thread. Executors are shared
+         * among running jobs in proportion to their weights.
+         * @param weight positive number, 1.0 per default
+         */
+        static void setJobWeight(double weight);
+
+        /*!
+         * weighted max-min fair share of the executors among jobs: each executor goes to the job with the fewest
+         * executors relative to its weight, jobs which got an executor for each of their queued tasks only take the
+         * ones nobody else needs.
+         * @param numExecutors executors to share
+         * @param weights positive weight per job
+         * @param numQueuedTasks queued tasks per job
+         * @param round rotates the job considered first, so ties are broken differently on each call
+         * @return number of executors per job
+         */
+        static std::vector<size_t> fairShares(size_t numExecutors, const std::vector<double>& weights,
+                                              const std::vector<size_t>& numQueuedTasks, size_t round=0);
+
+        //! partitions the executors evicted because a job exceeded tuplex.scheduler.jobMemoryQuota
+        size_t numQuotaEvictions() const;
+
+        //! drivers of job threads (cf. tuplex.scheduler.multiJob) which were not released yet
+        size_t numJobDrivers();
+
+        //! port the metrics endpoint listens on, 0 if it is not running (see tuplex.metrics.enable)
+        uint16_t metricsPort() const { return _metricsServer ? _metricsServer->port() : 0; }
     private:
         Executor *_driver; //! driver from local backend...
         std::vector<Executor*> _executors; //! drivers to be used
@@ -53,8 +105,82 @@ namespace tuplex {
         HistoryServerConnection _historyConn;
         std::shared_ptr<HistoryServerConnector> _historyServer;
 
+        std::unique_ptr<MetricsServer> _metricsServer; //! optional Prometheus endpoint, see tuplex.metrics.enable
+
+        /*!
+         * registers gauges for memory usage of the executors and serves RuntimeMetrics on 127.0.0.1:port
+         */
+        void startMetricsEndpoint(uint16_t port);
+
         ContextOptions _options;
 
+        // concurrent execution of independent stages
+        std::atomic_int _numConcurrentStageGroups; //! number of executeStages calls currently running stages concurrently
+        std::mutex _stageMutex; //! held by a concurrently executing stage except while its tasks run
+        std::mutex _queuesMutex; //! protects the queue lists below
+        std::vector<std::unique_ptr<WorkQueue>> _stageQueues; //! all queues ever used by concurrent stages
+        std::vector<WorkQueue*> _freeQueues; //! reused, b.c. an executor may still peek into a queue after being detached
+        std::vector<WorkQueue*> _activeQueues; //! queues of stages whose tasks currently run
+        size_t _rebalanceRound;
+        std::atomic<int64_t> _nextJobID; //! id of the next job started with tuplex.scheduler.multiJob
+        std::mutex _jobDriversMutex;
+        std::unordered_map<std::thread::id, std::unique_ptr<Executor>> _jobDrivers; //! drivers of job threads, cf. driver()
+        std::vector<std::unique_ptr<Executor>> _retiredJobDrivers; //! drivers of finished jobs still holding partitions
+        size_t _numJobDriversCreated;
+
+        /*!
+         * moves the driver of the calling thread's job to the retired ones and frees retired drivers which don't
+         * hold any partitions anymore. Result partitions of the job keep its driver alive until they are consumed.
+         */
+        void releaseJobDriver();
+
+        //! whether tasks of different stages or jobs may run at the same time, i.e. need to share the executors
+        bool sharedExecutors() const { return _numConcurrentStageGroups.load() > 0 || _options.MULTI_JOB(); }
+
+        /*!
+         * spreads the executors over all active queues which still hold tasks. Jobs get a share of the executors
+         * in proportion to their weight (not more than they have tasks for), within a job they are spread
+         * round-robin over its queues. Each call rotates the assignment, so stages get a fair share of the
+         * executors and drained queues do not keep executors idle.
+         */
+        void rebalanceExecutors();
+
+        /*!
+         * performs tasks on a queue of their own, while other stages work on theirs. Only the thread
+         * owning the driver works on tasks itself, others wait for the executors.
+         */
+        std::vector<IExecutorTask*> performTasksConcurrently(std::vector<IExecutorTask*>& tasks, std::function<void()> driverCallback);
+
+        // ahead of time compilation
+        struct CompileJob {
+            TransformStage* stage;
+            std::atomic_bool claimed; //! set by the thread compiling the stage
+            std::promise<std::shared_ptr<TransformStage::JITSymbols>> promise;
+            std::shared_future<std::shared_ptr<TransformStage::JITSymbols>> syms;
+            double compileTime; //! valid once syms is ready
+        };
+        std::vector<std::unique_ptr<CompileJob>> _compileJobs;
+        std::vector<std::thread> _compileThreads;
+        std::atomic_size_t _nextCompileJob;
+        std::atomic_bool _compileCancelled;
+
+        //! stops compiling stages ahead of time and drops the results
+        void cancelCompileJobs();
+
+        /*!
+         * compiles the stage of job unless another thread already does
+         * @return true if compiled by the calling thread
+         */
+        bool runCompileJob(CompileJob& job);
+
+        //! compiles the stage of an already claimed job and fulfills its promise
+        void compileJob(CompileJob& job);
+
+        /*!
+         * compiles the stage or, when compiled ahead of time, waits for its symbols
+         */
+        std::shared_ptr<TransformStage::JITSymbols> compileStage(TransformStage* tstage);
+
         /*!
          * init or retrieve driver + as many executors as demanded from the Local execution engine
          */
@@ -67,17 +193,46 @@ namespace tuplex {
 
 
         std::vector<IExecutorTask*> createLoadAndTransformToMemoryTasks(TransformStage* tstage, const ContextOptions& options,  codegen::read_block_f functor);
+
+        /*!
+         * creates a task reading the range [rangeStart, rangeStart + rangeSize) of uri, (0, 0) for the full file
+         */
+        TransformTask* createFileInputTask(TransformStage* tstage, const ContextOptions& options, codegen::read_block_f functor,
+                                           const URI& uri, size_t rangeStart, size_t rangeSize, bool exactSplits);
+
+        /*!
+         * runs the file input of a stage in two waves. The first wave uses the configured split size, one task per
+         * worker. From its throughput and output size, split size and output partition size for the rest of the input
+         * are chosen, so the remaining tasks balance across the workers without being dominated by per-task overhead.
+         * @param outputLimit optional tracker of the stage's output limit, tasks get indexed in input order
+         * @param aggState optional aggregate state of the stage, set on all tasks
+         * @return completed tasks of both waves
+         */
+        std::vector<IExecutorTask*> performAdaptiveFileTasks(TransformStage* tstage, codegen::read_block_f functor,
+                                                             const std::shared_ptr<TaskOutputLimit>& outputLimit=nullptr,
+                                                             const std::shared_ptr<AggregateState>& aggState=nullptr);
         void executeTransformStage(TransformStage* tstage);
 
+        /*!
+         * registers the input ranges of all file source tasks with a prefetcher & starts its IO threads
+         */
+        std::unique_ptr<InputPrefetcher> prefetchInput(TransformStage* tstage, std::vector<IExecutorTask*>& tasks);
+
+        /*!
+         * switches the (ordered) tasks of a CSV output stage to write part files directly, one per task.
+         * @return number of part files assigned, i.e. the first part number free for resolved rows
+         */
+        size_t streamOutputToFiles(TransformStage* tstage, std::vector<IExecutorTask*>& tasks);
+
 
         /*!
          * Create the final hashmap from all of the input [tasks] (e.g. either merge them (join) or combine them (aggregate)
          * @param tasks
          * @param hashtableKeyByteWidth The width of the keys in the hashtables (e.g. differentiate between i64 and str hashtable)
-         * @param combine whether this is an aggregate (e.g. if we should call the aggregate combiner, rather than simply merging the hashtables)
+         * @param combine aggregate state of the stage if this is an aggregate (i.e. buckets are combined using its combiner), nullptr to simply merge the hashtables
          * @return the final hashtable sink
          */
-        HashTableSink createFinalHashmap(std::vector<IExecutorTask*>& tasks, int hashtableKeyByteWidth, bool combine);
+        HashTableSink createFinalHashmap(std::vector<IExecutorTask*>& tasks, int hashtableKeyByteWidth, const AggregateState* combine);
 
         // hash join stage
         void executeHashJoinStage(HashJoinStage* hstage);
@@ -90,7 +245,7 @@ namespace tuplex {
 
 
         // write output (may be already in correct format!)
-        void writeOutput(TransformStage* tstage, std::vector<IExecutorTask*>& sortedTasks);
+        void writeOutput(TransformStage* tstage, std::vector<IExecutorTask*>& sortedTasks, size_t firstPartNo=0);
 
         std::vector<IExecutorTask*> performTasks(std::vector<IExecutorTask*>& tasks, std::function<void()> driverCallback=[](){});
 
@@ -142,18 +297,19 @@ namespace tuplex {
             return std::vector<Partition*>();
         }
 
-        inline std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> getExceptionCounts(IExecutorTask* task) {
+        inline const ExceptionCounts& getExceptionCounts(IExecutorTask* task) {
+            static const ExceptionCounts noCounts;
             if(!task)
-                return std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t>();
+                return noCounts;
 
             if(task->type() == TaskType::UDFTRAFOTASK)
-                return dynamic_cast<TransformTask*>(task)->exceptionCounts();
+                return dynamic_cast<TransformTask*>(task)->denseExceptionCounts();
 
             if(task->type() == TaskType::RESOLVE)
-                return dynamic_cast<ResolveTask*>(task)->exceptionCounts();
+                return dynamic_cast<ResolveTask*>(task)->denseExceptionCounts();
 
             throw std::runtime_error("unknown task type seen in " + std::string(__FILE_NAME__) + ":" + std::to_string(__LINE__));
-            return std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t>();
+            return noCounts;
         }
 
         inline std::vector<std::tuple<size_t, PyObject*>> getNonConformingRows(IExecutorTask* task) {
@@ -173,7 +329,7 @@ namespace tuplex {
         std::vector<IExecutorTask*> resolveViaSlowPath(std::vector<IExecutorTask*>& tasks,
                 bool merge_rows_in_order,
                 codegen::resolve_f functor,
-                TransformStage* tstage, bool combineHashmaps);
+                TransformStage* tstage, const std::shared_ptr<AggregateState>& aggState);
     };
 
     /*!
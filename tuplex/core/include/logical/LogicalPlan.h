@@ -32,6 +32,8 @@ namespace tuplex {
         void optimizeFilters();
         void emitPartialFilters();
         void reorderDataProcessingOperators();
+        void reorderByMeasuredCost();
+        void eliminateDeadColumns();
 
     public:
 
@@ -68,6 +68,12 @@ namespace tuplex {
 
             bool hasExceptionHandler() const { return !_exceptionHandlerName.empty(); }
 
+            /*!
+             * every cancellationCheckInterval calls, calls the cancellation callback (if set) and branches to
+             * bbCancelled if it returns non-zero. Builder will be set to the block where to continue processing.
+             */
+            void cancellationCheckpoint(llvm::IRBuilder<> &builder, llvm::Value *userData, llvm::BasicBlock *bbCancelled);
+
         private:
             std::shared_ptr<codegen::PipelineBuilder> _pipBuilder;
             std::string _desiredFuncName;
@@ -75,6 +81,7 @@ namespace tuplex {
 
             std::vector<std::tuple<int64_t, ExceptionCode>> _codesToIgnore;
             std::string _exceptionHandlerName;
+            std::string _cancellationCallbackName;
             std::unordered_map<std::string, llvm::Value *> _args;
 
             llvm::Value *_intermediate;
@@ -111,6 +118,12 @@ namespace tuplex {
 
             void setExceptionHandler(const std::string &name) { _exceptionHandlerName = name; }
 
+            /*!
+             * callback (cf. codegen::cancel_check_f) checked every couple rows, the task function returns early if
+             * it signals cancellation
+             */
+            void setCancellationCallback(const std::string &name) { _cancellationCallbackName = name; }
+
             // aggregation based writers
             /*!
              * this adds an initialized intermediate, e.g. for an aggregate and initializes by the values supplied in Row
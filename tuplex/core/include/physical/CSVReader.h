@@ -35,19 +35,25 @@ namespace tuplex {
                   const char delimiter,
                   const char quotechar = '"',
                   const std::vector<bool>& columnsToKeep=std::vector<bool>{}) : _userData(userData), _rowFunctor(rowFunctor), _makeParseErrorsInternal(makeParseErrorsInternal), _operatorID(csvOperatorID), _exceptionHandler(exceptionHandler), _numColumns(numColumns), _delimiter(delimiter),
-                                                _quotechar(quotechar), _rangeStart(0), _rangeEnd(0), _columnsToKeep(columnsToKeep), _numRowsRead(0) {}
+                                                _quotechar(quotechar), _rangeStart(0), _rangeEnd(0), _rangeRowAligned(false), _columnsToKeep(columnsToKeep), _numRowsRead(0) {}
 
         CSVReader(void *userData,
                   codegen::cells_row_f rowFunctor,
                   const size_t numColumns,
                   const char delimiter,
                   const char quotechar = '"') : _userData(userData), _rowFunctor(rowFunctor), _operatorID(-1), _makeParseErrorsInternal(false), _exceptionHandler(nullptr), _numColumns(numColumns), _delimiter(delimiter),
-                                                _quotechar(quotechar), _rangeStart(0), _rangeEnd(0), _numRowsRead(0) {}
+                                                _quotechar(quotechar), _rangeStart(0), _rangeEnd(0), _rangeRowAligned(false), _numRowsRead(0) {}
 
-        void setRange(size_t start, size_t end) {
+        /*!
+         * restrict reading to rows starting within [start, end)
+         * @param rowAligned if true, start is known to be the start of a row (e.g. via csvSplitOffsets) and no
+         *        row start needs to be inferred
+         */
+        void setRange(size_t start, size_t end, bool rowAligned=false) {
             assert(start <= end); // 0,0 is allowed
             _rangeStart = start;
             _rangeEnd = end;
+            _rangeRowAligned = rowAligned;
         }
 
         void setHeader(const std::vector<std::string> &header) { //@TODO: this is CSV specific! change it!
@@ -76,6 +82,7 @@ namespace tuplex {
         std::vector<bool> _columnsToKeep; /// used for projection pushdown, i.e. when serializing exceptions out
         size_t _rangeStart;
         size_t _rangeEnd;
+        bool _rangeRowAligned;
         size_t _numRowsRead;
     };
 
@@ -0,0 +1,35 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_CSVSPLITTER_H
+#define TUPLEX_CSVSPLITTER_H
+
+#include <URI.h>
+#include <vector>
+
+namespace tuplex {
+
+    /*!
+     * computes exact row boundaries to split a CSV file at, in two passes. First, chunks of splitSize bytes are scanned
+     * in parallel for their quote parity. Then, a prefix over the parities yields the quote state at each chunk start
+     * and with it the first row start within the chunk. Contrary to findLineStart, which guesses a row start from the
+     * expected column count, this also holds for quoted fields containing newlines.
+     * @param uri CSV file
+     * @param fileSize size of the file in bytes
+     * @param splitSize targeted bytes per split, the remainder is added to the last split
+     * @param quotechar quote character
+     * @param numThreads how many threads to use for the first pass
+     * @return ascending start offsets of the splits, the first one is 0. A split ends where the next one starts.
+     */
+    extern std::vector<size_t> csvSplitOffsets(const URI& uri, size_t fileSize, size_t splitSize,
+                                               char quotechar='"', size_t numThreads=1);
+}
+
+#endif //TUPLEX_CSVSPLITTER_H
@@ -65,6 +65,12 @@ namespace tuplex {
         // ==> practical for parsing CSV/JSON!
         typedef int64_t(*cells_row_f)(void*, int64_t, char **, int64_t*);
 
+        // cancellation checkpoint called by block functors every couple rows with userData,
+        // a non-zero return value makes the functor stop and return the number of bytes consumed so far
+        typedef int64_t(*cancel_check_f)(void*);
+        // rows between two cancellation checkpoints, needs to be a power of two
+        static const int64_t cancellationCheckInterval = 1024;
+
         // functions used when hashing a row in build phase.
         // 1. user data as usual,
         // 2. str key/int key
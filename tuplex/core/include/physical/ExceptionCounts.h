@@ -0,0 +1,126 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_EXCEPTIONCOUNTS_H
+#define TUPLEX_EXCEPTIONCOUNTS_H
+
+#include <Utils.h>
+#include <ExceptionCodes.h>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace tuplex {
+
+    /*!
+     * dense numbering of (operatorID, exception code) pairs. The operators of a stage are known once it is built and
+     * exception codes form a small enum, hence exception counts can be held in flat arrays instead of hashmaps.
+     */
+    class ExceptionCountIndex {
+    public:
+        ExceptionCountIndex() {}
+
+        /*!
+         * @param operatorIDs operators which may raise exceptions in the stage, i.e. input node + all operators
+         */
+        explicit ExceptionCountIndex(std::vector<int64_t> operatorIDs);
+
+        //! number of slots
+        size_t size() const { return _operatorIDs.size() * NUM_CODE_SLOTS; }
+
+        /*!
+         * slot of (operatorID, exception code)
+         * @return slot or -1 if the pair is not covered by the index
+         */
+        int64_t slot(int64_t opID, ExceptionCode ec) const;
+
+        //! inverse of slot
+        std::tuple<int64_t, ExceptionCode> key(size_t slot) const;
+
+    private:
+        // framework codes, python exception classes and re.error, cf. ExceptionCodes.h
+        static const size_t NUM_FRAMEWORK_SLOTS = EXCEPTION_CODE_FRAMEWORK_END;
+        static const size_t NUM_PYTHON_SLOTS = EXCEPTION_CODE_PYTHON_END - EXCEPTION_CODE_PYTHON_BEGIN;
+        static const size_t NUM_CODE_SLOTS = NUM_FRAMEWORK_SLOTS + NUM_PYTHON_SLOTS + 1;
+        std::vector<int64_t> _operatorIDs; //! sorted
+
+        static int64_t codeSlot(ExceptionCode ec);
+        static ExceptionCode slotCode(size_t codeSlot);
+    };
+
+    /*!
+     * exception counts of a single task. Not thread-safe, counters are allocated with the first exception.
+     * Pairs not covered by the index (e.g. no index given) are counted in a hashmap.
+     */
+    class ExceptionCounts {
+    public:
+        explicit ExceptionCounts(std::shared_ptr<const ExceptionCountIndex> index=nullptr) : _index(index) {}
+
+        void setIndex(std::shared_ptr<const ExceptionCountIndex> index) { assert(empty()); _index = index; }
+        std::shared_ptr<const ExceptionCountIndex> index() const { return _index; }
+
+        inline void inc(int64_t opID, ExceptionCode ec, size_t delta=1) {
+            auto slot = _index ? _index->slot(opID, ec) : -1;
+            if(slot < 0) {
+                _overflow[std::make_tuple(opID, ec)] += delta;
+                return;
+            }
+            if(_counts.empty())
+                _counts.resize(_index->size(), 0);
+            _counts[slot] += delta;
+        }
+
+        /*!
+         * adds counts of other. If both use the same index, this is a single pass over the counters.
+         */
+        void add(const ExceptionCounts& other);
+
+        bool empty() const;
+
+        //! (operatorID, exception code) -> count, only pairs with count > 0
+        std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> toMap() const;
+
+    private:
+        friend class ConcurrentExceptionCounts;
+        std::shared_ptr<const ExceptionCountIndex> _index;
+        std::vector<size_t> _counts; //! indexed by slot, empty until the first exception
+        std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> _overflow;
+    };
+
+    /*!
+     * exception counts of a stage, shared by all of its tasks. Tasks add their counts once they are done, without
+     * locking for pairs covered by the index. Can be read at any time, e.g. to report progress.
+     */
+    class ConcurrentExceptionCounts {
+    public:
+        explicit ConcurrentExceptionCounts(std::shared_ptr<const ExceptionCountIndex> index);
+
+        void add(const ExceptionCounts& counts);
+
+        //! sets all counts back to zero. Must not run concurrently to add.
+        void reset();
+
+        //! current counts, (operatorID, exception code) -> count
+        std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> snapshot() const;
+
+    private:
+        std::shared_ptr<const ExceptionCountIndex> _index;
+        size_t _size;
+        std::unique_ptr<std::atomic<size_t>[]> _counts;
+
+        mutable std::mutex _overflowMutex; //! pairs not covered by the index, rare
+        std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> _overflow;
+    };
+}
+
+#endif //TUPLEX_EXCEPTIONCOUNTS_H
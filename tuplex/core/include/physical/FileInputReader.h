@@ -13,6 +13,7 @@
 
 #include <URI.h>
 #include <VirtualFileSystem.h>
+#include <functional>
 
 namespace tuplex {
 
@@ -21,6 +22,27 @@ namespace tuplex {
         virtual ~FileInputReader() {}
         virtual void read(const URI& inputFilePath) = 0;
         virtual size_t inputRowCount() const = 0;
+
+        /*!
+         * use an already opened file (e.g. prefetched by an IO thread) for the next read instead of opening the input
+         */
+        void setInputFile(std::unique_ptr<VirtualFile> file) { _inputFile = std::move(file); }
+
+        /*!
+         * check called between blocks (or every couple rows) of the input, reading stops once it returns true
+         */
+        void setCancellationCheck(std::function<bool()> check) { _cancellationCheck = check; }
+    protected:
+        std::unique_ptr<VirtualFile> _inputFile;
+        std::function<bool()> _cancellationCheck;
+
+        bool cancelled() const { return _cancellationCheck && _cancellationCheck(); }
+
+        std::unique_ptr<VirtualFile> openInputFile(const URI& inputFilePath) {
+            if(_inputFile)
+                return std::move(_inputFile);
+            return VirtualFileSystem::open_file(inputFilePath, VirtualFileMode::VFS_READ);
+        }
     };
 }
 
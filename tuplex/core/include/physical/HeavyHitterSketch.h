@@ -0,0 +1,61 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_HEAVYHITTERSKETCH_H
+#define TUPLEX_HEAVYHITTERSKETCH_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tuplex {
+
+    /*!
+     * space-saving sketch (Metwally et al.) to find the most frequent keys of a stream using a fixed number of counters.
+     * Any key occurring more than total/capacity times is guaranteed to be tracked, estimates are upper bounds which
+     * overcount by at most the error stored with each counter.
+     */
+    class HeavyHitterSketch {
+    public:
+        struct Counter {
+            std::string key;
+            size_t count; //! estimated occurrences (upper bound)
+            size_t error; //! maximum overestimation of count
+        };
+
+        HeavyHitterSketch() = delete;
+        explicit HeavyHitterSketch(size_t capacity);
+
+        /*!
+         * records occurrences of key
+         * @return estimated number of occurrences of key so far (upper bound)
+         */
+        size_t add(const std::string& key, size_t count=1);
+
+        //! estimated number of occurrences of key, 0 if not tracked
+        size_t estimate(const std::string& key) const;
+
+        //! number of occurrences added in total
+        size_t total() const { return _total; }
+
+        /*!
+         * tracked keys whose estimated count is at least minCount, sorted by count descending
+         */
+        std::vector<Counter> heavyHitters(size_t minCount=1) const;
+
+    private:
+        size_t _capacity;
+        size_t _total;
+        std::vector<Counter> _counters;
+        std::unordered_map<std::string, size_t> _index; // key -> position in _counters
+    };
+}
+
+#endif //TUPLEX_HEAVYHITTERSKETCH_H
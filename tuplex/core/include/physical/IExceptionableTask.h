@@ -12,6 +12,7 @@
 #define TUPLEX_IEXCEPTIONABLETASK_H
 
 #include "IExecutorTask.h"
+#include "ExceptionCounts.h"
 #include <unordered_map>
 
 namespace tuplex {
@@ -67,7 +68,13 @@ namespace tuplex {
          * @return
          */
         std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t>
-        exceptionCounts() const { return _exceptionCounts; }
+        exceptionCounts() const { return _exceptionCounts.toMap(); }
+
+        //! exception counts as dense array, cheap to merge with counts of other tasks of the same stage
+        const ExceptionCounts& denseExceptionCounts() const { return _exceptionCounts; }
+
+        //! set dense numbering of (operatorID, exception code) pairs, must be called before exceptions are serialized
+        void setExceptionCountIndex(std::shared_ptr<const ExceptionCountIndex> index) { _exceptionCounts.setIndex(index); }
 
         Schema getExceptionSchema() const { return _exceptionRowSchema; }
 
@@ -92,7 +99,7 @@ namespace tuplex {
         std::vector<Partition *> _exceptions;
 
         // exception counts (required for sampling etc. later)
-        std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> _exceptionCounts;
+        ExceptionCounts _exceptionCounts;
 
         // helps for serializing stuff
         uint8_t *_lastPtr;
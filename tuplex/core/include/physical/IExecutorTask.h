@@ -40,6 +40,12 @@ namespace tuplex {
         size_t threadNumber() const { return _threadNumber; }
         void setThreadNumber(size_t threadNumber) { _threadNumber = threadNumber; }
 
+        /*!
+         * true if the job got cancelled (SIGINT). Long running tasks check this periodically and stop early, output
+         * produced so far stays valid.
+         */
+        bool isCancelled() const;
+
         virtual std::vector<Partition*> getOutputPartitions() const = 0;
 
         virtual size_t getNumOutputRows() const;
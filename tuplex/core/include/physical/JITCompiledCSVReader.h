@@ -30,7 +30,7 @@ namespace tuplex {
                           const size_t numColumns,
                           const char delimiter,
                           const char quotechar='"',
-                          size_t bufferSize=1024 * 128) : _userData(userData), _functor(functor), _numColumns(numColumns), _bufferSize(bufferSize), _delimiter(delimiter), _quotechar(quotechar), _rangeStart(0), _rangeEnd(0), _inputBuffer(nullptr), _num_normal_rows(0), _num_bad_rows(0)  {}
+                          size_t bufferSize=1024 * 128) : _userData(userData), _functor(functor), _numColumns(numColumns), _bufferSize(bufferSize), _delimiter(delimiter), _quotechar(quotechar), _rangeStart(0), _rangeEnd(0), _rangeRowAligned(false), _inputBuffer(nullptr), _num_normal_rows(0), _num_bad_rows(0)  {}
         ~JITCompiledCSVReader() override {
             if(_inputBuffer)
                 delete [] _inputBuffer;
@@ -39,10 +39,16 @@ namespace tuplex {
         void read(const URI& inputFilePath) override;
         size_t inputRowCount() const override { return _num_normal_rows + _num_bad_rows; }
 
-        void setRange(size_t start, size_t end) {
+        /*!
+         * restrict reading to rows starting within [start, end)
+         * @param rowAligned if true, start is known to be the start of a row (e.g. via csvSplitOffsets) and no
+         *        row start needs to be inferred
+         */
+        void setRange(size_t start, size_t end, bool rowAligned=false) {
             assert(start < end || (start == 0 && end == 0));
             _rangeStart = start;
             _rangeEnd = end;
+            _rangeRowAligned = rowAligned;
         }
 
         void setHeader(const std::vector<std::string>& header) { //@TODO: this is CSV specific! change it!
@@ -74,6 +80,7 @@ namespace tuplex {
         // optional: set input range
         size_t _rangeStart;
         size_t _rangeEnd;
+        bool _rangeRowAligned;
         std::vector<std::string> _header;
 
 
@@ -0,0 +1,92 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_JITTEXTSOURCETASKBUILDER_H
+#define TUPLEX_JITTEXTSOURCETASKBUILDER_H
+
+#include "BlockBasedTaskBuilder.h"
+
+namespace tuplex {
+    namespace codegen {
+        /*!
+         * class to build a task function using a memory block by splitting it into lines.
+         * Lines are passed zero-copy to the pipeline, i.e. the line terminator ('\n' or '\r\n') is overwritten
+         * in place with '\0'. Hence, the buffer passed to the generated function must be writable and zero padded.
+         */
+        class JITTextSourceTaskBuilder : public BlockBasedTaskBuilder {
+        private:
+            int64_t _operatorID; /// operatorID where to put null failures / value errors etc. out
+            python::Type _fileInputRowType; /// original file input type, i.e. (str) or (Option[str])
+            std::vector<bool> _columnsToSerialize; /// whether the single line column is serialized or not
+            std::vector<std::string> _nullValues; /// strings that should be interpreted as null values.
+
+            /*!
+             * generates code to process a single line (already zero terminated)
+             * @param builder
+             * @param userData a value for userData (i.e. the class ptr of the task typically) to be parsed to callback functions
+             * @param linePtr start of the line
+             * @param lineSize size of the line including the '\0' terminator
+             * @param normalRowCountVar where to store normal row counts
+             * @param badRowCountVar where to store bad row counts
+             * @param outputRowNumberVar output row number (for exception handling)
+             * @param processRowFunc (optional) pipeline function
+             */
+            void processRow(llvm::IRBuilder<> &builder,
+                            llvm::Value *userData,
+                            llvm::Value *linePtr,
+                            llvm::Value *lineSize,
+                            llvm::Value *normalRowCountVar,
+                            llvm::Value *badRowCountVar,
+                            llvm::Value *outputRowNumberVar,
+                            llvm::Function *processRowFunc = nullptr);
+
+            // building vars for LLVM
+            void createMainLoop(llvm::Function *read_block_func);
+
+            // creates external call to memchr (SIMD accelerated in libc)
+            llvm::Value* findNewline(llvm::IRBuilder<>& builder, llvm::Value* ptr, llvm::Value* endPtr);
+        public:
+            JITTextSourceTaskBuilder() = delete;
+
+            /*!
+             * construct a new task which splits text input (given block wise) into lines
+             * @param env CodeEnv where to generate code into
+             * @param rowType the row type of the text file, i.e. (str) or (Option[str])
+             * @param columnsToSerialize if empty vector, the line gets serialized. If not, length must be 1.
+             * @param name Name of the function to generate
+             * @param operatorID ID of the operator for exception handling.
+             * @param null_values array of strings that should be interpreted as null values
+             */
+            explicit JITTextSourceTaskBuilder(const std::shared_ptr<LLVMEnvironment> &env,
+                                              const python::Type &rowType,
+                                              const std::vector<bool> &columnsToSerialize,
+                                              const std::string &name,
+                                              int64_t operatorID,
+                                              const std::vector<std::string> &null_values) : BlockBasedTaskBuilder::BlockBasedTaskBuilder(env,
+                                                                                                                                          restrictRowType(
+                                                                                                                                                  columnsToSerialize,
+                                                                                                                                                  rowType),
+                                                                                                                                          name),
+                                                                                             _operatorID(operatorID),
+                                                                                             _fileInputRowType(rowType),
+                                                                                             _columnsToSerialize(columnsToSerialize),
+                                                                                             _nullValues(null_values) {
+                if(_columnsToSerialize.empty())
+                    _columnsToSerialize.emplace_back(true);
+                assert(_fileInputRowType.parameters().size() == 1);
+                assert(_columnsToSerialize.size() == 1);
+            }
+
+            virtual llvm::Function *build() override;
+        };
+    }
+}
+
+#endif //TUPLEX_JITTEXTSOURCETASKBUILDER_H
@@ -46,6 +46,13 @@ namespace tuplex {
         std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> _ecounts; //! exception counts for this stage.
     protected:
         IBackend* _backend;
+
+        /*!
+         * executes all predecessors of this stage. When there are several (e.g. for a join), the backend
+         * decides whether they run concurrently.
+         * @param context Context on which to execute the predecessors
+         */
+        void executePredecessors(const Context& context);
     public:
         PhysicalStage() = delete;
         PhysicalStage(PhysicalPlan *plan, IBackend* backend, int64_t number, std::vector<PhysicalStage*> predecessors=std::vector<PhysicalStage*>()) : _plan(plan), _backend(backend), _number(number), _predecessors(predecessors)   {
@@ -87,7 +87,11 @@ namespace tuplex {
                                                             _htableFormat(HashTableFormat::UNKNOWN),
                                                             _outputRowNumber(0),
                                                             _wallTime(0.0),
-                                                            _numInputRowsRead(0) {
+                                                            _numInputRowsRead(0),
+                                                            _numRowsResolvedCompiled(0),
+                                                            _numRowsResolvedInterpreter(0),
+                                                            _deferSlowPathExceptions(false),
+                                                            _hasPendingException(false) {
             // copy the IDs and sort them so binary search can be used.
             std::sort(_operatorIDsAffectedByResolvers.begin(), _operatorIDsAffectedByResolvers.end());
             _normalPtrBytesRemaining = 0;
@@ -125,6 +129,22 @@ namespace tuplex {
         inline void exceptionCallback(const int64_t ecCode, const int64_t opID, const int64_t row, const uint8_t *buf, const size_t bufSize) {
             serializeException(ecCode, opID, row, buf, bufSize);
         }
+
+        /*!
+         * exception handler of the compiled slow path. While the functor processes a row, the exception is held back
+         * and only saved once it is clear the row does not need to be reprocessed by the interpreter.
+         */
+        inline void slowPathExceptionCallback(const int64_t ecCode, const int64_t opID, const int64_t row, const uint8_t *buf, const size_t bufSize) {
+            if(!_deferSlowPathExceptions) {
+                exceptionCallback(ecCode, opID, row, buf, bufSize);
+                return;
+            }
+            _hasPendingException = true;
+            _pendingECCode = ecCode;
+            _pendingOpID = opID;
+            _pendingRowNumber = row;
+            _pendingException.assign(buf, buf + bufSize);
+        }
         void writeRowToHashTable(char *key, size_t key_size, bool bucketize, char *buf, size_t buf_size);
         void writeRowToHashTable(uint64_t key, bool key_null, bool bucketize, char *buf, size_t buf_size);
         void writeRowToHashTableAggregate(char *key, size_t key_size, bool bucketize, char *buf, size_t buf_size);
@@ -151,6 +171,9 @@ namespace tuplex {
         HashTableSink hashTableSink() const { return _htable; } // needs to be freed manually!
         bool hasHashTableSink() const { return _htableFormat != HashTableFormat::UNKNOWN; }
 
+        //! aggregate functors of the stage, required when resolved rows are aggregated by key
+        void setAggregateState(const std::shared_ptr<AggregateState>& state) { _aggState = state; }
+
         void execute() override;
 
         TaskType type() const override { return TaskType::RESOLVE; }
@@ -198,6 +221,11 @@ namespace tuplex {
         double wallTime() const override { return _wallTime; }
         size_t getNumInputRows() const override { return _numInputRowsRead; }
 
+        //! number of exception rows resolved by the compiled general-case path
+        size_t numRowsResolvedCompiled() const { return _numRowsResolvedCompiled; }
+        //! number of exception rows resolved by the interpreter
+        size_t numRowsResolvedInterpreter() const { return _numRowsResolvedInterpreter; }
+
     private:
         int64_t                 _stageID; /// to which stage does this task belong to.
         std::vector<Partition*> _partitions;
@@ -242,6 +270,7 @@ namespace tuplex {
         // -> hash to be a hybrid because sometimes incompatible python objects have to be hashed here.
         HashTableSink _htable;
         HashTableFormat _htableFormat;
+        std::shared_ptr<AggregateState> _aggState;
         python::Type _hash_element_type;
         python::Type _hash_bucket_type;
         AggregateType _hash_agg_type;
@@ -257,6 +286,16 @@ namespace tuplex {
 
         double _wallTime;
         size_t _numInputRowsRead;
+        size_t _numRowsResolvedCompiled;
+        size_t _numRowsResolvedInterpreter;
+
+        // exception of the compiled slow path for the current row, see slowPathExceptionCallback
+        bool _deferSlowPathExceptions;
+        bool _hasPendingException;
+        int64_t _pendingECCode;
+        int64_t _pendingOpID;
+        int64_t _pendingRowNumber;
+        std::vector<uint8_t> _pendingException;
 
         // the different row schemas to use
         inline Schema commonCaseOutputSchema() const {
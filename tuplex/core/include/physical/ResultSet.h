@@ -14,6 +14,7 @@
 #include <Row.h>
 #include <Partition.h>
 #include <deque>
+#include <algorithm>
 #include <limits>
 #include <ExceptionCodes.h>
 #include <Python.h>
@@ -67,6 +68,14 @@ namespace tuplex {
         Partition* getNextPartition();
         size_t rowCount() const;
 
+        /*!
+         * checks whether partition is held by this result set (either as normal rows or as exception)
+         */
+        bool contains(const Partition* partition) const {
+            return std::find(_partitions.begin(), _partitions.end(), partition) != _partitions.end()
+                   || std::find(_exceptions.begin(), _exceptions.end(), partition) != _exceptions.end();
+        }
+
         Schema schema() const { return _schema; }
 
         /*!
@@ -22,6 +22,21 @@ namespace tuplex {
 
     class LogicalOperator;
 
+    /*!
+     * cost & selectivity of an operator measured by running a sample through the interpreter
+     */
+    struct OperatorProfile {
+        size_t numInputRows; //! sample rows which reached the operator
+        size_t numOutputRows; //! rows passed on, i.e. not filtered out and no exception
+        size_t numExceptions;
+        double time; //! time in s spent in the operator's UDF
+
+        OperatorProfile() : numInputRows(0), numOutputRows(0), numExceptions(0), time(0.0) {}
+
+        double costPerRow() const { return numInputRows > 0 ? time / numInputRows : 0.0; }
+        double selectivity() const { return numInputRows > 0 ? numOutputRows / (double)numInputRows : 1.0; }
+    };
+
     /*!
      * helper class to process a sample of rows through a pipeline (yet only with a trafo stage)
      * using the python interpreter (embedded)
@@ -102,6 +117,14 @@ namespace tuplex {
 
         void sample(size_t numSamples=64); // also include option for general python3 list...
 
+        /*!
+         * runs rows through the map, filter, withColumn and mapColumn operators of this processor and measures for
+         * each of them time per row & selectivity. A row stops at the first operator filtering it out or throwing.
+         * @param rows input rows to the first operator
+         * @return profile per operatorID
+         */
+        std::unordered_map<int64_t, OperatorProfile> profile(const std::vector<Row>& rows);
+
 #warning "Todo, add here most likely path processor..."
     };
 }
@@ -12,6 +12,11 @@
 #define TUPLEX_SIMPLEFILEWRITETASK_H
 
 #include "IExecutorTask.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 namespace tuplex {
 
@@ -43,27 +48,68 @@ public:
 
         auto outFile = VirtualFileSystem::open_file(_uri, VirtualFileMode::VFS_WRITE);
         if(!outFile) {
+            for(auto p : _partitions)
+                p->invalidate();
             abort("could not open " + _uri.toPath() + " in write mode.");
             return;
         }
 
-        // write prefix
-        if(_header && _headerLength > 0) {
-            outFile->write(_header, _headerLength);
-        }
-
-        // write all bytes from partitions
-        size_t totalBytes = 0;
+        // preallocate, total size is known upfront
+        size_t totalBytes = _headerLength;
         size_t totalRows = 0;
         for(auto p : _partitions) {
-            auto numBytes = p->bytesWritten();
-            totalBytes += numBytes;
+            totalBytes += p->bytesWritten();
             totalRows += p->getNumRows();
-            auto dataptr = p->lock();
-            // write to file
-            outFile->write(dataptr, numBytes);
-            p->unlock();
-            p->invalidate(); // free partition
+        }
+        outFile->reserve(totalBytes);
+
+        // gather partitions into batches written by a single (vectored) call. Written batches are freed by one
+        // background thread, i.e. freeing overlaps with writing the next batch.
+        std::vector<std::pair<const void*, uint64_t>> buffers;
+        if(_header && _headerLength > 0)
+            buffers.emplace_back(_header, _headerLength);
+
+        ReleaseQueue released;
+        std::thread releaseThread([&released]() { released.run(); });
+
+        bool ok = true;
+        size_t pos = 0;
+        while(ok && pos < _partitions.size()) {
+            std::vector<Partition*> batch;
+            size_t batchBytes = 0;
+            // locking an evicted partition recovers it, which evicts unlocked partitions of its executor. Partitions
+            // of a batch stay locked, hence they may take up only part of their executor's memory.
+            std::unordered_map<const Executor*, size_t> lockedBytes;
+            auto fitsBatch = [&](const Partition* p) {
+                return batchBytes + p->bytesWritten() <= _maxBatchSize &&
+                       lockedBytes[p->owner()] + p->size() <= p->owner()->memorySize() / 2;
+            };
+            while(pos < _partitions.size() && (batch.empty() || fitsBatch(_partitions[pos]))) {
+                auto p = _partitions[pos++];
+                buffers.emplace_back(p->lock(), p->bytesWritten());
+                batchBytes += p->bytesWritten();
+                lockedBytes[p->owner()] += p->size();
+                batch.push_back(p);
+            }
+
+            ok = outFile->writev(buffers) == VirtualFileSystemStatus::VFS_OK;
+            buffers.clear();
+
+            // partition mutexes need to be released by the locking thread
+            for(auto p : batch)
+                p->unlock();
+            released.push(std::move(batch));
+        }
+
+        // after a failed write, the partitions which were not written yet are freed as well
+        if(pos < _partitions.size())
+            released.push(std::vector<Partition*>(_partitions.begin() + pos, _partitions.end()));
+        released.close();
+        releaseThread.join();
+
+        if(!ok) {
+            abort("failed to write to " + _uri.toPath());
+            return;
         }
 
         outFile->close();
@@ -85,6 +131,54 @@ private:
     uint8_t *_header;
     size_t _headerLength;
 
+    // upper bound of bytes written per call, i.e. how many partitions are locked at a time (also bounded by
+    // half of the memory of the executors owning them)
+    static const size_t _maxBatchSize = 64 * 1024 * 1024;
+
+    /*!
+     * written batches waiting to be freed. Bounded, i.e. writing blocks when freeing falls behind.
+     */
+    class ReleaseQueue {
+    public:
+        void push(std::vector<Partition*> batch) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this]() { return _batches.size() < _maxQueuedBatches; });
+            _batches.push_back(std::move(batch));
+            _cv.notify_all();
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closed = true;
+            _cv.notify_all();
+        }
+
+        //! frees batches until the queue is closed and empty
+        void run() {
+            while(true) {
+                std::vector<Partition*> batch;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(lock, [this]() { return !_batches.empty() || _closed; });
+                    if(_batches.empty())
+                        return;
+                    batch = std::move(_batches.front());
+                    _batches.pop_front();
+                    _cv.notify_all();
+                }
+                for(auto p : batch)
+                    p->invalidate(); // free partition
+            }
+        }
+
+    private:
+        static const size_t _maxQueuedBatches = 2;
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::deque<std::vector<Partition*>> _batches;
+        bool _closed = false;
+    };
+
     void abort(const std::string& message) {}
 };
 
@@ -75,6 +75,7 @@ namespace tuplex {
             std::string _funcFileWriteCallbackName;
             std::string _funcMemoryWriteCallbackName;
             std::string _funcExceptionCallback;
+            std::string _funcCancellationCallbackName;
 
             int64_t _stageNumber;
             int64_t _outputDataSetID;
@@ -17,16 +17,29 @@
 #include <cassert>
 
 namespace tuplex {
+
+    /*!
+     * block based text reader. Fills a (zero padded) buffer and hands it to a code-generated block functor
+     * (cf. JITTextSourceTaskBuilder), which splits the buffer into lines and passes them zero-copy to the pipeline.
+     * A split [rangeStart, rangeEnd) processes all lines which start within the range.
+     */
     class TextReader : public FileInputReader {
     public:
         TextReader() = delete;
-        void read(const URI& inputFilePath) override;
+        TextReader(void *userData,
+                   codegen::read_block_f functor,
+                   size_t bufferSize=1024 * 1024) : _userData(userData), _functor(functor), _bufferSize(bufferSize),
+                                                    _inputBuffer(nullptr), _inBufferLength(0), _rangeStart(0),
+                                                    _rangeEnd(0), _num_normal_rows(0), _num_bad_rows(0) {}
+        ~TextReader() override {
+            if(_inputBuffer)
+                delete [] _inputBuffer;
+            _inputBuffer = nullptr;
+        }
 
-        size_t inputRowCount() const override { return _numRowsRead; }
+        void read(const URI& inputFilePath) override;
 
-        TextReader(void *userData,
-                   codegen::cells_row_f rowFunctor) : _userData(userData), _rowFunctor(rowFunctor), _rangeStart(0),
-                                                      _rangeEnd(0), _numRowsRead(0) {}
+        size_t inputRowCount() const override { return _num_normal_rows + _num_bad_rows; }
 
         void setRange(size_t start, size_t end) {
             assert(start <= end); // 0,0 is allowed
@@ -34,17 +47,33 @@ namespace tuplex {
             _rangeEnd = end;
         }
 
-        void setFunctor(codegen::cells_row_f functor) {
-            _rowFunctor = functor;
+        void setFunctor(codegen::read_block_f functor) {
+            _functor = functor;
         }
 
     private:
         void*   _userData;
-        codegen::cells_row_f _rowFunctor;
+        codegen::read_block_f _functor;
+
+        size_t _bufferSize;
+        uint8_t* _inputBuffer;
+        size_t _inBufferLength;
+
         size_t _rangeStart;
         size_t _rangeEnd;
-        size_t _numRowsRead;
+
+        int64_t _num_normal_rows, _num_bad_rows;
+
+        inline bool useRange() const { return _rangeStart < _rangeEnd; }
+
+        /*!
+         * fill buffer from file, grows buffer if it is already full (i.e. a line is longer than the buffer)
+         * @return bytes read
+         */
+        size_t fillBuffer(VirtualFile* fp);
+
+        void moveInputBuffer(size_t bytesConsumed);
     };
 }
 
-#endif //TUPLEX_TEXTREADER_H
\ No newline at end of file
+#endif //TUPLEX_TEXTREADER_H
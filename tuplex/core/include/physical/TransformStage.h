@@ -15,6 +15,7 @@
 #include <Partition.h>
 #include "PhysicalStage.h"
 #include "LLVMOptimizer.h"
+#include "ExceptionCounts.h"
 #include <logical/ParallelizeOperator.h>
 #include <logical/MapOperator.h>
 #include <logical/MapColumnOperator.h>
@@ -194,6 +195,7 @@ namespace tuplex {
         std::string writeFileCallbackName() const { return _funcFileWriteCallbackName; }
         std::string writeHashCallbackName() const { return _funcHashWriteCallbackName; }
         std::string exceptionCallbackName() const { return _funcExceptionCallback; }
+        std::string cancellationCallbackName() const { return _funcCancellationCallbackName; }
         std::string aggCombineCallbackName() const { return _aggregateCallbackName; }
 
         // std::string resolveCode() const { return _irResolveCode; }
@@ -374,6 +376,29 @@ namespace tuplex {
          */
         void setDataAggregationMode(const AggregateType& t) { _aggMode = t; }
 
+        /*!
+         * heavy hitters of the hash table this stage builds, found in the sample by the planner. Tasks keep their
+         * buckets outside of the hash table (key format as in TransformTask::setHotKeys)
+         */
+        const std::vector<std::string>& hotKeys() const { return _hotKeys; }
+        void setHotKeys(const std::vector<std::string>& keys) { _hotKeys = keys; }
+
+        /*!
+         * estimated number of output rows per input row when probing a join's hash table, 1.0 if unknown.
+         * Used to shrink input splits of probe stages whose keys hit large buckets.
+         */
+        double probeFanout() const { return _probeFanout; }
+        void setProbeFanout(double fanout) { _probeFanout = fanout; }
+
+        //! dense numbering of the (operatorID, exception code) pairs this stage may produce, shared by its tasks
+        std::shared_ptr<const ExceptionCountIndex> exceptionCountIndex() const { return _exceptionCountIndex; }
+
+        /*!
+         * exception counts of the tasks executed so far, updated by each task when it finishes.
+         * Reset by the backend before the stage is executed.
+         */
+        ConcurrentExceptionCounts* liveExceptionCounts() const { return _liveExceptionCounts.get(); }
+
     private:
         /*!
          * creates a new TransformStage with generated code
@@ -392,6 +417,7 @@ namespace tuplex {
         std::string _funcMemoryWriteCallbackName; //! llvm function name of the write callback
         std::string _funcFileWriteCallbackName; //! llvm function name of the write callback used for file output.
         std::string _funcExceptionCallback; //! llvm function of the exception callback function
+        std::string _funcCancellationCallbackName; //! llvm function called at cancellation checkpoints
         std::string _funcHashWriteCallbackName; //! the function to call when saving to hash table
         std::string _initStageFuncName; //! init function for a stage (sets up globals & Co)
         std::string _releaseStageFuncName; //! release function for a stage (releases globals & Co)
@@ -424,6 +450,13 @@ namespace tuplex {
 
         std::vector<int64_t> _operatorIDsWithResolvers;
 
+        std::vector<std::string> _hotKeys;
+        double _probeFanout;
+
+        std::shared_ptr<const ExceptionCountIndex> _exceptionCountIndex;
+        std::unique_ptr<ConcurrentExceptionCounts> _liveExceptionCounts;
+        void setExceptionCountOperators(const std::vector<int64_t>& operatorIDs);
+
         std::vector<Partition*> _inputPartitions; //! memory input partitions for this task.
         size_t                  _inputLimit; //! limit number of input rows (inf per default)
         size_t                  _outputLimit; //! output limit, set e.g. by take, to_csv etc. (inf per default)
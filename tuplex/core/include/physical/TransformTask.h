@@ -15,6 +15,11 @@
 #include "CodeDefs.h"
 #include "FileInputReader.h"
 #include <hashmap.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace tuplex {
 
@@ -24,8 +29,9 @@ namespace tuplex {
         Partition *currentPartition;
         size_t bytesWritten;
         uint8_t* outputPtr;
+        size_t partitionSize; // minimum size of new partitions, 0 for the executor's default
 
-        MemorySink() : currentPartition(nullptr), bytesWritten(0), outputPtr(nullptr)   {}
+        MemorySink() : currentPartition(nullptr), bytesWritten(0), outputPtr(nullptr), partitionSize(0)   {}
 
         inline void unlock() {
             if(currentPartition) {
@@ -41,6 +47,7 @@ namespace tuplex {
             currentPartition = nullptr;
             bytesWritten = 0;
             outputPtr = nullptr;
+            partitionSize = 0;
         }
     };
 
@@ -52,7 +59,7 @@ namespace tuplex {
 
         assert(owner);
 
-        auto minRequiredSize =  (size_t)size + sizeof(int64_t); // Make sure allocate at least 8 bytes for the row counter
+        auto minRequiredSize =  std::max((size_t)size + sizeof(int64_t), sink.partitionSize); // Make sure allocate at least 8 bytes for the row counter
         assert(minRequiredSize > 0);
 
         // write to partition OR somewhere else...
@@ -105,6 +112,65 @@ namespace tuplex {
         HashTableSink() : hm(nullptr), null_bucket(nullptr), hybrid_hm(nullptr) {}
     };
 
+    /*!
+     * shared by the tasks of a stage with an output limit (e.g. take). Tasks report their output row count when done,
+     * once the tasks 0..i produced enough rows all tasks after i can stop, their rows would be clipped anyways.
+     */
+    class TaskOutputLimit {
+    public:
+        explicit TaskOutputLimit(size_t limit) : _limit(limit), _cutoff(std::numeric_limits<int64_t>::max()) {}
+
+        size_t limit() const { return _limit; }
+
+        void taskDone(size_t taskIndex, size_t numOutputRows);
+
+        //! true if output of the task with taskIndex is not needed anymore to satisfy the limit
+        bool exceeded(size_t taskIndex) const { return static_cast<int64_t>(taskIndex) > _cutoff.load(); }
+    private:
+        size_t _limit;
+        std::mutex _mutex;
+        std::vector<int64_t> _rowCounts; //! output rows per task index, -1 while task is not done yet
+        std::atomic<int64_t> _cutoff; //! index of last task whose output is required
+    };
+
+    /*!
+     * aggregate functors and partial aggregates of a single stage, shared by its tasks. Stages may run concurrently,
+     * hence each stage owns its state instead of using globals.
+     */
+    class AggregateState {
+    public:
+        AggregateState(codegen::agg_init_f init_func, codegen::agg_combine_f combine_func,
+                       codegen::agg_agg_f aggregate_func=nullptr) : _init(init_func), _combine(combine_func),
+                                                                    _aggregate(aggregate_func) {}
+        AggregateState(const AggregateState& other) = delete;
+        ~AggregateState();
+
+        //! true for aggregateByKey, i.e. values are aggregated into hash table buckets
+        bool byKey() const { return _aggregate != nullptr; }
+
+        /*!
+         * combine buf into the partial aggregate of a worker thread (general aggregate)
+         * @param threadNum thread number of the executor running the task
+         */
+        void combine(size_t threadNum, uint8_t* buf, int64_t buf_size);
+
+        /*!
+         * combine all partial aggregates into a malloced result and free them
+         * @return false if no partial aggregate exists
+         */
+        bool fetch(uint8_t** out, int64_t* out_size);
+
+        uint8_t* combineBuckets(uint8_t* bucketA, uint8_t* bucketB) const;
+        void aggregateValues(uint8_t** bucket, char *buf, size_t buf_size) const;
+    private:
+        codegen::agg_init_f _init;
+        codegen::agg_combine_f _combine;
+        codegen::agg_agg_f _aggregate;
+
+        std::mutex _mutex;
+        std::unordered_map<size_t, std::pair<uint8_t*, int64_t>> _partials; //! thread number -> partial aggregate
+    };
+
     // one Trafo task which can be configured somehow
     class TransformTask : public IExecutorTask {
     public:
@@ -112,7 +178,10 @@ namespace tuplex {
                           _functor(nullptr),
                           _stageID(-1),
                           _htableFormat(HashTableFormat::UNKNOWN),
-                          _wallTime(0.0) {
+                          _stageTaskIndex(0),
+                          _stoppedEarly(false),
+                          _wallTime(0.0),
+                          _liveExceptionCounts(nullptr) {
             resetSinks();
             resetSources();
         }
@@ -148,10 +217,30 @@ namespace tuplex {
                                 char delimiter,
                                 char quotechar,
                                 const std::vector<bool>& colsToKeep,
-                                FileFormat fmt);
+                                FileFormat fmt,
+                                bool rangeRowAligned=false);
+
+
+        /*!
+         * file source range as given to setInputFileSource, (0, 0) means the full file
+         */
+        std::tuple<size_t, size_t> inputFileRange() const { return std::make_tuple(_inputRangeStart, _inputRangeSize); }
+        URI inputFilePath() const { return _inputFilePath; }
+
+        /*!
+         * callback invoked when the task starts reading its file source. Returns the opened (prefetched) input or
+         * nullptr, in which case the reader opens the file itself.
+         */
+        void setInputPrefetch(std::function<std::unique_ptr<VirtualFile>()> prefetch) { _inputPrefetch = prefetch; }
 
         void sinkOutputToMemory(const Schema& outputSchema, int64_t outputDataSetID);
-        void sinkOutputToFile(const URI& uri, const std::unordered_map<std::string, std::string>& options);
+        //! size to allocate output partitions with (rounded up to blocks of the executor), call after sinkOutputToMemory
+        void setOutputPartitionSize(size_t size) { _output.partitionSize = size; }
+        /*!
+         * write output rows directly to uri instead of memory partitions. Exceptions are still sunk to memory and
+         * tagged with outputDataSetID, so they can get resolved after the task completed.
+         */
+        void sinkOutputToFile(const URI& uri, const std::unordered_map<std::string, std::string>& options, int64_t outputDataSetID=-1);
         void setOutputPrefix(const char* buf, size_t bufSize); // extra prefix to write first to output.
 
         void sinkOutputToHashTable(HashTableFormat fmt, int64_t outputDataSetID);
@@ -159,6 +248,41 @@ namespace tuplex {
 
         void setOutputLimit(size_t limit) { _outLimit = limit; }
         void setOutputSkip(size_t numRowsToSkip) { _outSkipRows = numRowsToSkip; }
+
+        //! aggregate functors and partial aggregates of the stage, required for aggregate pipelines
+        void setAggregateState(const std::shared_ptr<AggregateState>& state) { _aggState = state; }
+        AggregateState* aggregateState() const { return _aggState.get(); }
+
+        /*!
+         * keys expected to hold many rows (string keys incl. '\0', int keys as 8 bytes). Their buckets are kept outside
+         * of the hash table and put into it once the task is done, i.e. their rows skip the hash lookup.
+         * @param keys heavy hitters found by the planner, at most a few
+         */
+        void setHotKeys(const std::vector<std::string>& keys);
+
+        /*!
+         * stop the task early once the stage's output limit is satisfied by this task or the tasks before it
+         * @param limit tracker shared by all tasks of the stage
+         * @param taskIndex position of this task's output within the stage's output
+         */
+        void setStageOutputLimit(const std::shared_ptr<TaskOutputLimit>& limit, size_t taskIndex) {
+            _stageLimit = limit;
+            _stageTaskIndex = taskIndex;
+        }
+
+        /*!
+         * count exceptions densely and publish them to the stage's counts once the task is done
+         * @param index numbering of (operatorID, exception code) pairs of the stage
+         * @param liveCounts counts shared by all tasks of the stage, may be nullptr
+         */
+        void setExceptionCounting(const std::shared_ptr<const ExceptionCountIndex>& index,
+                                  ConcurrentExceptionCounts* liveCounts) {
+            _exceptionCounts.setIndex(index);
+            _liveExceptionCounts = liveCounts;
+        }
+
+        //! true if the task stopped at a cancellation checkpoint before its input was exhausted
+        bool stoppedEarly() const { return _stoppedEarly; }
         void execute() override;
 
         bool hasFileSink() const { return _outputFilePath != URI::INVALID; }
@@ -175,10 +299,12 @@ namespace tuplex {
         static codegen::str_hash_row_f writeStringHashTableAggregateCallback();
         static codegen::i64_hash_row_f writeInt64HashTableAggregateCallback();
         static codegen::write_row_f aggCombineCallback();
+        static codegen::cancel_check_f cancellationCallback();
 
         // most be public because of C++ issues -.-
         int64_t writeRowToMemory(uint8_t* buf, int64_t bufSize);
         int64_t writeRowToFile(uint8_t* buf, int64_t bufSize);
+        bool checkStop();
         void writeExceptionToMemory(const int64_t ecCode, const int64_t opID, const int64_t row, const uint8_t *buf, const size_t bufSize);
         void writeExceptionToFile(const int64_t ecCode, const int64_t opID, const int64_t row, const uint8_t *buf, const size_t bufSize);
         void writeRowToHashTable(char *key, size_t key_len, bool bucketize, char *buf, size_t buf_size);
@@ -204,7 +330,10 @@ namespace tuplex {
         * returns the number of exceptions in this task, hashed after operatorID and exception code
         * @return
         */
-        std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> exceptionCounts() const { return _exceptionCounts; }
+        std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> exceptionCounts() const { return _exceptionCounts.toMap(); }
+
+        //! exception counts as dense array, cheap to merge with counts of other tasks of the same stage
+        const ExceptionCounts& denseExceptionCounts() const { return _exceptionCounts; }
 
         double wallTime() const override { return _wallTime; }
     private:
@@ -225,7 +354,10 @@ namespace tuplex {
 
         // file source variables
         URI _inputFilePath;
+        size_t _inputRangeStart;
+        size_t _inputRangeSize;
         std::unique_ptr<FileInputReader> _reader;
+        std::function<std::unique_ptr<VirtualFile>()> _inputPrefetch;
 
         // file sink variables
         URI _outputFilePath;
@@ -252,9 +384,36 @@ namespace tuplex {
         // hash table sink
         HashTableSink _htable;
         HashTableFormat _htableFormat;
+        std::shared_ptr<AggregateState> _aggState;
+
+        struct HotBucket {
+            std::string key;
+            uint64_t intKey;
+            uint8_t* bucket;
+        };
+        std::vector<HotBucket> _hotBuckets;
+        inline uint8_t** hotBucket(const char* key, size_t key_len) {
+            for(auto& hb : _hotBuckets)
+                if(hb.key.size() == key_len && 0 == memcmp(hb.key.data(), key, key_len))
+                    return &hb.bucket;
+            return nullptr;
+        }
+        inline uint8_t** hotBucket(uint64_t key) {
+            for(auto& hb : _hotBuckets)
+                if(hb.intKey == key)
+                    return &hb.bucket;
+            return nullptr;
+        }
+        void flushHotBuckets();
 
         // NEW: row counter here for correct exception handling...
         int64_t _outputRowCounter;
+        size_t _normalRowCounter; //! rows written to a sink, i.e. without exception rows. Checked against the stage limit
+
+        // early stop for limits/cancellation
+        std::shared_ptr<TaskOutputLimit> _stageLimit;
+        size_t _stageTaskIndex;
+        bool _stoppedEarly;
 
         double _wallTime;
 
@@ -268,7 +427,8 @@ namespace tuplex {
 
         // exceptions
         // exception counts (required for sampling etc. later)
-        std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> _exceptionCounts;
+        ExceptionCounts _exceptionCounts;
+        ConcurrentExceptionCounts* _liveExceptionCounts;
 
         void incExceptionCounts(int64_t ecCode, int64_t opID);
 
@@ -279,14 +439,6 @@ namespace tuplex {
             return _numInputRowsRead;
         }
     };
-
-    // thread-local helper funcs for aggregates!
-    extern bool initThreadLocalAggregates(size_t num_slots, codegen::agg_init_f init_func, codegen::agg_combine_f combine_func);
-    extern bool initThreadLocalAggregateByKey(codegen::agg_init_f init_func, codegen::agg_combine_f combine_func, codegen::agg_agg_f aggregate_func);
-    extern bool fetchAggregate(uint8_t** out, int64_t* out_size);
-
-    extern uint8_t* combineBuckets(uint8_t *bucketA, uint8_t* bucketB);
-    extern void aggregateValues(uint8_t** bucket, char *buf, size_t buf_size);
 }
 
 #endif //TUPLEX_TRANSFORMTASK_H
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <logical/LogicalOperator.h>
 #include <logical/ParallelizeOperator.h>
 #include <logical/FileInputOperator.h>
+#include <logical/CacheOperator.h>
 #include "ErrorDataSet.h"
 #include "EmptyDataset.h"
 #include <JITCompiler.h>
@@ -18,6 +19,8 @@
 #include <VirtualFileSystem.h>
 #include <ee/local/LocalBackend.h>
 #include <Signals.h>
+#include <map>
+#include <queue>
 #ifdef BUILD_WITH_AWS
 #include <ee/aws/AWSLambdaBackend.h>
 #endif
@@ -46,7 +49,13 @@ namespace tuplex {
         Timer timer;
         bool aws_init_rc = initAWS(aws_credentials, options.AWS_REQUESTER_PAY());
         logger.debug("initialized AWS SDK in " + std::to_string(timer.time()) + "s");
+        VirtualFileSystem::setListingParallelism("s3://", options.AWS_LISTING_PARALLELISM());
+        if(options.INPUT_CACHE_SIZE() > 0)
+            VirtualFileSystem::enableBlockCache(options.SCRATCH_DIR().join_path("input_cache"), options.INPUT_CACHE_SIZE());
+        else
+            VirtualFileSystem::disableBlockCache();
 #endif
+        VirtualFileSystem::setListingCacheTTL(options.LISTING_CACHE_TTL());
 
         // start backend depending on options
         switch(options.BACKEND()) {
@@ -468,4 +477,200 @@ namespace tuplex {
     Executor* Context::getDriver() const {
         assert(_ee); return _ee->driver();
     }
-}
\ No newline at end of file
+
+    void Context::setJobWeight(double weight) {
+        // only the local backend shares executors among jobs
+        LocalBackend::setJobWeight(weight);
+    }
+
+    // all operators the result of op depends on (including op itself)
+    static std::unordered_set<LogicalOperator*> operatorAncestors(LogicalOperator* op) {
+        std::unordered_set<LogicalOperator*> ancestors;
+        std::queue<LogicalOperator*> q;
+        q.push(op);
+        while(!q.empty()) {
+            auto node = q.front(); q.pop();
+            if(!node || ancestors.count(node))
+                continue;
+            ancestors.insert(node);
+            for(auto p : node->parents())
+                q.push(p);
+        }
+        return ancestors;
+    }
+
+    // whether the output of op can be materialized once and then be reused by an action with the given ancestors
+    static bool canShare(LogicalOperator* op, const std::unordered_set<LogicalOperator*>& actionAncestors) {
+        switch(op->type()) {
+            case LogicalOperatorType::TAKE:
+            case LogicalOperatorType::FILEOUTPUT:
+            case LogicalOperatorType::PARALLELIZE: // already in memory
+            case LogicalOperatorType::CACHE:
+                return false;
+            default:
+                break;
+        }
+
+        // resolvers/ignores refer to the operator before them, the cache would cut them off
+        for(auto c : op->getChildren())
+            if(isExceptionOperator(c->type()) && actionAncestors.count(c))
+                return false;
+
+        // only worth it when this saves reading files again
+        for(auto a : operatorAncestors(op))
+            if(a->type() == LogicalOperatorType::FILEINPUT)
+                return true;
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ResultSet>> Context::runAll(const std::vector<DataSet*>& actions) {
+        using namespace std;
+        auto& logger = Logger::instance().logger("core");
+
+        vector<shared_ptr<ResultSet>> results(actions.size());
+        vector<LogicalOperator*> ops(actions.size(), nullptr);
+        vector<unordered_set<LogicalOperator*>> ancestors(actions.size());
+        vector<size_t> pending;
+
+        for(size_t i = 0; i < actions.size(); ++i) {
+            auto ds = actions[i];
+            if(!ds)
+                throw std::runtime_error("runAll received nullptr as action");
+            auto op = ds->getOperator();
+            if(ds->isError() || ds->isEmpty() || !op ||
+               (op->type() != LogicalOperatorType::TAKE && op->type() != LogicalOperatorType::FILEOUTPUT)) {
+                // not a deferred action, just collect
+                results[i] = ds->collect();
+                continue;
+            }
+            ops[i] = op;
+            ancestors[i] = operatorAncestors(op);
+            pending.push_back(i);
+        }
+
+        // greedily pick the operator shared by most actions, ties are broken towards the deepest operator
+        while(pending.size() > 1) {
+            map<int64_t, pair<LogicalOperator*, vector<size_t>>> coverage;
+            for(auto i : pending) {
+                for(auto a : ancestors[i]) {
+                    if(a == ops[i] || !canShare(a, ancestors[i]))
+                        continue;
+                    auto& entry = coverage[a->getID()];
+                    entry.first = a;
+                    entry.second.push_back(i);
+                }
+            }
+
+            LogicalOperator* best = nullptr;
+            vector<size_t> bestIndices;
+            size_t bestDepth = 0;
+            for(const auto& kv : coverage) {
+                auto& indices = kv.second.second;
+                if(indices.size() < 2 || indices.size() < bestIndices.size())
+                    continue;
+                auto depth = operatorAncestors(kv.second.first).size();
+                if(indices.size() > bestIndices.size() || depth > bestDepth) {
+                    best = kv.second.first;
+                    bestIndices = indices;
+                    bestDepth = depth;
+                }
+            }
+
+            if(!best)
+                break;
+
+            logger.info("sharing operator " + best->name() + " across " + pluralize(bestIndices.size(), "action"));
+            executeShared(best, bestIndices, ops, ancestors, results);
+
+            pending.erase(std::remove_if(pending.begin(), pending.end(), [&](size_t i) {
+                return std::find(bestIndices.begin(), bestIndices.end(), i) != bestIndices.end();
+            }), pending.end());
+        }
+
+        // remaining actions do not share any work
+        for(auto i : pending)
+            results[i] = ops[i]->compute(*this);
+
+        return results;
+    }
+
+    void Context::executeShared(LogicalOperator *shared,
+                                const std::vector<size_t> &indices,
+                                const std::vector<LogicalOperator *> &actions,
+                                const std::vector<std::unordered_set<LogicalOperator *>> &ancestors,
+                                std::vector<std::shared_ptr<ResultSet>> &results) {
+        using namespace std;
+        auto& logger = Logger::instance().logger("core");
+
+        // materialize shared operator once, same as DataSet::cache
+        auto cop = new CacheOperator(shared, true);
+        addOperator(cop);
+        auto dsptr = createDataSet(cop->getOutputSchema());
+        dsptr->_operator = cop;
+        cop->setDataSet(dsptr);
+        dsptr->setColumns(shared->columns());
+        cop->setResult(cop->compute(*this));
+
+        // cached exceptions can't be merged in order, fall back to separate execution
+        bool canUseCache = cop->cachedExceptions().empty() || !_options.OPT_MERGE_EXCEPTIONS_INORDER();
+
+        // children of shared which lead to one of the actions read now from the cache
+        vector<LogicalOperator*> rewired;
+        if(canUseCache) {
+            for(auto child : shared->getChildren()) {
+                if(child == cop)
+                    continue;
+                bool used = false;
+                for(auto i : indices)
+                    used = used || ancestors[i].count(child) > 0;
+                if(used && child->replaceParent(shared, cop))
+                    rewired.push_back(child);
+            }
+            cop->setChildren(rewired);
+        } else {
+            logger.info("shared operator produced exceptions which need to be merged in order, executing actions separately");
+        }
+
+        auto restore = [&]() {
+            for(auto child : rewired)
+                child->replaceParent(cop, shared);
+            cop->setChildren({});
+            auto children = shared->getChildren();
+            children.erase(std::remove(children.begin(), children.end(), cop), children.end());
+            shared->setChildren(children);
+        };
+
+        try {
+            for(auto i : indices)
+                results[i] = actions[i]->compute(*this);
+        } catch(...) {
+            restore();
+            throw;
+        }
+        restore();
+
+        // release cached rows unless a result set handed them out directly (e.g. take right after the shared operator)
+        bool handedOut = false;
+        for(auto i : indices) {
+            if(!results[i])
+                continue;
+            for(auto p : cop->cachedPartitions())
+                handedOut = handedOut || results[i]->contains(p);
+            for(auto p : cop->cachedExceptions())
+                handedOut = handedOut || results[i]->contains(p);
+        }
+
+        if(handedOut) {
+            logger.info("shared result is referenced by an action result, keeping it cached");
+        } else {
+            for(auto p : cop->cachedPartitions()) {
+                p->makeMortal();
+                p->invalidate();
+            }
+            for(auto p : cop->cachedExceptions()) {
+                p->makeMortal();
+                p->invalidate();
+            }
+        }
+    }
+}
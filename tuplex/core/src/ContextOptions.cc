@@ -211,6 +211,7 @@ namespace tuplex {
                      {"tuplex.normalcaseThreshold", "0.9"},
                      {"tuplex.optionalThreshold", "0.7"},
                      {"tuplex.csv.selectionPushdown", "true"},
+                     {"tuplex.csv.exactSplits", "false"},
                      {"tuplex.webui.enable", "true"},
                      {"tuplex.webui.port", "5000"},
                      {"tuplex.webui.url", "localhost"},
@@ -218,6 +219,8 @@ namespace tuplex {
                      {"tuplex.webui.mongodb.port", "27017"},
                      {"tuplex.webui.mongodb.path", temp_mongodb_path},
                      {"tuplex.webui.exceptionDisplayLimit", "5"},
+                     {"tuplex.metrics.enable", "false"},
+                     {"tuplex.metrics.port", "9464"},
                      {"tuplex.readBufferSize", "128KB"},
                      {"tuplex.inputSplitSize", "64MB"},
                      {"tuplex.optimizer.codeStats", "false"},
@@ -225,9 +228,24 @@ namespace tuplex {
                      {"tuplex.optimizer.nullValueOptimization", "false"},
                      {"tuplex.optimizer.filterPushdown", "true"},
                      {"tuplex.optimizer.operatorReordering", "false"},
+                     {"tuplex.optimizer.deadColumnElimination", "true"},
                      {"tuplex.optimizer.sharedObjectPropagation", "true"},
                      {"tuplex.optimizer.mergeExceptionsInOrder", "true"},
                      {"tuplex.interleaveIO", "true"},
+                     {"tuplex.prefetchMemory", "128MB"},
+                     {"tuplex.streamFileOutput", "false"},
+                     {"tuplex.concurrentStages", "false"},
+                     {"tuplex.aotCompileThreads", "0"},
+                     {"tuplex.scheduler.multiJob", "false"},
+                     {"tuplex.scheduler.jobMemoryQuota", "0"},
+                     {"tuplex.hotKeyRows", "64"},
+                     {"tuplex.hotKeySketchSize", "64"},
+                     {"tuplex.adaptiveSplits", "false"},
+                     {"tuplex.executorHugePages", "false"},
+                     {"tuplex.executorPrefault", "false"},
+                     {"tuplex.executorPinThreads", "false"},
+                     {"tuplex.listingCacheTTL", "0"},
+                     {"tuplex.inputCacheSize", "0"},
                      {"tuplex.aws.scratchDir", ""},
                      {"tuplex.aws.requestTimeout", "600"},
                      {"tuplex.aws.connectTimeout", "30"},
@@ -237,6 +255,7 @@ namespace tuplex {
                      {"tuplex.aws.lambdaMemory", "1536"},
                      {"tuplex.aws.lambdaTimeout", "600"},
                      {"tuplex.aws.requesterPay", "false"},
+                     {"tuplex.aws.listingParallelism", "32"},
                      {"tuplex.resolveWithInterpreterOnly", "false"}};
 #else
         // DEBUG options
@@ -261,6 +280,7 @@ namespace tuplex {
                      {"tuplex.normalcaseThreshold", "0.9"},
                      {"tuplex.optionalThreshold", "0.7"},
                      {"tuplex.csv.selectionPushdown", "true"}, //
+                     {"tuplex.csv.exactSplits", "false"},
                      {"tuplex.webui.enable", "true"},
                      {"tuplex.webui.port", "5000"},
                      {"tuplex.webui.url", "localhost"},
@@ -268,6 +288,8 @@ namespace tuplex {
                      {"tuplex.webui.mongodb.port", "27017"},
                      {"tuplex.webui.mongodb.path", temp_mongodb_path},
                      {"tuplex.webui.exceptionDisplayLimit", "5"},
+                     {"tuplex.metrics.enable", "false"},
+                     {"tuplex.metrics.port", "9464"},
                      {"tuplex.readBufferSize", "4KB"},
                      {"tuplex.inputSplitSize", "16MB"},
                      {"tuplex.optimizer.codeStats", "true"},
@@ -275,9 +297,24 @@ namespace tuplex {
                      {"tuplex.optimizer.nullValueOptimization", "false"},
                      {"tuplex.optimizer.filterPushdown", "true"},
                      {"tuplex.optimizer.operatorReordering", "false"},
+                     {"tuplex.optimizer.deadColumnElimination", "true"},
                      {"tuplex.optimizer.sharedObjectPropagation", "true"},
                      {"tuplex.optimizer.mergeExceptionsInOrder", "false"},
                      {"tuplex.interleaveIO", "true"},
+                     {"tuplex.prefetchMemory", "128MB"},
+                     {"tuplex.streamFileOutput", "false"},
+                     {"tuplex.concurrentStages", "false"},
+                     {"tuplex.aotCompileThreads", "0"},
+                     {"tuplex.scheduler.multiJob", "false"},
+                     {"tuplex.scheduler.jobMemoryQuota", "0"},
+                     {"tuplex.hotKeyRows", "64"},
+                     {"tuplex.hotKeySketchSize", "64"},
+                     {"tuplex.adaptiveSplits", "false"},
+                     {"tuplex.executorHugePages", "false"},
+                     {"tuplex.executorPrefault", "false"},
+                     {"tuplex.executorPinThreads", "false"},
+                     {"tuplex.listingCacheTTL", "0"},
+                     {"tuplex.inputCacheSize", "0"},
                      {"tuplex.aws.scratchDir", ""},
                      {"tuplex.aws.requestTimeout", "600"},
                      {"tuplex.aws.connectTimeout", "30"},
@@ -287,6 +324,7 @@ namespace tuplex {
                      {"tuplex.aws.lambdaMemory", "1536"},
                      {"tuplex.aws.lambdaTimeout", "600"},
                      {"tuplex.aws.requesterPay", "false"},
+                     {"tuplex.aws.listingParallelism", "32"},
                      {"tuplex.resolveWithInterpreterOnly", "true"}};
 #endif
 
@@ -445,10 +483,18 @@ namespace tuplex {
         return memStringToSize(_store.at("tuplex.partitionSize"));
     }
 
+    size_t ContextOptions::INPUT_CACHE_SIZE() const {
+        return memStringToSize(_store.at("tuplex.inputCacheSize"));
+    }
+
     size_t ContextOptions::EXECUTOR_MEMORY() const {
         return memStringToSize(_store.at("tuplex.executorMemory"));
     }
 
+    size_t ContextOptions::JOB_MEMORY_QUOTA() const {
+        return memStringToSize(_store.at("tuplex.scheduler.jobMemoryQuota"));
+    }
+
     unsigned int ContextOptions::EXECUTOR_COUNT() const {
         unsigned int executorCount = std::stoi(_store.at("tuplex.executorCount"));
         return executorCount;
@@ -629,6 +675,10 @@ namespace tuplex {
         return memStringToSize(_store.at("tuplex.inputSplitSize"));
     }
 
+    size_t ContextOptions::PREFETCH_MEMORY() const {
+        return memStringToSize(_store.at("tuplex.prefetchMemory"));
+    }
+
     size_t ContextOptions::READ_BUFFER_SIZE() const {
         return memStringToSize(_store.at("tuplex.readBufferSize"));
     }
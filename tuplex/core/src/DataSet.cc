@@ -40,6 +40,16 @@ namespace tuplex {
     }
 
     std::shared_ptr<ResultSet> DataSet::take(int64_t numElements, std::ostream &os) {
+        auto& ds = deferTake(numElements);
+
+        // perform action.
+        assert(this->_context);
+        auto rs = ds._operator->compute(*this->_context);
+
+        return rs;
+    }
+
+    DataSet& DataSet::deferTake(int64_t numElements) {
         // error dataset?
         if (isError())
             throw std::runtime_error("is error dataset!");
@@ -54,12 +64,7 @@ namespace tuplex {
         DataSet *dsptr = _context->createDataSet(op->getOutputSchema());
         dsptr->_operator = op;
         op->setDataSet(dsptr);
-
-        // perform action.
-        assert(this->_context);
-        auto rs = op->compute(*this->_context);
-
-        return rs;
+        return *dsptr;
     }
 
     // collect functions
@@ -102,6 +107,20 @@ namespace tuplex {
                          size_t fileCount, size_t shardSize,
                          const std::unordered_map<std::string, std::string> &outputOptions, size_t limit,
                          std::ostream &os) {
+        auto& ds = deferTofile(fmt, uri, udf, fileCount, shardSize, outputOptions, limit);
+
+        // failed to create the output operator, error is already logged
+        if (ds.isError())
+            return;
+
+        // perform action.
+        assert(this->_context);
+        auto rs = ds._operator->compute(*this->_context);
+    }
+
+    DataSet& DataSet::deferTofile(tuplex::FileFormat fmt, const tuplex::URI &uri, const tuplex::UDF &udf,
+                                  size_t fileCount, size_t shardSize,
+                                  const std::unordered_map<std::string, std::string> &outputOptions, size_t limit) {
         if (isError())
             throw std::runtime_error("is error dataset!");
 
@@ -117,17 +136,14 @@ namespace tuplex {
 
         if (!op->good()) {
             Logger::instance().defaultLogger().error("failed to create file output operator");
-        } else {
-            // action, perform it!
-            DataSet *dsptr = _context->createDataSet(op->getOutputSchema());
-            dsptr->_operator = op;
-            dsptr->setColumns(_columnNames); // file op doesn't change column names!
-            op->setDataSet(dsptr);
-
-            // perform action.
-            assert(this->_context);
-            auto rs = op->compute(*this->_context);
+            return _context->makeError("failed to add file output operator to logical plan");
         }
+
+        DataSet *dsptr = _context->createDataSet(op->getOutputSchema());
+        dsptr->_operator = op;
+        dsptr->setColumns(_columnNames); // file op doesn't change column names!
+        op->setDataSet(dsptr);
+        return *dsptr;
     }
 
     DataSet &DataSet::map(const UDF &udf) {
@@ -13,8 +13,15 @@
 #include <RuntimeInterface.h>
 #include <Partition.h>
 #include <atomic>
+#include <algorithm>
 #include <unistd.h>
 #include <Signals.h>
+#include <RuntimeMetrics.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
 
 
 // Notes on Multithreaded programming:
@@ -25,9 +32,41 @@
 
 namespace tuplex {
 
+    // job on whose behalf the calling thread currently works
+    static thread_local int64_t t_currentJobID = -1;
+
+    int64_t Executor::currentJob() {
+        return t_currentJobID;
+    }
+
+    void Executor::setCurrentJob(int64_t jobID) {
+        t_currentJobID = jobID;
+    }
+
+    // accounts partitions allocated by a task to the job of the queue it came from
+    struct CurrentJobScope {
+        int64_t prev;
+        explicit CurrentJobScope(int64_t jobID) : prev(t_currentJobID) {
+            // queues without a job leave the one of the calling thread (e.g. the driver's) in place
+            if(jobID >= 0)
+                t_currentJobID = jobID;
+        }
+        ~CurrentJobScope() { t_currentJobID = prev; }
+    };
+
+    // counts a task as running while in scope, and as finished when leaving it, even if the task threw
+    struct TaskMetricsScope {
+        const IExecutorTask* task;
+        Timer timer;
+        explicit TaskMetricsScope(const IExecutorTask* task) : task(task) { RuntimeMetrics::instance().taskStarted(); }
+        ~TaskMetricsScope() { RuntimeMetrics::instance().taskFinished(task->type(), timer.time()); }
+    };
+
     WorkQueue::WorkQueue() {
         _numPendingTasks = 0;
         _numCompletedTasks = 0;
+        _jobID = -1;
+        _jobWeight = 1.0;
     }
 
     std::vector<IExecutorTask*> WorkQueue::popCompletedTasks() {
@@ -63,6 +102,7 @@ namespace tuplex {
         while((pendingTasks = _numPendingTasks.load(std::memory_order_acquire)) != 0) {
             IExecutorTask *task = nullptr;
             if(_queue.try_dequeue(task)) {
+                RuntimeMetrics::instance().taskDequeued();
                 _numPendingTasks.fetch_add(-1, std::memory_order_release);
                 _numCompletedTasks.fetch_add(1, std::memory_order_release);
             }
@@ -82,6 +122,7 @@ namespace tuplex {
             // @Todo: This should be put into a function "work" on the workQueue...
             // dequeue from general working queue
             if(_queue.try_dequeue(task)) {
+                RuntimeMetrics::instance().taskDequeued();
                 if(!task)
                     return false;
 
@@ -90,7 +131,11 @@ namespace tuplex {
 
                 //executor.logger().info("started task...");
                 // process task
-                task->execute();
+                {
+                    CurrentJobScope jobScope(_jobID);
+                    TaskMetricsScope metricsScope(task);
+                    task->execute();
+                }
                 // save which thread executed this task
                 task->setID(std::this_thread::get_id());
 
@@ -107,6 +152,7 @@ namespace tuplex {
             }
         } else {
             _queue.wait_dequeue(task);
+            RuntimeMetrics::instance().taskDequeued();
 
             if(!task)
                 return false;
@@ -115,7 +161,11 @@ namespace tuplex {
             task->setThreadNumber(executor.threadNumber()); // redundant?
 
             // process task
-            task->execute();
+            {
+                CurrentJobScope jobScope(_jobID);
+                TaskMetricsScope metricsScope(task);
+                task->execute();
+            }
             // save which thread executed this task
             task->setID(std::this_thread::get_id());
 
@@ -199,19 +249,26 @@ namespace tuplex {
                        const size_t runTimeMemory,
                        const size_t  runTimeMemoryDefaultBlockSize,
                        URI cache_path,
-                       const std::string& name) : _allocator(size, blockSize),
+                       const std::string& name,
+                       const ArenaPolicy& arenaPolicy) : _allocator(size, blockSize, arenaPolicy),
                                                   _runTimeMemory(runTimeMemory),
                                                   _runTimeMemoryDefaultBlockSize(runTimeMemoryDefaultBlockSize),
                                                   _uuid(getUniqueID()),
                                                   _cache_path(cache_path),
                                                   _name(makeExecutorName(name)),
                                                   _historyServer(nullptr),
-                                                  _threadNumber(0) {
+                                                  _threadNumber(0),
+                                                  _jobMemoryQuota(0),
+                                                  _numQuotaEvictions(0) {
 
         _threadID = std::this_thread::get_id();
         _workQueue = nullptr;
         _done = true; // per default, if worker(...) is executed it should not run through.
 
+        // with pinned threads, the arena is bound to the node of the worker first
+        if(!arenaPolicy.pinThreads)
+            _allocator.startPrefault();
+
         // @TODO: what about non-existing S3 path? to make more user-friendly fix this!
         if(cache_path.isLocal() && !cache_path.exists()) {
             info("provided cache path " + cache_path.toString() + " does not exist. Attempting to create it.");
@@ -242,6 +299,13 @@ namespace tuplex {
             return nullptr;
         }
 
+        // a job over its quota makes room by evicting its own partitions, so other jobs keep theirs in memory
+        auto jobID = currentJob();
+        if(_jobMemoryQuota > 0 && jobID >= 0) {
+            while(jobMemory(jobID) + minRequired > _jobMemoryQuota && evictLRUPartition(jobID))
+                _numQuotaEvictions++;
+        }
+
         uint8_t* memory = nullptr;
         // try to get memory, as long as it fails evict partitions
         while(!(memory = reinterpret_cast<uint8_t*>(_allocator.alloc(minRequired)))) {
@@ -249,11 +313,13 @@ namespace tuplex {
         }
 
         Partition *p = new Partition(this, memory, _allocator.allocatedSize(memory), schema, dataSetID);
+        p->setJobID(jobID);
 
         // print out info:
         //info("new partition at addr: " + hexAddr(p) + " uuid: " + uuidToString(p->uuid()));
 
         _partitions.push_front(p);
+        trackJobMemory(p, true);
         return p;
     }
 
@@ -310,6 +376,7 @@ namespace tuplex {
 
                 // remove from list
                 _partitions.remove(partition);
+                trackJobMemory(partition, false);
             } else if(std::find(_storedPartitions.begin(), _storedPartitions.end(), partition) != _storedPartitions.end()) {
 
                 // remove from list
@@ -342,6 +409,11 @@ namespace tuplex {
         return totalUsed;
     }
 
+    size_t Executor::numPartitions() {
+        boost::shared_lock<boost::shared_mutex> lock(_listMutex);
+        return _partitions.size() + _storedPartitions.size();
+    }
+
 
     void Executor::recoverPartition(tuplex::Partition *partition) {
 
@@ -380,34 +452,42 @@ namespace tuplex {
 
         _partitions.push_front(partition);
         _storedPartitions.remove(partition);
+        trackJobMemory(partition, true);
 
         std::stringstream ss;
         ss <<"recovered partition "+ uuidToString(partition->uuid()) + " from " + partitionPath.toString();
         info(ss.str());
     }
 
-    void Executor::evictLRUPartition() {
+    bool Executor::evictLRUPartition(int64_t jobID) {
 
         // function used exclusively by allocWritablePartition & recoverPartition
 
         // function should be only executed IFF _listmutex is locked!
 
-        if(_partitions.empty()) {
-            error("there is no partition to evict, fatal error!");
+        // save last unlocked list item (of the job) to disk & remove from partitions (should be added to global remvoe list?)
+        // locked partitions may be held by the evicting thread itself and the partition mutex is recursive,
+        // i.e. swapping them out would free memory still in use
+        auto rit = std::find_if(_partitions.rbegin(), _partitions.rend(), [jobID](const Partition* p) {
+            return !p->isLocked() && (jobID < 0 || p->getJobID() == jobID);
+        });
+        if(rit == _partitions.rend()) {
+            // running out of a job's quota is fine, running out of memory not
+            if(jobID >= 0)
+                return false;
+            error("there is no unlocked partition to evict, fatal error!");
             std::abort();
-            return;
+            return false;
         }
-
-        // save last list item to disk & remove from partitions (should be added to global remvoe list?)
-        Partition* last = _partitions.back();
+        auto it = std::prev(rit.base());
+        Partition* last = *it;
         assert(last->owner() == this);
         last->swapOut(_allocator, getPartitionURI(last));
 
-        assert(_partitions.back() == last);
-
         // threads may now access this partitions internals.
         // However, restore is blocked still through the list lock
-        _partitions.remove(last);
+        _partitions.erase(it);
+        trackJobMemory(last, false);
         assert(std::find(_partitions.begin(), _partitions.end(), last) == _partitions.end());
 
         // exclusive push
@@ -418,6 +498,53 @@ namespace tuplex {
         std::stringstream ss;
         ss<<"evicted partition " + uuidToString(last->uuid()) + " to " + getPartitionURI(last).toString();
         info(ss.str());
+        return true;
+    }
+
+    size_t Executor::jobMemory(int64_t jobID) const {
+        auto it = _jobMemory.find(jobID);
+        return it != _jobMemory.end() ? it->second : 0;
+    }
+
+    void Executor::trackJobMemory(const Partition *partition, bool inMemory) {
+        auto jobID = partition->getJobID();
+        if(jobID < 0)
+            return;
+        if(inMemory) {
+            _jobMemory[jobID] += partition->size();
+        } else {
+            auto it = _jobMemory.find(jobID);
+            assert(it != _jobMemory.end() && it->second >= partition->size());
+            it->second -= partition->size();
+            if(0 == it->second)
+                _jobMemory.erase(it); // job ids are not reused
+        }
+    }
+
+    void Executor::pinToCPU() {
+#ifdef __linux__
+        // thread number 0 is the driver (i.e. the main thread), executors start at 1
+        auto numCPUs = std::thread::hardware_concurrency();
+        if(0 == numCPUs)
+            return;
+        unsigned cpu = _threadNumber % numCPUs;
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(cpu, &cpuset);
+        if(0 != pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset)) {
+            error("failed to pin thread to CPU " + std::to_string(cpu));
+            _allocator.startPrefault();
+            return;
+        }
+
+        // find NUMA node of the CPU & place arena there
+        unsigned currentCPU = 0, node = 0;
+        if(0 == syscall(SYS_getcpu, &currentCPU, &node, nullptr) && _allocator.bindToNode(node))
+            info("pinned to CPU " + std::to_string(cpu) + ", memory on NUMA node " + std::to_string(node));
+        else
+            info("pinned to CPU " + std::to_string(cpu));
+#endif
+        _allocator.startPrefault();
     }
 
     void Executor::worker() {
@@ -427,6 +554,9 @@ namespace tuplex {
         auto this_id = std::this_thread::get_id();
         _threadID = this_id; //! needs to come first!!!
 
+        if(_allocator.policy().pinThreads)
+            pinToCPU();
+
         // init runtime memory
         runtime::setRunTimeMemory(_runTimeMemory, _runTimeMemoryDefaultBlockSize);
         info("initialized runtime memory (" + sizeToMemString(runtime::runTimeMemorySize()) + ")" );
@@ -496,6 +626,7 @@ namespace tuplex {
                 }
 
                 _partitions.clear();
+                _jobMemory.clear();
             }
 
             if(!_storedPartitions.empty()) {
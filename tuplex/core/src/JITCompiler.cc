@@ -282,10 +282,13 @@ namespace tuplex {
         jitlib.setGenerator(std::move(*ProcessSymbolsGenerator));
 
         // define symbols from custom symbols for this jitlib
-        for(auto keyval: _customSymbols)
-            auto rc = jitlib.define(llvm::orc::absoluteSymbols({{Mangle(keyval.first), keyval.second}}));
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for(auto keyval: _customSymbols)
+                auto rc = jitlib.define(llvm::orc::absoluteSymbols({{Mangle(keyval.first), keyval.second}}));
 
-        _dylibs.push_back(&jitlib); // save reference for search
+            _dylibs.push_back(&jitlib); // save reference for search
+        }
 
         assert(tsm);
         auto err = _lljit->addIRModule(jitlib, std::move(tsm.get()));
@@ -346,10 +349,13 @@ namespace tuplex {
         jitlib.setGenerator(std::move(*ProcessSymbolsGenerator));
 
         // define symbols from custom symbols for this jitlib
-        for(auto keyval: _customSymbols)
-            auto rc = jitlib.define(absoluteSymbols({{Mangle(keyval.first), keyval.second}}));
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for(auto keyval: _customSymbols)
+                auto rc = jitlib.define(absoluteSymbols({{Mangle(keyval.first), keyval.second}}));
 
-        _dylibs.push_back(&jitlib); // save reference for search
+            _dylibs.push_back(&jitlib); // save reference for search
+        }
         auto err = _lljit->addIRModule(jitlib, std::move(tsm.get()));
         if(err)
             throw std::runtime_error("compilation failed, " + errToString(err));
@@ -376,7 +382,13 @@ namespace tuplex {
             return nullptr;
 
         // search for symbol in all dylibs
-        for(auto it = _dylibs.rbegin(); it != _dylibs.rend(); ++it) {
+        // note: lookup triggers materialization, hence do it on a copy to not block other threads
+        std::vector<llvm::orc::JITDylib*> dylibs;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            dylibs = _dylibs;
+        }
+        for(auto it = dylibs.rbegin(); it != dylibs.rend(); ++it) {
             auto sym = _lljit->lookup(**it, Name);
             if(sym)
                 return reinterpret_cast<void*>(sym.get().getAddress());
@@ -38,7 +38,8 @@ namespace tuplex {
             const size_t blockSize,
              const size_t runTimeMemory,
              const size_t runTimeMemoryDefaultBlockSize,
-            const URI& cache_path) {
+            const URI& cache_path,
+            const ArenaPolicy& arenaPolicy) {
 
         if(0 == num) // no execs
             return std::vector<Executor*>();
@@ -82,7 +83,7 @@ namespace tuplex {
         auto& logger = Logger::instance().logger("local execution engine");
         for(int i = 0; i < numStillNeeded; ++i) {
             URI uri = URI(cache_path.toString() + "/" + "E" + std::to_string(num_current + 1 + i));
-            _executors.push_back(std::make_unique<Executor>(size, blockSize, runTimeMemory, runTimeMemoryDefaultBlockSize, uri, "E/" + std::to_string(num_current + 1 + i)));
+            _executors.push_back(std::make_unique<Executor>(size, blockSize, runTimeMemory, runTimeMemoryDefaultBlockSize, uri, "E/" + std::to_string(num_current + 1 + i), arenaPolicy));
             auto exec = _executors.back().get();
             _refCounts[exec] = 1;
             execs.push_back(exec);
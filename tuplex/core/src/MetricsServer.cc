@@ -0,0 +1,118 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <MetricsServer.h>
+#include <RuntimeMetrics.h>
+#include <Logger.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace tuplex {
+
+    MetricsServer::MetricsServer(uint16_t port) : _fd(-1), _port(port), _done(false) {
+        _fd = socket(AF_INET, SOCK_STREAM, 0);
+        if(_fd < 0)
+            throw std::runtime_error("could not create socket for metrics endpoint: " + std::string(strerror(errno)));
+
+        int reuse = 1;
+        setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        // localhost only, metrics are not meant to be exposed to the network
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+        if(bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(_fd, 16) != 0) {
+            auto err = std::string(strerror(errno));
+            close(_fd);
+            throw std::runtime_error("could not bind metrics endpoint to 127.0.0.1:" + std::to_string(port) + ": " + err);
+        }
+
+        socklen_t len = sizeof(addr);
+        if(getsockname(_fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0)
+            _port = ntohs(addr.sin_port);
+
+        _thread = std::thread(&MetricsServer::serve, this);
+    }
+
+    MetricsServer::~MetricsServer() {
+        _done = true;
+        if(_thread.joinable())
+            _thread.join();
+        if(_fd >= 0)
+            close(_fd);
+    }
+
+    void MetricsServer::serve() {
+        while(!_done) {
+            // wake up regularly to check whether the server got stopped
+            pollfd pfd{_fd, POLLIN, 0};
+            if(poll(&pfd, 1, 100) <= 0 || !(pfd.revents & POLLIN))
+                continue;
+
+            int fd = accept(_fd, nullptr, nullptr);
+            if(fd < 0)
+                continue;
+
+            // do not let a stalled client block the endpoint
+            timeval timeout{1, 0};
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            handleConnection(fd);
+            close(fd);
+        }
+    }
+
+    void MetricsServer::handleConnection(int fd) {
+        // read request header, body is ignored
+        std::string request;
+        char buf[1024];
+        while(request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+            auto n = recv(fd, buf, sizeof(buf), 0);
+            if(n <= 0)
+                break;
+            request.append(buf, n);
+        }
+
+        std::string status = "200 OK";
+        std::string contentType = "text/plain; version=0.0.4; charset=utf-8";
+        std::string body;
+        if(request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 14, "GET /metrics?") == 0) {
+            body = RuntimeMetrics::instance().toPrometheusText();
+        } else if(request.compare(0, 4, "GET ") == 0) {
+            status = "404 Not Found";
+            body = "only /metrics is served\n";
+        } else {
+            status = "405 Method Not Allowed";
+            body = "only GET is supported\n";
+        }
+
+        std::string response = "HTTP/1.1 " + status + "\r\n"
+                               "Content-Type: " + contentType + "\r\n"
+                               "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                               "Connection: close\r\n\r\n" + body;
+        size_t sent = 0;
+        while(sent < response.size()) {
+            auto n = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if(n <= 0) {
+                Logger::instance().logger("metrics").debug("failed to send metrics response: " + std::string(strerror(errno)));
+                break;
+            }
+            sent += n;
+        }
+    }
+}
@@ -0,0 +1,219 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <RuntimeMetrics.h>
+#include <Utils.h>
+#include <JobMetrics.h>
+#include <physical/ExceptionCounts.h>
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <sstream>
+#include <set>
+
+namespace tuplex {
+
+    MetricsHistogram::MetricsHistogram(std::vector<double> bounds) : _bounds(std::move(bounds)),
+                                                                     _counts(new std::atomic<uint64_t>[_bounds.size() + 1]),
+                                                                     _sumNanos(0) {
+        assert(std::is_sorted(_bounds.begin(), _bounds.end()));
+        for(unsigned i = 0; i <= _bounds.size(); ++i)
+            _counts[i] = 0;
+    }
+
+    void MetricsHistogram::observe(double value) {
+        auto idx = std::lower_bound(_bounds.begin(), _bounds.end(), value) - _bounds.begin();
+        _counts[idx].fetch_add(1, std::memory_order_relaxed);
+        _sumNanos.fetch_add(static_cast<uint64_t>(std::max(value, 0.0) * 1e9), std::memory_order_relaxed);
+    }
+
+    void MetricsHistogram::write(std::ostream &os, const std::string &name, const std::string &labels) const {
+        auto prefix = labels.empty() ? "" : labels + ",";
+        uint64_t cumulative = 0;
+        for(unsigned i = 0; i < _bounds.size(); ++i) {
+            cumulative += _counts[i].load(std::memory_order_relaxed);
+            os<<name<<"_bucket{"<<prefix<<"le=\""<<_bounds[i]<<"\"} "<<cumulative<<"\n";
+        }
+        cumulative += _counts[_bounds.size()].load(std::memory_order_relaxed);
+        os<<name<<"_bucket{"<<prefix<<"le=\"+Inf\"} "<<cumulative<<"\n";
+        auto suffix = labels.empty() ? "" : "{" + labels + "}";
+        os<<name<<"_sum"<<suffix<<" "<<static_cast<double>(_sumNanos.load(std::memory_order_relaxed)) / 1e9<<"\n";
+        // count is the +Inf bucket, so both stay consistent while observations happen concurrently
+        os<<name<<"_count"<<suffix<<" "<<cumulative<<"\n";
+    }
+
+    static const char* taskTypeLabels[] = {"unknown", "transform", "resolve", "hashprobe", "filewrite"};
+
+    RuntimeMetrics& RuntimeMetrics::instance() {
+        static RuntimeMetrics metrics;
+        return metrics;
+    }
+
+    RuntimeMetrics::RuntimeMetrics() : _tasksQueued(0), _tasksRunning(0),
+                                       _compileTime({0.01, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0}),
+                                       _jobsCompleted(0),
+                                       _lastLogicalOptimizationTime(0.0), _lastLLVMOptimizationTime(0.0),
+                                       _lastLLVMCompilationTime(0.0), _lastTotalCompilationTime(0.0),
+                                       _lastSamplingTime(0.0) {
+        for(auto& c : _tasksCompleted)
+            c = 0;
+        for(auto& c : _exceptions)
+            c = 0;
+        for(unsigned i = 0; i < NUM_TASK_TYPES; ++i)
+            _taskLatency.emplace_back(new MetricsHistogram({0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 5.0, 10.0, 30.0, 60.0}));
+    }
+
+    size_t RuntimeMetrics::taskTypeIndex(TaskType type) {
+        switch(type) {
+            case TaskType::UDFTRAFOTASK:
+                return 1;
+            case TaskType::RESOLVE:
+                return 2;
+            case TaskType::HASHPROBE:
+                return 3;
+            case TaskType::SIMPLEFILEWRITE:
+                return 4;
+            default:
+                return 0;
+        }
+    }
+
+    void RuntimeMetrics::taskFinished(TaskType type, double seconds) {
+        auto idx = taskTypeIndex(type);
+        _tasksRunning.fetch_sub(1, std::memory_order_relaxed);
+        _tasksCompleted[idx].fetch_add(1, std::memory_order_relaxed);
+        _taskLatency[idx]->observe(seconds);
+    }
+
+    void RuntimeMetrics::stageCompiled(double seconds) {
+        _compileTime.observe(seconds);
+    }
+
+    void RuntimeMetrics::jobFinished(const JobMetrics &metrics) {
+        _jobsCompleted.fetch_add(1, std::memory_order_relaxed);
+        for(const auto& keyval : metrics.getExceptionCounts()) {
+            auto code = ecToI64(std::get<1>(keyval.first));
+            if(code >= 0 && code < static_cast<int64_t>(MAX_EXCEPTION_CODE))
+                _exceptions[code].fetch_add(keyval.second, std::memory_order_relaxed);
+        }
+        _lastLogicalOptimizationTime = metrics.getLogicalOptimizationTime();
+        _lastLLVMOptimizationTime = metrics.getLLVMOptimizationTime();
+        _lastLLVMCompilationTime = metrics.getLLVMCompilationTime();
+        _lastTotalCompilationTime = metrics.getTotalCompilationTime();
+        _lastSamplingTime = metrics.getSamplingTime();
+    }
+
+    void RuntimeMetrics::addGauge(const void *owner, const std::string &name, const std::string &help,
+                                  std::function<double()> func, const void *key) {
+        std::lock_guard<std::mutex> lock(_gaugeMutex);
+        _gauges.push_back(Gauge{owner, name, help, std::move(func), key});
+    }
+
+    void RuntimeMetrics::removeGauges(const void *owner) {
+        std::lock_guard<std::mutex> lock(_gaugeMutex);
+        _gauges.erase(std::remove_if(_gauges.begin(), _gauges.end(),
+                                     [owner](const Gauge& g) { return g.owner == owner; }), _gauges.end());
+    }
+
+    void RuntimeMetrics::addStageExceptionCounts(const void *owner, const ConcurrentExceptionCounts *counts) {
+        assert(counts);
+        std::lock_guard<std::mutex> lock(_gaugeMutex);
+        _stageExceptionCounts.emplace_back(owner, counts);
+    }
+
+    void RuntimeMetrics::removeStageExceptionCounts(const void *owner) {
+        std::lock_guard<std::mutex> lock(_gaugeMutex);
+        _stageExceptionCounts.erase(std::remove_if(_stageExceptionCounts.begin(), _stageExceptionCounts.end(),
+                                                   [owner](const std::pair<const void*, const ConcurrentExceptionCounts*>& p) {
+                                                       return p.first == owner;
+                                                   }), _stageExceptionCounts.end());
+    }
+
+    // writes HELP/TYPE lines for a metric family
+    static void writeHeader(std::ostream& os, const std::string& name, const std::string& help, const std::string& type) {
+        os<<"# HELP "<<name<<" "<<help<<"\n";
+        os<<"# TYPE "<<name<<" "<<type<<"\n";
+    }
+
+    std::string RuntimeMetrics::toPrometheusText() const {
+        std::stringstream ss;
+        ss.precision(15); // e.g. memory in bytes should not be rounded
+
+        writeHeader(ss, "tuplex_tasks_queued", "Tasks waiting in the work queues of the executors.", "gauge");
+        ss<<"tuplex_tasks_queued "<<std::max(_tasksQueued.load(std::memory_order_relaxed), (int64_t)0)<<"\n";
+        writeHeader(ss, "tuplex_tasks_running", "Tasks currently executed.", "gauge");
+        ss<<"tuplex_tasks_running "<<std::max(_tasksRunning.load(std::memory_order_relaxed), (int64_t)0)<<"\n";
+
+        writeHeader(ss, "tuplex_tasks_completed_total", "Tasks executed, by task type.", "counter");
+        for(unsigned i = 0; i < NUM_TASK_TYPES; ++i)
+            ss<<"tuplex_tasks_completed_total{type=\""<<taskTypeLabels[i]<<"\"} "
+              <<_tasksCompleted[i].load(std::memory_order_relaxed)<<"\n";
+
+        writeHeader(ss, "tuplex_task_duration_seconds", "Wall time of executing a task, by task type.", "histogram");
+        for(unsigned i = 0; i < NUM_TASK_TYPES; ++i)
+            _taskLatency[i]->write(ss, "tuplex_task_duration_seconds", std::string("type=\"") + taskTypeLabels[i] + "\"");
+
+        writeHeader(ss, "tuplex_stage_compile_seconds", "Time to compile a stage to native code.", "histogram");
+        _compileTime.write(ss, "tuplex_stage_compile_seconds");
+
+        writeHeader(ss, "tuplex_jobs_completed_total", "Jobs executed.", "counter");
+        ss<<"tuplex_jobs_completed_total "<<_jobsCompleted.load(std::memory_order_relaxed)<<"\n";
+
+        writeHeader(ss, "tuplex_exceptions_total", "Rows which raised an exception in finished jobs, by exception class.", "counter");
+        for(unsigned i = 0; i < MAX_EXCEPTION_CODE; ++i) {
+            auto count = _exceptions[i].load(std::memory_order_relaxed);
+            if(count > 0)
+                ss<<"tuplex_exceptions_total{exception=\""<<exceptionCodeToPythonClass(i64ToEC(i))<<"\"} "<<count<<"\n";
+        }
+
+        // counted by the tasks of stages still running, i.e. not part of tuplex_exceptions_total yet
+        std::map<std::string, size_t> stageExceptions;
+        {
+            std::lock_guard<std::mutex> lock(_gaugeMutex);
+            for(const auto& entry : _stageExceptionCounts)
+                for(const auto& keyval : entry.second->snapshot())
+                    stageExceptions[exceptionCodeToPythonClass(std::get<1>(keyval.first))] += keyval.second;
+        }
+        writeHeader(ss, "tuplex_running_stage_exceptions", "Rows which raised an exception in stages currently executed, by exception class.", "gauge");
+        for(const auto& keyval : stageExceptions)
+            ss<<"tuplex_running_stage_exceptions{exception=\""<<keyval.first<<"\"} "<<keyval.second<<"\n";
+
+        std::vector<std::tuple<std::string, std::string, double>> jobTimes{
+                std::make_tuple("tuplex_last_job_logical_optimization_seconds", "Logical optimization time of the last finished job.", _lastLogicalOptimizationTime.load()),
+                std::make_tuple("tuplex_last_job_llvm_optimization_seconds", "LLVM optimization time of the last finished job.", _lastLLVMOptimizationTime.load()),
+                std::make_tuple("tuplex_last_job_llvm_compilation_seconds", "LLVM compilation time of the last finished job.", _lastLLVMCompilationTime.load()),
+                std::make_tuple("tuplex_last_job_total_compilation_seconds", "Total compilation time of the last finished job.", _lastTotalCompilationTime.load()),
+                std::make_tuple("tuplex_last_job_sampling_seconds", "Sampling time of the last finished job.", _lastSamplingTime.load())};
+        for(const auto& t : jobTimes) {
+            writeHeader(ss, std::get<0>(t), std::get<1>(t), "gauge");
+            ss<<std::get<0>(t)<<" "<<std::get<2>(t)<<"\n";
+        }
+
+        // gauges computed on demand, summed up by name
+        std::map<std::string, std::pair<std::string, double>> gauges;
+        {
+            std::lock_guard<std::mutex> lock(_gaugeMutex);
+            std::set<std::pair<std::string, const void*>> counted;
+            for(const auto& g : _gauges) {
+                if(g.key && !counted.emplace(g.name, g.key).second)
+                    continue;
+                auto& entry = gauges[g.name];
+                entry.first = g.help;
+                entry.second += g.func();
+            }
+        }
+        for(const auto& keyval : gauges) {
+            writeHeader(ss, keyval.first, keyval.second.first, "gauge");
+            ss<<keyval.first<<" "<<keyval.second.second<<"\n";
+        }
+
+        return ss.str();
+    }
+}
@@ -15,6 +15,7 @@
 #include <graphviz/GraphVizGraph.h>
 #include <IPrePostVisitor.h>
 #include <unordered_map>
+#include <mutex>
 #include <IReplaceVisitor.h>
 #include <ColumnRewriteVisitor.h>
 #include <TraceVisitor.h>
@@ -28,6 +29,18 @@ namespace tuplex {
 
     bool UDF::_compilationEnabled = true;
     bool UDF::_allowNumericTypeUnification = true;
+    bool UDF::_memoizationEnabled = true;
+
+    // typed ASTs of previous hintInputSchema calls, shared across all UDFs
+    struct TypedUDF {
+        codegen::AnnotatedAST ast;
+        Schema inputSchema;
+        Schema outputSchema;
+        bool compilable;
+    };
+    static const size_t MAX_TYPING_MEMO_ENTRIES = 4096;
+    static std::mutex g_typingMemoMutex;
+    static std::unordered_map<std::string, TypedUDF> g_typingMemo;
 
     UDF::UDF(const std::string &pythonLambdaStr,
              const std::string& pickledCode,
@@ -279,6 +292,51 @@ namespace tuplex {
     }
 
     bool UDF::hintInputSchema(const Schema &schema, bool removeBranches, bool printErrors) {
+        if(!_memoizationEnabled || !isCompiled())
+            return hintInputSchemaWithoutMemo(schema, removeBranches, printErrors);
+
+        // same AST (incl. types from earlier hints) hinted with the same schema yields the same typed AST
+        auto key = _ast.memoKey(true);
+        if(key.empty())
+            return hintInputSchemaWithoutMemo(schema, removeBranches, printErrors);
+        key = std::to_string(schema.getRowType().hash()) + (removeBranches ? "|rb|" : "|") + key;
+
+        {
+            std::lock_guard<std::mutex> lock(g_typingMemoMutex);
+            auto it = g_typingMemo.find(key);
+            if(it != g_typingMemo.end()) {
+                _ast = it->second.ast;
+                _hintedInputSchema = schema;
+                _inputSchema = it->second.inputSchema;
+                _outputSchema = it->second.outputSchema;
+                if(!it->second.compilable)
+                    markAsNonCompilable();
+                return true;
+            }
+        }
+
+        // failures are not memoized, they get logged on each attempt
+        if(!hintInputSchemaWithoutMemo(schema, removeBranches, printErrors))
+            return false;
+
+        std::lock_guard<std::mutex> lock(g_typingMemoMutex);
+        if(g_typingMemo.size() >= MAX_TYPING_MEMO_ENTRIES)
+            g_typingMemo.clear();
+        g_typingMemo[key] = TypedUDF{_ast, _inputSchema, _outputSchema, isCompiled()};
+        return true;
+    }
+
+    void UDF::clearMemo() {
+        std::lock_guard<std::mutex> lock(g_typingMemoMutex);
+        g_typingMemo.clear();
+    }
+
+    size_t UDF::memoSize() {
+        std::lock_guard<std::mutex> lock(g_typingMemoMutex);
+        return g_typingMemo.size();
+    }
+
+    bool UDF::hintInputSchemaWithoutMemo(const Schema &schema, bool removeBranches, bool printErrors) {
 
         _hintedInputSchema = schema;
         _inputSchema = Schema::UNKNOWN;
@@ -555,6 +613,18 @@ namespace tuplex {
             return cf;
         }
 
+        // same typed AST already generated into this module? then reuse the function
+        std::string memoKey = _memoizationEnabled ? cg.memoKey(true) : "";
+        if(!memoKey.empty()) {
+            memoKey = std::to_string(cf.input_type.hash()) + ":" + std::to_string(cf.output_type.hash())
+                      + (allowUndefinedBehaviour ? "|ub" : "|") + (sharedObjectPropagation ? "|sop|" : "||") + memoKey;
+            auto func = env.getCachedUDFFunction(memoKey);
+            if(func) {
+                cf.function = func;
+                return cf;
+            }
+        }
+
         // compile UDF to LLVM IR Code
         if(!cg.generateCode(&env, allowUndefinedBehaviour, sharedObjectPropagation)) {
             // log error and abort processing.
@@ -571,6 +641,8 @@ namespace tuplex {
             return cf;
         }
         cf.function = func;
+        if(!memoKey.empty())
+            env.cacheUDFFunction(memoKey, func);
 
         return cf;
     }
@@ -1202,6 +1274,153 @@ namespace tuplex {
 #endif
     }
 
+    // constant of the given type to replace an unused expression with, nullptr if there is none
+    static ASTNode* constantOfType(const python::Type& type) {
+        if(type == python::Type::I64)
+            return new NNumber(static_cast<int64_t>(0));
+        if(type == python::Type::F64)
+            return new NNumber(0.0);
+        if(type == python::Type::BOOLEAN)
+            return new NBoolean(false);
+        if(type == python::Type::STRING)
+            return new NString("''");
+        if(type == python::Type::NULLVALUE)
+            return new NNone();
+        return nullptr;
+    }
+
+    // primitive, non-optional values, i.e. operators on them do not raise a TypeError
+    static bool isPlainPrimitive(ASTNode* node) {
+        auto type = node->getInferredType();
+        return type == python::Type::I64 || type == python::Type::F64 ||
+               type == python::Type::BOOLEAN || type == python::Type::STRING;
+    }
+
+    // conservative check whether evaluating an expression may raise an exception, i.e. everything not known to be
+    // safe may raise (divisions, lookups, calls, operations on optional values, ...)
+    static bool expressionMayRaise(ASTNode* node) {
+        if(!node)
+            return true;
+        switch(node->type()) {
+            case ASTNodeType::Number:
+            case ASTNodeType::Boolean:
+            case ASTNodeType::String:
+            case ASTNodeType::None:
+            case ASTNodeType::Identifier:
+                return false;
+            case ASTNodeType::Tuple: {
+                for(auto el : dynamic_cast<NTuple*>(node)->_elements)
+                    if(expressionMayRaise(el))
+                        return true;
+                return false;
+            }
+            case ASTNodeType::Subscription: {
+                // row access, i.e. x['a'] or x[0] with a constant key
+                auto sub = dynamic_cast<NSubscription*>(node);
+                return !sub->_value || sub->_value->type() != ASTNodeType::Identifier ||
+                       !sub->_value->getInferredType().isTupleType() || !sub->_expression ||
+                       (sub->_expression->type() != ASTNodeType::Number &&
+                        sub->_expression->type() != ASTNodeType::String);
+            }
+            case ASTNodeType::UnaryOp: {
+                auto op = dynamic_cast<NUnaryOp*>(node);
+                if(op->_op != TokenType::NOT && !isPlainPrimitive(op->_operand))
+                    return true;
+                return expressionMayRaise(op->_operand);
+            }
+            case ASTNodeType::BinaryOp: {
+                auto op = dynamic_cast<NBinaryOp*>(node);
+                switch(op->_op) {
+                    case TokenType::PLUS:
+                    case TokenType::MINUS:
+                    case TokenType::STAR:
+                    case TokenType::AMPER:
+                    case TokenType::VBAR:
+                    case TokenType::CIRCUMFLEX:
+                    case TokenType::AND:
+                    case TokenType::OR:
+                        break;
+                    default:
+                        return true; // division by zero, negative shifts or exponents, ...
+                }
+                return !isPlainPrimitive(op->_left) || !isPlainPrimitive(op->_right) ||
+                       expressionMayRaise(op->_left) || expressionMayRaise(op->_right);
+            }
+            case ASTNodeType::Compare: {
+                auto cmp = dynamic_cast<NCompare*>(node);
+                if(cmp->_comps.empty())
+                    return expressionMayRaise(cmp->_left);
+                if(!isPlainPrimitive(cmp->_left) || expressionMayRaise(cmp->_left))
+                    return true;
+                for(auto comp : cmp->_comps)
+                    if(!isPlainPrimitive(comp) || expressionMayRaise(comp))
+                        return true;
+                return false;
+            }
+            case ASTNodeType::IfElse: {
+                auto ie = dynamic_cast<NIfElse*>(node);
+                return expressionMayRaise(ie->_expression) || expressionMayRaise(ie->_then) || expressionMayRaise(ie->_else);
+            }
+            default:
+                return true;
+        }
+    }
+
+    bool UDF::mayRaise() const {
+        if(!isCompiled() || empty())
+            return !empty();
+        auto root = getAnnotatedAST().getFunctionAST();
+        if(!root || root->type() != ASTNodeType::Lambda)
+            return true;
+        return expressionMayRaise(dynamic_cast<NLambda*>(root)->_expression);
+    }
+
+    bool UDF::replaceUnusedOutputsWithConstants(const std::vector<bool> &used) {
+        if(!isCompiled() || empty())
+            return false;
+
+        auto root = getAnnotatedAST().getFunctionAST();
+        if(!root || root->type() != ASTNodeType::Lambda)
+            return false; // multiple returns in def functions are not rewritten
+        auto lam = dynamic_cast<NLambda*>(root); assert(lam);
+
+        bool rewritten = false;
+        auto replace = [&rewritten](ASTNode*& node) {
+            switch(node->type()) {
+                case ASTNodeType::Number:
+                case ASTNodeType::Boolean:
+                case ASTNodeType::String:
+                case ASTNodeType::None:
+                    return; // constant already
+                default:
+                    break;
+            }
+            // exceptions of the original expression have to be kept, the row would be dropped otherwise
+            if(expressionMayRaise(node))
+                return;
+            auto constant = constantOfType(node->getInferredType());
+            if(!constant)
+                return;
+            delete node;
+            node = constant;
+            rewritten = true;
+        };
+
+        if(lam->_expression->type() == ASTNodeType::Tuple) {
+            auto tuple = dynamic_cast<NTuple*>(lam->_expression); assert(tuple);
+            if(used.size() != tuple->_elements.size())
+                return false;
+            for(unsigned i = 0; i < used.size(); ++i)
+                if(!used[i])
+                    replace(tuple->_elements[i]);
+        } else if(used.size() == 1 && !used.front())
+            replace(lam->_expression);
+
+        if(rewritten)
+            getAnnotatedAST().defineTypes(true);
+        return rewritten;
+    }
+
     bool UDF::rewriteDictAccessInAST(const std::vector<std::string> &columnNames, const std::string& parameterName) {
 
         // UDF compiled? if not, nothing to be done
@@ -12,4 +12,9 @@
 
 namespace tuplex {
     // @TODO: add here common backend functions when multiple backends are supported...
+
+    void IBackend::executeStages(const std::vector<PhysicalStage*>& stages, const Context& context) {
+        for(auto stage : stages)
+            stage->execute(context);
+    }
 }
\ No newline at end of file
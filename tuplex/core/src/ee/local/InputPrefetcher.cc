@@ -0,0 +1,166 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <ee/local/InputPrefetcher.h>
+#include <PrefetchedFile.h>
+#include <VirtualFileSystem.h>
+#include <Logger.h>
+#include <Timer.h>
+#include <cassert>
+
+namespace tuplex {
+
+    InputPrefetcher::InputPrefetcher(size_t numThreads, size_t memoryBudget) : _numThreads(std::max(numThreads, (size_t)1)),
+    _memoryBudget(memoryBudget), _state(std::make_shared<SharedState>()), _next(0), _done(false), _hits(0), _misses(0), _bytesLoaded(0), _stallTime(0) {
+    }
+
+    InputPrefetcher::~InputPrefetcher() {
+        {
+            std::lock_guard<std::mutex> lock(_state->mutex);
+            _done = true;
+        }
+        _state->cv.notify_all();
+        for(auto& t : _threads)
+            t.join();
+        _threads.clear();
+    }
+
+    size_t InputPrefetcher::add(const URI &uri, size_t fileSize, size_t offset, size_t length) {
+        assert(_threads.empty());
+        offset = std::min(offset, fileSize);
+        length = std::min(length, fileSize - offset);
+        _ranges.push_back(Range{uri, fileSize, offset, length, 0, State::PENDING, nullptr});
+        return _ranges.size() - 1;
+    }
+
+    void InputPrefetcher::start() {
+        assert(_threads.empty());
+        for(unsigned i = 0; i < std::min(_numThreads, _ranges.size()); ++i)
+            _threads.emplace_back(&InputPrefetcher::worker, this);
+    }
+
+    void InputPrefetcher::worker() {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        while(!_done) {
+            // ranges are loaded in order, skip the ones tasks already claimed
+            while(_next < _ranges.size() && _ranges[_next].state != State::PENDING)
+                _next++;
+            if(_next >= _ranges.size())
+                break;
+
+            // ranges larger than the whole budget are left to the task
+            auto& range = _ranges[_next];
+            if(range.length > _memoryBudget) {
+                _next++;
+                continue;
+            }
+
+            // backpressure, wait till tasks released enough memory (or claimed this range)
+            if(_state->memoryUsed + range.length > _memoryBudget) {
+                _state->cv.wait(lock);
+                continue;
+            }
+
+            range.state = State::LOADING;
+            _state->memoryUsed += range.length;
+            _next++;
+
+            lock.unlock();
+            bool ok = load(range);
+            lock.lock();
+
+            if(ok) {
+                range.state = State::LOADED;
+            } else {
+                range.state = State::FAILED;
+                range.data.reset();
+                _state->memoryUsed -= range.length;
+            }
+            _state->cv.notify_all();
+        }
+    }
+
+    bool InputPrefetcher::load(Range &range) {
+        try {
+            auto file = VirtualFileSystem::open_file(range.uri, VirtualFileMode::VFS_READ);
+            if(!file)
+                return false;
+            if(range.offset > 0 && file->seek(range.offset) != VirtualFileSystemStatus::VFS_OK)
+                return false;
+
+            range.data.reset(new uint8_t[std::max(range.length, (size_t)1)], std::default_delete<uint8_t[]>());
+            size_t pos = 0;
+            while(pos < range.length) {
+                size_t bytesRead = 0;
+                if(file->read(range.data.get() + pos, range.length - pos, &bytesRead) != VirtualFileSystemStatus::VFS_OK)
+                    return false;
+                if(0 == bytesRead) // file shorter than expected, serve what is there
+                    break;
+                pos += bytesRead;
+            }
+            range.bytesLoaded = pos;
+            _bytesLoaded += pos;
+            return true;
+        } catch(const std::exception& e) {
+            Logger::instance().logger("local ee").warn("prefetching " + range.uri.toPath() + " failed: " + e.what());
+            return false;
+        }
+    }
+
+    void InputPrefetcher::SharedState::release(size_t numBytes) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            assert(memoryUsed >= numBytes);
+            memoryUsed -= numBytes;
+        }
+        cv.notify_all();
+    }
+
+    std::unique_ptr<VirtualFile> InputPrefetcher::acquire(size_t id) {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        assert(id < _ranges.size());
+        auto& range = _ranges[id];
+
+        // IO threads are behind, do not wait for them
+        if(range.state == State::PENDING) {
+            range.state = State::ACQUIRED;
+            _misses++;
+            lock.unlock();
+            _state->cv.notify_all(); // pending range might be the one an IO thread waits on
+            return nullptr;
+        }
+
+        if(range.state == State::LOADING) {
+            Timer timer;
+            _state->cv.wait(lock, [&range]() { return range.state != State::LOADING; });
+            _stallTime += static_cast<size_t>(timer.time() * 1000000.0);
+        }
+
+        if(range.state != State::LOADED) {
+            range.state = State::ACQUIRED;
+            _misses++;
+            return nullptr;
+        }
+
+        range.state = State::ACQUIRED;
+        _hits++;
+
+        // memory is accounted till the file releases the buffer
+        auto length = range.length;
+        auto buffer = range.data;
+        auto state = _state;
+        range.data.reset();
+        std::shared_ptr<const uint8_t> data(buffer.get(), [state, buffer, length](const uint8_t*) mutable {
+            buffer.reset();
+            state->release(length);
+        });
+        return std::unique_ptr<VirtualFile>(new PrefetchedFile(range.uri, range.fileSize, data, range.offset, range.bytesLoaded));
+    }
+}
@@ -14,8 +14,13 @@
 #include <physical/ResolveTask.h>
 #include <physical/TransformTask.h>
 #include <physical/SimpleFileWriteTask.h>
+#include <physical/CSVSplitter.h>
 
 #include <memory>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <Signals.h>
 
 #include <ee/IBackend.h>
 #include <physical/PhysicalPlan.h>
@@ -30,7 +35,39 @@
 
 namespace tuplex {
 
-    LocalBackend::LocalBackend(const tuplex::ContextOptions &options) : _compiler(nullptr), _options(options) {
+    // true for threads spawned to execute a stage concurrently, these can't work on tasks with the driver
+    static thread_local bool t_stageThread = false;
+    // lock held by the stage executing on this thread (only when stages run concurrently)
+    static thread_local std::unique_lock<std::mutex>* t_stageLock = nullptr;
+    // weight of jobs started on this thread (only used with tuplex.scheduler.multiJob)
+    static thread_local double t_jobWeight = 1.0;
+    // true if the job of this thread was started by prepareStages, i.e. ends with finishStages
+    static thread_local bool t_jobOwner = false;
+
+    // registers the stage lock of the calling thread for the duration of a scope
+    struct StageLockScope {
+        std::unique_lock<std::mutex>* prev;
+        explicit StageLockScope(std::unique_lock<std::mutex>* lock) : prev(t_stageLock) { t_stageLock = lock; }
+        ~StageLockScope() { t_stageLock = prev; }
+    };
+
+    // allows other stages to proceed while the calling thread waits for its tasks (see performTasks)
+    struct StageLockRelease {
+        bool released;
+        explicit StageLockRelease(bool release) : released(release && t_stageLock && t_stageLock->owns_lock()) {
+            if(released)
+                t_stageLock->unlock();
+        }
+        ~StageLockRelease() {
+            if(released)
+                t_stageLock->lock();
+        }
+    };
+
+    LocalBackend::LocalBackend(const tuplex::ContextOptions &options) : _compiler(nullptr), _options(options),
+                                                                        _numConcurrentStageGroups(0), _rebalanceRound(0),
+                                                                        _nextJobID(0), _numJobDriversCreated(0), _nextCompileJob(0),
+                                                                        _compileCancelled(false) {
 
         // initialize driver
         auto& logger = this->logger();
@@ -64,14 +101,50 @@ namespace tuplex {
 
         // init local threads
         initExecutors(options);
+
+        if(options.METRICS_ENDPOINT())
+            startMetricsEndpoint(options.METRICS_PORT());
     }
 
     LocalBackend::~LocalBackend() {
+        // stop serving first, gauges read the executors
+        _metricsServer.reset();
+        RuntimeMetrics::instance().removeGauges(this);
+        cancelCompileJobs();
         freeExecutors();
     }
 
+    void LocalBackend::startMetricsEndpoint(uint16_t port) {
+        // executors (and the driver) of the local engine are shared by contexts, hence gauges are keyed by executor
+        // and counted once even when several contexts serve metrics
+        auto& metrics = RuntimeMetrics::instance();
+        for(auto exec : _executors) {
+            metrics.addGauge(this, "tuplex_executor_memory_used_bytes", "Bytes of executor memory held by partitions.",
+                             [exec]() { return static_cast<double>(exec->usedMemory()); }, exec);
+            metrics.addGauge(this, "tuplex_executor_memory_bytes", "Executor memory available for partitions.",
+                             [exec]() { return static_cast<double>(exec->memorySize()); }, exec);
+            metrics.addGauge(this, "tuplex_executors", "Number of executor threads.", []() { return 1.0; }, exec);
+        }
+        auto driver = _driver;
+        metrics.addGauge(this, "tuplex_driver_memory_used_bytes", "Bytes of driver memory held by partitions.",
+                         [driver]() { return static_cast<double>(driver->usedMemory()); }, driver);
+
+        // the port may be taken, e.g. by another context. That's not worth failing for.
+        try {
+            _metricsServer = std::make_unique<MetricsServer>(port);
+            logger().info("serving metrics on http://127.0.0.1:" + std::to_string(_metricsServer->port()) + "/metrics");
+        } catch(const std::exception& e) {
+            logger().warn(std::string("metrics endpoint disabled: ") + e.what());
+        }
+    }
+
     void LocalBackend::initExecutors(const ContextOptions& options) {
 
+        ArenaPolicy arenaPolicy;
+        arenaPolicy.hugePages = options.EXECUTOR_HUGE_PAGES();
+        arenaPolicy.prefault = options.EXECUTOR_PREFAULT();
+        arenaPolicy.pinThreads = options.EXECUTOR_PIN_THREADS();
+
         // fetch executors from local engine.
         // @TODO: use condition variable to put executors on sleep
         _executors = LocalEngine::instance().getExecutors(options.EXECUTOR_COUNT(),
@@ -79,7 +152,10 @@ namespace tuplex {
                                                           options.PARTITION_SIZE(),
                                                           options.RUNTIME_MEMORY(),
                                                           options.RUNTIME_MEMORY_DEFAULT_BLOCK_SIZE(),
-                                                          options.SCRATCH_DIR());
+                                                          options.SCRATCH_DIR(),
+                                                          arenaPolicy);
+        for(auto exec : _executors)
+            exec->setJobMemoryQuota(options.JOB_MEMORY_QUOTA());
 
         _driver = LocalEngine::instance().getDriver(options.DRIVER_MEMORY(),
                                                     options.PARTITION_SIZE(),
@@ -98,11 +174,64 @@ namespace tuplex {
 
     Executor *LocalBackend::driver() {
       assert(_driver);
+
+      // with tuplex.scheduler.multiJob, jobs run on several threads at once. An executor's partitions and runtime
+      // memory are bound to the thread which created it, hence each job thread gets a driver of its own.
+      if(_options.MULTI_JOB() && !t_stageThread && std::this_thread::get_id() != _driver->getThreadID()) {
+          std::lock_guard<std::mutex> lock(_jobDriversMutex);
+          auto& jobDriver = _jobDrivers[std::this_thread::get_id()];
+          if(!jobDriver)
+              jobDriver.reset(new Executor(_options.DRIVER_MEMORY(), _options.PARTITION_SIZE(), _options.RUNTIME_MEMORY(),
+                                           _options.RUNTIME_MEMORY_DEFAULT_BLOCK_SIZE(),
+                                           URI(_options.SCRATCH_DIR().toString() + "/driver_" + std::to_string(++_numJobDriversCreated)),
+                                           "job driver"));
+          return jobDriver.get();
+      }
       return _driver;
     }
 
+    void LocalBackend::releaseJobDriver() {
+        std::lock_guard<std::mutex> lock(_jobDriversMutex);
+        auto it = _jobDrivers.find(std::this_thread::get_id());
+        if(it != _jobDrivers.end()) {
+            _retiredJobDrivers.push_back(std::move(it->second));
+            _jobDrivers.erase(it);
+        }
+
+        _retiredJobDrivers.erase(std::remove_if(_retiredJobDrivers.begin(), _retiredJobDrivers.end(),
+                                                [](const std::unique_ptr<Executor>& exec) {
+                                                    return 0 == exec->numPartitions();
+                                                }), _retiredJobDrivers.end());
+    }
+
+    size_t LocalBackend::numJobDrivers() {
+        std::lock_guard<std::mutex> lock(_jobDriversMutex);
+        return _jobDrivers.size() + _retiredJobDrivers.size();
+    }
+
+    size_t LocalBackend::numQuotaEvictions() const {
+        size_t num = 0;
+        for(auto exec : _executors)
+            num += exec->numQuotaEvictions();
+        return num;
+    }
+
+    // steady clock time in s, used to record when stages ran
+    static double steadyTime() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
     void LocalBackend::execute(tuplex::PhysicalStage *stage) {
         assert(stage);
+        auto startTime = steadyTime();
+
+        // stages running concurrently (possibly of different jobs) share compiler, interpreter and history server,
+        // hence only one at a time may execute apart from working on its tasks
+        bool concurrent = sharedExecutors();
+        std::unique_lock<std::mutex> stageLock(_stageMutex, std::defer_lock);
+        if(concurrent)
+            stageLock.lock();
+        StageLockScope lockScope(&stageLock);
 
         // reset history server
         _historyServer.reset();
@@ -111,7 +240,8 @@ namespace tuplex {
             return;
 
         // history server connection should be established
-        bool useWebUI = _options.USE_WEBUI();
+        // note: executors can't report to multiple jobs at once, therefore concurrent stages are not tracked
+        bool useWebUI = _options.USE_WEBUI() && !concurrent;
         // register new job
         if(useWebUI) {
             _historyServer = HistoryServerConnector::registerNewJob(_historyConn,
@@ -139,6 +269,9 @@ namespace tuplex {
         } else
             throw std::runtime_error("unknown stage encountered in local backend!");
 
+        // concurrently executing stages hold the stage lock here, i.e. don't race on the metrics
+        stage->plan()->getContext().metrics().setStageTimes(stage->number(), startTime, steadyTime());
+
         // detach from driver
         _driver->setHistoryServer(nullptr);
 
@@ -454,11 +587,9 @@ namespace tuplex {
         assert(tstage);
 
         size_t readBufferSize = options.READ_BUFFER_SIZE();
-        bool normalCaseEnabled = options.OPT_NULLVALUE_OPTIMIZATION(); // this is important so exceptions get upgraded to internal ones
 
         // use normal case schemas here
         auto inputSchema = tstage->normalCaseInputSchema();
-        auto inputRowType = inputSchema.getRowType();
         auto outputSchema = tstage->normalCaseOutputSchema();
 
         // check what type of input the pipeline has (memory or files)
@@ -473,24 +604,9 @@ namespace tuplex {
             // => for now simply one task per file
             auto fileSchema = Schema(Schema::MemoryLayout::ROW, python::Type::makeTupleType({python::Type::STRING, python::Type::I64}));
 
-            std::vector<std::string> header;
-            // fetch from first FileInputOperator number of input columns (BEFORE optimization/projection pushdown!)
-            size_t numColumns = tstage->csvNumFileInputColumns();
-
-
-            // CSV, set header
-            if(tstage->csvHasHeader()) {
-                // because of projection pushdown, need to decode from input params!
-                header = tstage->csvHeader();
-            }
-
-
-            // other CSV params
-            char delimiter = tstage->csvInputDelimiter();
+            // used for exact splits, other CSV params are set by createFileInputTask
             char quotechar = tstage->csvInputQuotechar();
 
-            vector<bool>  colsToKeep = tstage->columnsToKeep(); // after projection pushdown, what to keep
-
             for(auto partition : tstage->inputPartitions()) {
                 // get num
                 auto numFiles = partition->getNumRows();
@@ -506,101 +622,46 @@ namespace tuplex {
                     // split files if splitsize != 0
                     if(options.INPUT_SPLIT_SIZE() == 0) {
                         // one task per URI
-                        auto task = new TransformTask();
-                        task->setFunctor(functor);
-                        task->setInputFileSource(uri, normalCaseEnabled, tstage->fileInputOperatorID(), inputRowType, header,
-                                                 !options.OPT_GENERATE_PARSER(),
-                                                 numColumns, 0, 0, delimiter, quotechar, colsToKeep, tstage->inputFormat());
-                        // hash table or memory output?
-                        if(tstage->outputMode() == EndPointMode::HASHTABLE) {
-                            if (tstage->hashtableKeyByteWidth() == 8)
-                                task->sinkOutputToHashTable(HashTableFormat::UINT64,
-                                                            tstage->outputDataSetID());
-                            else
-                                task->sinkOutputToHashTable(HashTableFormat::BYTES,
-                                                            tstage->outputDataSetID());
-                        }
-                        else {
-                            assert(tstage->outputMode() == EndPointMode::FILE ||
-                            tstage->outputMode() == EndPointMode::MEMORY);
-                            task->sinkOutputToMemory(outputSchema, tstage->outputDataSetID());
-                        }
-
-                        task->sinkExceptionsToMemory(inputSchema);
-                        task->setStageID(tstage->getID());
-                        // add to tasks
-                        tasks.emplace_back(std::move(task));
+                        tasks.emplace_back(createFileInputTask(tstage, options, functor, uri, 0, 0, false));
                     } else {
                         // split files according to split size
                         size_t s = 0;
                         size_t splitSize = options.INPUT_SPLIT_SIZE();
                         int num_parts = 0;
 
+                        // probing a skewed build side multiplies the rows of a split, shrink splits accordingly
+                        if(tstage->probeFanout() > 1.0)
+                            splitSize = std::min(splitSize, std::max(static_cast<size_t>(splitSize / tstage->probeFanout()),
+                                                                     (size_t)(64 * 1024)));
+
                         // two options: 1.) file is larger than split size => split 2.) one task for fiel_size <= split size
                         if(file_size <= splitSize) {
                             // 1 task (range 0,0 to indicate full file)
-                            auto task = new TransformTask();
-                            task->setFunctor(functor);
-                            task->setInputFileSource(uri, normalCaseEnabled, tstage->fileInputOperatorID(), inputRowType, header,
-                                                     !options.OPT_GENERATE_PARSER(),
-                                                     numColumns, 0, 0, delimiter,
-                                                     quotechar, colsToKeep, tstage->inputFormat());
-                            // hash table or memory output?
-                            if(tstage->outputMode() == EndPointMode::HASHTABLE) {
-                                if (tstage->hashtableKeyByteWidth() == 8)
-                                    task->sinkOutputToHashTable(HashTableFormat::UINT64,
-                                                                tstage->outputDataSetID());
-                                else
-                                    task->sinkOutputToHashTable(HashTableFormat::BYTES,
-                                                                tstage->outputDataSetID());
-                            }
-                            else {
-                                assert(tstage->outputMode() == EndPointMode::FILE ||
-                                       tstage->outputMode() == EndPointMode::MEMORY);
-                                task->sinkOutputToMemory(outputSchema, tstage->outputDataSetID());
-                            }
-                            task->sinkExceptionsToMemory(inputSchema);
-                            task->setStageID(tstage->getID());
-                            // add to tasks
-                            tasks.emplace_back(std::move(task));
+                            tasks.emplace_back(createFileInputTask(tstage, options, functor, uri, 0, 0, false));
                             num_parts++;
                         } else {
                             // split into multiple tasks
-                            while(s + splitSize <= file_size) {
-
-                                auto rangeStart = s;
-                                auto rangeEnd = std::min(s + splitSize, file_size);
-
-                                // last task should go to file end, i.e. modify accordingly
-                                if(file_size - rangeEnd < splitSize)
-                                    rangeEnd = file_size;
-
-                                auto task = new TransformTask();
-                                task->setFunctor(functor);
-                                task->setInputFileSource(uri, normalCaseEnabled, tstage->fileInputOperatorID(), inputRowType, header,
-                                                         !options.OPT_GENERATE_PARSER(),
-                                                         numColumns, rangeStart, rangeEnd - rangeStart, delimiter,
-                                                         quotechar, colsToKeep, tstage->inputFormat());
-                                // hash table or memory output?
-                                if(tstage->outputMode() == EndPointMode::HASHTABLE) {
-                                    if (tstage->hashtableKeyByteWidth() == 8)
-                                        task->sinkOutputToHashTable(HashTableFormat::UINT64,
-                                                                    tstage->outputDataSetID());
-                                    else
-                                        task->sinkOutputToHashTable(HashTableFormat::BYTES,
-                                                                    tstage->outputDataSetID());
-                                }
-                                else {
-                                    assert(tstage->outputMode() == EndPointMode::FILE ||
-                                           tstage->outputMode() == EndPointMode::MEMORY);
-                                    task->sinkOutputToMemory(outputSchema, tstage->outputDataSetID());
-                                }
-                                task->sinkExceptionsToMemory(inputSchema);
-                                task->setStageID(tstage->getID());
-                                // add to tasks
-                                tasks.emplace_back(std::move(task));
-
-                                s += splitSize;
+                            // either at exact row starts derived from the quote parity of the file, or at fixed
+                            // offsets with the readers inferring the row start (fails for multi-line fields)
+                            bool exactSplits = options.CSV_EXACT_SPLITS() && tstage->inputFormat() == FileFormat::OUTFMT_CSV;
+                            vector<size_t> splitStarts;
+                            if(exactSplits) {
+                                Timer timer;
+                                splitStarts = csvSplitOffsets(uri, file_size, splitSize, quotechar, options.EXECUTOR_COUNT() + 1);
+                                logger().info("found " + pluralize(splitStarts.size(), "exact split") + " for " + uri.toPath() + " in " + std::to_string(timer.time()) + "s");
+                            } else {
+                                // last task should go to file end
+                                for(; s + splitSize <= file_size; s += splitSize)
+                                    splitStarts.push_back(s);
+                            }
+
+                            for(int i = 0; i < splitStarts.size(); ++i) {
+
+                                auto rangeStart = splitStarts[i];
+                                auto rangeEnd = i + 1 < splitStarts.size() ? splitStarts[i + 1] : file_size;
+
+                                tasks.emplace_back(createFileInputTask(tstage, options, functor, uri, rangeStart,
+                                                                       rangeEnd - rangeStart, exactSplits));
                                 num_parts++;
                             }
                         }
@@ -640,6 +701,7 @@ namespace tuplex {
                     else
                         task->sinkOutputToHashTable(HashTableFormat::BYTES,
                                                     tstage->outputDataSetID());
+                    task->setHotKeys(tstage->hotKeys());
                 }
                 else {
                     assert(tstage->outputMode() == EndPointMode::FILE ||
@@ -647,6 +709,7 @@ namespace tuplex {
                     task->sinkOutputToMemory(outputSchema, tstage->outputDataSetID());
                 }
                 task->sinkExceptionsToMemory(inputSchema);
+                task->setExceptionCounting(tstage->exceptionCountIndex(), tstage->liveExceptionCounts());
                 task->setStageID(tstage->getID());
                 tasks.emplace_back(std::move(task));
                 numInputRows += partition->getNumRows();
@@ -660,6 +723,229 @@ namespace tuplex {
         return tasks;
     }
 
+    TransformTask* LocalBackend::createFileInputTask(TransformStage *tstage, const ContextOptions &options,
+                                                     codegen::read_block_f functor, const URI &uri, size_t rangeStart,
+                                                     size_t rangeSize, bool exactSplits) {
+        // use normal case schemas here
+        auto inputSchema = tstage->normalCaseInputSchema();
+        auto outputSchema = tstage->normalCaseOutputSchema();
+
+        // CSV, set header
+        std::vector<std::string> header;
+        if(tstage->csvHasHeader()) {
+            // because of projection pushdown, need to decode from input params!
+            header = tstage->csvHeader();
+        }
+
+        auto task = new TransformTask();
+        task->setFunctor(functor);
+        // parse exceptions are made internal when the normal case is enabled, so they get upgraded. The number of
+        // columns is the one of the FileInputOperator BEFORE optimization/projection pushdown!
+        task->setInputFileSource(uri, options.OPT_NULLVALUE_OPTIMIZATION(), tstage->fileInputOperatorID(),
+                                 inputSchema.getRowType(), header,
+                                 !options.OPT_GENERATE_PARSER(),
+                                 tstage->csvNumFileInputColumns(), rangeStart, rangeSize, tstage->csvInputDelimiter(),
+                                 tstage->csvInputQuotechar(), tstage->columnsToKeep(), tstage->inputFormat(), exactSplits);
+        // hash table or memory output?
+        if(tstage->outputMode() == EndPointMode::HASHTABLE) {
+            if (tstage->hashtableKeyByteWidth() == 8)
+                task->sinkOutputToHashTable(HashTableFormat::UINT64,
+                                            tstage->outputDataSetID());
+            else
+                task->sinkOutputToHashTable(HashTableFormat::BYTES,
+                                            tstage->outputDataSetID());
+            task->setHotKeys(tstage->hotKeys());
+        }
+        else {
+            assert(tstage->outputMode() == EndPointMode::FILE ||
+                   tstage->outputMode() == EndPointMode::MEMORY);
+            task->sinkOutputToMemory(outputSchema, tstage->outputDataSetID());
+        }
+        task->sinkExceptionsToMemory(inputSchema);
+        task->setExceptionCounting(tstage->exceptionCountIndex(), tstage->liveExceptionCounts());
+        task->setStageID(tstage->getID());
+        return task;
+    }
+
+    std::vector<IExecutorTask*> LocalBackend::performAdaptiveFileTasks(TransformStage *tstage, codegen::read_block_f functor,
+                                                                       const std::shared_ptr<TaskOutputLimit>& outputLimit,
+                                                                       const std::shared_ptr<AggregateState>& aggState) {
+        using namespace std;
+        assert(tstage->fileInputMode());
+
+        // tasks of the first wave should take at least this long, else per-task overhead dominates
+        static const double minTaskTime = 0.1;
+        // tasks longer than this become stragglers at the end of the stage
+        static const double maxTaskTime = 5.0;
+        // number of tasks per worker for the remaining input, so workers finishing early can pick up more
+        static const size_t tasksPerWorker = 4;
+        static const size_t minSplitSize = 1024 * 1024;
+
+        // input files in order, file sizes are stored along with the URIs in the input partitions
+        auto fileSchema = Schema(Schema::MemoryLayout::ROW, python::Type::makeTupleType({python::Type::STRING, python::Type::I64}));
+        vector<pair<URI, size_t>> files;
+        size_t remainingBytes = 0;
+        for(auto partition : tstage->inputPartitions()) {
+            auto numFiles = partition->getNumRows();
+            const uint8_t* ptr = partition->lock();
+            size_t bytesRead = 0;
+            for(int i = 0; i < numFiles; ++i) {
+                Row row = Row::fromMemory(fileSchema, ptr, partition->capacity() - bytesRead);
+                files.emplace_back(URI(row.getString(0)), row.getInt(1));
+                remainingBytes += row.getInt(1);
+                ptr += row.serializedLength();
+                bytesRead += row.serializedLength();
+            }
+            partition->unlock();
+        }
+
+        // cursor over the input, a split never spans multiple files. The last split of a file takes the remainder.
+        size_t fileIdx = 0;
+        size_t fileOffset = 0;
+        vector<size_t> taskBytes; // input bytes per task order
+        auto nextTask = [&](size_t splitSize) {
+            const auto& file = files[fileIdx];
+            size_t rangeStart = fileOffset;
+            size_t rangeEnd = fileOffset + 2 * splitSize > file.second ? file.second : fileOffset + splitSize;
+            // (0, 0) indicates full file
+            size_t rangeSize = 0 == rangeStart && rangeEnd == file.second ? 0 : rangeEnd - rangeStart;
+            auto task = createFileInputTask(tstage, _options, functor, file.first, rangeStart, rangeSize, false);
+            task->setOrder(taskBytes.size());
+            if(outputLimit)
+                task->setStageOutputLimit(outputLimit, taskBytes.size());
+            task->setAggregateState(aggState);
+            taskBytes.push_back(rangeEnd - rangeStart);
+            remainingBytes -= rangeEnd - rangeStart;
+            fileOffset = rangeEnd;
+            if(fileOffset >= file.second) {
+                fileIdx++;
+                fileOffset = 0;
+            }
+            return task;
+        };
+
+        auto runWave = [&](vector<IExecutorTask*>& tasks) {
+            std::unique_ptr<InputPrefetcher> prefetcher;
+            if(_options.INTERLEAVE_IO())
+                prefetcher = prefetchInput(tstage, tasks);
+            return performTasks(tasks);
+        };
+
+        // first wave, one task of the configured split size per worker
+        size_t numWorkers = _executors.size() + 1; // driver works as well
+        vector<IExecutorTask*> tasks;
+        while(fileIdx < files.size() && tasks.size() < numWorkers)
+            tasks.emplace_back(nextTask(_options.INPUT_SPLIT_SIZE()));
+        auto completedTasks = runWave(tasks);
+        if(fileIdx >= files.size())
+            return completedTasks;
+
+        // measure throughput and output size of the first wave
+        double wallTime = 0.0;
+        size_t inputBytes = 0;
+        size_t outputBytes = 0;
+        size_t outputRows = 0;
+        for(auto task : completedTasks) {
+            wallTime += task->wallTime();
+            inputBytes += taskBytes[task->getOrder().front()];
+            for(auto p : task->getOutputPartitions())
+                outputBytes += p->bytesWritten();
+            outputRows += task->getNumOutputRows();
+        }
+        double throughput = wallTime > 0.0 ? inputBytes / wallTime : 0.0; // bytes per second and task
+        double expansion = inputBytes > 0 ? outputBytes / (double)inputBytes : 0.0;
+
+        // balance the remaining input across the workers, bounded by the task time
+        size_t splitSize = remainingBytes / (tasksPerWorker * numWorkers);
+        if(throughput > 0.0)
+            splitSize = std::min(std::max(splitSize, (size_t)(throughput * minTaskTime)), (size_t)(throughput * maxTaskTime));
+        splitSize = std::max(splitSize, minSplitSize);
+
+        // output of a task should fit into one partition, yet a single one may not occupy too much of an executor
+        size_t partitionSize = _options.PARTITION_SIZE();
+        double rowWidth = outputRows > 0 ? outputBytes / (double)outputRows : 0.0;
+        if(outputRows > 0) {
+            auto expectedOutput = (size_t)(splitSize * expansion + rowWidth);
+            partitionSize = std::max(partitionSize, std::min(expectedOutput, _options.EXECUTOR_MEMORY() / 8));
+        }
+
+        {
+            std::stringstream ss;
+            ss<<"[Transform Stage] Stage "<<tstage->number()<<" first wave of "<<pluralize(completedTasks.size(), "task")
+              <<" processed "<<sizeToMemString((size_t)throughput)<<"/s per task, output expansion "<<expansion
+              <<", "<<rowWidth<<" bytes per output row. Splitting remaining "<<sizeToMemString(remainingBytes)
+              <<" into splits of "<<sizeToMemString(splitSize)<<", output partitions of "<<sizeToMemString(partitionSize);
+            logger().info(ss.str());
+        }
+
+        // second wave, remaining input
+        tasks.clear();
+        while(fileIdx < files.size()) {
+            auto task = nextTask(splitSize);
+            if(task->hasMemorySink())
+                task->setOutputPartitionSize(partitionSize);
+            tasks.emplace_back(task);
+        }
+        auto remainingTasks = runWave(tasks);
+        completedTasks.insert(completedTasks.end(), remainingTasks.begin(), remainingTasks.end());
+        return completedTasks;
+    }
+
+    std::unique_ptr<InputPrefetcher> LocalBackend::prefetchInput(TransformStage *tstage, std::vector<IExecutorTask*> &tasks) {
+        assert(tstage->fileInputMode());
+
+        // file sizes are stored along with the URIs in the input partitions
+        auto fileSchema = Schema(Schema::MemoryLayout::ROW, python::Type::makeTupleType({python::Type::STRING, python::Type::I64}));
+        std::unordered_map<std::string, size_t> fileSizes;
+        bool remoteInput = false;
+        for(auto partition : tstage->inputPartitions()) {
+            auto numFiles = partition->getNumRows();
+            const uint8_t* ptr = partition->lock();
+            size_t bytesRead = 0;
+            for(int i = 0; i < numFiles; ++i) {
+                Row row = Row::fromMemory(fileSchema, ptr, partition->capacity() - bytesRead);
+                URI uri(row.getString(0));
+                fileSizes[uri.toString()] = row.getInt(1);
+                remoteInput |= !uri.isLocal();
+                ptr += row.serializedLength();
+                bytesRead += row.serializedLength();
+            }
+            partition->unlock();
+        }
+
+        // remote stores are latency bound, hence use more IO threads. Loaded input is held outside of the executor
+        // arenas, hence bounded separately.
+        auto prefetcher = std::make_unique<InputPrefetcher>(remoteInput ? 8 : 2, _options.PREFETCH_MEMORY());
+
+        // readers look back a couple bytes before the start of a split and read the last row beyond its end
+        const size_t lookBack = 64;
+        const size_t lookAhead = _options.READ_BUFFER_SIZE();
+        for(auto task : tasks) {
+            auto ttask = dynamic_cast<TransformTask*>(task);
+            if(!ttask || !ttask->hasFileSource())
+                continue;
+            auto uri = ttask->inputFilePath();
+            auto it = fileSizes.find(uri.toString());
+            if(it == fileSizes.end())
+                continue;
+
+            size_t rangeStart = 0, rangeSize = 0;
+            std::tie(rangeStart, rangeSize) = ttask->inputFileRange();
+            size_t offset = 0, length = it->second;
+            if(rangeSize > 0) {
+                offset = rangeStart > lookBack ? rangeStart - lookBack : 0;
+                length = rangeStart + rangeSize + lookAhead - offset;
+            }
+
+            auto id = prefetcher->add(uri, it->second, offset, length);
+            auto p = prefetcher.get();
+            ttask->setInputPrefetch([p, id]() { return p->acquire(id); });
+        }
+
+        prefetcher->start();
+        return prefetcher;
+    }
+
     PyObject* preparePythonPipeline(const std::string& py_code, const std::string& pipeline_name) {
         PyObject* pip_object = nullptr;
 
@@ -736,6 +1022,16 @@ namespace tuplex {
             return;
         }
 
+        // counts of a previous execution of this stage
+        tstage->liveExceptionCounts()->reset();
+
+        // served by the metrics endpoint while the stage runs
+        RuntimeMetrics::instance().addStageExceptionCounts(tstage, tstage->liveExceptionCounts());
+        struct StageExceptionCountsRegistration {
+            const TransformStage* stage;
+            ~StageExceptionCountsRegistration() { RuntimeMetrics::instance().removeStageExceptionCounts(stage); }
+        } countsRegistration{tstage};
+
         bool merge_except_rows = _options.OPT_MERGE_EXCEPTIONS_INORDER();
 
         // when result of this stage is a hash table, merging makes no sense b.c.
@@ -768,12 +1064,11 @@ namespace tuplex {
 
         // 1.) COMPILATION
         // compile code & link functions to tasks
-        LLVMOptimizer optimizer;
-        auto syms = tstage->compile(*_compiler, _options.USE_LLVM_OPTIMIZER() ? &optimizer : nullptr, false); // @TODO: do not compile slow path yet, do it later in parallel when other threads are already working!
-        bool combineOutputHashmaps = syms->aggInitFunctor && syms->aggCombineFunctor && syms->aggAggregateFunctor;
+        auto syms = compileStage(tstage);
         JobMetrics& metrics = tstage->PhysicalStage::plan()->getContext().metrics();
         double total_compilation_time = metrics.getTotalCompilationTime() + timer.time();
         metrics.setTotalCompilationTime(total_compilation_time);
+        RuntimeMetrics::instance().stageCompiled(timer.time());
         {
             std::stringstream ss;
             ss<<"[Transform Stage] Stage "<<tstage->number()<<" compiled to x86 in "<<timer.time()<<"s";
@@ -792,18 +1087,70 @@ namespace tuplex {
             throw std::runtime_error("initStage() failed for stage " + std::to_string(tstage->number()) + " with code " + std::to_string(init_rc));
 
 
-        // init aggregate by key
-        if(syms->aggAggregateFunctor) {
-            initThreadLocalAggregateByKey(syms->aggInitFunctor, syms->aggCombineFunctor, syms->aggAggregateFunctor);
+        // init aggregate (by key), owned by the stage so stages can run concurrently
+        std::shared_ptr<AggregateState> aggState;
+        if(syms->aggInitFunctor && syms->aggCombineFunctor)
+            aggState = std::make_shared<AggregateState>(syms->aggInitFunctor, syms->aggCombineFunctor, syms->aggAggregateFunctor);
+        // buckets of the task hash tables are combined with the aggregate's combiner instead of concatenated
+        auto combineOutputHashmaps = aggState && aggState->byKey() ? aggState.get() : nullptr;
+
+        // stream CSV output to one part file per task, so memory use does not grow with the output size
+        // note: a limit, a number of output files or a split size need to know the whole output, hence in these cases
+        // output is still collected in memory
+        bool streamOutput = _options.STREAM_FILE_OUTPUT() && tstage->outputMode() == EndPointMode::FILE
+                            && tstage->outputFormat() == FileFormat::OUTFMT_CSV
+                            && tstage->outputLimit() == std::numeric_limits<size_t>::max()
+                            && 0 == tstage->numOutputFiles() && 0 == tstage->splitSize();
+
+        // adaptive splits create tasks while executing, this requires splits at arbitrary offsets and
+        // part numbers for streamed output are assigned upfront
+        bool adaptiveSplits = _options.ADAPTIVE_SPLITS() && tstage->fileInputMode() && _options.INPUT_SPLIT_SIZE() > 0
+                              && !(_options.CSV_EXACT_SPLITS() && tstage->inputFormat() == FileFormat::OUTFMT_CSV)
+                              && !streamOutput;
+
+        if(tstage->fileInputMode())
+            metrics.addFileScan();
+
+        std::vector<IExecutorTask*> tasks;
+        if(!adaptiveSplits)
+            tasks = createLoadAndTransformToMemoryTasks(tstage, _options, syms->functor);
+        for(auto task : tasks)
+            dynamic_cast<TransformTask*>(task)->setAggregateState(aggState);
+
+        // with a limit (e.g. take) tasks stop at their next cancellation checkpoint once the tasks before them
+        // produced enough rows. Aggregates and hash table sinks need to see all rows.
+        std::shared_ptr<TaskOutputLimit> outputLimit;
+        if(tstage->outputLimit() != std::numeric_limits<size_t>::max()
+           && tstage->outputMode() != EndPointMode::HASHTABLE && !syms->aggInitFunctor) {
+            outputLimit = std::make_shared<TaskOutputLimit>(tstage->outputLimit());
+            for(size_t i = 0; i < tasks.size(); ++i)
+                dynamic_cast<TransformTask*>(tasks[i])->setStageOutputLimit(outputLimit, i);
         }
-        else {
-            if (syms->aggInitFunctor && syms->aggCombineFunctor) {
-                initThreadLocalAggregates(_options.EXECUTOR_COUNT() + 1, syms->aggInitFunctor, syms->aggCombineFunctor);
-            }
+
+        size_t numStreamedParts = 0;
+        if(streamOutput) {
+            numStreamedParts = streamOutputToFiles(tstage, tasks);
+
+            // normal rows are already on disk, resolved rows can't be merged back in order. Instead, writeOutput
+            // puts them into part files numbered after the streamed ones.
+            merge_except_rows = false;
         }
 
-        auto tasks = createLoadAndTransformToMemoryTasks(tstage, _options, syms->functor);
-        auto completedTasks = performTasks(tasks);
+        // IO threads load input of upcoming tasks while executors compute
+        std::unique_ptr<InputPrefetcher> prefetcher;
+        if(_options.INTERLEAVE_IO() && tstage->fileInputMode() && !adaptiveSplits)
+            prefetcher = prefetchInput(tstage, tasks);
+
+        auto completedTasks = adaptiveSplits ? performAdaptiveFileTasks(tstage, syms->functor, outputLimit, aggState) : performTasks(tasks);
+
+        if(prefetcher) {
+            std::stringstream ss;
+            ss<<"[Transform Stage] Stage "<<tstage->number()<<" prefetched "<<sizeToMemString(prefetcher->bytesLoaded())
+              <<" for "<<prefetcher->numHits()<<"/"<<pluralize(prefetcher->numHits() + prefetcher->numMisses(), "task")
+              <<", tasks waited "<<prefetcher->stallTime()<<"s for input";
+            Logger::instance().defaultLogger().info(ss.str());
+            prefetcher.reset();
+        }
 
         // Note: this doesn't work yet because of the globals.
         // to make this work, need better global mapping...
@@ -821,8 +1168,15 @@ namespace tuplex {
         }
 
         {
+            size_t numStopped = 0;
+            for(auto task : completedTasks)
+                numStopped += dynamic_cast<TransformTask*>(task)->stoppedEarly();
+            metrics.setTasksStoppedEarly(tstage->number(), numStopped);
+
             std::stringstream ss;
             ss<<"[Transform Stage] Stage "<<tstage->number()<<" completed "<<completedTasks.size()<<" load&transform tasks in "<<timer.time()<<"s";
+            if(numStopped > 0)
+                ss<<" ("<<pluralize(numStopped, "task")<<" stopped early)";
             Logger::instance().defaultLogger().info(ss.str());
         }
 
@@ -930,7 +1284,7 @@ namespace tuplex {
                     auto resolveFunctor = _options.RESOLVE_WITH_INTERPRETER_ONLY() ? nullptr : syms->resolveFunctor;
 
                     // cout<<"*** num tasks before resolution: "<<completedTasks.size()<<" ***"<<endl;
-                    completedTasks = resolveViaSlowPath(completedTasks, merge_except_rows, resolveFunctor, tstage, combineOutputHashmaps);
+                    completedTasks = resolveViaSlowPath(completedTasks, merge_except_rows, resolveFunctor, tstage, aggState);
                     // cout<<"*** num tasks after resolution: "<<completedTasks.size()<<" ***";
                 }
 
@@ -949,12 +1303,23 @@ namespace tuplex {
 
                 totalWallTime = 0.0;
                 size_t slowPathNumInputRows = 0;
+                size_t numRowsResolvedCompiled = 0;
+                size_t numRowsResolvedInterpreter = 0;
                 for(auto task : completedTasks) {
                     if(task->type() == TaskType::RESOLVE) {
                         totalWallTime += task->wallTime();
                         slowPathNumInputRows += task->getNumInputRows();
+                        auto rtask = dynamic_cast<ResolveTask*>(task);
+                        assert(rtask);
+                        numRowsResolvedCompiled += rtask->numRowsResolvedCompiled();
+                        numRowsResolvedInterpreter += rtask->numRowsResolvedInterpreter();
                     }
                 }
+                ss.str("");
+                ss<<"slow path resolved "<<numRowsResolvedCompiled<<" rows via compiled general-case path, "
+                  <<numRowsResolvedInterpreter<<" rows via interpreter";
+                logger().info(ss.str());
+                metrics.setSlowPathRowCounts(tstage->number(), numRowsResolvedCompiled, numRowsResolvedInterpreter);
                 double time_per_row_slow_path_ms = totalWallTime / slowPathNumInputRows * 1000.0;
 
                 // print timing info for slow path
@@ -991,7 +1356,7 @@ namespace tuplex {
             case EndPointMode::FILE: {
                 // i.e. if output format is tuplex, then attach special writer!
                 // ==> could maybe codegen avro as output format, and then write to whatever??
-                writeOutput(tstage, completedTasks);
+                writeOutput(tstage, completedTasks, numStreamedParts);
                 break;
             }
             case EndPointMode::MEMORY: {
@@ -1001,11 +1366,11 @@ namespace tuplex {
                 vector<Partition*> unresolved;
                 vector<tuple<size_t, PyObject*>> nonconforming_rows; // rows where the output type does not fit,
                                                                      // need to manually merged.
-                unordered_map<tuple<int64_t, ExceptionCode>, size_t> ecounts;
+                ExceptionCounts taskCounts(tstage->exceptionCountIndex());
                 size_t rowDelta = 0;
                 for (const auto& task : completedTasks) {
                     // update exception counts
-                    ecounts = merge_ecounts(ecounts, getExceptionCounts(task));
+                    taskCounts.add(getExceptionCounts(task));
 
                     auto taskOutput = getOutputPartitions(task);
                     auto exceptions = getRemainingExceptions(task);
@@ -1056,7 +1421,7 @@ namespace tuplex {
                 // => general case partitions set as artificial exceptions to keep around...
 
                 // set to stage output
-                tstage->setMemoryResult(output, general_output, nonconforming_rows, ecounts);
+                tstage->setMemoryResult(output, general_output, nonconforming_rows, taskCounts.toMap());
                 break;
             }
             case EndPointMode::HASHTABLE: {
@@ -1076,10 +1441,10 @@ namespace tuplex {
         }
 
         // if aggregate stage, convert thread-local results to global one and assign as result set...
-        if(syms->aggInitFunctor && syms->aggCombineFunctor && !syms->aggAggregateFunctor) {
+        if(aggState && !aggState->byKey()) {
             uint8_t* aggResult = nullptr;
             int64_t aggResultSize = 0;
-            if(!fetchAggregate(&aggResult, &aggResultSize)) // this also frees the thread-local aggregates...
+            if(!aggState->fetch(&aggResult, &aggResultSize)) // this also frees the partial aggregates...
                 throw std::runtime_error("failed to fetch global aggregate result.");
 
             if(!aggResult)
@@ -1134,7 +1499,7 @@ namespace tuplex {
     std::vector<IExecutorTask*> LocalBackend::resolveViaSlowPath(
             std::vector<IExecutorTask*> &tasks,
             bool merge_rows_in_order,
-            codegen::resolve_f functor, tuplex::TransformStage *tstage, bool combineHashmaps) {
+            codegen::resolve_f functor, tuplex::TransformStage *tstage, const std::shared_ptr<AggregateState>& aggState) {
 
         using namespace std;
         assert(tstage);
@@ -1149,7 +1514,7 @@ namespace tuplex {
 
             // special case: create a global hash output result and put it into the FIRST resolve task.
             Timer timer;
-            hsink = createFinalHashmap(tasks, tstage->hashtableKeyByteWidth(), combineHashmaps);
+            hsink = createFinalHashmap(tasks, tstage->hashtableKeyByteWidth(), aggState && aggState->byKey() ? aggState.get() : nullptr);
             logger().info("created combined normal-case result in " + std::to_string(timer.time()) + "s");
             hasNormalHashSink = true;
         }
@@ -1260,7 +1625,7 @@ namespace tuplex {
             else if(compareOrders(maxOrder, tt->getOrder()))
                 maxOrder = tt->getOrder();
 
-            if (tt->exceptionCounts().size() > 0) {
+            if (!tt->denseExceptionCounts().empty()) {
                 // task found with exceptions in it => exception partitions need to be resolved using special functor
 
                 // hash-table output not yet supported
@@ -1289,6 +1654,8 @@ namespace tuplex {
                                              pip_object);
 
                 rtask->setOrder(tt->getOrder()); // copy order from original task for sorting later!
+                rtask->setExceptionCountIndex(tstage->exceptionCountIndex());
+                rtask->setAggregateState(aggState);
 
 
                 if(tstage->predecessors().size() > 0) {
@@ -1385,6 +1752,8 @@ namespace tuplex {
                 rtask->setHybridIntermediateHashTables(tstage->predecessors().size(), input_intermediates.hybrids);
 
                 rtask->setOrder(maxOrder); // this is arbitrary, just put the slow path rows at the end
+                rtask->setExceptionCountIndex(tstage->exceptionCountIndex());
+                rtask->setAggregateState(aggState);
                 // hash output?
                 if(hashOutput) {
                     if (tstage->hashtableKeyByteWidth() == 8) {
@@ -1413,11 +1782,6 @@ namespace tuplex {
     }
 
     std::vector<IExecutorTask*> LocalBackend::performTasks(std::vector<IExecutorTask*> &tasks, std::function<void()> driverCallback) {
-        // perform tasks in main memory
-        // start workqueue
-        WorkQueue& wq = LocalEngine::instance().getQueue();
-        wq.clear();
-
         // check if ord is set, if not issue warning & add
         bool orderlessTaskFound = false;
         for(int i = 0; i < tasks.size(); ++i) {
@@ -1433,6 +1797,18 @@ namespace tuplex {
         }
 #endif
 
+        // other stages or jobs running? => share executors. Other stages may compile, resolve or sink their output
+        // while this one waits for its tasks, all state the tasks touch is owned by the stage.
+        if(sharedExecutors()) {
+            StageLockRelease release(true);
+            return performTasksConcurrently(tasks, driverCallback);
+        }
+
+        // perform tasks in main memory
+        // start workqueue
+        WorkQueue& wq = LocalEngine::instance().getQueue();
+        wq.clear();
+
         // add all tasks to queue
         for(auto& task : tasks) wq.addTask(task);
         // clear
@@ -1468,6 +1844,337 @@ namespace tuplex {
         return wq.popCompletedTasks();
     }
 
+    std::vector<IExecutorTask*> LocalBackend::performTasksConcurrently(std::vector<IExecutorTask*> &tasks, std::function<void()> driverCallback) {
+        WorkQueue* wq = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(_queuesMutex);
+            if(_freeQueues.empty()) {
+                _stageQueues.emplace_back(new WorkQueue());
+                _freeQueues.push_back(_stageQueues.back().get());
+            }
+            wq = _freeQueues.back();
+            _freeQueues.pop_back();
+        }
+
+        // history server can't be shared among concurrent stages. Executors have none attached here, performTasks
+        // detaches it after each stage (it must not be changed while they work on another stage's queue).
+        assert(std::all_of(_executors.begin(), _executors.end(), [](Executor* exec) { return !exec->historyServer(); }));
+
+        // executors working on the queue account their partitions to the job of this thread
+        wq->setJob(Executor::currentJob(), t_jobWeight);
+
+        size_t numTasks = tasks.size();
+        for(auto& task : tasks) wq->addTask(task);
+        tasks.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(_queuesMutex);
+            _activeQueues.push_back(wq);
+        }
+        rebalanceExecutors();
+
+        driverCallback();
+
+        // runtime memory is thread-local, hence only the thread which set it up for the driver may use it
+        bool useDriver = !t_stageThread;
+        while(wq->numCompletedTasks() < numTasks) {
+            // check for interrupt, if so clear queue!
+            if(check_interrupted()) {
+                wq->clear();
+                break;
+            }
+
+            if(useDriver && wq->workTask(*driver(), true))
+                continue;
+
+            // nothing to do here, maybe executors can help out on other queues
+            rebalanceExecutors();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        if(useDriver)
+            runtime::rtfree_all();
+
+        {
+            std::lock_guard<std::mutex> lock(_queuesMutex);
+            _activeQueues.erase(std::find(_activeQueues.begin(), _activeQueues.end(), wq));
+        }
+        rebalanceExecutors();
+
+        auto completedTasks = wq->popCompletedTasks();
+        wq->setJob(-1);
+        {
+            std::lock_guard<std::mutex> lock(_queuesMutex);
+            _freeQueues.push_back(wq);
+        }
+        return completedTasks;
+    }
+
+    void LocalBackend::rebalanceExecutors() {
+        std::lock_guard<std::mutex> lock(_queuesMutex);
+
+        // no stage working? => detach, the regular path uses the engine's queue again
+        if(_activeQueues.empty()) {
+            for(auto& exec : _executors)
+                exec->removeFromQueue();
+            return;
+        }
+
+        // queues which still hold tasks, grouped by job
+        struct JobShare {
+            int64_t jobID;
+            double weight;
+            size_t numQueuedTasks;
+            size_t numExecutors;
+            std::vector<WorkQueue*> queues;
+        };
+        std::vector<JobShare> jobs;
+        for(auto q : _activeQueues) {
+            auto numQueued = q->numQueuedTasks();
+            if(0 == numQueued)
+                continue;
+            auto it = std::find_if(jobs.begin(), jobs.end(), [q](const JobShare& js) { return js.jobID == q->jobID(); });
+            if(it == jobs.end()) {
+                jobs.push_back(JobShare{q->jobID(), std::max(q->jobWeight(), 1e-6), 0, 0, {}});
+                it = std::prev(jobs.end());
+            }
+            it->numQueuedTasks += numQueued;
+            it->queues.push_back(q);
+        }
+
+        // all tasks started, executors finish their current one
+        if(jobs.empty())
+            return;
+
+        std::vector<double> weights;
+        std::vector<size_t> numQueuedTasks;
+        for(const auto& js : jobs) {
+            weights.push_back(js.weight);
+            numQueuedTasks.push_back(js.numQueuedTasks);
+        }
+        auto shares = fairShares(_executors.size(), weights, numQueuedTasks, _rebalanceRound);
+        for(unsigned j = 0; j < jobs.size(); ++j)
+            jobs[j].numExecutors = shares[j];
+
+        // round-robin over the queues of each job, starting at a different queue each time
+        unsigned idx = 0;
+        for(const auto& js : jobs) {
+            for(unsigned i = 0; i < js.numExecutors; ++i, ++idx)
+                _executors[idx]->attachWorkQueue(js.queues[(i + _rebalanceRound) % js.queues.size()]);
+        }
+        _rebalanceRound++;
+    }
+
+    std::vector<size_t> LocalBackend::fairShares(size_t numExecutors, const std::vector<double>& weights,
+                                                 const std::vector<size_t>& numQueuedTasks, size_t round) {
+        assert(weights.size() == numQueuedTasks.size());
+        auto numJobs = weights.size();
+        std::vector<size_t> shares(numJobs, 0);
+        if(0 == numJobs)
+            return shares;
+
+        for(unsigned i = 0; i < numExecutors; ++i) {
+            size_t best = 0;
+            bool bestSaturated = true;
+            double bestShare = 0.0;
+            for(unsigned j = 0; j < numJobs; ++j) {
+                auto idx = (j + round) % numJobs;
+                bool saturated = shares[idx] >= numQueuedTasks[idx];
+                double share = shares[idx] / weights[idx];
+                if(j == 0 || (bestSaturated && !saturated) || (saturated == bestSaturated && share < bestShare)) {
+                    best = idx;
+                    bestSaturated = saturated;
+                    bestShare = share;
+                }
+            }
+            shares[best]++;
+        }
+        return shares;
+    }
+
+    void LocalBackend::prepareStages(const std::vector<PhysicalStage*>& stages) {
+        // a thread runs one job at a time, the job's tasks and partitions are accounted to it
+        if(_options.MULTI_JOB()) {
+            if(Executor::currentJob() < 0) {
+                // drivers of earlier jobs whose results were consumed meanwhile can go
+                releaseJobDriver();
+
+                auto jobID = _nextJobID++;
+                Executor::setCurrentJob(jobID);
+                t_jobOwner = true;
+                std::stringstream ss;
+                ss<<"started job "<<jobID<<" with weight "<<t_jobWeight;
+                logger().info(ss.str());
+            }
+
+            // compile jobs are state of the backend, not of a job. Jobs of other threads would cancel them.
+            if(_options.AOT_COMPILE_THREADS() > 0)
+                logger().warn("tuplex.aotCompileThreads is ignored with tuplex.scheduler.multiJob, "
+                              "stages are compiled right before they run");
+            return;
+        }
+
+        cancelCompileJobs();
+
+        size_t numThreads = _options.AOT_COMPILE_THREADS();
+#if LLVM_VERSION_MAJOR < 9
+        // legacy JIT can't add modules from multiple threads
+        numThreads = 0;
+#endif
+        if(0 == numThreads)
+            return;
+
+        for(auto stage : stages) {
+            auto tstage = dynamic_cast<TransformStage*>(stage);
+            if(!tstage || tstage->bitCode().empty())
+                continue;
+            auto job = std::make_unique<CompileJob>();
+            job->stage = tstage;
+            job->claimed = false;
+            job->compileTime = 0.0;
+            job->syms = job->promise.get_future().share();
+            _compileJobs.push_back(std::move(job));
+        }
+
+        // the first stage gets compiled right away by the executing thread, nothing to hide for it
+        if(_compileJobs.size() < 2) {
+            _compileJobs.clear();
+            return;
+        }
+
+        _compileCancelled = false;
+        numThreads = std::min(numThreads, _compileJobs.size() - 1);
+        _nextCompileJob = 1 + numThreads;
+        for(unsigned i = 0; i < numThreads; ++i) {
+            // each thread starts with a job claimed here, i.e. the next stages are compiled in the background for
+            // sure instead of racing with the executing thread
+            auto& first = *_compileJobs[1 + i];
+            first.claimed = true;
+            _compileThreads.emplace_back([this, &first]() {
+                compileJob(first);
+                size_t idx = 0;
+                while(!_compileCancelled && (idx = _nextCompileJob++) < _compileJobs.size())
+                    runCompileJob(*_compileJobs[idx]);
+            });
+        }
+        logger().info("compiling " + pluralize(_compileJobs.size() - 1, "stage") + " ahead of time using "
+                      + pluralize(numThreads, "thread"));
+    }
+
+    void LocalBackend::finishStages() {
+        if(t_jobOwner) {
+            Executor::setCurrentJob(-1);
+            t_jobOwner = false;
+            releaseJobDriver();
+        }
+
+        if(!_options.MULTI_JOB())
+            cancelCompileJobs();
+    }
+
+    void LocalBackend::setJobWeight(double weight) {
+        if(weight <= 0.0)
+            throw std::runtime_error("job weight must be positive, got " + std::to_string(weight));
+        t_jobWeight = weight;
+    }
+
+    void LocalBackend::cancelCompileJobs() {
+        _compileCancelled = true;
+        for(auto& t : _compileThreads)
+            t.join();
+        _compileThreads.clear();
+        _compileJobs.clear();
+    }
+
+    bool LocalBackend::runCompileJob(CompileJob &job) {
+        if(job.claimed.exchange(true))
+            return false;
+        compileJob(job);
+        return true;
+    }
+
+    void LocalBackend::compileJob(CompileJob &job) {
+        Timer timer;
+        try {
+            LLVMOptimizer optimizer;
+            auto syms = job.stage->compile(*_compiler, _options.USE_LLVM_OPTIMIZER() ? &optimizer : nullptr, false);
+            job.compileTime = timer.time();
+            job.promise.set_value(syms);
+        } catch(...) {
+            job.compileTime = timer.time();
+            job.promise.set_exception(std::current_exception());
+        }
+    }
+
+    std::shared_ptr<TransformStage::JITSymbols> LocalBackend::compileStage(TransformStage *tstage) {
+        auto it = std::find_if(_compileJobs.begin(), _compileJobs.end(),
+                               [tstage](const std::unique_ptr<CompileJob>& job) { return job->stage == tstage; });
+        if(it == _compileJobs.end()) {
+            LLVMOptimizer optimizer;
+            return tstage->compile(*_compiler, _options.USE_LLVM_OPTIMIZER() ? &optimizer : nullptr, false); // @TODO: do not compile slow path yet, do it later in parallel when other threads are already working!
+        }
+
+        // not started yet? => compile here instead of waiting
+        Timer timer;
+        auto& job = **it;
+        bool compiledHere = runCompileJob(job);
+        auto syms = job.syms.get();
+        if(!compiledHere) {
+            // whatever was not spent waiting here ran while earlier stages executed
+            double hidden = std::max(0.0, job.compileTime - timer.time());
+            JobMetrics& metrics = tstage->PhysicalStage::plan()->getContext().metrics();
+            metrics.setHiddenCompilationTime(metrics.getHiddenCompilationTime() + hidden);
+            metrics.addAheadOfTimeStage();
+            std::stringstream ss;
+            ss<<"[Transform Stage] Stage "<<tstage->number()<<" compiled ahead of time, waited "<<timer.time()<<"s";
+            Logger::instance().defaultLogger().info(ss.str());
+        }
+        return syms;
+    }
+
+    void LocalBackend::executeStages(const std::vector<PhysicalStage*>& stages, const Context& context) {
+        // stage threads can't work on tasks with the driver, without executors their tasks would never run
+        if(!_options.CONCURRENT_STAGES() || stages.size() < 2 || _executors.empty()) {
+            IBackend::executeStages(stages, context);
+            return;
+        }
+
+        // a stage (and its predecessors) starts as soon as the stages it depends on are done,
+        // the caller continues only after all of them finished
+        _numConcurrentStageGroups++;
+        std::vector<std::exception_ptr> errors(stages.size());
+        std::vector<std::thread> threads;
+        auto jobID = Executor::currentJob();
+        auto jobWeight = t_jobWeight;
+        for(unsigned i = 1; i < stages.size(); ++i) {
+            threads.emplace_back([&stages, &context, &errors, i, jobID, jobWeight]() {
+                t_stageThread = true;
+                Executor::setCurrentJob(jobID);
+                t_jobWeight = jobWeight;
+                try {
+                    stages[i]->execute(context);
+                } catch(...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+
+        // first one runs on the calling thread, which may own the driver
+        try {
+            stages.front()->execute(context);
+        } catch(...) {
+            errors.front() = std::current_exception();
+        }
+
+        for(auto& t : threads)
+            t.join();
+        _numConcurrentStageGroups--;
+
+        for(const auto& e : errors)
+            if(e)
+                std::rethrow_exception(e);
+    }
+
     // ensure output folder exists. => separate function here, b.c. it slows down pipeline by a lot!
     void ensureOutputFolderExists(const URI& baseURI) {
         std::string base; // base which to use to form string
@@ -1552,21 +2259,22 @@ namespace tuplex {
 
         using namespace std;
 
-        unordered_map<tuple<int64_t, ExceptionCode>, size_t> ecounts;
+        // tasks of a stage share the same index, hence this adds up arrays and converts to a map only once
+        ExceptionCounts ecounts;
         for(const auto& task : tasks) {
 
             // i.e. resolve task is an exceptionable one...
             auto etask = dynamic_cast<IExceptionableTask*>(task);
             if(etask)
-                ecounts = merge_ecounts(ecounts, etask->exceptionCounts());
+                ecounts.add(etask->denseExceptionCounts());
 
             // special case, Trafo task!
             auto ttask = dynamic_cast<TransformTask*>(task);
             if(ttask)
-                ecounts = merge_ecounts(ecounts, ttask->exceptionCounts());
+                ecounts.add(ttask->denseExceptionCounts());
         }
 
-        return ecounts;
+        return ecounts.toMap();
     }
 
     void LocalBackend::executeAggregateStage(tuplex::AggregateStage *astage) {
@@ -1753,6 +2461,9 @@ namespace tuplex {
         return MAP_OK;
     }
 
+    // aggregate whose combiner is used by the combine_bucket callbacks (hashmap_iterate has no user data)
+    static thread_local const AggregateState* t_combineState = nullptr;
+
     static int combine_bucket(map_t hm, hashmap_element* entry) {
         assert(hm);
         auto key = entry->key;
@@ -1761,7 +2472,7 @@ namespace tuplex {
         // data is a bucket. Check in combined hashmap hm
         uint8_t* bucket = nullptr;
         hashmap_get(hm, key, keylen, reinterpret_cast<any_t*>(&bucket));
-        bucket = combineBuckets(bucket, data);
+        bucket = t_combineState->combineBuckets(bucket, data);
         hashmap_put(hm, key, keylen, bucket);
         // @TODO: there might be a memory leak for the keys...
         // => anyways need to rewrite this slow hashmap...
@@ -1787,7 +2498,7 @@ namespace tuplex {
         // data is a bucket. Check in combined hashmap hm
         uint8_t* bucket = nullptr;
         int64_hashmap_get(hm, key, reinterpret_cast<any_t*>(&bucket));
-        bucket = combineBuckets(bucket, data);
+        bucket = t_combineState->combineBuckets(bucket, data);
         int64_hashmap_put(hm, key, bucket);
         return MAP_OK;
     }
@@ -1811,7 +2522,7 @@ namespace tuplex {
         }
     }
 
-    HashTableSink LocalBackend::createFinalHashmap(std::vector<IExecutorTask*>& tasks, int hashtableKeyByteWidth, bool combine) {
+    HashTableSink LocalBackend::createFinalHashmap(std::vector<IExecutorTask*>& tasks, int hashtableKeyByteWidth, const AggregateState* combine) {
         if(tasks.empty()) {
             HashTableSink sink;
             if(hashtableKeyByteWidth == 8) sink.hm = int64_hashmap_new();
@@ -1839,9 +2550,10 @@ namespace tuplex {
             }
 
             // merge in null bucket + other buckets from other tables (this could be slow...)
+            t_combineState = combine;
             for(int i = 1; i < tasks.size(); ++i) {
                 auto task_sink = getHashSink(tasks[i]);
-                if(combine) combineBuckets(sink.null_bucket, task_sink.null_bucket);
+                if(combine) sink.null_bucket = combine->combineBuckets(sink.null_bucket, task_sink.null_bucket);
                 else sink.null_bucket = merge_buckets(sink.null_bucket, task_sink.null_bucket);
 
                 // fetch all buckets in hashmap & place into new hashmap
@@ -1863,11 +2575,12 @@ namespace tuplex {
                 delete tasks[i];
                 tasks[i] = nullptr;
             }
+            t_combineState = nullptr;
             return sink;
         }
     }
 
-    void LocalBackend::writeOutput(TransformStage *tstage, std::vector<IExecutorTask*> &tasks) {
+    void LocalBackend::writeOutput(TransformStage *tstage, std::vector<IExecutorTask*> &tasks, size_t firstPartNo) {
         using namespace std;
 
         Timer timer;
@@ -1884,8 +2597,9 @@ namespace tuplex {
         UDF udf = tstage->outputPathUDF();
         auto fmt = tstage->outputFormat();
 
-        // create folder if not clear
-        ensureOutputFolderExists(uri);
+        // create folder if not clear. Streamed part files were written to it already, i.e. must not be removed.
+        if(0 == firstPartNo)
+            ensureOutputFolderExists(uri);
         // count number of output rows in tasks
         size_t numTotalOutputRows = 0;
         vector<Partition *> outputs; // collect all output partitions in this vector
@@ -1897,8 +2611,16 @@ namespace tuplex {
 
         auto ecounts = calcExceptionCounts(tasks);
 
+        // tasks streamed their rows to part files already and nothing got resolved, done.
+        if(firstPartNo > 0 && outputs.empty()) {
+            Logger::instance().defaultLogger().info("streamed " + pluralize(numTotalOutputRows, "row") + " to "
+                                                    + pluralize(firstPartNo, "part file") + " in " + std::to_string(timer.time()) + "s");
+            tstage->setFileResult(ecounts);
+            return;
+        }
+
         // write to one file
-        int partNo = 0;
+        int partNo = firstPartNo;
         auto outputFilePath = outputURI(udf, uri, partNo, fmt);
 
         // check that outputFilePath is NOT empty.
@@ -1935,23 +2657,29 @@ namespace tuplex {
             memcpy(header, (uint8_t *)headerLine.c_str(), header_length);
         }
 
-        // create write tasks (evenly distribute partitions over executors)
+        // create write tasks, one per part file. Parts hold at most splitSize bytes (header included, partitions are
+        // not split), there are at most numOutputFiles parts with the last one taking the rest. Without either, the
+        // partitions are evenly distributed over the executors.
         auto numExecutors = 1 + _options.EXECUTOR_COUNT();
-        size_t bytesPerExecutor = totalBytes / numExecutors;
+        size_t bytesPerPart = header_length + totalBytes / numExecutors;
+        if(numOutputFiles > 0)
+            bytesPerPart = header_length + (totalBytes + numOutputFiles - 1) / numOutputFiles;
+        if(splitSize > 0)
+            bytesPerPart = splitSize;
         vector<Partition*> partitions;
         vector<IExecutorTask*> wtasks;
-        size_t bytesInList = 0;
+        size_t bytesInList = header_length;
         for(const auto& p : outputs) {
-            partitions.push_back(p);
-            bytesInList += p->bytesWritten();
-
-            if(bytesInList >= bytesPerExecutor) {
+            bool lastPart = numOutputFiles > 0 && wtasks.size() + 1 >= numOutputFiles;
+            if(!partitions.empty() && !lastPart && bytesInList + p->bytesWritten() > bytesPerPart) {
                 // spawn task
                 //const URI& uri, uint8_t *header, size_t header_length, const std::vector<Partition *> &partitions
                 wtasks.emplace_back(new SimpleFileWriteTask(outputURI(udf, uri, partNo++, fmt), header, header_length, partitions));
                 partitions.clear();
-                bytesInList = 0;
+                bytesInList = header_length;
             }
+            partitions.push_back(p);
+            bytesInList += p->bytesWritten();
         }
         // add last task (remaining partitions)
         if(!partitions.empty()) {
@@ -1973,4 +2701,28 @@ namespace tuplex {
         Logger::instance().defaultLogger().info("writing output took " + std::to_string(timer.time()) + "s");
         tstage->setFileResult(ecounts);
     }
+
+    size_t LocalBackend::streamOutputToFiles(TransformStage *tstage, std::vector<IExecutorTask*> &tasks) {
+        assert(tstage->outputMode() == EndPointMode::FILE);
+        assert(tstage->outputFormat() == FileFormat::OUTFMT_CSV);
+
+        URI uri = tstage->outputURI();
+        UDF udf = tstage->outputPathUDF();
+        auto fmt = tstage->outputFormat();
+        auto outOptions = tstage->outputOptions();
+
+        // tasks write concurrently, hence the folder needs to exist upfront
+        ensureOutputFolderExists(uri);
+
+        // tasks are created in input order, so numbering parts after task position keeps the output ordered
+        size_t partNo = 0;
+        for(auto task : tasks) {
+            auto ttask = dynamic_cast<TransformTask*>(task);
+            assert(ttask);
+            ttask->sinkOutputToFile(outputURI(udf, uri, partNo++, fmt), outOptions, tstage->outputDataSetID());
+        }
+
+        logger().info("streaming output of stage " + std::to_string(tstage->number()) + " to " + pluralize(partNo, "part file"));
+        return partNo;
+    }
 } // namespace tuplex
\ No newline at end of file
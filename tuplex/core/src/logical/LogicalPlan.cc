@@ -27,6 +27,7 @@
 #include <ApplyVisitor.h>
 #include <logical/AggregateOperator.h>
 #include <FilterBreakdownVisitor.h>
+#include <physical/SampleProcessor.h>
 
 namespace tuplex {
     LogicalPlan::LogicalPlan(LogicalOperator *action) {
@@ -53,7 +54,8 @@ namespace tuplex {
         // options which will change UDFs or the tree require a copy of the plan to operate.
         bool copy_required = context.getOptions().OPT_NULLVALUE_OPTIMIZATION() ||
                              context.getOptions().CSV_PARSER_SELECTION_PUSHDOWN() ||
-                             context.getOptions().OPT_FILTER_PUSHDOWN();
+                             context.getOptions().OPT_FILTER_PUSHDOWN() ||
+                             context.getOptions().OPT_DEAD_COLUMN_ELIMINATION();
 
         // optimize first if desired (context options object)
         // ==> optimize creates a copy if required
@@ -1243,6 +1245,197 @@ namespace tuplex {
         }
     }
 
+    // filters & withColumns in a linear chain can be reordered among each other. Operators followed by a resolver or
+    // ignore stay in place, because these refer to the operator before them.
+    bool isCostReorderable(LogicalOperator* op) {
+        if(op->type() != LogicalOperatorType::FILTER && op->type() != LogicalOperatorType::WITHCOLUMN)
+            return false;
+        if(op->parents().size() != 1 || op->getChildren().size() != 1)
+            return false;
+        auto childType = op->getChildren().front()->type();
+        return childType != LogicalOperatorType::RESOLVE && childType != LogicalOperatorType::IGNORE;
+    }
+
+    // operators in front of a chain which the sample needs to pass through first
+    bool isSampleTraceable(LogicalOperator* op) {
+        switch(op->type()) {
+            case LogicalOperatorType::MAP:
+            case LogicalOperatorType::FILTER:
+            case LogicalOperatorType::WITHCOLUMN:
+            case LogicalOperatorType::MAPCOLUMN:
+            case LogicalOperatorType::RESOLVE:
+            case LogicalOperatorType::IGNORE:
+                return op->parents().size() == 1;
+            default:
+                return false;
+        }
+    }
+
+    /*!
+     * reorders a chain of filters & withColumns using per operator cost and selectivity measured on a sample:
+     * independent filters are ordered by rank = (1 - selectivity) / cost, withColumns are delayed past filters which
+     * don't access their column. Filters which threw on the sample stay behind all operators before them, so that
+     * no new exceptions are introduced.
+     * @return true if the chain got reordered
+     */
+    bool reorderChainByCost(std::vector<LogicalOperator*>& chain) {
+        using namespace std;
+
+        // trace sample from the closest operator which the interpreter can't run through the chain
+        vector<LogicalOperator*> operators(chain.begin(), chain.end());
+        auto source = chain.front()->parent();
+        while(isSampleTraceable(source)) {
+            operators.insert(operators.begin(), source);
+            source = source->parent();
+        }
+        auto sample = source->getSample(MAX_TYPE_SAMPLING_ROWS);
+        if(sample.empty())
+            return false;
+
+        auto profiles = SampleProcessor(operators).profile(sample);
+
+        // rank & whether an operator may move in front of operators before it in the chain
+        auto n = chain.size();
+        vector<double> ranks(n, 0.0);
+        vector<bool> pinned(n, false);
+        for(unsigned i = 0; i < n; ++i) {
+            auto it = profiles.find(chain[i]->getID());
+            if(it == profiles.end() || 0 == it->second.numInputRows || it->second.numExceptions > 0) {
+                pinned[i] = true;
+                continue;
+            }
+            if(chain[i]->type() == LogicalOperatorType::FILTER) {
+                // guard against timer resolution
+                auto cost = std::max(it->second.costPerRow(), 1e-9);
+                ranks[i] = (1.0 - it->second.selectivity()) / cost;
+            }
+        }
+
+        // mustPrecede(i, j) for i < j
+        auto mustPrecede = [&](unsigned i, unsigned j) {
+            if(pinned[j])
+                return true;
+            // withColumns keep their order & are never moved in front of a filter
+            if(chain[j]->type() == LogicalOperatorType::WITHCOLUMN)
+                return true;
+            // filters are independent of each other
+            if(chain[i]->type() == LogicalOperatorType::FILTER)
+                return false;
+
+            // filter j may only move in front of withColumn i if it doesn't access the column i writes
+            auto fop = dynamic_cast<FilterOperator*>(chain[j]); assert(fop);
+            auto wop = dynamic_cast<WithColumnOperator*>(chain[i]); assert(wop);
+            auto cols = fop->parent()->columns();
+            for(auto idx : fop->getUDF().getAccessedColumns()) {
+                if(idx >= cols.size() || cols[idx] == wop->columnToMap())
+                    return true;
+            }
+            return false;
+        };
+
+        // greedy: place among the operators whose predecessors are all placed the one with the highest rank
+        vector<unsigned> order;
+        vector<bool> placed(n, false);
+        while(order.size() < n) {
+            int best = -1;
+            for(unsigned j = 0; j < n; ++j) {
+                if(placed[j])
+                    continue;
+                bool ready = true;
+                for(unsigned i = 0; i < j && ready; ++i)
+                    ready = placed[i] || !mustPrecede(i, j);
+                if(ready && (best < 0 || ranks[j] > ranks[best]))
+                    best = j;
+            }
+            assert(best >= 0);
+            placed[best] = true;
+            order.push_back(best);
+        }
+
+        bool reordered = false;
+        for(unsigned i = 0; i < n; ++i)
+            reordered = reordered || order[i] != i;
+        if(!reordered)
+            return false;
+
+        // rebuild the chain in the new order. Operators are recreated because their schemas depend on the parent.
+        auto parent = chain.front()->parent();
+        auto child = chain.back()->getChildren().front();
+        LogicalOperator* last = parent;
+        std::stringstream ss;
+        for(auto idx : order) {
+            auto op = chain[idx];
+            auto udfop = dynamic_cast<UDFOperator*>(op); assert(udfop);
+            UDF udf(udfop->getUDF().getCode(), udfop->getUDF().getPickledCode());
+            auto allowNumericTypeUnification = udfop->getUDF().allowNumericTypeUnification();
+
+            LogicalOperator* new_op = nullptr;
+            if(op->type() == LogicalOperatorType::FILTER)
+                new_op = new FilterOperator(last, udf, last->columns(), allowNumericTypeUnification);
+            else
+                new_op = new WithColumnOperator(last, last->columns(), dynamic_cast<WithColumnOperator*>(op)->columnToMap(),
+                                                udf, allowNumericTypeUnification);
+            new_op->setID(op->getID()); // keep ID, important for exception tracking!
+
+            // the constructor appended new_op to the children of last, take the place of the old operator instead
+            auto children = last->getChildren();
+            children.erase(std::remove(children.begin(), children.end(), new_op), children.end());
+            if(last == parent)
+                std::replace(children.begin(), children.end(), chain.front(), new_op);
+            else
+                children = {new_op};
+            last->setChildren(children);
+            last = new_op;
+
+            ss<<" "<<op->name()<<"("<<op->getID()<<")";
+        }
+        bool found = child->replaceParent(chain.back(), last);
+        assert(found);
+        last->setChild(child);
+
+        for(auto op : chain) {
+            op->setChildren({}); op->setParents({}); // no dependencies
+            delete op;
+        }
+        chain.clear();
+
+        Logger::instance().defaultLogger().info("reordered operators by measured cost:" + ss.str());
+        return true;
+    }
+
+    void LogicalPlan::reorderByMeasuredCost() {
+        // measuring runs UDFs in the interpreter
+        if(!python::isInterpreterRunning())
+            return;
+
+        // collect maximal chains of reorderable operators, walking from the start of a chain to its end
+        std::vector<std::vector<LogicalOperator*>> chains;
+        std::set<LogicalOperator*> visited;
+        std::queue<LogicalOperator*> q; // BFS
+        q.push(_action);
+        while(!q.empty()) {
+            auto node = q.front(); q.pop();
+            if(visited.count(node))
+                continue;
+            visited.insert(node);
+            if(isCostReorderable(node) && !isCostReorderable(node->parent())) {
+                std::vector<LogicalOperator*> chain{node};
+                while(isCostReorderable(chain.back()->getChildren().front()))
+                    chain.push_back(chain.back()->getChildren().front());
+                bool hasFilter = std::any_of(chain.begin(), chain.end(), [](LogicalOperator* op) {
+                    return op->type() == LogicalOperatorType::FILTER;
+                });
+                if(chain.size() > 1 && hasFilter)
+                    chains.push_back(chain);
+            }
+            for(auto p : node->parents())
+                q.push(p);
+        }
+
+        for(auto& chain : chains)
+            reorderChainByCost(chain);
+    }
+
     void LogicalPlan::reorderDataProcessingOperators() {
         // optimize:
         // ==> i.e. reorder joins that reduce cardinality to bottom if possible!
@@ -1275,6 +1468,9 @@ namespace tuplex {
                 operatorPushup(node);
         }
 
+        // order filters & withColumns by their cost and selectivity on a sample
+        reorderByMeasuredCost();
+
 #ifndef NDEBUG
 #ifdef GENERATE_PDFS
         toPDF("logical_plan_after_join_pushdown.pdf");
@@ -1284,6 +1480,214 @@ namespace tuplex {
 #endif
     }
 
+    // marks input columns accessed by a UDF as live
+    static void markAccessedColumns(std::vector<bool>& live, UDFOperator* op) {
+        for(auto idx : op->getUDF().getAccessedColumns())
+            if(idx < live.size())
+                live[idx] = true;
+    }
+
+    static size_t numOutputColumns(LogicalOperator* op) {
+        auto rowType = op->getOutputSchema().getRowType();
+        return rowType.isTupleType() ? rowType.parameters().size() : 1;
+    }
+
+    // removes a withColumn operator which appends a column that is never used. Operators following it up to the next
+    // map get the columns after it shifted, hence removal requires such a map and no exceptions of the operator.
+    static bool removeAppendedColumn(WithColumnOperator* wop) {
+        auto parent = wop->parent();
+        auto idx = static_cast<size_t>(wop->getColumnIndex());
+        if(idx != numOutputColumns(parent) || wop->getUDF().mayRaise() || wop->getChildren().size() != 1)
+            return false;
+
+        auto child = wop->getChildren().front();
+        if(child->type() == LogicalOperatorType::RESOLVE || child->type() == LogicalOperatorType::IGNORE)
+            return false;
+
+        // collect operators up to the next map, which then computes the same output again
+        std::vector<LogicalOperator*> following;
+        size_t numColumns = idx + 1;
+        auto cur = child;
+        while(true) {
+            following.push_back(cur);
+            numColumns = std::max(numColumns, numOutputColumns(cur));
+            if(cur->type() == LogicalOperatorType::MAP && !dynamic_cast<MapOperator*>(cur)->getUDF().empty())
+                break;
+            switch(cur->type()) {
+                case LogicalOperatorType::WITHCOLUMN:
+                case LogicalOperatorType::MAPCOLUMN:
+                case LogicalOperatorType::FILTER:
+                case LogicalOperatorType::IGNORE:
+                case LogicalOperatorType::MAP:
+                    break;
+                case LogicalOperatorType::RESOLVE: {
+                    // resolvers of mapColumn keep their schema when rewritten
+                    auto np = dynamic_cast<ResolveOperator*>(cur)->getNormalParent();
+                    if(!np || np->type() == LogicalOperatorType::MAPCOLUMN)
+                        return false;
+                    break;
+                }
+                default:
+                    return false;
+            }
+            if(cur->getChildren().size() != 1)
+                return false;
+            cur = cur->getChildren().front();
+        }
+
+        // link parent <-> child
+        bool found = parent->replaceChild(wop, child);
+        assert(found);
+        found = child->replaceParent(wop, parent);
+        assert(found);
+        wop->setChildren({}); wop->setParents({});
+        delete wop;
+
+        // drop the column from the following operators
+        std::unordered_map<size_t, size_t> rewriteMap;
+        for(size_t i = 0; i < numColumns; ++i)
+            if(i != idx)
+                rewriteMap[i] = i < idx ? i : i - 1;
+        for(auto op : following) {
+            if(op->type() == LogicalOperatorType::IGNORE)
+                dynamic_cast<IgnoreOperator*>(op)->updateSchema();
+            else
+                dynamic_cast<UDFOperator*>(op)->rewriteParametersInAST(rewriteMap);
+        }
+        return true;
+    }
+
+    // walks up a chain of operators starting with the given live output columns of op. Operators after which the
+    // analysis has to restart with all columns live (shared parents, joins, aggregates) are added to roots.
+    static size_t eliminateDeadColumnsInChain(LogicalOperator* op, std::vector<bool> live, std::vector<LogicalOperator*>& roots) {
+        size_t numRewritten = 0;
+        std::vector<size_t> resolverCols; // input columns of the normal parent accessed by resolvers
+        while(op) {
+            if(op->parents().size() != 1) {
+                // sources or joins, the latter require all columns of both sides
+                for(auto p : op->parents())
+                    roots.push_back(p);
+                return numRewritten;
+            }
+
+            auto parent = op->parent();
+            auto opType = op->type(); // op may get removed
+            std::vector<bool> liveIn(numOutputColumns(parent), false);
+            switch(opType) {
+                case LogicalOperatorType::TAKE:
+                case LogicalOperatorType::FILEOUTPUT: {
+                    liveIn = std::vector<bool>(liveIn.size(), true);
+                    break;
+                }
+                case LogicalOperatorType::IGNORE: {
+                    liveIn = live;
+                    break;
+                }
+                case LogicalOperatorType::RESOLVE: {
+                    liveIn = live;
+                    auto rop = dynamic_cast<ResolveOperator*>(op); assert(rop);
+                    auto np = rop->getNormalParent(); assert(np);
+                    if(np->type() == LogicalOperatorType::MAPCOLUMN)
+                        resolverCols.push_back(dynamic_cast<MapColumnOperator*>(np)->getColumnIndex());
+                    else {
+                        auto cols = rop->getUDF().getAccessedColumns();
+                        resolverCols.insert(resolverCols.end(), cols.begin(), cols.end());
+                    }
+                    break;
+                }
+                case LogicalOperatorType::FILTER: {
+                    // filters drop rows, hence their columns are always required
+                    liveIn = live;
+                    markAccessedColumns(liveIn, dynamic_cast<UDFOperator*>(op));
+                    break;
+                }
+                case LogicalOperatorType::WITHCOLUMN: {
+                    auto wop = dynamic_cast<WithColumnOperator*>(op); assert(wop);
+                    auto idx = static_cast<size_t>(wop->getColumnIndex());
+                    bool used = idx >= live.size() || live[idx];
+                    for(unsigned i = 0; i < liveIn.size(); ++i)
+                        liveIn[i] = i != idx && i < live.size() && live[i];
+                    if(!used && removeAppendedColumn(wop)) {
+                        numRewritten++;
+                        break;
+                    }
+                    if(!used && wop->getUDF().replaceUnusedOutputsWithConstants({false}))
+                        numRewritten++;
+                    markAccessedColumns(liveIn, wop);
+                    break;
+                }
+                case LogicalOperatorType::MAPCOLUMN: {
+                    // the mapped column still gets passed to the UDF, hence only the computation can be saved
+                    auto mop = dynamic_cast<MapColumnOperator*>(op); assert(mop);
+                    auto idx = static_cast<size_t>(mop->getColumnIndex());
+                    if(idx < live.size() && !live[idx] && mop->getUDF().replaceUnusedOutputsWithConstants({false}))
+                        numRewritten++;
+                    liveIn = live;
+                    if(idx < liveIn.size())
+                        liveIn[idx] = true;
+                    break;
+                }
+                case LogicalOperatorType::MAP: {
+                    auto mop = dynamic_cast<MapOperator*>(op); assert(mop);
+                    if(mop->getUDF().empty()) {
+                        liveIn = live; // rename only
+                        break;
+                    }
+                    if(mop->getUDF().replaceUnusedOutputsWithConstants(live))
+                        numRewritten++;
+                    markAccessedColumns(liveIn, mop);
+                    break;
+                }
+                default: {
+                    // aggregates, caches, ... require all columns
+                    roots.push_back(parent);
+                    return numRewritten;
+                }
+            }
+
+            // resolvers following an operator need its input columns too
+            if(opType != LogicalOperatorType::RESOLVE && opType != LogicalOperatorType::IGNORE) {
+                for(auto idx : resolverCols)
+                    if(idx < liveIn.size())
+                        liveIn[idx] = true;
+                resolverCols.clear();
+            }
+
+            // parents shared with other children get analyzed separately with all columns live
+            if(parent->getChildren().size() != 1) {
+                roots.push_back(parent);
+                return numRewritten;
+            }
+
+            op = parent;
+            live = liveIn;
+        }
+        return numRewritten;
+    }
+
+    void LogicalPlan::eliminateDeadColumns() {
+        // backwards liveness analysis over the columns of each operator, starting at the action.
+        // withColumn operators appending an unused column are removed if they can't raise, the columns of the
+        // operators up to the next map get shifted. Other UDF outputs which are never used get replaced with constants
+        // (unless computing them may raise), so they are not computed and projection pushdown can drop the columns
+        // they were computed from.
+        size_t numRewritten = 0;
+        std::set<LogicalOperator*> visited;
+        std::vector<LogicalOperator*> roots{_action};
+        while(!roots.empty()) {
+            auto root = roots.back(); roots.pop_back();
+            if(visited.count(root))
+                continue;
+            visited.insert(root);
+            std::vector<bool> live(root->isActionable() ? 0 : numOutputColumns(root), true);
+            numRewritten += eliminateDeadColumnsInChain(root, live, roots);
+        }
+
+        if(numRewritten > 0)
+            Logger::instance().defaultLogger().info("eliminated unused outputs of " + std::to_string(numRewritten)
+                                                    + " operator(s)");
+    }
+
     LogicalPlan* LogicalPlan::optimize(const Context& context, bool inPlace) {
 
         using namespace std;
@@ -1320,6 +1724,14 @@ namespace tuplex {
         assert(verifyLogicalPlan(_action));
 #endif
 
+        // remove computations of columns which are never used, before pushing down the required columns
+        if(context.getOptions().OPT_DEAD_COLUMN_ELIMINATION()) {
+            eliminateDeadColumns();
+#ifndef NDEBUG
+            assert(verifyLogicalPlan(_action));
+#endif
+        }
+
         // projectionPushdown (to csv parser etc. if possible)
         // ==> i.e. only parse accessed fields!
         if(context.getOptions().CSV_PARSER_SELECTION_PUSHDOWN()) {
@@ -1337,7 +1749,6 @@ namespace tuplex {
             // note: could remove identity functions...
             // i.e. lambda x: x or lambda x: (x[0], x[1], ..., x[len(x) - 1]) same for def...
 
-            // TODO: optimize unused withColumn and mapColumn operations away!!! ==> people just write bad code...
 #ifndef NDEBUG
             toPDF("logical_plan_after_projection_pushdown.pdf");
 #endif
@@ -118,6 +118,39 @@ namespace tuplex {
             return block;
         }
 
+        void BlockBasedTaskBuilder::cancellationCheckpoint(llvm::IRBuilder<> &builder, llvm::Value *userData,
+                                                           llvm::BasicBlock *bbCancelled) {
+            using namespace llvm;
+
+            if(_cancellationCallbackName.empty())
+                return;
+
+            auto& context = env().getContext();
+            auto func = builder.GetInsertBlock()->getParent(); assert(func);
+
+            // count calls, the first one checks as well
+            auto b = getFirstBlockBuilder(builder);
+            auto counterVar = b.CreateAlloca(env().i64Type(), 0, nullptr, "cancellationCounterVar");
+            b.CreateStore(env().i64Const(0), counterVar);
+            auto counter = builder.CreateLoad(counterVar);
+            builder.CreateStore(builder.CreateAdd(counter, env().i64Const(1)), counterVar);
+
+            BasicBlock* bbCheck = BasicBlock::Create(context, "cancellation_check", func);
+            BasicBlock* bbContinue = BasicBlock::Create(context, "cancellation_continue", func);
+            auto atCheckpoint = builder.CreateICmpEQ(builder.CreateAnd(counter, env().i64Const(cancellationCheckInterval - 1)),
+                                                     env().i64Const(0));
+            builder.CreateCondBr(atCheckpoint, bbCheck, bbContinue);
+
+            // typedef int64_t(*cancel_check_f)(void*);
+            builder.SetInsertPoint(bbCheck);
+            FunctionType *callback_type = FunctionType::get(ctypeToLLVM<int64_t>(context), {ctypeToLLVM<void*>(context)}, false);
+            auto callback_func = env().getModule()->getOrInsertFunction(_cancellationCallbackName, callback_type);
+            auto rc = builder.CreateCall(callback_func, {userData});
+            builder.CreateCondBr(builder.CreateICmpNE(rc, env().i64Const(0)), bbCancelled, bbContinue);
+
+            builder.SetInsertPoint(bbContinue);
+        }
+
         llvm::Value * BlockBasedTaskBuilder::initIntermediate(llvm::IRBuilder<> &builder) {
             // return nullptr if unspecified (triggers default behavior w/o intermediate for pipeline)
             if(_intermediateType == python::Type::UNKNOWN)
@@ -23,11 +23,11 @@ namespace tuplex {
     public:
         VFCSVStreamCursor() = delete;
 
-        explicit VFCSVStreamCursor(const URI &uri, char delimiter, char quotechar, size_t numColumns = 0,
-                                   size_t rangeStart = 0, size_t rangeEnd = 0) :
+        explicit VFCSVStreamCursor(std::unique_ptr<VirtualFile> file, const URI &uri, char delimiter, char quotechar, size_t numColumns = 0,
+                                   size_t rangeStart = 0, size_t rangeEnd = 0, bool rangeRowAligned = false) :
                 _delimiter(delimiter), _quotechar(quotechar),
-                _file(VirtualFileSystem::open_file(uri, VirtualFileMode::VFS_READ)), _numColumns(numColumns),
-                _rangeStart(rangeStart), _rangeEnd(rangeEnd), _curFilePos(0) {
+                _file(std::move(file)), _numColumns(numColumns),
+                _rangeStart(rangeStart), _rangeEnd(rangeEnd), _rangeRowAligned(rangeRowAligned), _curFilePos(0) {
 
             if(!_file)
                 throw std::runtime_error("could not open file " + uri.toPath());
@@ -192,6 +192,7 @@ namespace tuplex {
         size_t _numColumns;
         size_t _rangeStart;
         size_t _rangeEnd;
+        bool _rangeRowAligned;
         size_t _curFilePos;
 
 
@@ -210,6 +211,16 @@ namespace tuplex {
                 return 0;
             }
 
+            // exact split, rangeStart is a row start. rangeEnd is one as well, hence never read beyond it.
+            if(_rangeRowAligned) {
+                _file->seek(_rangeStart);
+                size_t bytesRead = 0;
+                auto nbytes_max_to_read = std::min(vec_.size() - write_pos_ - 33, _rangeEnd - _rangeStart);
+                _file->read(&vec_[write_pos_], nbytes_max_to_read, &bytesRead);
+                write_pos_ = bytesRead;
+                return 0;
+            }
+
             // fill initial buffer starting from rangeStart
             assert(_rangeStart >= 128); // sanity check
 
@@ -305,7 +316,7 @@ namespace tuplex {
             if(_rangeStart < _rangeEnd) {
 
                 // sanity check
-                assert(_rangeEnd - _rangeStart >= 256); // range should be at least 256bytes for a row!
+                assert(_rangeRowAligned || _rangeEnd - _rangeStart >= 256); // range should be at least 256bytes for a row!
 
                 getChunkStart();
 
@@ -411,7 +422,7 @@ namespace tuplex {
             throw std::runtime_error("functor not initialized");
 
         // create cursor
-        VFCSVStreamCursor cursor(inputFilePath, _delimiter, _quotechar, _numColumns, _rangeStart, _rangeEnd);
+        VFCSVStreamCursor cursor(openInputFile(inputFilePath), inputFilePath, _delimiter, _quotechar, _numColumns, _rangeStart, _rangeEnd, _rangeRowAligned);
 
         // read using csvmonkey
         csvmonkey::CsvReader<> reader(cursor, _delimiter, _quotechar);
@@ -618,6 +629,10 @@ namespace tuplex {
             }
             rowNumber++;
 
+            // leave the rest of the range when the task got cancelled
+            if(0 == (rowNumber & (codegen::cancellationCheckInterval - 1)) && cancelled())
+                break;
+
             // check whether curFilePos (i.e. the one where current offset is) of cursor is larger than rangeEnd, if so end parse
             // when ranges are used
             if(_rangeEnd != 0 && cursor.curFilePos() >= _rangeEnd)
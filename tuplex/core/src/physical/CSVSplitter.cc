@@ -0,0 +1,90 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <physical/CSVSplitter.h>
+#include <CSVUtils.h>
+#include <VirtualFileSystem.h>
+#include <atomic>
+#include <future>
+
+namespace tuplex {
+
+    static CSVChunkParity scanChunk(const URI& uri, size_t offset, size_t length, char quotechar) {
+        auto fp = VirtualFileSystem::open_file(uri, VirtualFileMode::VFS_READ);
+        if(!fp)
+            throw std::runtime_error("could not open " + uri.toPath() + " to split it");
+        if(offset > 0 && fp->seek(offset) != VirtualFileSystemStatus::VFS_OK)
+            throw std::runtime_error("could not seek to " + std::to_string(offset) + " in " + uri.toPath());
+
+        const size_t blockSize = std::min(length, 4 * 1024 * 1024ul);
+        std::unique_ptr<char[]> buf(new char[blockSize]);
+
+        CSVChunkParity info;
+        size_t remaining = length;
+        while(remaining > 0) {
+            size_t bytesRead = 0;
+            fp->read(buf.get(), std::min(remaining, blockSize), &bytesRead);
+            if(0 == bytesRead)
+                break;
+            info = combineChunkParity(info, csvChunkParity(buf.get(), bytesRead, quotechar));
+            remaining -= bytesRead;
+        }
+        fp->close();
+
+        if(info.size != length)
+            throw std::runtime_error("could only read " + std::to_string(info.size) + " of "
+                                     + std::to_string(length) + " bytes at offset " + std::to_string(offset)
+                                     + " from " + uri.toPath());
+        return info;
+    }
+
+    std::vector<size_t> csvSplitOffsets(const URI& uri, size_t fileSize, size_t splitSize, char quotechar, size_t numThreads) {
+        if(0 == splitSize || fileSize <= splitSize)
+            return std::vector<size_t>{0};
+
+        // the last chunk holds the remainder (like the split logic in the backend)
+        size_t numChunks = fileSize / splitSize;
+        auto chunkStart = [&](size_t i) { return i * splitSize; };
+        auto chunkEnd = [&](size_t i) { return i + 1 == numChunks ? fileSize : (i + 1) * splitSize; };
+
+        // 1st pass: quote parity of each chunk, chunks are assigned dynamically to the threads
+        std::vector<CSVChunkParity> chunks(numChunks);
+        std::atomic<size_t> nextChunk(0);
+        std::vector<std::future<void>> workers;
+        numThreads = std::max(1ul, std::min(numThreads, numChunks));
+        for(unsigned t = 0; t < numThreads; ++t) {
+            workers.emplace_back(std::async(std::launch::async, [&]() {
+                size_t i = 0;
+                while((i = nextChunk++) < numChunks)
+                    chunks[i] = scanChunk(uri, chunkStart(i), chunkEnd(i) - chunkStart(i), quotechar);
+            }));
+        }
+        for(auto& w : workers)
+            w.get(); // rethrows IO errors
+
+        // 2nd pass: chunk i starts within a quoted field iff the quotes before it are odd
+        std::vector<size_t> offsets{0};
+        size_t numQuotes = 0;
+        for(size_t i = 0; i < numChunks; ++i) {
+            if(i > 0) {
+                auto lineEnd = chunks[i].firstLineEnd[numQuotes & 0x1u];
+                // no row starts in this chunk (i.e. a multi-line field spans it), the current split grows
+                if(lineEnd >= 0) {
+                    auto offset = chunkStart(i) + lineEnd + 1;
+                    if(offset < fileSize)
+                        offsets.push_back(offset);
+                }
+            }
+            numQuotes += chunks[i].numQuotes;
+        }
+
+        return offsets;
+    }
+}
@@ -0,0 +1,148 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <physical/ExceptionCounts.h>
+#include <algorithm>
+
+namespace tuplex {
+
+    ExceptionCountIndex::ExceptionCountIndex(std::vector<int64_t> operatorIDs) : _operatorIDs(std::move(operatorIDs)) {
+        std::sort(_operatorIDs.begin(), _operatorIDs.end());
+        _operatorIDs.erase(std::unique(_operatorIDs.begin(), _operatorIDs.end()), _operatorIDs.end());
+    }
+
+    int64_t ExceptionCountIndex::codeSlot(ExceptionCode ec) {
+        auto code = ecToI64(ec);
+        if(code >= 0 && code < EXCEPTION_CODE_FRAMEWORK_END)
+            return code;
+        if(code >= EXCEPTION_CODE_PYTHON_BEGIN && code < EXCEPTION_CODE_PYTHON_END)
+            return NUM_FRAMEWORK_SLOTS + code - EXCEPTION_CODE_PYTHON_BEGIN;
+        if(ec == ExceptionCode::RE_ERROR)
+            return NUM_FRAMEWORK_SLOTS + NUM_PYTHON_SLOTS;
+        return -1;
+    }
+
+    ExceptionCode ExceptionCountIndex::slotCode(size_t codeSlot) {
+        assert(codeSlot < NUM_CODE_SLOTS);
+        if(codeSlot < NUM_FRAMEWORK_SLOTS)
+            return i64ToEC(codeSlot);
+        if(codeSlot < NUM_FRAMEWORK_SLOTS + NUM_PYTHON_SLOTS)
+            return i64ToEC(EXCEPTION_CODE_PYTHON_BEGIN + codeSlot - NUM_FRAMEWORK_SLOTS);
+        return ExceptionCode::RE_ERROR;
+    }
+
+    int64_t ExceptionCountIndex::slot(int64_t opID, ExceptionCode ec) const {
+        // stages have a handful of operators, so a binary search is cheaper than hashing
+        auto it = std::lower_bound(_operatorIDs.begin(), _operatorIDs.end(), opID);
+        if(it == _operatorIDs.end() || *it != opID)
+            return -1;
+        auto code = codeSlot(ec);
+        if(code < 0)
+            return -1;
+        return (it - _operatorIDs.begin()) * NUM_CODE_SLOTS + code;
+    }
+
+    std::tuple<int64_t, ExceptionCode> ExceptionCountIndex::key(size_t slot) const {
+        assert(slot < size());
+        return std::make_tuple(_operatorIDs[slot / NUM_CODE_SLOTS], slotCode(slot % NUM_CODE_SLOTS));
+    }
+
+    void ExceptionCounts::add(const ExceptionCounts &other) {
+        // pairs outside of the index don't prevent adopting it, i.e. later merges stay a single pass
+        if(!_index && _counts.empty())
+            _index = other._index;
+
+        for(const auto& keyval : other._overflow)
+            _overflow[keyval.first] += keyval.second;
+
+        if(other._counts.empty())
+            return;
+
+        if(_index == other._index) {
+            if(_counts.empty())
+                _counts = other._counts;
+            else {
+                assert(_counts.size() == other._counts.size());
+                for(unsigned i = 0; i < _counts.size(); ++i)
+                    _counts[i] += other._counts[i];
+            }
+        } else {
+            // different stages, go over the pairs
+            for(unsigned i = 0; i < other._counts.size(); ++i)
+                if(other._counts[i] > 0) {
+                    auto key = other._index->key(i);
+                    inc(std::get<0>(key), std::get<1>(key), other._counts[i]);
+                }
+        }
+    }
+
+    bool ExceptionCounts::empty() const {
+        if(!_overflow.empty())
+            return false;
+        return std::all_of(_counts.begin(), _counts.end(), [](size_t c) { return c == 0; });
+    }
+
+    std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> ExceptionCounts::toMap() const {
+        auto m = _overflow;
+        for(unsigned i = 0; i < _counts.size(); ++i)
+            if(_counts[i] > 0)
+                m[_index->key(i)] += _counts[i];
+        return m;
+    }
+
+    ConcurrentExceptionCounts::ConcurrentExceptionCounts(std::shared_ptr<const ExceptionCountIndex> index) : _index(index),
+                                                                                                        _size(index ? index->size() : 0),
+                                                                                                        _counts(new std::atomic<size_t>[_size]) {
+        reset();
+    }
+
+    void ConcurrentExceptionCounts::add(const ExceptionCounts &counts) {
+        if(!counts._counts.empty()) {
+            if(counts._index == _index) {
+                for(unsigned i = 0; i < _size; ++i)
+                    if(counts._counts[i] > 0)
+                        _counts[i].fetch_add(counts._counts[i], std::memory_order_relaxed);
+            } else {
+                // counted against another index, e.g. the task was created for another stage
+                std::lock_guard<std::mutex> lock(_overflowMutex);
+                for(unsigned i = 0; i < counts._counts.size(); ++i)
+                    if(counts._counts[i] > 0)
+                        _overflow[counts._index->key(i)] += counts._counts[i];
+            }
+        }
+
+        if(!counts._overflow.empty()) {
+            std::lock_guard<std::mutex> lock(_overflowMutex);
+            for(const auto& keyval : counts._overflow)
+                _overflow[keyval.first] += keyval.second;
+        }
+    }
+
+    void ConcurrentExceptionCounts::reset() {
+        for(unsigned i = 0; i < _size; ++i)
+            _counts[i] = 0;
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+        _overflow.clear();
+    }
+
+    std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> ConcurrentExceptionCounts::snapshot() const {
+        std::unordered_map<std::tuple<int64_t, ExceptionCode>, size_t> m;
+        {
+            std::lock_guard<std::mutex> lock(_overflowMutex);
+            m = _overflow;
+        }
+        for(unsigned i = 0; i < _size; ++i) {
+            auto c = _counts[i].load(std::memory_order_relaxed);
+            if(c > 0)
+                m[_index->key(i)] += c;
+        }
+        return m;
+    }
+}
@@ -0,0 +1,64 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <physical/HeavyHitterSketch.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace tuplex {
+
+    HeavyHitterSketch::HeavyHitterSketch(size_t capacity) : _capacity(capacity), _total(0) {
+        if(0 == capacity)
+            throw std::runtime_error("heavy hitter sketch needs at least one counter");
+        _counters.reserve(capacity);
+    }
+
+    size_t HeavyHitterSketch::add(const std::string &key, size_t count) {
+        _total += count;
+
+        auto it = _index.find(key);
+        if(it != _index.end()) {
+            _counters[it->second].count += count;
+            return _counters[it->second].count;
+        }
+
+        if(_counters.size() < _capacity) {
+            _index[key] = _counters.size();
+            _counters.push_back(Counter{key, count, 0});
+            return count;
+        }
+
+        // replace the smallest counter, the new key inherits its count as error
+        auto pos = std::min_element(_counters.begin(), _counters.end(), [](const Counter& a, const Counter& b) {
+            return a.count < b.count;
+        }) - _counters.begin();
+        auto& c = _counters[pos];
+        _index.erase(c.key);
+        c.error = c.count;
+        c.count += count;
+        c.key = key;
+        _index[key] = pos;
+        return c.count;
+    }
+
+    size_t HeavyHitterSketch::estimate(const std::string &key) const {
+        auto it = _index.find(key);
+        return it != _index.end() ? _counters[it->second].count : 0;
+    }
+
+    std::vector<HeavyHitterSketch::Counter> HeavyHitterSketch::heavyHitters(size_t minCount) const {
+        std::vector<Counter> res;
+        for(const auto& c : _counters)
+            if(c.count >= minCount)
+                res.push_back(c);
+        std::sort(res.begin(), res.end(), [](const Counter& a, const Counter& b) { return a.count > b.count; });
+        return res;
+    }
+}
@@ -36,11 +36,7 @@ namespace tuplex {
         incNumRows();
 
         // add to counts
-        auto key = make_tuple(exceptionOperatorID, i32ToEC(exceptionCode));
-        auto it = _exceptionCounts.find(key);
-        if(it == _exceptionCounts.end())
-            _exceptionCounts[key] = 0;
-        _exceptionCounts[key]++;
+        _exceptionCounts.inc(exceptionOperatorID, i32ToEC(exceptionCode));
     }
 
     void IExceptionableTask::makeSpace(Executor *owner, const Schema& schema, size_t size) {
@@ -9,9 +9,14 @@
 //--------------------------------------------------------------------------------------------------------------------//
 
 #include <physical/IExecutorTask.h>
+#include <Signals.h>
 
 namespace tuplex {
 
+    bool IExecutorTask::isCancelled() const {
+        return check_interrupted();
+    }
+
     size_t IExecutorTask::getNumOutputRows() const {
         size_t num = 0;
         for(auto p : getOutputPartitions())
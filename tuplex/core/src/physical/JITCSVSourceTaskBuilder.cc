@@ -330,6 +330,7 @@ namespace tuplex {
             BasicBlock *bLoopCond = BasicBlock::Create(context, "loopCond", read_block_func);
             BasicBlock *bLoopDone = BasicBlock::Create(context, "loopDone", read_block_func);
             BasicBlock *bLoopBody = BasicBlock::Create(context, "loopBody", read_block_func);
+            BasicBlock *bLoopCancelled = BasicBlock::Create(context, "loopCancelled", read_block_func);
 
             // parse first row
             auto parseCode = builder.CreateCall(parseRowF, {resStructVar, builder.CreateLoad(currentPtrVar, "readPtr"), endPtr}, "parseCode");
@@ -344,6 +345,7 @@ namespace tuplex {
 #ifdef TRACE_PARSER
             env().debugPrint(builder, "entered loop body, readPtr=", builder.CreatePtrToInt(builder.CreateLoad(currentPtrVar, "readPtr"), env().i64Type()));
 #endif
+            cancellationCheckpoint(builder, argUserData, bLoopCancelled);
 
             // process row here -- BEGIN
             processRow(builder, argUserData, builder.CreateLoad(parseCodeVar), resStructVar, normalRowCountVar, badRowCountVar, outputRowNumberVar, nullptr, nullptr, pipFunc);
@@ -403,6 +405,14 @@ namespace tuplex {
 
 
 
+            // cancelled, the row parsed last is not processed yet. Hence, report all bytes up to its start as consumed
+            builder.SetInsertPoint(bLoopCancelled);
+            {
+                auto rowStart = builder.CreateLoad(builder.CreateGEP(resStructVar, {env().i32Const(0), env().i32Const(1)}));
+                builder.CreateRet(builder.CreateSub(builder.CreatePtrToInt(rowStart, env().i64Type()),
+                                                    builder.CreatePtrToInt(argInPtr, env().i64Type())));
+            }
+
             // -- block start --
             builder.SetInsertPoint(bLoopDone);
 #ifdef TRACE_PARSER
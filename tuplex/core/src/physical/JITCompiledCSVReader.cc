@@ -141,7 +141,7 @@ namespace tuplex {
 #endif
 
         // iterate over input file, fill up buffer and call consume
-        auto fp = VirtualFileSystem::open_file(uri, VirtualFileMode::VFS_READ);
+        auto fp = openInputFile(uri);
         if(!fp)
             throw std::runtime_error("could not open " + uri.toPath() + " in read mode.");
 
@@ -155,20 +155,27 @@ namespace tuplex {
         _inBufferLength = 0;
         size_t rangeBytesRead = 0;
 
-        int readBeforeSize = 16; // read 16 bytes before rangeStart, must be > 2 for lookback if the first field is hit accidentally
+        int readBeforeSize = _rangeRowAligned ? 0 : 16; // read 16 bytes before rangeStart, must be > 2 for lookback if the first field is hit accidentally
 
 
         bool useRange = this->useRange(); // important to call this here
 
         // if ranges are used, seek to rangeStart
         if(useRange && _rangeStart != 0) {
-            assert(_rangeStart > readBeforeSize);
+            assert(_rangeStart >= readBeforeSize);
             // seek file to range start
             fp->seek(_rangeStart - readBeforeSize);
         }
 
         bool firstBlock = true;
+        bool stoppedEarly = false;
         while(!fp->eof()) {
+            // the functor stops at a checkpoint when the task got cancelled, leave the rest of the range
+            if(cancelled()) {
+                stoppedEarly = true;
+                break;
+            }
+
             // fill buffer with start
             size_t bytesToRead = _bufferSize - _inBufferLength;
             assert(bytesToRead <= _bufferSize);
@@ -188,8 +195,8 @@ namespace tuplex {
                 int csvStartOffset = 0;
                 if(useRange) {
 
-                    // when rangestart is 0, nothing todo
-                    if(_rangeStart == 0) {
+                    // when rangestart is 0 or known to be a row start, nothing todo
+                    if(_rangeStart == 0 || _rangeRowAligned) {
                         // nothing todo
                     } else {
                         // _inputBuffer contains a couple bytes before the start of the range, need for look back
@@ -269,6 +276,12 @@ namespace tuplex {
 
             assert(bytesConsumed <= _bufferSize);
 
+            // functor returned at a cancellation checkpoint, possibly without consuming anything
+            if(cancelled()) {
+                stoppedEarly = true;
+                break;
+            }
+
             if(0 == bytesConsumed && _inBufferLength == _bufferSize) { //@TODO: test for this!!!
                 // this case is assumed if the line is larger than the buffer!!!
                 // --> needs to be handled separately
@@ -306,7 +319,7 @@ namespace tuplex {
 
             // either the read range is larger than the range End xor
             // the rangeend is larger than the actual file size
-            assert(_rangeStart + rangeBytesRead >= _rangeEnd || _rangeEnd > fsize);
+            assert(stoppedEarly || _rangeStart + rangeBytesRead >= _rangeEnd || _rangeEnd > fsize);
         }
         Logger::instance().defaultLogger().info("CSV read done: " + pluralize(_num_normal_rows, "normal row") + " / " + pluralize(_num_bad_rows, "exceptional row"));
 #endif
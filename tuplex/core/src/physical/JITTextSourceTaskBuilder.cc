@@ -0,0 +1,240 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <physical/JITTextSourceTaskBuilder.h>
+#include <CodegenHelper.h>
+
+// #define TRACE_PARSER
+
+namespace tuplex {
+    namespace codegen {
+        llvm::Function* JITTextSourceTaskBuilder::build() {
+
+            // check if pipeline exists
+            if(pipeline()) {
+                auto processRowFunc = pipeline()->getFunction();
+                if(!processRowFunc)
+                    throw std::runtime_error("invalid function from pipeline builder in JITTextSourceTaskBuilder");
+            }
+
+            // build wrapper function
+            auto func = createFunction();
+
+            // build all necessary ingredients
+            createMainLoop(func);
+
+            return func;
+        }
+
+        llvm::Value* JITTextSourceTaskBuilder::findNewline(llvm::IRBuilder<> &builder, llvm::Value *ptr,
+                                                           llvm::Value *endPtr) {
+            using namespace llvm;
+
+            // void* memchr(const void*, int, size_t), libc's version uses SSE2/AVX2 to scan the buffer.
+            FunctionType *memchr_type = FunctionType::get(env().i8ptrType(), {env().i8ptrType(),
+                                                                              env().i32Type(),
+                                                                              env().i64Type()}, false);
+            auto memchr_func = env().getModule()->getOrInsertFunction("memchr", memchr_type);
+            auto numBytes = builder.CreateSub(builder.CreatePtrToInt(endPtr, env().i64Type()),
+                                              builder.CreatePtrToInt(ptr, env().i64Type()));
+            return builder.CreateCall(memchr_func, {ptr, env().i32Const('\n'), numBytes});
+        }
+
+        void JITTextSourceTaskBuilder::processRow(llvm::IRBuilder<> &builder,
+                                                  llvm::Value *userData,
+                                                  llvm::Value *linePtr,
+                                                  llvm::Value *lineSize,
+                                                  llvm::Value *normalRowCountVar,
+                                                  llvm::Value *badRowCountVar,
+                                                  llvm::Value *outputRowNumberVar,
+                                                  llvm::Function *processRowFunc) {
+            using namespace llvm;
+            auto& context = env().getContext();
+
+            FlattenedTuple ft(&env());
+            ft.init(_inputRowType);
+
+            BasicBlock* bbProcessEnd = BasicBlock::Create(context, "line_done", builder.GetInsertBlock()->getParent());
+
+            if(_columnsToSerialize.front()) {
+                auto t = _fileInputRowType.parameters().front();
+                llvm::Value* isnull = nullptr;
+
+                if(!_nullValues.empty()) {
+                    // line is zero terminated, so null value comparison can be performed directly
+                    isnull = env().compareToNullValues(builder, linePtr, _nullValues, true);
+
+                    // normal case is not an option type, i.e. a null line is an internal exception
+                    if(!t.isOptionType()) {
+                        BasicBlock* bbNullCheckPassed = BasicBlock::Create(context, "line_null_check_passed", builder.GetInsertBlock()->getParent());
+                        BasicBlock* bbNullError = BasicBlock::Create(context, "line_null_error", builder.GetInsertBlock()->getParent());
+                        builder.CreateCondBr(isnull, bbNullError, bbNullCheckPassed);
+
+                        builder.SetInsertPoint(bbNullError);
+                        FlattenedTuple badRow(&env());
+                        badRow.init(_inputRowType);
+                        badRow.setElement(builder, 0, linePtr, lineSize, nullptr);
+                        auto serialized_row = badRow.serializeToMemory(builder);
+                        auto oldBlock = builder.GetInsertBlock();
+                        auto bbException = exceptionBlock(builder, userData,
+                                                          env().i64Const(ecToI64(ExceptionCode::NULLERROR)),
+                                                          env().i64Const(_operatorID),
+                                                          builder.CreateLoad(outputRowNumberVar),
+                                                          serialized_row.val, serialized_row.size);
+                        builder.CreateStore(builder.CreateAdd(builder.CreateLoad(outputRowNumberVar), env().i64Const(1)), outputRowNumberVar);
+                        builder.CreateStore(builder.CreateAdd(builder.CreateLoad(badRowCountVar), env().i64Const(1)), badRowCountVar);
+                        builder.CreateBr(bbProcessEnd);
+                        builder.SetInsertPoint(oldBlock);
+                        builder.CreateBr(bbException);
+
+                        builder.SetInsertPoint(bbNullCheckPassed);
+                        isnull = nullptr;
+                    }
+                }
+
+                ft.setElement(builder, 0, linePtr, lineSize, isnull);
+            }
+
+            builder.CreateStore(builder.CreateAdd(builder.CreateLoad(normalRowCountVar), env().i64Const(1)), normalRowCountVar);
+
+            if(processRowFunc) {
+                auto res = PipelineBuilder::call(builder, processRowFunc, ft,
+                                                 userData, builder.CreateLoad(outputRowNumberVar),
+                                                 initIntermediate(builder));
+
+                auto ecCode = builder.CreateZExtOrTrunc(res.resultCode, env().i64Type());
+                auto ecOpID = builder.CreateZExtOrTrunc(res.exceptionOperatorID, env().i64Type());
+                auto numRowsCreated = builder.CreateZExtOrTrunc(res.numProducedRows, env().i64Type());
+
+                auto exceptionRaised = builder.CreateICmpNE(ecCode, env().i64Const(ecToI32(ExceptionCode::SUCCESS)));
+
+                llvm::BasicBlock* bbNoException = llvm::BasicBlock::Create(context, "pipeline_ok", builder.GetInsertBlock()->getParent());
+
+                // create exception block, serialize input row depending on result
+                // note: creating exception block automatically sets builder to this block
+                auto serialized_row = ft.serializeToMemory(builder);
+                auto outputRowNumber = builder.CreateLoad(outputRowNumberVar);
+                llvm::BasicBlock* curBlock = builder.GetInsertBlock();
+                llvm::BasicBlock* bbException = exceptionBlock(builder, userData, ecCode, ecOpID,
+                                                               outputRowNumber, serialized_row.val, serialized_row.size);
+                builder.CreateBr(bbNoException);
+
+                // add branching to previous block
+                builder.SetInsertPoint(curBlock);
+                builder.CreateCondBr(exceptionRaised, bbException, bbNoException);
+
+                builder.SetInsertPoint(bbNoException);
+                // outputRowNumber += numRowsCreated
+                builder.CreateStore(builder.CreateAdd(builder.CreateLoad(outputRowNumberVar), numRowsCreated), outputRowNumberVar);
+            }
+            builder.CreateBr(bbProcessEnd);
+
+            builder.SetInsertPoint(bbProcessEnd);
+
+            // row is processed, so free runtime memory allocated for processing this row...
+            env().freeAll(builder);
+        }
+
+        void JITTextSourceTaskBuilder::createMainLoop(llvm::Function *read_block_func) {
+            using namespace llvm;
+            using namespace std;
+
+            assert(read_block_func);
+
+            auto& context = env().getContext();
+
+            auto pipFunc = pipeline() ? pipeline()->getFunction() : nullptr;
+
+            auto argUserData = arg("userData");
+            auto argInPtr = arg("inPtr");
+            auto argInSize = arg("inSize");
+            auto argOutNormalRowCount = arg("outNormalRowCount");
+            auto argOutBadRowCount = arg("outBadRowCount");
+            auto argIgnoreLastRow = arg("ignoreLastRow");
+
+            BasicBlock *bbBody = BasicBlock::Create(context, "entry", read_block_func);
+            IRBuilder<> builder(bbBody);
+
+            Value *endPtr = builder.CreateGEP(argInPtr, argInSize, "endPtr");
+            Value *currentPtrVar = builder.CreateAlloca(env().i8ptrType(), 0, nullptr, "readPtrVar");
+            Value *lineEndVar = builder.CreateAlloca(env().i8ptrType(), 0, nullptr, "lineEndVar");
+            Value *nextPtrVar = builder.CreateAlloca(env().i8ptrType(), 0, nullptr, "nextPtrVar");
+            Value *outputRowNumberVar = builder.CreateAlloca(env().i64Type(), 0, nullptr, "outputRowNumberVar");
+            builder.CreateStore(argInPtr, currentPtrVar);
+            builder.CreateStore(builder.CreateAdd(builder.CreateLoad(argOutBadRowCount), builder.CreateLoad(argOutNormalRowCount)), outputRowNumberVar);
+
+            BasicBlock *bLoopCond = BasicBlock::Create(context, "loopCond", read_block_func);
+            BasicBlock *bLoopBody = BasicBlock::Create(context, "loopBody", read_block_func);
+            BasicBlock *bNewline = BasicBlock::Create(context, "newline_found", read_block_func);
+            BasicBlock *bNoNewline = BasicBlock::Create(context, "newline_not_found", read_block_func);
+            BasicBlock *bLastLine = BasicBlock::Create(context, "last_line", read_block_func);
+            BasicBlock *bLine = BasicBlock::Create(context, "line", read_block_func);
+            BasicBlock *bLoopDone = BasicBlock::Create(context, "loopDone", read_block_func);
+            builder.CreateBr(bLoopCond);
+
+            // condition: readPtr < endPtr
+            builder.SetInsertPoint(bLoopCond);
+            Value *cond = builder.CreateICmpULT(builder.CreatePtrToInt(builder.CreateLoad(currentPtrVar, "readPtr"), env().i64Type()),
+                                                builder.CreatePtrToInt(endPtr, env().i64Type()));
+            builder.CreateCondBr(cond, bLoopBody, bLoopDone);
+
+            // body: search for next '\n'
+            builder.SetInsertPoint(bLoopBody);
+            // on cancellation, the current line is left unconsumed
+            cancellationCheckpoint(builder, argUserData, bLoopDone);
+            auto readPtr = builder.CreateLoad(currentPtrVar, "readPtr");
+            auto newlinePtr = findNewline(builder, readPtr, endPtr);
+            builder.CreateCondBr(builder.CreateICmpEQ(newlinePtr, env().i8nullptr()), bNoNewline, bNewline);
+
+            builder.SetInsertPoint(bNewline);
+            builder.CreateStore(newlinePtr, lineEndVar);
+            builder.CreateStore(builder.CreateGEP(newlinePtr, env().i32Const(1)), nextPtrVar);
+            builder.CreateBr(bLine);
+
+            // no newline found => either partial line (more data to come) or last line of the file
+            builder.SetInsertPoint(bNoNewline);
+            builder.CreateCondBr(env().booleanToCondition(builder, argIgnoreLastRow), bLoopDone, bLastLine);
+
+            builder.SetInsertPoint(bLastLine);
+            builder.CreateStore(endPtr, lineEndVar);
+            builder.CreateStore(endPtr, nextPtrVar);
+            builder.CreateBr(bLine);
+
+            // process line [readPtr, lineEnd), strip '\r' of '\r\n' line endings and zero terminate in place
+            builder.SetInsertPoint(bLine);
+            auto lineEnd = builder.CreateLoad(lineEndVar);
+            auto lineLength = builder.CreateSub(builder.CreatePtrToInt(lineEnd, env().i64Type()),
+                                                builder.CreatePtrToInt(readPtr, env().i64Type()));
+            auto lastCharPtr = builder.CreateGEP(lineEnd, env().i64Const(-1));
+            // note: select to avoid reading before the buffer start for empty lines
+            auto lastChar = builder.CreateLoad(builder.CreateSelect(builder.CreateICmpSGT(lineLength, env().i64Const(0)),
+                                                                    lastCharPtr, lineEnd));
+            auto hasCR = builder.CreateICmpEQ(lastChar, env().i8Const('\r'));
+            lineLength = builder.CreateSelect(hasCR, builder.CreateSub(lineLength, env().i64Const(1)), lineLength);
+            builder.CreateStore(env().i8Const('\0'), builder.CreateGEP(readPtr, lineLength));
+
+#ifdef TRACE_PARSER
+            env().debugPrint(builder, "line: ", readPtr);
+#endif
+            processRow(builder, argUserData, readPtr, builder.CreateAdd(lineLength, env().i64Const(1)),
+                       argOutNormalRowCount, argOutBadRowCount, outputRowNumberVar, pipFunc);
+            builder.CreateStore(builder.CreateLoad(nextPtrVar), currentPtrVar);
+            builder.CreateBr(bLoopCond);
+
+            // done, return how many bytes were consumed (partial lines are left for the next call)
+            builder.SetInsertPoint(bLoopDone);
+            if(!_intermediateCallbackName.empty())
+                writeIntermediate(builder, argUserData, _intermediateCallbackName);
+            auto bytesConsumed = builder.CreateSub(builder.CreatePtrToInt(builder.CreateLoad(currentPtrVar), env().i64Type()),
+                                                   builder.CreatePtrToInt(argInPtr, env().i64Type()));
+            builder.CreateRet(bytesConsumed);
+        }
+    }
+}
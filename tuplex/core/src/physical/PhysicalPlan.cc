@@ -13,6 +13,7 @@
 #include <physical/HashJoinStage.h>
 #include <physical/AggregateStage.h>
 #include <physical/StageBuilder.h>
+#include <physical/HeavyHitterSketch.h>
 #include <logical/ParallelizeOperator.h>
 #include <logical/FileInputOperator.h>
 #include <logical/MapOperator.h>
@@ -26,9 +27,111 @@
 #include <logical/CacheOperator.h>
 #include <RuntimeInterface.h>
 #include <Signals.h>
+#include <RuntimeMetrics.h>
+#include <mutex>
 
 namespace tuplex {
 
+    // jobs of a context may finish at the same time (cf. tuplex.scheduler.multiJob)
+    static std::mutex metricsMutex;
+
+    // at most that many heavy hitters per hash table, each costs tasks a comparison per row
+    static const size_t MAX_HOT_KEYS = 8;
+
+    // key of a sample row as tasks pass it to the hash table (strings incl. '\0', ints as 8 bytes). False for the null bucket
+    static bool sampleHashKey(const Row& row, size_t col, std::string& key) {
+        if(col >= row.getNumColumns() || row.get(col).isNull())
+            return false;
+        auto type = row.getType(col).withoutOptions();
+        if(type == python::Type::STRING) {
+            key = row.getString(col);
+            key.push_back('\0');
+            return true;
+        }
+        if(type == python::Type::I64) {
+            auto i = row.getInt(col);
+            key.assign(reinterpret_cast<const char*>(&i), sizeof(int64_t));
+            return true;
+        }
+        return false;
+    }
+
+    static bool hashableKeyType(const python::Type& keyType) {
+        return keyType.withoutOptions() == python::Type::STRING || keyType.withoutOptions() == python::Type::I64;
+    }
+
+    /*!
+     * heavy hitters of the hash table keyed by column keyCol of op's output. Counts of op's sample are scaled
+     * to op's estimated number of rows, keys occurring at least twice in the sample and estimated to hold
+     * tuplex.hotKeyRows rows are hot.
+     */
+    static std::vector<std::string> hotKeysFromSample(LogicalOperator* op, size_t keyCol, const ContextOptions& options) {
+        std::vector<std::string> keys;
+        if(0 == options.HOT_KEY_ROWS() || 0 == options.HOT_KEY_SKETCH_SIZE())
+            return keys;
+
+        HeavyHitterSketch sketch(options.HOT_KEY_SKETCH_SIZE());
+        std::string key;
+        for(const auto& row : op->getSample(MAX_TYPE_SAMPLING_ROWS))
+            if(sampleHashKey(row, keyCol, key))
+                sketch.add(key);
+        if(0 == sketch.total())
+            return keys;
+
+        double rowsPerSampleRow = std::max(1.0, static_cast<double>(op->cost()) / sketch.total());
+        for(const auto& c : sketch.heavyHitters(2)) {
+            auto guaranteed = c.count - c.error;
+            if(guaranteed < 2 || guaranteed * rowsPerSampleRow < options.HOT_KEY_ROWS())
+                continue;
+            keys.push_back(c.key);
+            if(keys.size() >= MAX_HOT_KEYS)
+                break;
+        }
+        return keys;
+    }
+
+    /*!
+     * estimated output rows per probe row of a join, from matching the probe side's sample against the build side's
+     * sample (build counts scaled to the build side's estimated number of rows). At least 1.0.
+     */
+    static double probeFanoutFromSample(JoinOperator* jop) {
+        auto build = jop->buildRight() ? jop->right() : jop->left();
+        auto probe = jop->buildRight() ? jop->left() : jop->right();
+        size_t buildCol = jop->buildRight() ? jop->rightKeyIndex() : jop->leftKeyIndex();
+        size_t probeCol = jop->buildRight() ? jop->leftKeyIndex() : jop->rightKeyIndex();
+
+        std::unordered_map<std::string, size_t> buildCounts;
+        size_t numBuildRows = 0;
+        std::string key;
+        for(const auto& row : build->getSample(MAX_TYPE_SAMPLING_ROWS))
+            if(sampleHashKey(row, buildCol, key)) {
+                buildCounts[key]++;
+                numBuildRows++;
+            }
+        if(0 == numBuildRows)
+            return 1.0;
+        double rowsPerSampleRow = std::max(1.0, static_cast<double>(build->cost()) / numBuildRows);
+
+        size_t numProbeRows = 0;
+        double numOutputRows = 0.0;
+        for(const auto& row : probe->getSample(MAX_TYPE_SAMPLING_ROWS)) {
+            double matches = 0.0;
+            if(sampleHashKey(row, probeCol, key)) {
+                auto it = buildCounts.find(key);
+                if(it != buildCounts.end())
+                    matches = it->second * rowsPerSampleRow;
+            }
+            // a left join keeps unmatched rows
+            if(jop->joinType() == JoinType::LEFT)
+                matches = std::max(1.0, matches);
+            numOutputRows += matches;
+            numProbeRows++;
+        }
+        if(0 == numProbeRows)
+            return 1.0;
+        return std::max(1.0, numOutputRows / numProbeRows);
+    }
+
     PhysicalPlan::PhysicalPlan(tuplex::LogicalPlan *optimizedPlan, tuplex::LogicalPlan *originalPlan, const Context& context)
             : _context(context), _num_stages(0) {
 
@@ -300,6 +403,7 @@ namespace tuplex {
         // add output writer (depending on op)
         assert(!ops.empty());
         auto outputNode = ops.back(); assert(outputNode);
+        std::vector<std::string> hotKeys; // heavy hitters of the hash table output, if any
         // what is the detected outputMode?
         switch(outputMode) {
             case EndPointMode::FILE: {
@@ -336,6 +440,8 @@ namespace tuplex {
                     size_t keyCol = jop->buildRight() ? jop->rightKeyIndex() : jop->leftKeyIndex();
                     auto schema = jop->buildRight() ? jop->right()->getOutputSchema() : jop->left()->getOutputSchema();
                     builder.addHashTableOutput(schema, true, false, {keyCol}, jop->keyType(), jop->bucketType()); // using keycol
+                    if(hashableKeyType(jop->keyType()))
+                        hotKeys = hotKeysFromSample(outputNode, keyCol, _context.getOptions());
                 }
                 // is output node hashtable?
                 else if(outputNode->type() == LogicalOperatorType::AGGREGATE) {
@@ -352,6 +458,8 @@ namespace tuplex {
                     } else if(aop->aggType() == AggregateType::AGG_BYKEY) {
                         // Builds intermediate hashtable outputs with the aggregate function, and then merges them with the combiner
                         builder.addHashTableOutput(outputNode->getOutputSchema(), false, true, aop->keyColsInParent(), aop->keyType(), aop->aggregateOutputType());
+                        if(aop->keyColsInParent().size() == 1 && hashableKeyType(aop->keyType()))
+                            hotKeys = hotKeysFromSample(aop->parent(), aop->keyColsInParent().front(), _context.getOptions());
                         hashGroupedDataType = AggregateType::AGG_BYKEY;
                     } else throw std::runtime_error("wrong aggregate type!");
                 } else
@@ -368,6 +476,19 @@ namespace tuplex {
         // generate code for stage and init vars
         auto stage = builder.build(this, backend());
         stage->setDataAggregationMode(hashGroupedDataType);
+        stage->setHotKeys(hotKeys);
+        if(!hotKeys.empty())
+            _logger.info("stage " + std::to_string(stage->number()) + ": " + pluralize(hotKeys.size(), "heavy hitter")
+                         + " found in sample");
+
+        // probing a join whose build side is skewed produces many rows per input row
+        if(_context.getOptions().HOT_KEY_ROWS() > 0) {
+            double fanout = 1.0;
+            for(auto op : ops)
+                if(op->type() == LogicalOperatorType::JOIN)
+                    fanout *= probeFanoutFromSample(dynamic_cast<JoinOperator*>(op));
+            stage->setProbeFanout(fanout);
+        }
         // fill in physical plan data
         // b.c. the stages were constructed top-down, need to reverse the stages
         std::reverse(dependents.begin(), dependents.end());
@@ -555,8 +676,24 @@ namespace tuplex {
             throw std::runtime_error("no planned stage, aborting execution");
         }
 
+        // stages in execution order, i.e. predecessors first
+        std::vector<PhysicalStage*> stages;
+        std::function<void(PhysicalStage*)> collect = [&](PhysicalStage* stage) {
+            for(auto pred : stage->predecessors())
+                collect(pred);
+            stages.push_back(stage);
+        };
+        collect(_stage);
+
         // execute using backend...
-        _stage->execute(_context);
+        backend()->prepareStages(stages);
+        try {
+            _stage->execute(_context);
+        } catch(...) {
+            backend()->finishStages();
+            throw;
+        }
+        backend()->finishStages();
 
 
         // signal check & no print of exception stats in that case
@@ -593,8 +730,11 @@ namespace tuplex {
             numTotalExceptionsFound += keyval.second;
 
         // update context job statistics
-        _context.metrics().totalExceptionCount = numTotalExceptionsFound;
-        _context.metrics().setExceptionCounts(ecounts);
+        {
+            std::lock_guard<std::mutex> lock(metricsMutex);
+            _context.metrics().totalExceptionCount = numTotalExceptionsFound;
+            _context.metrics().setExceptionCounts(ecounts);
+        }
 
         if(numTotalExceptionsFound > 0) {
             std::stringstream ss;
@@ -607,7 +747,12 @@ namespace tuplex {
 
         // metrics
         // aggregate sampling time from all input operators (run sequentially)
-        _context.metrics().setSamplingTime(aggregateSamplingTime());
+        auto samplingTime = aggregateSamplingTime();
+        {
+            std::lock_guard<std::mutex> lock(metricsMutex);
+            _context.metrics().setSamplingTime(samplingTime);
+            RuntimeMetrics::instance().jobFinished(_context.metrics());
+        }
 
         // @TODO: update history server? make sure things work?
     }
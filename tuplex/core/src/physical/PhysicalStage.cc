@@ -21,14 +21,22 @@ namespace tuplex {
 
     void PhysicalStage::execute(const tuplex::Context &context) {
         // execute predecessors
-        for(auto stage : _predecessors)
-            stage->execute(context);
+        executePredecessors(context);
 
         // execute stage via backend
         assert(_backend);
         _backend->execute(this);
     }
 
+    void PhysicalStage::executePredecessors(const tuplex::Context &context) {
+        // backend may be a nullptr for dummy stages, i.e. then run in order
+        if(_backend && _predecessors.size() > 1)
+            _backend->executeStages(_predecessors, context);
+        else
+            for(auto stage : _predecessors)
+                stage->execute(context);
+    }
+
     nlohmann::json PhysicalStage::getJSON() const {
         using namespace nlohmann;
         using namespace std;
@@ -1941,7 +1941,9 @@ namespace tuplex {
                 // env.debugPrint(builder, "string decode failed");
 #endif
                 env.freeAll(builder);
-                builder.CreateRet(ecCode); // original exception code.
+                // cells do not fit the general case either => let the interpreter deal with the row. Returning the
+                // original code here would make the resolve task drop the row.
+                builder.CreateRet(env.i64Const(ecToI64(ExceptionCode::NORMALCASEVIOLATION)));
             }
             // 2.) decode normal case type & upgrade to exception case type, then apply all resolvers & Co
             {
@@ -34,12 +34,9 @@ extern "C" {
 
         // Logger::instance().logger("resolve task").debug("writing exception for row #" + std::to_string(row));
 
-        // @TODO: avoid double recording with BOTH fallback path and interpreter path...
-        // i.e. better call the callback somewhere else...
-        // --> get rid of callback?
-        // --> just record which ecCode, opID, row, buf?
-        // what about loops?
-        task->exceptionCallback(ecCode, opID, row, buf, bufSize);
+        // exceptions of the compiled slow path are held back until it is known whether the row goes to the interpreter,
+        // this avoids double recording with BOTH fallback path and interpreter path.
+        task->slowPathExceptionCallback(ecCode, opID, row, buf, bufSize);
         return (int64_t)tuplex::ExceptionCode::SUCCESS;
     }
 
@@ -135,7 +132,8 @@ namespace tuplex {
         }
 
         // aggregate in the new value
-        aggregateValues(&bucket, buf, buf_size);
+        assert(_aggState);
+        _aggState->aggregateValues(&bucket, buf, buf_size);
 
         // write back the bucket
         if(key != nullptr && key_len > 0) {
@@ -184,7 +182,8 @@ namespace tuplex {
             bucket = _htable.null_bucket;
         }
         // aggregate in the new value
-        aggregateValues(&bucket, buf, buf_size);
+        assert(_aggState);
+        _aggState->aggregateValues(&bucket, buf, buf_size);
         if(!key_null) {
             // get current bucket
             int64_hashmap_put(_htable.hm, key, bucket);
@@ -414,23 +413,38 @@ default:
         }
 
         // fallback 1: slow, compiled code path
+        // => general-case pipeline over the option/super type, i.e. null-values or widened types are processed here.
         int resCode = -1;
         if(_functor) {
+            _hasPendingException = false;
+            _deferSlowPathExceptions = true;
             resCode = _functor(this, _rowNumber, ecCode, ebuf, eSize);
+            _deferSlowPathExceptions = false;
             // uncomment to print out details on demand
             // if(resCode != 0) {
             //     std::cout<<"functor delivered resCode "<<resCode<<std::endl;
             // }
 
-            // normal-case violation too? -> backup via interpreter!
-            if(resCode == ecToI32(ExceptionCode::NORMALCASEVIOLATION)) {
+            if(resCode == 0) {
+                _numRowsResolvedCompiled++;
+            } else if(requiresInterpreterReprocessing(i64ToEC(resCode))) {
+                // normal-case violation too or the row could not be decoded? -> backup via interpreter!
+                // the exception held back for this row gets discarded, it is recorded below if the interpreter fails too.
                 if(!_interpreterFunctor) {
 #ifndef NDEBUG
                     std::cerr<<"normal case violation encountered, but no interpreter backup?"<<std::endl;
 #endif
                 }
                 resCode = -1;
+            } else {
+                // true exception, i.e. the interpreter would raise the same one => save it, done.
+                if(_hasPendingException)
+                    exceptionCallback(_pendingECCode, _pendingOpID, _pendingRowNumber,
+                                      _pendingException.data(), _pendingException.size());
+                else
+                    exceptionCallback(resCode, operatorID, _rowNumber, ebuf, eSize);
             }
+            _hasPendingException = false;
         }
 
         // fallback 2: interpreter path
@@ -648,6 +662,7 @@ default:
 
                         // everything was successful, change resCode to 0!
                         resCode = 0;
+                        _numRowsResolvedInterpreter++;
                     }
                 }
             }
@@ -671,6 +686,8 @@ default:
         Timer timer;
 
         _numInputRowsRead = 0;
+        _numRowsResolvedCompiled = 0;
+        _numRowsResolvedInterpreter = 0;
 
         // alloc hashmap if required
         if(hasHashTableSink()) {
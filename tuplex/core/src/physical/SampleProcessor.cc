@@ -15,6 +15,7 @@
 #include <logical/ResolveOperator.h>
 #include <logical/FileInputOperator.h>
 #include <Utils.h>
+#include <Timer.h>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -154,7 +155,10 @@ namespace tuplex {
                     for(unsigned i = 0; i < num_columns; i++) {
                         if(i != idx) {
                             assert(i < PyTuple_Size(pyRow));
-                            PyTuple_SET_ITEM(pyRes, i, PyTuple_GET_ITEM(pyRow, i));
+                            // SET_ITEM steals a reference, pyRow keeps its own
+                            auto pyItem = PyTuple_GET_ITEM(pyRow, i);
+                            Py_XINCREF(pyItem);
+                            PyTuple_SET_ITEM(pyRes, i, pyItem);
                         }
                         else
                             PyTuple_SET_ITEM(pyRes, i, pyColRes);
@@ -173,6 +177,7 @@ namespace tuplex {
                 auto idx = ((MapColumnOperator*)op)->getColumnIndex();
                 PyObject *pyElement = PyTuple_GetItem(pyRow, idx);
                 PyObject *pyArg = PyTuple_New(1);
+                Py_XINCREF(pyElement); // pyArg is consumed by the call
                 PyTuple_SET_ITEM(pyArg, 0, pyElement);
 
                 // only in tuple mode!
@@ -181,9 +186,11 @@ namespace tuplex {
                 if(pcr.exceptionCode == ExceptionCode::SUCCESS) {
                     pyRes = PyTuple_New(PyTuple_Size(pyRow));
                     for(unsigned i = 0; i < PyTuple_Size(pyRow); ++i) {
-                        if(i != idx)
-                            PyTuple_SET_ITEM(pyRes, i, PyTuple_GET_ITEM(pyRow, i));
-                        else
+                        if(i != idx) {
+                            auto pyItem = PyTuple_GET_ITEM(pyRow, i);
+                            Py_XINCREF(pyItem);
+                            PyTuple_SET_ITEM(pyRes, i, pyItem);
+                        } else
                             PyTuple_SET_ITEM(pyRes, i, pyColRes);
                     }
                 }
@@ -730,6 +737,48 @@ namespace tuplex {
     }
 
 
+    std::unordered_map<int64_t, OperatorProfile> SampleProcessor::profile(const std::vector<Row> &rows) {
+        std::unordered_map<int64_t, OperatorProfile> profiles;
+
+        python::lockGIL();
+        for(const auto& row : rows) {
+            PyObject* rowObj = python::rowToPython(row);
+            for(auto op : _operators) {
+                auto type = op->type();
+                if(type != LogicalOperatorType::MAP && type != LogicalOperatorType::FILTER
+                   && type != LogicalOperatorType::WITHCOLUMN && type != LogicalOperatorType::MAPCOLUMN)
+                    continue; // sources, resolvers, ... are not profiled
+
+                auto& p = profiles[op->getID()];
+                p.numInputRows++;
+                Timer timer;
+                auto pcr = applyOperator(op, rowObj);
+                p.time += timer.time();
+
+                if(pcr.exceptionCode != ExceptionCode::SUCCESS) {
+                    p.numExceptions++;
+                    break;
+                }
+
+                if(type == LogicalOperatorType::FILTER) {
+                    bool keep = PyObject_IsTrue(pcr.res);
+                    Py_XDECREF(pcr.res);
+                    if(!keep)
+                        break;
+                } else {
+                    // the operator's output is the next operator's input
+                    Py_XDECREF(rowObj);
+                    rowObj = pcr.res;
+                }
+                p.numOutputRows++;
+            }
+            Py_XDECREF(rowObj);
+        }
+        python::unlockGIL();
+
+        return profiles;
+    }
+
     std::vector<std::string> SampleProcessor::getColumnNames(int64_t operatorID) {
         // find operator & return column names
         auto it = std::find_if(_operators.begin(), _operators.end(), [operatorID](LogicalOperator* op) {
@@ -14,6 +14,7 @@
 #include <physical/BlockBasedTaskBuilder.h>
 #include <physical/CellSourceTaskBuilder.h>
 #include <physical/JITCSVSourceTaskBuilder.h>
+#include <physical/JITTextSourceTaskBuilder.h>
 #include <physical/TuplexSourceTaskBuilder.h>
 #include <physical/AggregateFunctions.h>
 #include <logical/CacheOperator.h>
@@ -549,6 +550,7 @@ namespace tuplex {
             _funcMemoryWriteCallbackName = func_prefix + "memOut_Stage_" + to_string(number());
             _funcHashWriteCallbackName = func_prefix + "hashOut_Stage_" + to_string(number());
             _funcExceptionCallback = func_prefix + "except_Stage_" + to_string(number());
+            _funcCancellationCallbackName = func_prefix + "cancelled_Stage_" + to_string(number());
 
             auto &logger = Logger::instance().logger("codegen");
             auto readSchema = _readSchema.getRowType(); // what to read from files (before projection pushdown)
@@ -976,7 +978,15 @@ namespace tuplex {
 
                 // @TODO: null values as parameter!
                 // check whether parser should be generated or not
-                if (_generateParser) {
+                if(_inputFileFormat == FileFormat::OUTFMT_TEXT) {
+                    // text needs no parser, lines are always split by a generated block loop
+                    tb = make_shared<codegen::JITTextSourceTaskBuilder>(env,
+                                                                        readSchema,
+                                                                        _columnsToRead,
+                                                                        funcStageName,
+                                                                        _inputNodeID,
+                                                                        null_values);
+                } else if (_generateParser) {
                     tb = make_shared<codegen::JITCSVSourceTaskBuilder>(env,
                                                                        readSchema,
                                                                        _columnsToRead,
@@ -1000,6 +1010,7 @@ namespace tuplex {
             // set pipeline and
             // add ignore codes & exception handler
             tb->setExceptionHandler(_funcExceptionCallback);
+            tb->setCancellationCallback(_funcCancellationCallbackName);
             tb->setIgnoreCodes(ignoreCodes);
             tb->setPipeline(pip);
 
@@ -1017,9 +1028,12 @@ namespace tuplex {
             // compile on top of this pipeline resolve code path if several conditons are met
             // 1.) compile if resolve function is present
             // 2.) compile if null-value optimization is present (could be done lazily)
+            // 3.) compile if the normal case is specialized, i.e. rows violating it (nulls, wider types) are
+            //     processed over the general-case (super) types in compiled code instead of the interpreter
             auto numResolveOperators = resolveOperatorCount();
+            bool normalCaseSpecialized = _normalCaseInputSchema != _inputSchema || _normalCaseOutputSchema != _outputSchema;
             // if resolvers are present, compile a slowPath.
-            bool requireSlowPath = _nullValueOptimization; // per default, slow path is always required when null-value opt is enabled.
+            bool requireSlowPath = _nullValueOptimization || normalCaseSpecialized; // per default, slow path is always required when null-value opt is enabled.
 
             // special case: input source is cached and no exceptions happened => no resolve path necessary if there are no resolvers!
             if(_inputNode->type() == LogicalOperatorType::CACHE && dynamic_cast<CacheOperator*>(_inputNode)->cachedExceptions().empty())
@@ -1411,6 +1425,7 @@ namespace tuplex {
             stage->_funcStageName = _funcStageName;
             stage->_funcMemoryWriteCallbackName = _funcMemoryWriteCallbackName;
             stage->_funcExceptionCallback = _funcExceptionCallback;
+            stage->_funcCancellationCallbackName = _funcCancellationCallbackName;
             stage->_funcFileWriteCallbackName = _funcFileWriteCallbackName;
             stage->_funcHashWriteCallbackName = _funcHashWriteCallbackName;
             stage->_writerFuncName = _writerFuncName;
@@ -1429,6 +1444,12 @@ namespace tuplex {
 
             stage->_operatorIDsWithResolvers = getOperatorIDsAffectedByResolvers(_operators);
 
+            // operators which may produce exceptions, used to count them in flat arrays
+            std::vector<int64_t> exceptionOperatorIDs{_inputNodeID};
+            for(auto op : _operators)
+                exceptionOperatorIDs.push_back(op->getID());
+            stage->setExceptionCountOperators(exceptionOperatorIDs);
+
             stage->setInitData();
 
             return stage;
@@ -11,165 +11,132 @@
 #include <physical/TextReader.h>
 #include <VirtualFileSystem.h>
 #include <Logger.h>
-#include <RuntimeInterface.h>
-#include <ExceptionCodes.h>
-#include <nmmintrin.h>
+#include <StringUtils.h>
+#include <cstring>
 
 namespace tuplex {
 
-    class BufferedFileReader {
-        std::unique_ptr<VirtualFile> _file;
+    size_t TextReader::fillBuffer(VirtualFile *fp) {
+        assert(fp);
 
-        size_t _readPos;
-        size_t _numBytesInBuf;
-        size_t _numBytesRead;
-
-        __m128i _newline_chars;
-
-        static const size_t maxBufSize = 131072 - 16 - 1; // assumption that this is large enough
-        char _buf[131072];
-
-        inline void readBytes(size_t writePos) {
-            if(!_file->eof()) {
-                _file->read(&_buf[writePos], maxBufSize - writePos, &_numBytesInBuf);
-                _readPos = writePos;
-                _numBytesInBuf += writePos;
-            }
+        // line does not fit into buffer? => double buffer
+        if(_inBufferLength == _bufferSize) {
+            auto newBuffer = new uint8_t[2 * _bufferSize + 16];
+            memcpy(newBuffer, _inputBuffer, _inBufferLength);
+            delete [] _inputBuffer;
+            _inputBuffer = newBuffer;
+            _bufferSize *= 2;
         }
 
-        __attribute__((always_inline)) int findNextNewline() {
-            // returns the offset of the first '\r' or '\n' or '\0' in the next 16 characters (16 => not found)
-            auto n = _mm_cmpistri(_newline_chars, _mm_loadu_si128((__m128i *)&_buf[_readPos]), _SIDD_UBYTE_OPS|_SIDD_CMP_EQUAL_ANY|_SIDD_POSITIVE_POLARITY);
-            return n;
-        }
-
-    public:
-        BufferedFileReader() = delete;
+        size_t bytesRead = 0;
+        fp->read(_inputBuffer + _inBufferLength, _bufferSize - _inBufferLength, &bytesRead);
+        _inBufferLength += bytesRead;
 
-        explicit BufferedFileReader(const URI &inputFilePath, size_t rangeStart) : _file(
-                VirtualFileSystem::open_file(inputFilePath, VirtualFileMode::VFS_READ)), _readPos(0), _numBytesInBuf(0),
-                                                                _numBytesRead(0) {
-            // set up new line characters
-            __v16qi vq = {'\n', '\r', '\0', '\0'};
-            _newline_chars = (__m128i) vq;
+        // zero pad buffer, the block functor zero terminates the last line in place
+        memset(_inputBuffer + _inBufferLength, 0, 16);
+        return bytesRead;
+    }
 
-            // zero out the end of the array
-            memset(&_buf[maxBufSize], 0, 16 + 1);
+    void TextReader::moveInputBuffer(size_t bytesConsumed) {
+        if(bytesConsumed == 0)
+            return;
 
-            // set up beginning of file read
-            _file->seek(rangeStart);
-            readBytes(0);
-        }
+        assert(bytesConsumed <= _inBufferLength);
+        memmove(_inputBuffer, _inputBuffer + bytesConsumed, _inBufferLength - bytesConsumed);
+        _inBufferLength -= bytesConsumed;
+        memset(_inputBuffer + _inBufferLength, 0, 16);
+    }
 
-        bool eof() { return _readPos == _numBytesInBuf; }
-        int numBytesRead() { return _numBytesRead; }
+    void TextReader::read(const URI &inputFilePath) {
+        // check that functor is valid
+        if(!_functor)
+            throw std::runtime_error("functor not initialized");
 
-        char readChar() { return _buf[_readPos]; }
+        auto fp = openInputFile(inputFilePath);
+        if(!fp)
+            throw std::runtime_error("could not open " + inputFilePath.toPath() + " in read mode.");
+
+        // init buffers, add +16 zero padded bytes
+        if(_inputBuffer)
+            delete [] _inputBuffer;
+        _inputBuffer = new uint8_t[_bufferSize + 16];
+        memset(_inputBuffer, 0, _bufferSize + 16);
+        _inBufferLength = 0;
+
+        bool useRange = this->useRange();
+
+        // file offset of the first byte in the buffer
+        size_t bufferOffset = 0;
+
+        // a split starting at rangeStart > 0 begins with the first line after the first '\n' at or after rangeStart - 1.
+        // => lines starting exactly at rangeStart are processed by this split, not the previous one.
+        if(useRange && _rangeStart != 0) {
+            fp->seek(_rangeStart - 1);
+            bufferOffset = _rangeStart - 1;
+
+            bool lineStartFound = false;
+            while(!lineStartFound) {
+                if(0 == fillBuffer(fp.get()) && fp->eof() && _inBufferLength == 0)
+                    return;
+                auto nl = static_cast<uint8_t*>(memchr(_inputBuffer, '\n', _inBufferLength));
+                if(nl) {
+                    auto skip = nl - _inputBuffer + 1;
+                    bufferOffset += skip;
+                    moveInputBuffer(skip);
+                    lineStartFound = true;
+                } else {
+                    bufferOffset += _inBufferLength;
+                    _inBufferLength = 0;
+                    if(fp->eof())
+                        return;
+                }
 
-        size_t readAndAdvance(size_t n, size_t &start) {
-            if(n == 0) return 0;
-            size_t ret = 0;
-            if(_numBytesInBuf - _readPos > n) {
-                _readPos += n;
-                ret = n;
-            }
-            else { // need to wrap the line around, pin start -> end of line
-                ret = _numBytesInBuf - _readPos;
-                size_t curlen = _numBytesInBuf - start;
-                _numBytesInBuf = curlen;
-                _readPos = curlen;
-                std::memmove(_buf, &_buf[start], curlen); // move the current line to beginning of buffer
-                readBytes(curlen);
-                start = 0;
+                // line belongs to the next split?
+                if(bufferOffset >= _rangeEnd)
+                    return;
             }
-            _numBytesRead += ret;
-            return ret;
         }
 
-        // store the start index (in _buf) of the line, and return the length
-        size_t readLine(size_t &start) {
-            start = _readPos;
-            size_t len = 0;
-            while(true) {
-                int n;
-                while (!eof() && ((n = findNextNewline()) == 16)) {
-                    len += readAndAdvance(n, start);
+        while(true) {
+            // the functor stops at a checkpoint when the task got cancelled, leave the rest of the range
+            if(cancelled())
+                break;
+
+            bool eof = fp->eof();
+            if(!eof)
+                fillBuffer(fp.get());
+            eof = fp->eof();
+
+            if(0 == _inBufferLength)
+                break;
+
+            size_t blockLength = _inBufferLength;
+            bool lastBlock = eof;
+
+            // clamp to range: last line of this split is the one containing byte rangeEnd - 1
+            if(useRange && bufferOffset + _inBufferLength >= _rangeEnd) {
+                size_t searchStart = _rangeEnd - 1 > bufferOffset ? _rangeEnd - 1 - bufferOffset : 0;
+                auto nl = static_cast<uint8_t*>(memchr(_inputBuffer + searchStart, '\n', _inBufferLength - searchStart));
+                if(nl) {
+                    blockLength = nl - _inputBuffer + 1;
+                    // cut off here, the block functor zero terminates in place
+                    _inputBuffer[blockLength] = '\0';
+                    lastBlock = true;
                 }
-                if(eof()) return len; // no terminating newline
-                len += readAndAdvance(n, start);
-
-                // advance past the cr/lf
-                auto foundChar = readChar();
-                readAndAdvance(1, start);
-
-                // lf line ending, return
-                if(foundChar == '\n') return len;
-
-                // check whether we are at a crlf ending
-                if(eof()) { // file ended with carriage return, not crlf
-                    len += 1;
-                    return len;
-                }
-                if(readChar() == '\n') { // yes!
-                    readAndAdvance(1, start);
-                    return len;
-                }
-                len += 1; // no, just a carriage return in the string
             }
-        }
-
-        const char * const getBuffer() { return _buf; }
-    };
-
-    void TextReader::read(const URI &inputFilePath) {
-        using namespace std;
-
-        _numRowsRead = 0;
 
-        // check that functor is valid
-        if (!_rowFunctor)
-            throw std::runtime_error("functor not initialized");
+            auto bytesConsumed = _functor(_userData, _inputBuffer, blockLength, &_num_normal_rows, &_num_bad_rows, !lastBlock);
+            assert(bytesConsumed <= blockLength);
 
-        // open up file and read in pieces
-        BufferedFileReader bufFile(inputFilePath, _rangeStart);
-
-        // find starting position
-        if(_rangeStart != 0) {
-            // special case: _rangeStart = 0 ==> beginning of file
-            // otherwise, need to find the next newline
-            size_t tmp;
-            bufFile.readLine(tmp);
-        }
-        // at start position, read one row at a time until we pass the rangeEnd
-        char **cells = new char*[1];
-        int64_t *cell_sizes = new int64_t[1];
-        cells[0] = nullptr;
-        int rowNumber = 0;
-        bool one_chunk = (_rangeStart == 0 && _rangeEnd == 0);
-        while(!bufFile.eof() && (one_chunk || (bufFile.numBytesRead() < _rangeEnd - _rangeStart))) {
-            // get the line into runtime memory
-            size_t start;
-            auto len = bufFile.readLine(start);
-
-            cells[0] = (char*)runtime::rtmalloc(len + 1);
-            cells[0][len] = 0;
-            cell_sizes[0] = len + 1;
-            memcpy(cells[0], &bufFile.getBuffer()[start], len);
-
-            // call functor
-            auto resCode = i64ToEC(_rowFunctor(_userData, rowNumber, cells, cell_sizes));
-            _numRowsRead++;
-            if(resCode != ExceptionCode::SUCCESS) {
-                std::cout<<"Row "<<rowNumber<<" exception: "<<exceptionCodeToString(resCode)<<std::endl;
-            }
+            if(lastBlock)
+                break;
 
-            // fetch contents
-            runtime::rtfree_all(); // reset memory
-            rowNumber++;
+            bufferOffset += bytesConsumed;
+            moveInputBuffer(bytesConsumed);
         }
 
-        delete [] cells;
-        delete [] cell_sizes;
-        runtime::rtfree_all();
+#ifndef NDEBUG
+        Logger::instance().defaultLogger().info("text read done: " + pluralize(_num_normal_rows, "normal row") + " / " + pluralize(_num_bad_rows, "exceptional row"));
+#endif
     }
-}
\ No newline at end of file
+}
@@ -49,7 +49,10 @@ namespace tuplex {
                                    bool allowUndefinedBehavior) : PhysicalStage::PhysicalStage(plan, backend, number),
                                                                   _inputLimit(std::numeric_limits<size_t>::max()),
                                                                   _outputLimit(std::numeric_limits<size_t>::max()),
-                                                                  _aggMode(AggregateType::AGG_NONE) {
+                                                                  _aggMode(AggregateType::AGG_NONE),
+                                                                  _probeFanout(1.0) {
+        // no operators known yet, exceptions get counted in hashmaps until StageBuilder provides them
+        setExceptionCountOperators({});
 
         // TODO: is this code out of date? + is allowUndefinedBehavior needed here?
         // plan stage using operators.
@@ -589,10 +592,8 @@ namespace tuplex {
         //     ss<<"Stage"<<stage->number()<<" ";
         // Logger::instance().defaultLogger().info(ss.str());
 
-        // execute all predecessors (can be at most one!)
-        // @TODO: this should be parallelized for tiny stages!
-        for (auto stage : predecessors())
-            stage->execute(context);
+        // execute all predecessors, independent ones (e.g. multiple joins) may run concurrently
+        executePredecessors(context);
 
         // if output is hashtable, pass to init function!
         auto numPreds = predecessors().size();
@@ -720,6 +721,9 @@ namespace tuplex {
         return fields;
     }
 
+    // stages may get compiled ahead of time on multiple threads, which all add up into the same metrics
+    static std::mutex compileMetricsMutex;
+
     std::shared_ptr<TransformStage::JITSymbols> TransformStage::compile(JITCompiler &jit, LLVMOptimizer *optimizer, bool excludeSlowPath, bool registerSymbols) {
         auto& logger = Logger::instance().defaultLogger();
 
@@ -753,7 +757,10 @@ namespace tuplex {
             optimizer->optimizeModule(*mod.get());
 
             double llvm_optimization_time = timer.time();
-            metrics.setLLVMOptimizationTime(llvm_optimization_time);
+            {
+                std::lock_guard<std::mutex> lock(compileMetricsMutex);
+                metrics.setLLVMOptimizationTime(llvm_optimization_time);
+            }
             logger.info("Optimization via LLVM passes took " + std::to_string(llvm_optimization_time) + " ms");
 
             timer.reset();
@@ -765,6 +772,8 @@ namespace tuplex {
             jit.registerSymbol(writeMemoryCallbackName(), TransformTask::writeRowCallback(false));
         if(registerSymbols && !exceptionCallbackName().empty())
             jit.registerSymbol(exceptionCallbackName(), TransformTask::exceptionCallback(false));
+        if(registerSymbols && !cancellationCallbackName().empty())
+            jit.registerSymbol(cancellationCallbackName(), TransformTask::cancellationCallback());
         if(registerSymbols && !writeFileCallbackName().empty())
             jit.registerSymbol(writeFileCallbackName(), TransformTask::writeRowCallback(true));
 
@@ -848,9 +857,12 @@ namespace tuplex {
         }
 
         double compilation_time_via_llvm_this_number = timer.time();
-        double compilation_time_via_llvm_thus_far = compilation_time_via_llvm_this_number +
-                metrics.getLLVMCompilationTime();
-        metrics.setLLVMCompilationTime(compilation_time_via_llvm_thus_far);
+        {
+            std::lock_guard<std::mutex> lock(compileMetricsMutex);
+            double compilation_time_via_llvm_thus_far = compilation_time_via_llvm_this_number +
+                                                        metrics.getLLVMCompilationTime();
+            metrics.setLLVMCompilationTime(compilation_time_via_llvm_thus_far);
+        }
         ss<<"Compiled code paths for stage "<<number()<<" in "<<std::fixed<<std::setprecision(2)<<compilation_time_via_llvm_this_number<<" ms";
 
         logger.info(ss.str());
@@ -893,6 +905,11 @@ namespace tuplex {
         }
     }
 
+    void TransformStage::setExceptionCountOperators(const std::vector<int64_t> &operatorIDs) {
+        _exceptionCountIndex = std::make_shared<ExceptionCountIndex>(operatorIDs);
+        _liveExceptionCounts.reset(new ConcurrentExceptionCounts(_exceptionCountIndex));
+    }
+
     TransformStage* TransformStage::from_protobuf(const messages::TransformStage &msg) {
         auto stage = new TransformStage(nullptr, nullptr, msg.stagenumber(), true); // dummy, no backend/plan
 
@@ -931,6 +948,7 @@ namespace tuplex {
         stage->_funcStageName = msg.funcstagename();
         stage->_funcMemoryWriteCallbackName = msg.funcmemorywritecallbackname();
         stage->_funcExceptionCallback = msg.funcexceptioncallback();
+        stage->_funcCancellationCallbackName = msg.funccancellationcallbackname();
         stage->_funcFileWriteCallbackName = msg.funcfilewritecallbackname();
         stage->_funcHashWriteCallbackName = msg.funchashwritecallbackname();
         stage->_writerFuncName = "";
@@ -989,6 +1007,7 @@ namespace tuplex {
         msg->set_funcfilewritecallbackname(_funcFileWriteCallbackName);
         msg->set_funchashwritecallbackname(_funcHashWriteCallbackName);
         msg->set_funcexceptioncallback(_funcExceptionCallback);
+        msg->set_funccancellationcallbackname(_funcCancellationCallbackName);
         msg->set_funcinitstagename(_initStageFuncName);
         msg->set_funcreleasestagename(_releaseStageFuncName);
         msg->set_resolverowfunctionname(_resolveRowFunctionName);
@@ -29,6 +29,11 @@ extern "C" {
         return task->writeRowToFile(buf, bufSize);
     }
 
+    static int64_t cancelCheckCallback(tuplex::TransformTask* task) {
+        assert(task);
+        return task->checkStop();
+    }
+
     static void e2mCallback(tuplex::TransformTask *task, int64_t ecCode, int64_t opID, int64_t row, uint8_t* buf, int64_t bufSize) {
         assert(task);
         assert(dynamic_cast<tuplex::TransformTask*>(task));
@@ -164,100 +169,67 @@ namespace tuplex {
     }
 
 
-    // aggregate: We do this here smarter using thread_locals!
-    // @TODO: avoid thread_local, use array and give each task, the executor ID/thread number!
-    static uint8_t** tl_aggregate = nullptr; // <-- lazy init within task!
-    static int64_t* tl_aggregate_size = nullptr; // <-- lazy init as well!
-    static size_t tl_num_slots = 0;
-    static codegen::agg_combine_f agg_combine_functor = nullptr; // <-- check
-    static codegen::agg_init_f agg_init_functor = nullptr;
-    static codegen::agg_agg_f agg_aggregate_functor = nullptr;
-
-    // do not go separate way, simply add to thread-local aggregate!
+    // do not go separate way, simply add to the partial aggregate of the executing thread!
     extern "C" int64_t combineAggregate(TransformTask* task, uint8_t* buf, int64_t buf_size) {
-        assert(agg_combine_functor);
         assert(task);
-#ifndef NDEBUG
         assert(buf);
-        assert(tl_aggregate); // if this fails, init was not performed...
-#endif
-
-        auto threadNum = task->threadNumber();
-        assert(threadNum < tl_num_slots);
-        agg_combine_functor(&tl_aggregate[threadNum], &tl_aggregate_size[threadNum], buf, buf_size);
+        assert(task->aggregateState()); // if this fails, the stage did not set up the aggregate...
+        task->aggregateState()->combine(task->threadNumber(), buf, buf_size);
         return 0;
     }
 
-    static void freeAggregates() {
-        if (tl_aggregate) {
-            for(unsigned i = 0; i < tl_num_slots; ++i)
-                free(tl_aggregate[i]); // these should be C-malloced!
-            delete [] tl_aggregate;
-        }
-
-        if (tl_aggregate_size) {
-            delete [] tl_aggregate_size;
-        }
-
-        tl_aggregate = nullptr;
-        tl_aggregate_size = nullptr;
-        tl_num_slots = 0;
-        agg_combine_functor = nullptr;
-        agg_init_functor = nullptr;
-        agg_aggregate_functor = nullptr;
+    AggregateState::~AggregateState() {
+        for(auto& kv : _partials)
+            free(kv.second.first); // these should be C-malloced!
     }
 
-    bool initThreadLocalAggregates(size_t num_slots, codegen::agg_init_f init_func, codegen::agg_combine_f combine_func) {
-        assert(num_slots > 0 && num_slots < 65536); // make sure not too many slots.
-
-        freeAggregates();
+    void AggregateState::combine(size_t threadNum, uint8_t *buf, int64_t buf_size) {
+        assert(_combine && _init);
 
-        agg_combine_functor = combine_func;
-
-        tl_num_slots = num_slots;
-        tl_aggregate = new uint8_t*[num_slots];
-        tl_aggregate_size = new int64_t[num_slots];
-
-        for(unsigned i = 0; i < num_slots; ++i) {
-            init_func(&tl_aggregate[i], &tl_aggregate_size[i]);
+        // called once per processed block, hence the lock is not contended much
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _partials.find(threadNum);
+        if(it == _partials.end()) {
+            std::pair<uint8_t*, int64_t> agg(nullptr, 0);
+            _init(&agg.first, &agg.second);
+            it = _partials.emplace(threadNum, agg).first;
         }
-
-        return true;
+        _combine(&it->second.first, &it->second.second, buf, buf_size);
     }
 
-    bool initThreadLocalAggregateByKey(codegen::agg_init_f init_func, codegen::agg_combine_f combine_func, codegen::agg_agg_f aggregate_func) {
-        freeAggregates();
+    bool AggregateState::fetch(uint8_t **out, int64_t *out_size) {
+        std::lock_guard<std::mutex> lock(_mutex);
 
-        agg_combine_functor = combine_func;
-        agg_init_functor = init_func;
-        agg_aggregate_functor = aggregate_func;
-        return true;
-    }
-
-    bool fetchAggregate(uint8_t** out, int64_t* out_size) {
-        if(!tl_aggregate || !tl_aggregate_size)
-            return false;
-
-        assert(tl_num_slots > 0);
-
-        // combine all the thread-local aggregates
-        uint8_t* agg = tl_aggregate[0];
-        int64_t agg_size = tl_aggregate_size[0];
-        for(unsigned i = 1; i < tl_num_slots; ++i) {
-            agg_combine_functor(&agg, &agg_size, tl_aggregate[i], tl_aggregate_size[i]);
+        // no task processed a block, result is the initial aggregate
+        if(_partials.empty()) {
+            if(!_init)
+                return false;
+            std::pair<uint8_t*, int64_t> agg(nullptr, 0);
+            _init(&agg.first, &agg.second);
+            _partials.emplace(0, agg);
         }
 
+        // combine all the partial aggregates
+        auto it = _partials.begin();
+        uint8_t* agg = it->second.first;
+        int64_t agg_size = it->second.second;
+        for(++it; it != _partials.end(); ++it)
+            _combine(&agg, &agg_size, it->second.first, it->second.second);
+        _partials.begin()->second = std::make_pair(agg, agg_size);
+
         // copy buffer
         *out = static_cast<uint8_t *>(malloc(agg_size));
         memcpy(*out, agg, agg_size);
         *out_size = agg_size;
 
-        freeAggregates();
+        for(auto& kv : _partials)
+            free(kv.second.first);
+        _partials.clear();
 
         return true;
     }
 
-    uint8_t* combineBuckets(uint8_t* bucketA, uint8_t* bucketB) {
+    uint8_t* AggregateState::combineBuckets(uint8_t* bucketA, uint8_t* bucketB) const {
         // if one is null, just return the other
         if (!bucketA && !bucketB)
             return nullptr;
@@ -272,13 +244,13 @@ namespace tuplex {
 
         auto sizeA = *(int64_t*)bucketA;
         auto valA = static_cast<uint8_t*>(malloc(sizeA));
-        // TODO: when we convert everything to thread locals, we should change agg_combine_functor to match the size | value format of agg_aggregate_functor so that we can roll aggregate into aggregateByKey and just using the nullbucket
+        // TODO: we should change the combine functor to match the size | value format of the aggregate functor so that we can roll aggregate into aggregateByKey and just using the nullbucket
         memcpy(valA, bucketA + 8, sizeA);
 
         auto sizeB = *(uint64_t*)bucketB;
         auto valB = bucketB + 8;
 
-        agg_combine_functor(&valA, &sizeA, valB, sizeB);
+        _combine(&valA, &sizeA, valB, sizeB);
 
         // allocate the output buffer (should be avoided by the above TODO eventually)
         auto ret = static_cast<uint8_t*>(malloc(sizeA + 8));
@@ -288,13 +260,15 @@ namespace tuplex {
         return ret;
     }
 
-    void aggregateValues(uint8_t** bucket, char *buf, size_t buf_size) {
+    void AggregateState::aggregateValues(uint8_t** bucket, char *buf, size_t buf_size) const {
+        assert(_aggregate);
+
         // if this is the first one, we need to initialize
         if(*bucket == nullptr) {
             // initialize
             uint8_t* init_val = nullptr;
             int64_t init_size = 0;
-            agg_init_functor(&init_val, &init_size);
+            _init(&init_val, &init_size);
             // allocate the bucket
             auto *new_bucket = static_cast<uint8_t *>(malloc(init_size + 8));
             *(int64_t*)new_bucket = init_size;
@@ -304,7 +278,7 @@ namespace tuplex {
         }
 
         // aggregate the value -> knows size | buffer construct
-        agg_aggregate_functor(bucket, reinterpret_cast<uint8_t *>(buf), buf_size);
+        _aggregate(bucket, reinterpret_cast<uint8_t *>(buf), buf_size);
     }
 
 
@@ -312,6 +286,39 @@ namespace tuplex {
         return reinterpret_cast<codegen::write_row_f>(combineAggregate);
     }
 
+    codegen::cancel_check_f TransformTask::cancellationCallback() {
+        return reinterpret_cast<codegen::cancel_check_f>(cancelCheckCallback);
+    }
+
+    void TaskOutputLimit::taskDone(size_t taskIndex, size_t numOutputRows) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(taskIndex >= _rowCounts.size())
+            _rowCounts.resize(taskIndex + 1, -1);
+        _rowCounts[taskIndex] = static_cast<int64_t>(numOutputRows);
+
+        // find the first task after which the limit is reached, taking only completed tasks without gaps into account
+        size_t numRows = 0;
+        for(size_t i = 0; i < _rowCounts.size() && _rowCounts[i] >= 0; ++i) {
+            numRows += _rowCounts[i];
+            if(numRows >= _limit) {
+                if(static_cast<int64_t>(i) < _cutoff)
+                    _cutoff = static_cast<int64_t>(i);
+                break;
+            }
+        }
+    }
+
+    bool TransformTask::checkStop() {
+        if(_stoppedEarly)
+            return true;
+
+        bool stop = isCancelled();
+        if(!stop && _stageLimit)
+            stop = _normalRowCounter >= _stageLimit->limit() || _stageLimit->exceeded(_stageTaskIndex);
+        _stoppedEarly = stop;
+        return stop;
+    }
+
     void TransformTask::execute() {
         Timer timer;
 
@@ -360,7 +367,9 @@ namespace tuplex {
 
         // check what type of source exists
         if(hasFileSource()) {
-            processFileSource();
+            // a task that is not needed anymore skips its input
+            if(!checkStop())
+                processFileSource();
         } else if(hasMemorySource()) {
             if(_inputPartitions.empty())
                 throw std::runtime_error("no input partition assigned!");
@@ -372,10 +381,20 @@ namespace tuplex {
         // free runtime memory
         runtime::rtfree_all();
 
+        if(hasHashTableSink())
+            flushHotBuckets();
+
         // close file
         if(hasFileSink())
             _outFile->close();
 
+        if(_stageLimit)
+            _stageLimit->taskDone(_stageTaskIndex, _normalRowCounter);
+
+        // publish exception counts, so they can be read while other tasks of the stage are still running
+        if(_liveExceptionCounts)
+            _liveExceptionCounts->add(_exceptionCounts);
+
 
         // // task was successful if bytes were written
         // // negative numbers for failure (i.e. -1 = TASK_FAILURE)
@@ -451,7 +470,9 @@ namespace tuplex {
 
         // reset file sources
         _inputFilePath = URI::INVALID;
-
+        _inputRangeStart = 0;
+        _inputRangeSize = 0;
+        _inputPrefetch = nullptr;
 
         // reset memory sources
         _inputPartitions.clear();
@@ -481,6 +502,8 @@ namespace tuplex {
 
         // reset output row counter...
         _outputRowCounter = 0;
+        _normalRowCounter = 0;
+        _stoppedEarly = false;
     }
 
     void TransformTask::processMemorySource() {
@@ -496,6 +519,13 @@ namespace tuplex {
 
         // go over all input partitions.
         for(auto inputPartition : _inputPartitions) {
+            // stopped (at a cancellation checkpoint of the functor), remaining partitions are not needed
+            if(checkStop()) {
+                if(_invalidateSourceAfterUse)
+                    inputPartition->invalidate();
+                continue;
+            }
+
             // lock ptr, extract number of rows ==> store them
             // lock raw & call functor!
             int64_t inSize = inputPartition->size();
@@ -531,6 +561,11 @@ namespace tuplex {
 
         assert(_reader);
 
+        // input may have been loaded already by an IO thread
+        if(_inputPrefetch)
+            _reader->setInputFile(_inputPrefetch());
+
+        _reader->setCancellationCheck([this]() { return checkStop(); });
         _reader->read(_inputFilePath);
 
         _numInputRowsRead = _reader->inputRowCount();
@@ -560,15 +595,44 @@ namespace tuplex {
 
         _numOutputRowsWritten++;
         _outputRowCounter++; // TODO: unify with numOutputRowsWritten??
+        _normalRowCounter++;
 
         return ecToI32(ExceptionCode::SUCCESS);
     }
 
     int64_t TransformTask::writeRowToMemory(uint8_t *buf, int64_t size) {
+        // CSV output stages emit formatted rows via the memory callback, stream them when a file sink is attached
+        if(hasFileSink())
+            return writeRowToFile(buf, size);
+
         _outputRowCounter++;
+        _normalRowCounter++;
         return rowToMemorySink(owner(), _output, _outputSchema, _outputDataSetID, buf, size);
     }
 
+    void TransformTask::setHotKeys(const std::vector<std::string> &keys) {
+        _hotBuckets.clear();
+        for(const auto& key : keys) {
+            HotBucket hb{key, 0, nullptr};
+            if(key.size() == sizeof(uint64_t))
+                memcpy(&hb.intKey, key.data(), sizeof(uint64_t));
+            _hotBuckets.push_back(hb);
+        }
+    }
+
+    void TransformTask::flushHotBuckets() {
+        // hot buckets are filled before their key enters the hash table, hence they can be put directly
+        for(auto& hb : _hotBuckets) {
+            if(!hb.bucket)
+                continue;
+            if(_htableFormat == HashTableFormat::UINT64)
+                int64_hashmap_put(_htable.hm, hb.intKey, hb.bucket);
+            else
+                hashmap_put(_htable.hm, hb.key.data(), hb.key.size(), hb.bucket);
+            hb.bucket = nullptr;
+        }
+    }
+
     // note: could also use a int64_t, int64_t hashmap for string when string key is stored in bucket...
     void TransformTask::writeRowToHashTable(char* key, size_t key_len, bool bucketize, char *buf, size_t buf_size) {
         // saves key + rest in buckets (incl. null bucket)
@@ -581,6 +645,11 @@ namespace tuplex {
             // put into hashmap!
             uint8_t *bucket = nullptr;
             if(bucketize) { //@TODO: maybe get rid off this if by specializing pipeline better for unique case...
+                // heavy hitter? extend its bucket without touching the hash table
+                if(auto hot = hotBucket(key, key_len)) {
+                    *hot = extend_bucket(*hot, reinterpret_cast<uint8_t *>(buf), buf_size);
+                    return;
+                }
                 hashmap_get(_htable.hm, key, key_len, (void **) (&bucket));
                 // update or new entry
                 bucket = extend_bucket(bucket, reinterpret_cast<uint8_t *>(buf), buf_size);
@@ -598,6 +667,15 @@ namespace tuplex {
         assert(_htableFormat != HashTableFormat::UNKNOWN);
 
         // @TODO: is there a memory bug here when it comes to storing the key???
+        // heavy hitter? aggregate into its bucket without touching the hash table
+        if(key != nullptr && key_len > 0) {
+            if(auto hot = hotBucket(key, key_len)) {
+                assert(_aggState);
+                _aggState->aggregateValues(hot, buf, buf_size);
+                return;
+            }
+        }
+
         // get the bucket
         uint8_t *bucket = nullptr;
         if(key != nullptr && key_len > 0) {
@@ -609,7 +687,8 @@ namespace tuplex {
         }
 
         // aggregate in the new value
-        aggregateValues(&bucket, buf, buf_size);
+        assert(_aggState);
+        _aggState->aggregateValues(&bucket, buf, buf_size);
 
         // write back the bucket
         if(key != nullptr && key_len > 0) {
@@ -629,6 +708,10 @@ namespace tuplex {
             // put into hashmap!
             uint8_t *bucket = nullptr;
             if(bucketize) { //@TODO: maybe get rid off this if by specializing pipeline better for unique case...
+                if(auto hot = hotBucket(key)) {
+                    *hot = extend_bucket(*hot, reinterpret_cast<uint8_t *>(buf), buf_size);
+                    return;
+                }
                 int64_hashmap_get(_htable.hm, key, (void **) (&bucket));
                 // update or new entry
                 bucket = extend_bucket(bucket, reinterpret_cast<uint8_t *>(buf), buf_size);
@@ -645,6 +728,14 @@ namespace tuplex {
         assert(_htable.hm);
         assert(_htableFormat != HashTableFormat::UNKNOWN);
 
+        if(!key_null) {
+            if(auto hot = hotBucket(key)) {
+                assert(_aggState);
+                _aggState->aggregateValues(hot, buf, buf_size);
+                return;
+            }
+        }
+
         // get the bucket
         uint8_t *bucket = nullptr;
         if(!key_null) {
@@ -654,7 +745,8 @@ namespace tuplex {
             bucket = _htable.null_bucket;
         }
         // aggregate in the new value
-        aggregateValues(&bucket, buf, buf_size);
+        assert(_aggState);
+        _aggState->aggregateValues(&bucket, buf, buf_size);
         if(!key_null) {
             // get current bucket
             int64_hashmap_put(_htable.hm, key, bucket);
@@ -687,13 +779,15 @@ namespace tuplex {
         incExceptionCounts(ecCode, opID);
     }
 
-    void TransformTask::sinkOutputToFile(const URI &uri, const std::unordered_map<std::string, std::string> &options) {
+    void TransformTask::sinkOutputToFile(const URI &uri, const std::unordered_map<std::string, std::string> &options,
+                                         int64_t outputDataSetID) {
         // reset sinks
         resetSinks();
 
         // init file variables
         _outputFilePath = uri;
         _outOptions = options;
+        _outputDataSetID = outputDataSetID;
     }
 
     void TransformTask::sinkOutputToMemory(const Schema& outputSchema, int64_t outputDataSetID) {
@@ -738,7 +832,8 @@ namespace tuplex {
                                            size_t rangeStart, size_t rangeSize,
                                            char delimiter, char quotechar,
                                            const std::vector<bool>& colsToKeep,
-                                           FileFormat fmt) {
+                                           FileFormat fmt,
+                                           bool rangeRowAligned) {
         resetSources();
 
         assert(rowType.isTupleType());
@@ -747,20 +842,26 @@ namespace tuplex {
         //   assert(header.size() == rowType.parameters().size());
 
         _inputFilePath = inputFile;
+        _inputRangeStart = rangeStart;
+        _inputRangeSize = rangeSize;
         _inputSchema = Schema(Schema::MemoryLayout::ROW, rowType);
 
+        // text input is always processed via a block functor, there is no cell based version
+        if(fmt == FileFormat::OUTFMT_TEXT) {
+            auto text = new TextReader(this, reinterpret_cast<codegen::read_block_f>(_functor));
+            text->setRange(rangeStart, rangeStart + rangeSize);
+            _reader.reset(text);
+            return;
+        }
+
         // completely compiled parser or the smaller version?
         if(cellBasedFunctor) {
             if(fmt == FileFormat::OUTFMT_CSV) {
                 auto csv = new CSVReader(this, reinterpret_cast<codegen::cells_row_f>(_functor), makeParseExceptionsInternal, operatorID, exceptionCallback(), numColumns, delimiter,
                                          quotechar, colsToKeep);
-                csv->setRange(rangeStart, rangeStart + rangeSize);
+                csv->setRange(rangeStart, rangeStart + rangeSize, rangeRowAligned);
                 csv->setHeader(header);
                 _reader.reset(csv);
-            } else if(fmt == FileFormat::OUTFMT_TEXT) {
-                auto text = new TextReader(this, reinterpret_cast<codegen::cells_row_f>(_functor));
-                text->setRange(rangeStart, rangeStart+rangeSize);
-                _reader.reset(text);
             } else {
                 throw std::runtime_error("unsupported input filetype");
             }
@@ -769,11 +870,9 @@ namespace tuplex {
                 auto csv = new JITCompiledCSVReader(this, reinterpret_cast<codegen::read_block_f>(_functor), numColumns,
                                                     delimiter,
                                                     quotechar); // pass this as user data for all the other callbacks.
-                csv->setRange(rangeStart, rangeStart + rangeSize);
+                csv->setRange(rangeStart, rangeStart + rangeSize, rangeRowAligned);
                 csv->setHeader(header);
                 _reader.reset(csv);
-            } else if(fmt == FileFormat::OUTFMT_TEXT) {
-                throw std::runtime_error("Text code-generated parser not implemented yet!");
             } else {
                 throw std::runtime_error("unsupported code-generated input filetype");
             }
@@ -794,13 +893,7 @@ namespace tuplex {
     }
 
     void TransformTask::incExceptionCounts(int64_t ecCode, int64_t opID) {
-        using namespace std;
-        auto key = make_tuple(opID, i32ToEC(ecCode));
-        auto it = _exceptionCounts.find(key);
-        if(it == _exceptionCounts.end())
-            _exceptionCounts[key] = 0;
-
-        _exceptionCounts[key]++;
+        _exceptionCounts.inc(opID, i32ToEC(ecCode));
     }
 
     size_t TransformTask::getNumOutputRows() const {
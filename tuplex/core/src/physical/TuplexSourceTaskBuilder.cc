@@ -167,6 +167,8 @@ namespace tuplex {
             // ---------
             // loop body
             builder.SetInsertPoint(bbLoopBody);
+            // on cancellation, report the rows before the current one as done
+            cancellationCheckpoint(builder, argUserData, bbLoopDone);
             // decode tuple from input ptr
             FlattenedTuple ft(_env.get());
             ft.init(_inputRowType);
@@ -0,0 +1,86 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_BLOCKCACHE_H
+#define TUPLEX_BLOCKCACHE_H
+
+#include "URI.h"
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace tuplex {
+
+    /*!
+     * local (e.g. SSD) read-through cache for blocks of remote objects. Blocks are stored as individual files in a
+     * directory, keyed by object (uri, etag, size) and block index. When the capacity is exceeded, least recently used
+     * blocks are evicted. The directory is scanned on construction, so blocks survive across processes/runs.
+     * Thread-safe.
+     */
+    class BlockCache {
+    public:
+        BlockCache() = delete;
+
+        /*!
+         * @param dir local directory where to store blocks, created if not existing
+         * @param capacity maximum number of bytes to store in dir
+         * @param blockSize size of a block, the last block of an object may be smaller
+         */
+        BlockCache(const URI& dir, size_t capacity, size_t blockSize=1024 * 1024);
+
+        size_t blockSize() const { return _blockSize; }
+        size_t capacity() const { return _capacity; }
+        URI directory() const { return URI(_dir); }
+
+        /*!
+         * key identifying a version of a remote object
+         */
+        static std::string objectKey(const URI& uri, const std::string& etag, size_t size);
+
+        /*!
+         * retrieves a block
+         * @param objectKey object key, cf. objectKey(...)
+         * @param blockIndex index of the block, i.e. offset / blockSize
+         * @param buffer where to copy the data to
+         * @param length expected length of the block
+         * @return true if block was found and copied to buffer
+         */
+        bool get(const std::string& objectKey, size_t blockIndex, uint8_t* buffer, size_t length);
+
+        /*!
+         * stores a block, evicts least recently used blocks if necessary
+         */
+        void put(const std::string& objectKey, size_t blockIndex, const uint8_t* buffer, size_t length);
+
+        size_t hits() const { return _hits; }
+        size_t misses() const { return _misses; }
+        size_t size() const;
+    private:
+        std::string _dir;
+        size_t _capacity;
+        size_t _blockSize;
+
+        mutable std::mutex _mutex;
+        std::list<std::string> _lru; ///! block file names, most recently used first
+        std::unordered_map<std::string, std::pair<std::list<std::string>::iterator, size_t>> _index;
+        size_t _size;
+
+        std::atomic<size_t> _hits;
+        std::atomic<size_t> _misses;
+
+        std::string blockName(const std::string& objectKey, size_t blockIndex) const;
+        void scanDirectory();
+        void evict(); // call with _mutex held
+    };
+}
+
+#endif //TUPLEX_BLOCKCACHE_H
@@ -0,0 +1,127 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_COPYENGINE_H
+#define TUPLEX_COPYENGINE_H
+
+#include "URI.h"
+#include "VirtualFileSystemBase.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tuplex {
+
+    /*!
+     * snapshot of a running copy operation
+     */
+    struct CopyProgress {
+        size_t filesCopied;
+        size_t filesTotal;
+        size_t bytesCopied;
+        size_t bytesTotal; ///! only known for local sources, remote objects are counted once transferred
+        double elapsed; ///! seconds since start
+
+        double throughput() const { return elapsed > 0.0 ? bytesCopied / elapsed : 0.0; } // bytes/s
+    };
+
+    /*!
+     * copies files concurrently. Local files larger than the chunk size are split into chunks, which are copied
+     * in parallel (in-kernel via copy_file_range/sendfile for local targets). Uploads/downloads/remote copies are
+     * issued concurrently per file, the S3 transfer manager splits large objects into parts itself. With a block
+     * cache enabled, downloads read through it instead of the transfer manager.
+     */
+    class CopyEngine {
+    public:
+        CopyEngine() = delete;
+
+        /*!
+         * @param parallelism number of files/chunks copied concurrently
+         * @param chunkSize local files are copied in chunks of this size
+         */
+        explicit CopyEngine(size_t parallelism, size_t chunkSize=32 * 1024 * 1024) : _parallelism(std::max(parallelism, (size_t)1)),
+        _chunkSize(std::max(chunkSize, (size_t)4096)), _progressInterval(1.0) {}
+
+        /*!
+         * adds a single file to copy. Supported are local->local, local->s3, s3->local and s3->s3.
+         */
+        void add(const URI& src, const URI& target);
+
+        /*!
+         * called with current progress at most every interval seconds and once after all files are copied
+         */
+        void setProgressCallback(std::function<void(const CopyProgress&)> callback, double interval=1.0) {
+            _progressCallback = callback;
+            _progressInterval = interval;
+        }
+
+        /*!
+         * copies all added files, stops issuing new copies after the first failure
+         * @param targets target URIs which were (possibly partially) written, so a caller may clean up on failure
+         * @return VFS_OK if all files were copied
+         */
+        VirtualFileSystemStatus run(std::vector<URI>& targets);
+
+        CopyProgress progress() const;
+
+        size_t numFiles() const { return _files.size(); }
+    private:
+        struct File {
+            URI src;
+            URI target;
+            size_t size;
+        };
+
+        struct Chunk {
+            size_t file;
+            size_t offset;
+            size_t length;
+        };
+
+        size_t _parallelism;
+        size_t _chunkSize;
+        std::vector<File> _files;
+        std::unique_ptr<std::atomic<size_t>[]> _pendingChunks; ///! per file, file is copied when 0
+        std::unique_ptr<std::atomic<bool>[]> _touched; ///! per file, whether target was (possibly partially) written
+
+        std::function<void(const CopyProgress&)> _progressCallback;
+        double _progressInterval;
+        std::mutex _progressMutex;
+        double _lastProgress;
+
+        std::atomic<size_t> _filesCopied{0};
+        std::atomic<size_t> _bytesCopied{0};
+        size_t _bytesTotal;
+        std::chrono::steady_clock::time_point _start;
+
+        bool isLocalCopy(const File& f) const { return f.src.isLocal() && f.target.isLocal(); }
+
+        VirtualFileSystemStatus prepare(File& f);
+        VirtualFileSystemStatus copyChunk(const Chunk& chunk);
+
+        /*!
+         * downloads a remote file by reading it through its filesystem, i.e. through the block cache
+         */
+        VirtualFileSystemStatus downloadThroughCache(const File& f, size_t& bytesDownloaded);
+        static const size_t _downloadBufferSize = 8 * 1024 * 1024;
+        void reportProgress(bool force);
+
+        /*!
+         * calls f(i) for i in [0, n) using up to parallelism threads, stops early when f returns false
+         */
+        bool parallelFor(size_t n, const std::function<bool(size_t)>& f);
+    };
+}
+
+#endif //TUPLEX_COPYENGINE_H
@@ -0,0 +1,133 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_GLOBEXPANDER_H
+#define TUPLEX_GLOBEXPANDER_H
+
+#include "IFileSystemImpl.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tuplex {
+
+    /*!
+     * thread-safe cache of directory listings, so repeated glob/walk queries within a session don't hit the
+     * (remote) filesystem again. Entries expire after ttl seconds, a ttl of 0 disables caching.
+     */
+    class ListingCache {
+    public:
+        explicit ListingCache(double ttl=0.0) : _ttl(ttl) {}
+
+        void setTTL(double ttl) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _ttl = ttl;
+            if(_ttl <= 0.0)
+                _listings.clear();
+        }
+
+        double ttl() const { return _ttl; }
+
+        /*!
+         * retrieve listing of a directory
+         * @param dir directory URI, ending with /
+         * @param entries where to store the cached entries
+         * @return true if a non-expired listing was found
+         */
+        bool get(const std::string& dir, std::vector<ListingEntry>& entries);
+
+        void put(const std::string& dir, const std::vector<ListingEntry>& entries);
+
+        /*!
+         * removes all listings affected by a change to uri, i.e. listings of parent directories of uri as well as
+         * all listings below uri (in case uri is a directory).
+         * @param uri file or directory which got created/modified/removed
+         */
+        void invalidate(const URI& uri);
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _listings.clear();
+        }
+
+        size_t hits() const { return _hits; }
+        size_t misses() const { return _misses; }
+    private:
+        using clock = std::chrono::steady_clock;
+        struct Listing {
+            clock::time_point timestamp;
+            std::vector<ListingEntry> entries;
+        };
+
+        std::mutex _mutex;
+        double _ttl;
+        std::unordered_map<std::string, Listing> _listings;
+        std::atomic<size_t> _hits{0};
+        std::atomic<size_t> _misses{0};
+    };
+
+    /*!
+     * expands a single (i.e. no ,) unix style wildcard pattern like s3://bucket/year=20??/month=??/data.csv level by level.
+     * The longest literal prefix is used as starting directory, then all directories of the current level
+     * are listed concurrently using up to parallelism threads. Literal path components are appended without listing.
+     */
+    class GlobExpander {
+    public:
+        GlobExpander() = delete;
+
+        /*!
+         * @param impl file system to list directories with
+         * @param parallelism maximum number of concurrent list requests
+         * @param cache optional listing cache, nullptr to disable caching
+         */
+        GlobExpander(IFileSystemImpl* impl, size_t parallelism, ListingCache* cache=nullptr) : _impl(impl),
+        _parallelism(std::max(parallelism, (size_t)1)), _cache(cache), _numListings(0) {
+            assert(_impl);
+        }
+
+        /*!
+         * expands pattern into all matching files and directories (sorted)
+         * @param pattern pattern, must contain a prefix (i.e. file:// or s3://)
+         * @return matching entries incl. size
+         */
+        std::vector<ListingEntry> expand(const std::string& pattern);
+
+        /*!
+         * checks whether a path contains (unescaped) wildcard characters
+         */
+        static bool hasWildcard(const std::string& path);
+
+        /*!
+         * number of list calls issued to the file system during the last expand (cache hits not included)
+         */
+        size_t numListings() const { return _numListings; }
+    private:
+        IFileSystemImpl* _impl;
+        size_t _parallelism;
+        ListingCache* _cache;
+        std::atomic<size_t> _numListings;
+
+        /*!
+         * lists all dirs concurrently
+         * @param dirs directory URIs ending with /
+         * @return listing for each dir (same order), failed listings are empty
+         */
+        std::vector<std::vector<ListingEntry>> listAll(const std::vector<std::string>& dirs);
+
+        bool listDirectory(const std::string& dir, std::vector<ListingEntry>& entries);
+    };
+}
+
+#endif //TUPLEX_GLOBEXPANDER_H
@@ -23,6 +23,18 @@ namespace tuplex {
 
     class VirtualFile;
 
+    /*!
+     * single entry of a directory listing
+     */
+    struct ListingEntry {
+        URI uri;
+        size_t size;
+        bool isDirectory;
+
+        ListingEntry() : size(0), isDirectory(false) {}
+        ListingEntry(const URI& uri, size_t size, bool isDirectory) : uri(uri), size(size), isDirectory(isDirectory) {}
+    };
+
     /*!
      * abstract class to implement a concrete FileSystem implementation
      */
@@ -38,6 +50,15 @@ namespace tuplex {
         virtual std::unique_ptr<VirtualMappedFile> map_file(const URI& uri) = 0;
         virtual std::vector<URI> glob(const std::string& pattern) = 0;
 
+        /*!
+         * lists a single directory (no recursion) incl. file sizes. Default implementation uses ls and file_size,
+         * file systems should overwrite this to retrieve sizes with the listing.
+         * @param dir directory to list
+         * @param entries output, files and subdirectories of dir
+         * @return status code
+         */
+        virtual VirtualFileSystemStatus list(const URI& dir, std::vector<ListingEntry>* entries);
+
         // abstract implementation using glob & Co available per default
         virtual bool walkPattern(const URI& pattern, std::function<bool(void*, const URI&, size_t)> callback, void* userData=nullptr);
     };
@@ -25,7 +25,7 @@ namespace tuplex {
      * @param local_path path to a local file
      * @return mime type as string or "application/octet-stream" in case of failure
      */
-    std::string detectMIMEType(const std::string& local_path) noexcept {
+    inline std::string detectMIMEType(const std::string& local_path) noexcept {
         magic_t mag = magic_open(MAGIC_MIME_TYPE);
         if(!mag) {
 #ifndef NDEBUG
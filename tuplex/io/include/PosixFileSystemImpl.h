@@ -42,6 +42,8 @@ namespace tuplex {
 
             void open();
             VirtualFileSystemStatus write(const void* buffer, uint64_t bufferSize) override;
+            VirtualFileSystemStatus writev(const std::vector<std::pair<const void*, uint64_t>>& buffers) override;
+            VirtualFileSystemStatus reserve(uint64_t numBytes) override;
             VirtualFileSystemStatus read(void* buffer, uint64_t nbytes, size_t* bytesRead) const override;
             VirtualFileSystemStatus close() override;
             bool is_open() const override { return _fh != nullptr; }
@@ -104,10 +106,29 @@ namespace tuplex {
         VirtualFileSystemStatus touch(const URI& uri, bool overwrite) override;
         VirtualFileSystemStatus file_size(const URI& uri, uint64_t& size) override;
         VirtualFileSystemStatus ls(const URI& parent, std::vector<URI>* uris) override;
+        VirtualFileSystemStatus list(const URI& dir, std::vector<ListingEntry>* entries) override;
         std::unique_ptr<VirtualMappedFile> map_file(const URI &uri) override;
         std::vector<URI> glob(const std::string& pattern) override;
         static VirtualFileSystemStatus copySingleFile(const URI& src, const URI& target, bool overwrite=true);
 
+        /*!
+         * checks whether both paths refer to the same existing file, e.g. via a hard link, a symlink or a differently
+         * spelled path. Compares device and inode, a copy onto itself would truncate the source.
+         */
+        static bool sameFile(const URI& a, const URI& b);
+
+        /*!
+         * creates (or truncates) a file of given size, incl. missing parent directories. Used to preallocate the
+         * target of a chunked copy.
+         */
+        static VirtualFileSystemStatus createFile(const URI& uri, size_t size);
+
+        /*!
+         * copies bytes [offset, offset + length) of src to the same range of the existing file target. Ranges of the same
+         * file may be copied concurrently. Uses copy_file_range (in-kernel, reflinks where supported) or sendfile on Linux.
+         */
+        static VirtualFileSystemStatus copyRange(const URI& src, const URI& target, size_t offset, size_t length);
+
         // use this...
         // or https://linux.die.net/man/3/ftw
         // https://www.bfilipek.com/2019/04/dir-iterate.html#from-cposix
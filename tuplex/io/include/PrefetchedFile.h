@@ -0,0 +1,60 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_PREFETCHEDFILE_H
+#define TUPLEX_PREFETCHEDFILE_H
+
+#include "IFileSystemImpl.h"
+#include <memory>
+
+namespace tuplex {
+
+    /*!
+     * read-only file, which serves a byte range [offset, offset + length) of the file uri from memory (e.g. loaded ahead
+     * of time by an IO thread). Reads outside of the range are served from the underlying file, which is opened lazily.
+     * A read crossing the end of the range returns the buffered bytes only (short read).
+     */
+    class PrefetchedFile : public VirtualFile {
+    public:
+        PrefetchedFile() = delete;
+
+        /*!
+         * @param uri underlying file
+         * @param fileSize size of the underlying file
+         * @param data buffer holding the range, freed when the file is destroyed
+         * @param offset file offset of the first byte in data
+         * @param length number of bytes in data
+         */
+        PrefetchedFile(const URI& uri, size_t fileSize, std::shared_ptr<const uint8_t> data, size_t offset, size_t length) :
+        VirtualFile::VirtualFile(uri, VirtualFileMode::VFS_READ), _fileSize(fileSize), _data(data), _offset(offset),
+        _length(length), _position(0), _filePosition(0) {}
+
+        VirtualFileSystemStatus write(const void* buffer, uint64_t bufferSize) override { return VirtualFileSystemStatus::VFS_NOTYETIMPLEMENTED; }
+        VirtualFileSystemStatus read(void* buffer, uint64_t nbytes, size_t* bytesRead) const override;
+        VirtualFileSystemStatus close() override;
+        VirtualFileSystemStatus seek(int64_t delta) override;
+        size_t size() const override { return _fileSize; }
+        bool is_open() const override { return true; }
+        bool eof() const override { return _position >= _fileSize; }
+
+    private:
+        size_t _fileSize;
+        std::shared_ptr<const uint8_t> _data;
+        size_t _offset;
+        size_t _length;
+        mutable size_t _position;
+
+        // fallback for reads outside the buffered range
+        mutable std::unique_ptr<VirtualFile> _file;
+        mutable size_t _filePosition;
+    };
+}
+
+#endif //TUPLEX_PREFETCHEDFILE_H
@@ -18,6 +18,9 @@
 #include <Base.h>
 
 #include <aws/s3/model/CompletedPart.h>
+#include <deque>
+#include <future>
+#include <aws/s3/model/UploadPartRequest.h>
 
 namespace tuplex {
     class S3File : public VirtualFile {
@@ -53,16 +56,61 @@ namespace tuplex {
     private:
 
         /*!
-         * requests to fill the buffer with up to bytesToRequest.
-         * @param bytesToRequest how many bytes to request. Must be smaller than _bufferSize - _bufferPosition
-         * @return number of bytes filled in
+         * ranged GET request, issued asynchronously ahead of the consumer
          */
-        size_t fillBuffer(size_t bytesToRequest);
+        struct ReadRequest {
+            size_t offset;
+            size_t length;
+            std::shared_ptr<uint8_t> data; ///! target of the response stream, shared so requests may outlive the file
+            bool cached; ///! served from the block cache, no outcome to wait for
+            Aws::S3::Model::GetObjectOutcomeCallable outcome;
+        };
+
+        /*!
+         * makes the next chunk of the file the buffer (waiting for its request if necessary)
+         * and issues further read-ahead requests.
+         * @return false if file is exhausted
+         */
+        bool nextChunk();
+
+        /*!
+         * issue async ranged request starting at _requestPosition
+         */
+        void issueReadRequest();
+
+        /*!
+         * keep up to readAheadDepth requests in flight, once file is read sequentially
+         */
+        void readAhead();
+
+        /*!
+         * drops buffer & in flight requests, i.e. next read starts at _filePosition
+         */
+        void resetReadState();
+
+        /*!
+         * retrieves etag & size of the object, if the filesystem has a block cache. Sets _objectKey on success.
+         */
+        void lookupObject();
+
+        bool readFromCache(ReadRequest& request);
+        void writeToCache(const ReadRequest& request, size_t retrievedBytes);
+
+        /*!
+         * retrieves bytes [offset, offset + nbytes) with a single ranged request
+         * @return number of bytes retrieved
+         */
+        size_t getRange(size_t offset, uint64_t nbytes, void* buffer) const;
+
+        /*!
+         * readOnly served from whole blocks of the block cache, missing blocks are requested and stored
+         */
+        VirtualFileSystemStatus readOnlyCached(void* buffer, uint64_t nbytes, size_t* bytesRead);
 
         void init();
         S3FileSystemImpl& _s3fs;
 
-        uint8_t *_buffer; ///! buffers
+        uint8_t *_buffer; ///! buffers. In read mode this points to _chunk.
         size_t _bufferLength; ///! how many valid bytes are stored in buffer
         static const size_t _bufferSize = 1024 * 1024 * 32; ///! size of the buffer, set here to 32MB buffer
 
@@ -89,6 +137,14 @@ namespace tuplex {
         size_t _fileSize; ///! lazily set file size from request
         size_t _filePosition; ///! global filePosition (for parts request or multipart upload)
 
+        // variables for reading files from S3
+        std::shared_ptr<uint8_t> _chunk; ///! chunk currently used as buffer
+        std::deque<ReadRequest> _readRequests; ///! in-flight requests, in file order
+        size_t _requestPosition; ///! file offset up to which ranged requests were issued
+        size_t _readChunkSize; ///! size of the next ranged request, doubles up to the max chunk size
+        size_t _numChunksRead;
+        std::string _objectKey; ///! block cache key of the object (uri, etag, size), empty if not cached
+
 
         // variables for uploading files to S3
         void lazyUpload();
@@ -98,8 +154,30 @@ namespace tuplex {
         Aws::String _uploadID; // multipart upload ID
         std::vector<Aws::S3::Model::CompletedPart> _parts;
         void initMultiPartUpload();
-        void uploadPart(); // uploads current buffer & resets everything
-        void completeMultiPartUpload(); // issues complete Upload request
+        void uploadPart(); // hands current buffer to background upload & continues with a fresh buffer
+        void completeMultiPartUpload(); // waits for all parts & issues complete Upload request
+        void abortMultiPartUpload(); // waits for in flight parts & issues abort request
+
+        /*!
+         * part upload running in the background (on the filesystem's executor)
+         */
+        struct PartUpload {
+            int partNumber;
+            uint8_t* buffer;
+            std::future<Aws::S3::Model::UploadPartOutcome> outcome;
+        };
+        std::deque<PartUpload> _partUploads; ///! in flight parts, in part order
+
+        /*!
+         * waits for oldest in flight part, records it as completed and recycles its buffer.
+         * Throws if the part could not be uploaded.
+         */
+        void waitForPart();
+
+        static Aws::S3::Model::UploadPartOutcome uploadPartWithRetry(S3FileSystemImpl& fs,
+                                                                     Aws::S3::Model::UploadPartRequest req,
+                                                                     const uint8_t* buffer,
+                                                                     size_t length);
 
         Aws::S3::Model::RequestPayer _requestPayer;
 
@@ -18,13 +18,21 @@
 #include <aws/transfer/TransferManager.h>
 #include <aws/core/utils/threading/Executor.h>
 #include "IFileSystemImpl.h"
+#include "BlockCache.h"
+#include <atomic>
+#include <mutex>
 
 namespace tuplex {
     class S3FileSystemImpl : public IFileSystemImpl {
         friend class S3File;
     public:
         S3FileSystemImpl() = delete;
-        S3FileSystemImpl(const std::string& access_key, const std::string& secret_key, const std::string& caFile, bool lambdaMode, bool requesterPay);
+        /*!
+         * @param endpointOverride endpoint of an S3 compatible store (e.g. http://127.0.0.1:9000), empty for AWS.
+         *                         Requests use path-style addressing then.
+         */
+        S3FileSystemImpl(const std::string& access_key, const std::string& secret_key, const std::string& caFile, bool lambdaMode, bool requesterPay,
+                         const std::string& endpointOverride="");
 
         Aws::S3::S3Client const& client() const { return *_client.get(); }
 
@@ -32,10 +40,47 @@ namespace tuplex {
         void resetCounters();
         size_t numPuts() const { return _putRequests; }
         size_t numGets() const { return _getRequests; }
+        size_t numHeads() const { return _headRequests; }
         size_t numMultipart() const { return _initMultiPartUploadRequests + _multiPartPutRequests + _closeMultiPartUploadRequests; }
         size_t numLs() const { return _lsRequests; }
         size_t bytesTransferred() const { return _bytesTransferred; }
         size_t bytesReceived() const { return _bytesReceived; }
+        size_t numReadAheadRequests() const { return _readAheadRequests; }
+        size_t readAheadStallTime() const { return _readAheadStallTime; } // in us
+
+        /*!
+         * configures prefetching for files opened in read mode. Ranged GET requests start small and double in size,
+         * once a file is read sequentially up to numRequests requests are kept in flight ahead of the consumer.
+         * @param numRequests number of concurrent ranged requests per file, 0 disables read-ahead
+         * @param maxChunkSize maximum size of a single ranged request
+         */
+        void setReadAhead(size_t numRequests, size_t maxChunkSize) {
+            _readAheadDepth = numRequests;
+            _maxReadChunkSize = std::max(maxChunkSize, (size_t)_initialReadChunkSize);
+        }
+        size_t readAheadDepth() const { return _readAheadDepth; }
+        size_t maxReadChunkSize() const { return _maxReadChunkSize; }
+
+        /*!
+         * configures the background upload of files opened in write mode
+         * @param numParts maximum number of parts per file uploaded concurrently, writer blocks when exceeded
+         * @param maxRetries how often a failed part upload is retried (with exponential backoff)
+         */
+        void setUploadConcurrency(size_t numParts, size_t maxRetries=4) {
+            _uploadConcurrency = std::max(numParts, (size_t)1);
+            _maxUploadRetries = maxRetries;
+        }
+        size_t uploadConcurrency() const { return _uploadConcurrency; }
+        size_t maxUploadRetries() const { return _maxUploadRetries; }
+
+        /*!
+         * sets a local block cache for objects read through this filesystem, nullptr disables caching.
+         * Files opened for reading issue an additional HEAD request to key cached blocks by etag.
+         */
+        void setBlockCache(const std::shared_ptr<BlockCache>& cache) { _blockCache = cache; }
+        std::shared_ptr<BlockCache> blockCache() const { return _blockCache; }
+
+        ~S3FileSystemImpl() override;
 
 
         bool walkPattern(const URI& pattern, std::function<bool(void*, const URI&, size_t)> callback, void* userData=nullptr) override;
@@ -59,21 +104,45 @@ namespace tuplex {
         Aws::S3::Model::RequestPayer _requestPayer;
 
         // to compute pricing, use https://calculator.s3.amazonaws.com/index.html
-        // counters, practical for price estimation
-        size_t _putRequests;
-        size_t _initMultiPartUploadRequests;
-        size_t _multiPartPutRequests;
-        size_t _closeMultiPartUploadRequests;
-        size_t _getRequests;
-        size_t _bytesTransferred;
-        size_t _bytesReceived;
-        size_t _lsRequests;
+        // counters, practical for price estimation. Atomic, because requests are issued concurrently.
+        std::atomic<size_t> _putRequests;
+        std::atomic<size_t> _initMultiPartUploadRequests;
+        std::atomic<size_t> _multiPartPutRequests;
+        std::atomic<size_t> _closeMultiPartUploadRequests;
+        std::atomic<size_t> _getRequests;
+        std::atomic<size_t> _headRequests;
+        std::atomic<size_t> _bytesTransferred;
+        std::atomic<size_t> _bytesReceived;
+        std::atomic<size_t> _lsRequests;
+        std::atomic<size_t> _readAheadRequests;
+        std::atomic<size_t> _readAheadStallTime;
+
+        // async requests of all files (e.g. read-ahead) share one executor/connection pool of this size
+        static const size_t _connectionPoolSize = 32;
+        static const size_t _initialReadChunkSize = 1024 * 1024; // 1MB, enough for samples & small files
+        size_t _readAheadDepth;
+        size_t _maxReadChunkSize;
+        std::shared_ptr<Aws::Utils::Threading::Executor> _executor;
+
+        std::shared_ptr<BlockCache> _blockCache;
+
+        size_t _uploadConcurrency;
+        size_t _maxUploadRetries;
+
+        // part buffers are recycled across files, avoids allocating (and page faulting) a fresh buffer per part
+        static const size_t _maxPooledPartBuffers = 4;
+        std::mutex _partBufferMutex;
+        std::vector<uint8_t*> _partBuffers;
+        size_t _partBufferSize;
+        uint8_t* acquirePartBuffer(size_t size);
+        void releasePartBuffer(uint8_t* buffer);
 
         // transfer manager uses a threadpool, simply use here a pool for some additional threads.
         // Note: this design might be not that great together with the executor threadpool!
         // @TOOD: refactor threadpool to work better!
         std::shared_ptr<Aws::Utils::Threading::PooledThreadExecutor> _thread_pool;
         std::shared_ptr<Aws::Transfer::TransferManager> _transfer_manager;
+        std::mutex _transferMutex; // copy workers initialize concurrently
 
         void initTransferThreadPool(size_t numThreads = 4);
 
@@ -87,6 +156,7 @@ namespace tuplex {
         VirtualFileSystemStatus touch(const URI& uri, bool overwrite=false) override;
         VirtualFileSystemStatus file_size(const URI& uri, uint64_t& size) override;
         VirtualFileSystemStatus ls(const URI& parent, std::vector<URI>* uris) override;
+        VirtualFileSystemStatus list(const URI& dir, std::vector<ListingEntry>* entries) override;
         std::unique_ptr<VirtualMappedFile> map_file(const URI &uri) override;
         std::vector<URI> glob(const std::string& pattern) override;
     };
@@ -13,6 +13,8 @@
 
 #include "IFileSystemImpl.h"
 #include "VirtualFileSystemBase.h"
+#include <utility>
+#include <vector>
 
 namespace tuplex {
     class VirtualFile;
@@ -35,6 +37,27 @@ namespace tuplex {
          */
         virtual VirtualFileSystemStatus write(const void* buffer, uint64_t bufferSize) = 0;
 
+        /*!
+         * writes multiple buffers (in order) with as few calls to the underlying system as possible
+         * @param buffers pairs of data ptr and number of bytes
+         * @return status of write operation
+         */
+        virtual VirtualFileSystemStatus writev(const std::vector<std::pair<const void*, uint64_t>>& buffers) {
+            for(const auto& buf : buffers) {
+                auto rc = write(buf.first, buf.second);
+                if(rc != VirtualFileSystemStatus::VFS_OK)
+                    return rc;
+            }
+            return VirtualFileSystemStatus::VFS_OK;
+        }
+
+        /*!
+         * hint that bytes are going to be written, i.e. file systems may preallocate space
+         * @param numBytes expected number of bytes to be written from the current position on
+         * @return status of operation, not supported is no error
+         */
+        virtual VirtualFileSystemStatus reserve(uint64_t numBytes) { return VirtualFileSystemStatus::VFS_OK; }
+
         /*!
          * reads up to nbytes bytes towards buffer.
          * @param buffer memory location where to store bytes
@@ -32,6 +32,7 @@ namespace tuplex {
     class VirtualMappedFile;
     class VirtualFileSystem;
     class IFileSystemImpl;
+    struct CopyProgress;
 
     /*!
      * wrapper class around file systems. Provides interface to easily add new file adapters.
@@ -65,6 +66,16 @@ namespace tuplex {
          */
         static std::map<std::string, size_t> s3TransferStats();
 
+        /*!
+         * caches blocks of S3 objects on local disk, i.e. repeated reads of the same (unchanged) object are served
+         * locally.
+         * @param dir local directory where to store blocks, survives across processes
+         * @param capacity maximum number of bytes to store, least recently used blocks are evicted
+         */
+        static void enableBlockCache(const URI& dir, size_t capacity);
+        static void disableBlockCache();
+        static bool blockCacheEnabled();
+
         /*!
          * reset S3 file system stats to init state
          * @return
@@ -87,6 +98,12 @@ namespace tuplex {
          * @return handle
          */
         static std::shared_ptr<Aws::Transfer::TransferHandle> s3DownloadFile(const URI& s3_uri, const std::string& local_path);
+
+        /*!
+         * copies an object within S3 (server side)
+         * @return true on success
+         */
+        static bool s3CopyFile(const URI& s3_src, const URI& s3_target);
 #endif
         /*!
          * retrives the file system corresponding to a URI
@@ -151,12 +168,22 @@ namespace tuplex {
 
 
         /*!
-         * copies all files matching the src_pattern to the target URI
+         * copies all files matching the src_pattern to the target URI. Files (and chunks of large local files)
+         * are copied concurrently, cf. setCopyParallelism.
          * @param src_pattern
          * @param target a URI where to store the data
+         * @param progress optional callback, invoked periodically with progress & throughput
          * @return status code
          */
-        static VirtualFileSystemStatus copy(const std::string& src_pattern, const URI& target);
+        static VirtualFileSystemStatus copy(const std::string& src_pattern, const URI& target,
+                                            std::function<void(const CopyProgress&)> progress=nullptr);
+
+        /*!
+         * configures copy
+         * @param parallelism number of files/chunks copied concurrently
+         * @param chunkSize local files larger than this are split into chunks copied in parallel
+         */
+        static void setCopyParallelism(size_t parallelism, size_t chunkSize=32 * 1024 * 1024);
 
         /*!
          * opens a file and returns a file handle for that
@@ -184,16 +211,28 @@ namespace tuplex {
         */
         static bool walkPattern(const URI& pattern, std::function<bool(void*, const URI&, size_t)> callback, void* userData=nullptr);
 
-    private:
-        VirtualFileSystem() : _impl(nullptr)    {}
-        IFileSystemImpl *_impl;
+        /*!
+         * sets how many directories are listed concurrently when expanding patterns for a file system
+         * @param uriPrefix prefix of the file system, e.g. s3://
+         * @param parallelism maximum number of concurrent list requests
+         */
+        static void setListingParallelism(const std::string& uriPrefix, size_t parallelism);
 
+        /*!
+         * enables caching of directory listings across glob/walkPattern calls. Listings are invalidated when files
+         * are written/removed through the VirtualFileSystem, external changes become visible after ttl seconds.
+         * @param ttl time to live of a listing in seconds, 0 disables the cache
+         */
+        static void setListingCacheTTL(double ttl);
 
-        static int copyLocalToLocal(const std::vector<std::string>& src_uris, const URI& target, const std::string& lcp, std::vector<URI>& copied_uris, bool overwrite);
+        /*!
+         * removes all cached directory listings
+         */
+        static void clearListingCache();
 
-#ifdef BUILD_WITH_AWS
-        static int copyLocalToS3(const std::vector<std::string>& src_uris, const URI& target, const std::string& lcp, std::vector<URI>& copied_uris, bool overwrite);
-#endif
+    private:
+        VirtualFileSystem() : _impl(nullptr)    {}
+        IFileSystemImpl *_impl;
     };
 
     //! shortcut for lazy programmers
@@ -0,0 +1,178 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <BlockCache.h>
+#include <Logger.h>
+#include <Utils.h>
+#include <StringUtils.h>
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace tuplex {
+
+    BlockCache::BlockCache(const URI &dir, size_t capacity, size_t blockSize) : _dir(dir.withoutPrefix()),
+    _capacity(capacity), _blockSize(blockSize), _size(0), _hits(0), _misses(0) {
+        assert(_blockSize > 0);
+        if(!dir.isLocal())
+            throw std::runtime_error("block cache directory " + dir.toString() + " must be local");
+
+        boost::system::error_code ec;
+        boost::filesystem::create_directories(_dir, ec);
+        if(ec)
+            throw std::runtime_error("could not create block cache directory " + _dir + ": " + ec.message());
+
+        scanDirectory();
+    }
+
+    std::string BlockCache::objectKey(const URI &uri, const std::string &etag, size_t size) {
+        return uri.toString() + "|" + etag + "|" + std::to_string(size);
+    }
+
+    std::string BlockCache::blockName(const std::string &objectKey, size_t blockIndex) const {
+        // fnv is stable across processes, hence blocks can be found again in later runs
+        std::stringstream ss;
+        ss<<std::hex<<std::setw(16)<<std::setfill('0')<<hash64_fnv(objectKey.c_str(), objectKey.length())
+          <<std::dec<<"_"<<blockIndex<<".blk";
+        return ss.str();
+    }
+
+    void BlockCache::scanDirectory() {
+        using namespace boost::filesystem;
+
+        // order existing blocks by last access (mtime), most recent first
+        std::vector<std::tuple<std::time_t, std::string, size_t>> blocks;
+        for(directory_iterator it(_dir), end; it != end; ++it) {
+            boost::system::error_code ec;
+            auto name = it->path().filename().string();
+            if(!is_regular_file(it->path(), ec))
+                continue;
+
+            // leftovers of interrupted writes
+            if(name.find(".tmp") != std::string::npos) {
+                remove(it->path(), ec);
+                continue;
+            }
+
+            if(!strEndsWith(name, ".blk"))
+                continue;
+            blocks.emplace_back(last_write_time(it->path(), ec), name, file_size(it->path(), ec));
+        }
+        std::sort(blocks.begin(), blocks.end(), [](const std::tuple<std::time_t, std::string, size_t>& a,
+                const std::tuple<std::time_t, std::string, size_t>& b) {
+            return std::get<0>(a) > std::get<0>(b);
+        });
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        for(const auto& b : blocks) {
+            _lru.push_back(std::get<1>(b));
+            _index[std::get<1>(b)] = std::make_pair(std::prev(_lru.end()), std::get<2>(b));
+            _size += std::get<2>(b);
+        }
+        evict();
+
+        if(!blocks.empty())
+            Logger::instance().logger("filesystem").info("found " + pluralize(_index.size(), "cached block")
+            + " (" + sizeToMemString(_size) + ") in " + _dir);
+    }
+
+    bool BlockCache::get(const std::string &objectKey, size_t blockIndex, uint8_t *buffer, size_t length) {
+        auto name = blockName(objectKey, blockIndex);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _index.find(name);
+            if(it == _index.end() || it->second.second != length) {
+                _misses++;
+                return false;
+            }
+            // mark as most recently used
+            _lru.splice(_lru.begin(), _lru, it->second.first);
+        }
+
+        // read without holding the lock. Block may have been evicted in between, which is a miss.
+        auto path = _dir + "/" + name;
+        bool ok = false;
+        FILE *fp = fopen(path.c_str(), "rb");
+        if(fp) {
+            ok = fread(buffer, 1, length, fp) == length;
+            fclose(fp);
+        }
+
+        if(ok) {
+            _hits++;
+        } else {
+            _misses++;
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _index.find(name);
+            if(it != _index.end()) {
+                _size -= it->second.second;
+                _lru.erase(it->second.first);
+                _index.erase(it);
+            }
+        }
+        return ok;
+    }
+
+    void BlockCache::put(const std::string &objectKey, size_t blockIndex, const uint8_t *buffer, size_t length) {
+        if(length > _capacity)
+            return;
+
+        auto name = blockName(objectKey, blockIndex);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(_index.find(name) != _index.end())
+                return;
+        }
+
+        // write to temp file first & rename, so concurrent readers (other processes too) never see partial blocks
+        std::stringstream ss;
+        ss<<_dir<<"/"<<name<<".tmp"<<std::this_thread::get_id();
+        auto tmpPath = ss.str();
+        auto path = _dir + "/" + name;
+        FILE *fp = fopen(tmpPath.c_str(), "wb");
+        if(!fp)
+            return;
+        bool ok = fwrite(buffer, 1, length, fp) == length;
+        ok = (0 == fclose(fp)) && ok;
+        if(!ok || 0 != rename(tmpPath.c_str(), path.c_str())) {
+            ::remove(tmpPath.c_str());
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_index.find(name) != _index.end())
+            return;
+        _lru.push_front(name);
+        _index[name] = std::make_pair(_lru.begin(), length);
+        _size += length;
+        evict();
+    }
+
+    void BlockCache::evict() {
+        while(_size > _capacity && !_lru.empty()) {
+            auto name = _lru.back();
+            auto it = _index.find(name);
+            assert(it != _index.end());
+            _size -= it->second.second;
+            _index.erase(it);
+            _lru.pop_back();
+            ::remove((_dir + "/" + name).c_str());
+        }
+    }
+
+    size_t BlockCache::size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _size;
+    }
+}
@@ -0,0 +1,252 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <CopyEngine.h>
+#include <VirtualFileSystem.h>
+#include <PosixFileSystemImpl.h>
+#include <Logger.h>
+#include <mt/ThreadPool.h>
+#include "MimeType.h"
+#include <cassert>
+
+namespace tuplex {
+
+    void CopyEngine::add(const URI &src, const URI &target) {
+        _files.push_back(File{src, target, 0});
+    }
+
+    bool CopyEngine::parallelFor(size_t n, const std::function<bool(size_t)> &f) {
+        std::atomic<size_t> next(0);
+        std::atomic_bool ok(true);
+
+        // each thread pulls the next index, i.e. no task per item
+        auto work = [&]() {
+            size_t i = 0;
+            while(ok && (i = next++) < n) {
+                try {
+                    if(!f(i))
+                        ok = false;
+                } catch(const std::exception& e) {
+                    Logger::instance().logger("filesystem").error(std::string("copy failed: ") + e.what());
+                    ok = false;
+                }
+            }
+            return true;
+        };
+
+        auto numThreads = std::min(_parallelism, n);
+        if(numThreads <= 1) {
+            work();
+            return ok;
+        }
+
+        ThreadPool pool(numThreads);
+        std::vector<TaskFuture<bool>> futures;
+        for(unsigned i = 0; i < numThreads; ++i)
+            futures.emplace_back(pool.submit(work));
+        for(auto& future : futures)
+            future.get();
+        return ok;
+    }
+
+    VirtualFileSystemStatus CopyEngine::prepare(File &f) {
+        // remote sources are not listed with sizes, transfer them as a whole
+        if(!isLocalCopy(f) || f.src == f.target)
+            return VirtualFileSystemStatus::VFS_OK;
+
+        uint64_t size = 0;
+        auto rc = VirtualFileSystem::fromURI(f.src).file_size(f.src, size);
+        if(rc != VirtualFileSystemStatus::VFS_OK)
+            return rc;
+        f.size = size;
+
+        // preallocate, so chunks can be written concurrently
+        return PosixFileSystemImpl::createFile(f.target, f.size);
+    }
+
+    VirtualFileSystemStatus CopyEngine::downloadThroughCache(const File &f, size_t &bytesDownloaded) {
+        bytesDownloaded = 0;
+        auto src = VirtualFileSystem::open_file(f.src, VirtualFileMode::VFS_READ);
+        auto target = VirtualFileSystem::open_file(f.target, VirtualFileMode::VFS_OVERWRITE);
+        if(!src || !target)
+            return VirtualFileSystemStatus::VFS_IOERROR;
+
+        // remote reads are served from/stored in the block cache by the S3 file
+        std::unique_ptr<uint8_t[]> buffer(new uint8_t[_downloadBufferSize]);
+        while(true) {
+            size_t bytesRead = 0;
+            auto rc = src->read(buffer.get(), _downloadBufferSize, &bytesRead);
+            if(rc != VirtualFileSystemStatus::VFS_OK)
+                return rc;
+            if(0 == bytesRead)
+                break;
+            rc = target->write(buffer.get(), bytesRead);
+            if(rc != VirtualFileSystemStatus::VFS_OK)
+                return rc;
+            bytesDownloaded += bytesRead;
+        }
+        src->close();
+        return target->close();
+    }
+
+    VirtualFileSystemStatus CopyEngine::copyChunk(const Chunk &chunk) {
+        auto& f = _files[chunk.file];
+        auto& logger = Logger::instance().logger("filesystem");
+
+        size_t bytesCopied = chunk.length;
+        if(isLocalCopy(f)) {
+            auto rc = PosixFileSystemImpl::copyRange(f.src, f.target, chunk.offset, chunk.length);
+            if(rc != VirtualFileSystemStatus::VFS_OK) {
+                logger.error("failed to copy " + f.src.toPath() + " to " + f.target.toPath());
+                return rc;
+            }
+        } else {
+#ifdef BUILD_WITH_AWS
+            _touched[chunk.file] = true;
+            std::shared_ptr<Aws::Transfer::TransferHandle> handle;
+            bool downloadedThroughCache = false;
+            if(f.src.isLocal() && f.target.prefix() == "s3://") {
+                auto content_type = detectMIMEType(f.src.withoutPrefix());
+                assert(!content_type.empty());
+                logger.debug("uploading local file " + f.src.withoutPrefix() + " to "
+                             + f.target.toPath() + " (MIME: "+ content_type + ")");
+                handle = VirtualFileSystem::s3UploadFile(f.src.withoutPrefix(), f.target, content_type);
+            } else if(f.src.prefix() == "s3://" && f.target.isLocal()) {
+                auto rc = VirtualFileSystem::fromURI(f.target).create_dir(f.target.parent());
+                if(rc != VirtualFileSystemStatus::VFS_OK)
+                    return rc;
+                // downloads go through the block cache if enabled, else via the transfer manager
+                if(VirtualFileSystem::blockCacheEnabled()) {
+                    size_t bytesDownloaded = 0;
+                    rc = downloadThroughCache(f, bytesDownloaded);
+                    if(rc != VirtualFileSystemStatus::VFS_OK) {
+                        logger.error("failed to download " + f.src.toPath() + " to " + f.target.toPath());
+                        return rc;
+                    }
+                    bytesCopied = bytesDownloaded;
+                    downloadedThroughCache = true;
+                } else
+                    handle = VirtualFileSystem::s3DownloadFile(f.src, f.target.withoutPrefix());
+            } else if(f.src.prefix() == "s3://" && f.target.prefix() == "s3://") {
+                // server side copy, no bytes pass through here
+                bytesCopied = 0;
+                if(!VirtualFileSystem::s3CopyFile(f.src, f.target))
+                    return VirtualFileSystemStatus::VFS_IOERROR;
+            } else {
+                logger.error("unsupported copy from " + f.src.toPath() + " to " + f.target.toPath());
+                return VirtualFileSystemStatus::VFS_IOERROR;
+            }
+
+            if(handle) {
+                auto status = handle->GetStatus();
+                if(status != Aws::Transfer::TransferStatus::COMPLETED && status != Aws::Transfer::TransferStatus::EXACT_OBJECT_ALREADY_EXISTS)
+                    return VirtualFileSystemStatus::VFS_IOERROR;
+                bytesCopied = handle->GetBytesTransferred();
+            } else if(bytesCopied != 0 && !downloadedThroughCache)
+                return VirtualFileSystemStatus::VFS_IOERROR;
+#else
+            logger.error("Tuplex version was build without AWS SDK support. Can't copy " + f.src.toPath() + " to " + f.target.toPath());
+            return VirtualFileSystemStatus::VFS_IOERROR;
+#endif
+        }
+
+        _bytesCopied += bytesCopied;
+        if(0 == --_pendingChunks[chunk.file])
+            _filesCopied++;
+        reportProgress(false);
+        return VirtualFileSystemStatus::VFS_OK;
+    }
+
+    VirtualFileSystemStatus CopyEngine::run(std::vector<URI> &targets) {
+        auto& logger = Logger::instance().logger("filesystem");
+        _start = std::chrono::steady_clock::now();
+        _lastProgress = 0.0;
+        _filesCopied = 0;
+        _bytesCopied = 0;
+        _bytesTotal = 0;
+        _pendingChunks.reset(new std::atomic<size_t>[_files.size()]);
+        _touched.reset(new std::atomic<bool>[_files.size()]);
+        for(unsigned i = 0; i < _files.size(); ++i)
+            _touched[i] = false;
+
+        // 1. sizes & preallocation of local targets
+        bool ok = parallelFor(_files.size(), [this, &logger](size_t i) {
+            const auto& f = _files[i];
+            if(isLocalCopy(f) && f.src != f.target && PosixFileSystemImpl::sameFile(f.src, f.target)) {
+                // truncating the target would destroy the source, target must not be cleaned up either
+                logger.error("can't copy " + f.src.toPath() + " to " + f.target.toPath() + ", both refer to the same file");
+                return false;
+            }
+            _touched[i] = isLocalCopy(f) && f.src != f.target;
+            auto rc = prepare(_files[i]);
+            if(rc != VirtualFileSystemStatus::VFS_OK)
+                logger.error("failed to create " + _files[i].target.toPath() + " for copying");
+            return rc == VirtualFileSystemStatus::VFS_OK;
+        });
+
+        // 2. split into chunks, i.e. a single large file is copied by multiple threads
+        std::vector<Chunk> chunks;
+        if(ok) {
+            for(unsigned i = 0; i < _files.size(); ++i) {
+                const auto& f = _files[i];
+                if(f.src == f.target) {
+                    _pendingChunks[i] = 0;
+                    _filesCopied++;
+                    continue;
+                }
+
+                if(isLocalCopy(f)) {
+                    _bytesTotal += f.size;
+                    size_t numChunks = std::max((f.size + _chunkSize - 1) / _chunkSize, (size_t)1);
+                    _pendingChunks[i] = numChunks;
+                    for(size_t j = 0; j < numChunks; ++j)
+                        chunks.push_back(Chunk{i, j * _chunkSize, std::min(_chunkSize, f.size - j * _chunkSize)});
+                } else {
+                    _pendingChunks[i] = 1;
+                    chunks.push_back(Chunk{i, 0, 0});
+                }
+            }
+
+            // 3. copy
+            ok = parallelFor(chunks.size(), [this, &chunks](size_t i) {
+                return copyChunk(chunks[i]) == VirtualFileSystemStatus::VFS_OK;
+            });
+        }
+
+        for(unsigned i = 0; i < _files.size(); ++i)
+            if(_touched[i])
+                targets.push_back(_files[i].target);
+
+        reportProgress(true);
+        return ok ? VirtualFileSystemStatus::VFS_OK : VirtualFileSystemStatus::VFS_IOERROR;
+    }
+
+    CopyProgress CopyEngine::progress() const {
+        CopyProgress p;
+        p.filesCopied = _filesCopied;
+        p.filesTotal = _files.size();
+        p.bytesCopied = _bytesCopied;
+        p.bytesTotal = std::max(_bytesTotal, p.bytesCopied);
+        p.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+        return p;
+    }
+
+    void CopyEngine::reportProgress(bool force) {
+        if(!_progressCallback)
+            return;
+
+        std::lock_guard<std::mutex> lock(_progressMutex);
+        auto p = progress();
+        if(!force && p.elapsed - _lastProgress < _progressInterval)
+            return;
+        _lastProgress = p.elapsed;
+        _progressCallback(p);
+    }
+}
@@ -0,0 +1,231 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <GlobExpander.h>
+#include <Logger.h>
+#include <StringUtils.h>
+#include <Utils.h>
+#include <mt/ThreadPool.h>
+#include <fnmatch.h>
+#include <cstring>
+
+namespace tuplex {
+
+    bool ListingCache::get(const std::string &dir, std::vector<ListingEntry> &entries) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_ttl <= 0.0)
+            return false;
+
+        auto it = _listings.find(dir);
+        if(it == _listings.end()) {
+            _misses++;
+            return false;
+        }
+
+        // expired?
+        std::chrono::duration<double> age = clock::now() - it->second.timestamp;
+        if(age.count() > _ttl) {
+            _listings.erase(it);
+            _misses++;
+            return false;
+        }
+
+        entries = it->second.entries;
+        _hits++;
+        return true;
+    }
+
+    void ListingCache::put(const std::string &dir, const std::vector<ListingEntry> &entries) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_ttl <= 0.0)
+            return;
+
+        _listings[dir] = Listing{clock::now(), entries};
+    }
+
+    void ListingCache::invalidate(const URI &uri) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_listings.empty())
+            return;
+
+        auto path = uri.toString();
+        while(!path.empty() && path.back() == '/')
+            path.pop_back();
+
+        // keys are directories ending with /. Remove all ancestors (their listing may contain a new/removed subdir)
+        // as well as all listings below uri.
+        auto it = _listings.begin();
+        while(it != _listings.end()) {
+            const auto& key = it->first;
+            if(startsWith(path, key) || startsWith(key, path + "/"))
+                it = _listings.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    bool GlobExpander::hasWildcard(const std::string &path) {
+        for(unsigned i = 0; i < path.length(); ++i) {
+            if(path[i] == '\\') {
+                i++; // skip escaped char
+                continue;
+            }
+            if(path[i] == '*' || path[i] == '?' || path[i] == '[')
+                return true;
+        }
+        return false;
+    }
+
+    // removes escape chars from a literal path component
+    static std::string unescape(const std::string& s) {
+        std::string res;
+        res.reserve(s.length());
+        for(unsigned i = 0; i < s.length(); ++i) {
+            if(s[i] == '\\' && i + 1 < s.length())
+                i++;
+            res += s[i];
+        }
+        return res;
+    }
+
+    // last path component, ignoring a trailing /
+    static std::string entryName(const URI& uri) {
+        auto path = uri.toString();
+        if(!path.empty() && path.back() == '/')
+            path.pop_back();
+        auto idx = path.rfind('/');
+        return idx == std::string::npos ? path : path.substr(idx + 1);
+    }
+
+    bool GlobExpander::listDirectory(const std::string &dir, std::vector<ListingEntry> &entries) {
+        if(_cache && _cache->get(dir, entries))
+            return true;
+
+        auto rc = _impl->list(URI(dir), &entries);
+        _numListings++;
+        if(rc != VirtualFileSystemStatus::VFS_OK) {
+            // not existing dirs are expected when literal components follow a wildcard
+            entries.clear();
+            return false;
+        }
+
+        // relative local paths depend on the working directory, hence don't cache them
+        bool relativePath = startsWith(dir, "file://") && (dir.length() == strlen("file://") || dir[strlen("file://")] != '/');
+        if(_cache && !relativePath)
+            _cache->put(dir, entries);
+        return true;
+    }
+
+    std::vector<std::vector<ListingEntry>> GlobExpander::listAll(const std::vector<std::string> &dirs) {
+        std::vector<std::vector<ListingEntry>> listings(dirs.size());
+
+        auto numThreads = std::min(_parallelism, dirs.size());
+        if(numThreads <= 1) {
+            for(unsigned i = 0; i < dirs.size(); ++i)
+                listDirectory(dirs[i], listings[i]);
+            return listings;
+        }
+
+        // list dirs concurrently, each task writes its own slot so no synchronization is required.
+        ThreadPool pool(numThreads);
+        std::vector<TaskFuture<bool>> futures;
+        futures.reserve(dirs.size());
+        for(unsigned i = 0; i < dirs.size(); ++i) {
+            futures.emplace_back(pool.submit([this, &dirs, &listings, i]() {
+                try {
+                    return listDirectory(dirs[i], listings[i]);
+                } catch(const std::exception& e) {
+                    Logger::instance().logger("filesystem").error("listing " + dirs[i] + " failed: " + e.what());
+                    listings[i].clear();
+                    return false;
+                }
+            }));
+        }
+        for(auto& f : futures)
+            f.get();
+
+        return listings;
+    }
+
+    std::vector<ListingEntry> GlobExpander::expand(const std::string &pattern) {
+        _numListings = 0;
+
+        URI uri(pattern);
+        auto prefix = uri.prefix();
+        auto path = uri.withoutPrefix();
+
+        // trailing / in pattern => only directories match (same as glob(3))
+        bool onlyDirs = !path.empty() && path.back() == '/';
+
+        // hidden files are only matched explicitly on local file systems
+        int flags = prefix == "file://" ? FNM_PERIOD : 0;
+
+        // root directory: bucket for S3, / for absolute local paths, working directory for relative ones
+        std::string root = prefix;
+        auto components = splitToArray(path, '/');
+        components.erase(std::remove(components.begin(), components.end(), ""), components.end());
+        if(prefix == "s3://") {
+            if(components.empty() || hasWildcard(components.front())) {
+                Logger::instance().logger("filesystem").warn("globbing for bucket not supported, '" + pattern + "' invalid. Glob will return empty list.");
+                return {};
+            }
+            root += components.front() + "/";
+            components.erase(components.begin());
+        } else if(!path.empty() && path.front() == '/') {
+            root += "/";
+        }
+
+        if(components.empty())
+            return {};
+
+        // longest literal prefix is the starting directory
+        auto dir = root;
+        unsigned pos = 0;
+        while(pos + 1 < components.size() && !hasWildcard(components[pos]))
+            dir += unescape(components[pos++]) + "/";
+
+        std::vector<ListingEntry> results;
+        std::vector<std::string> frontier{dir};
+        for(; pos < components.size() && !frontier.empty(); ++pos) {
+            const auto& component = components[pos];
+            bool last = pos + 1 == components.size();
+
+            // literal component in between => no need to list
+            if(!last && !hasWildcard(component)) {
+                for(auto& d : frontier)
+                    d += unescape(component) + "/";
+                continue;
+            }
+
+            auto listings = listAll(frontier);
+            std::vector<std::string> next;
+            for(const auto& listing : listings) {
+                for(const auto& entry : listing) {
+                    if(0 != fnmatch(component.c_str(), entryName(entry.uri).c_str(), flags))
+                        continue;
+
+                    if(last) {
+                        if(!onlyDirs || entry.isDirectory)
+                            results.push_back(entry);
+                    } else if(entry.isDirectory) {
+                        auto d = entry.uri.toString();
+                        next.push_back(d.back() == '/' ? d : d + "/");
+                    }
+                }
+            }
+            frontier = std::move(next);
+        }
+
+        std::sort(results.begin(), results.end(), [](const ListingEntry& a, const ListingEntry& b) {
+            return a.uri.toString() < b.uri.toString();
+        });
+        return results;
+    }
+}
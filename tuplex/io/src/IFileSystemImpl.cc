@@ -13,6 +13,23 @@
 #include <cassert>
 
 namespace tuplex {
+    VirtualFileSystemStatus IFileSystemImpl::list(const URI &dir, std::vector<ListingEntry> *entries) {
+        assert(entries);
+        std::vector<URI> uris;
+        auto rc = ls(dir, &uris);
+        if(rc != VirtualFileSystemStatus::VFS_OK)
+            return rc;
+
+        for(const auto& uri : uris) {
+            bool isDirectory = !uri.isFile();
+            uint64_t size = 0;
+            if(!isDirectory)
+                file_size(uri, size);
+            entries->emplace_back(uri, size, isDirectory);
+        }
+        return VirtualFileSystemStatus::VFS_OK;
+    }
+
     bool IFileSystemImpl::walkPattern(const tuplex::URI &pattern,
                                       std::function<bool(void *, const tuplex::URI &, size_t)> callback,
                                       void *userData) {
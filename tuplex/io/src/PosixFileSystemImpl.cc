@@ -20,6 +20,12 @@
 #include <stdexcept>
 #include <sys/stat.h>
 #include <dirent.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+#include <sys/uio.h>
 
 #ifdef LINUX
 // use cstdio extensions to disable locking on FILE streams
@@ -104,8 +110,43 @@ namespace tuplex {
     }
 
     VirtualFileSystemStatus PosixFileSystemImpl::ls(const URI &parent, std::vector <URI> *uris) {
+        assert(uris);
+        std::vector<ListingEntry> entries;
+        auto rc = list(parent, &entries);
+        for(const auto& entry : entries)
+            uris->push_back(entry.uri);
+        return rc;
+    }
+
+    VirtualFileSystemStatus PosixFileSystemImpl::list(const URI &dir, std::vector<ListingEntry> *entries) {
+        assert(entries);
+        if(!validPrefix(dir))
+            return VirtualFileSystemStatus::VFS_INVALIDPREFIX;
+
+        // empty path refers to the working directory
+        auto path = dir.withoutPrefix();
+        DIR *dp = opendir(path.empty() ? "." : path.c_str());
+        if(!dp)
+            return errno == ENOENT || errno == ENOTDIR ? VirtualFileSystemStatus::VFS_FILENOTFOUND : VirtualFileSystemStatus::VFS_IOERROR;
+
+        auto base = std::string("file://") + path;
+        if(!path.empty() && path.back() != '/')
+            base += "/";
 
-        // @TODO: Implement...
+        struct dirent *ep = nullptr;
+        struct stat sb;
+        while((ep = readdir(dp))) {
+            if(0 == strcmp(ep->d_name, ".") || 0 == strcmp(ep->d_name, ".."))
+                continue;
+
+            // stat relative to the open directory, skips path resolution. Ignore e.g. dangling symlinks.
+            if(0 != fstatat(dirfd(dp), ep->d_name, &sb, 0))
+                continue;
+
+            bool isDirectory = S_ISDIR(sb.st_mode);
+            entries->emplace_back(URI(base + ep->d_name), isDirectory ? 0 : sb.st_size, isDirectory);
+        }
+        closedir(dp);
 
         return VirtualFileSystemStatus::VFS_OK;
     }
@@ -204,6 +245,65 @@ namespace tuplex {
                                                   : VirtualFileSystemStatus::VFS_IOERROR;
     }
 
+    VirtualFileSystemStatus PosixFileSystemImpl::PosixFile::writev(const std::vector<std::pair<const void*, uint64_t>> &buffers) {
+        if(!_fh)
+            return VirtualFileSystemStatus::VFS_IOERROR;
+
+        // small writes are cheaper through the stdio buffer
+        uint64_t totalBytes = 0;
+        for(const auto& buf : buffers)
+            totalBytes += buf.second;
+        if(totalBytes < POSIX_IOBUF_SIZE)
+            return VirtualFile::writev(buffers);
+
+        // bypass stdio buffer, i.e. flush whatever is buffered and write directly from the buffers
+        if(0 != fflush(_fh))
+            return VirtualFileSystemStatus::VFS_IOERROR;
+        int fd = fileno(_fh);
+
+        std::vector<struct iovec> iov;
+        iov.reserve(std::min(buffers.size(), (size_t)IOV_MAX));
+        size_t pos = 0;
+        while(pos < buffers.size()) {
+            iov.clear();
+            for(; pos < buffers.size() && iov.size() < IOV_MAX; ++pos)
+                if(buffers[pos].second > 0)
+                    iov.push_back({const_cast<void*>(buffers[pos].first), buffers[pos].second});
+
+            // handle partial writes (e.g. > 2GB or interrupted)
+            size_t idx = 0;
+            while(idx < iov.size()) {
+                auto n = ::writev(fd, iov.data() + idx, static_cast<int>(std::min(iov.size() - idx, (size_t)IOV_MAX)));
+                if(n < 0) {
+                    if(errno == EINTR)
+                        continue;
+                    return VirtualFileSystemStatus::VFS_IOERROR;
+                }
+                while(idx < iov.size() && static_cast<size_t>(n) >= iov[idx].iov_len) {
+                    n -= iov[idx].iov_len;
+                    idx++;
+                }
+                if(idx < iov.size()) {
+                    iov[idx].iov_base = static_cast<uint8_t*>(iov[idx].iov_base) + n;
+                    iov[idx].iov_len -= n;
+                }
+            }
+        }
+        return VirtualFileSystemStatus::VFS_OK;
+    }
+
+    VirtualFileSystemStatus PosixFileSystemImpl::PosixFile::reserve(uint64_t numBytes) {
+        if(!_fh)
+            return VirtualFileSystemStatus::VFS_IOERROR;
+#ifdef LINUX
+        // preallocate blocks without changing the file size, avoids fragmentation & metadata updates while writing
+        auto offset = ftello(_fh);
+        if(offset >= 0 && numBytes > 0)
+            fallocate(fileno(_fh), FALLOC_FL_KEEP_SIZE, offset, numBytes);
+#endif
+        return VirtualFileSystemStatus::VFS_OK;
+    }
+
     VirtualFileSystemStatus PosixFileSystemImpl::PosixFile::read(void *buffer, uint64_t nbytes,
                                                                  size_t* outBytesRead) const {
         if(!_fh)
@@ -514,6 +614,8 @@ namespace tuplex {
 
         if(src == target)
             return VirtualFileSystemStatus::VFS_OK;
+        if(sameFile(src, target))
+            return VirtualFileSystemStatus::VFS_IOERROR;
 
         // if / is contained, make sure path exists, if not create dir
         if(std::string::npos != target.withoutPrefix().find("/")) {
@@ -528,23 +630,13 @@ namespace tuplex {
             return VirtualFileSystemStatus::VFS_FILENOTFOUND;
 
 #ifdef LINUX
-        // use sendfile only on Linux, on macOS it's broken
-        // https://gist.github.com/gustavorv86/595127b9c22144f92b74f71a36098a4c
-        auto fd_in = open(src.withoutPrefix().c_str(), O_RDONLY);
-        if(-1 == fd_in)
-            return VirtualFileSystemStatus::VFS_IOERROR;
-        auto fd_out = creat(target.withoutPrefix().c_str(), 0660);
-        if(-1 == fd_out) {
-            close(fd_in);
-            return VirtualFileSystemStatus::VFS_IOERROR;
-        }
         struct stat s_stat = {0};
-        fstat(fd_in, &s_stat);
-        off_t n_bytes = 0;
-        // https://man7.org/linux/man-pages/man2/sendfile.2.html
-        auto rc = sendfile(fd_out, fd_in, &n_bytes, s_stat.st_size);
-        close(fd_in);
-        close(fd_out);
+        if(0 != stat(src.withoutPrefix().c_str(), &s_stat))
+            return VirtualFileSystemStatus::VFS_IOERROR;
+        auto rc = createFile(target, s_stat.st_size);
+        if(rc != VirtualFileSystemStatus::VFS_OK)
+            return rc;
+        return copyRange(src, target, 0, s_stat.st_size);
 #else
         auto s = copyfile_state_alloc();
         int rc = copyfile(src.withoutPrefix().c_str(), target.withoutPrefix().c_str(), s, COPYFILE_ALL);
@@ -557,8 +649,90 @@ namespace tuplex {
         return VirtualFileSystemStatus::VFS_OK;
     }
 
+    bool PosixFileSystemImpl::sameFile(const URI &a, const URI &b) {
+        // stat follows symlinks, i.e. compares the files both paths resolve to
+        struct stat a_stat = {0}, b_stat = {0};
+        if(0 != stat(a.withoutPrefix().c_str(), &a_stat) || 0 != stat(b.withoutPrefix().c_str(), &b_stat))
+            return false;
+        return a_stat.st_dev == b_stat.st_dev && a_stat.st_ino == b_stat.st_ino;
+    }
+
+    VirtualFileSystemStatus PosixFileSystemImpl::createFile(const URI &uri, size_t size) {
+        auto path = uri.withoutPrefix();
+        if(std::string::npos != path.find("/")) {
+            auto rc = VirtualFileSystem::fromURI(uri.parent()).create_dir(uri.parent());
+            if(rc != VirtualFileSystemStatus::VFS_OK)
+                return VirtualFileSystemStatus::VFS_IOERROR;
+        }
+
+        auto fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0660);
+        if(-1 == fd)
+            return VirtualFileSystemStatus::VFS_IOERROR;
+        auto rc = ftruncate(fd, size);
+        close(fd);
+        return 0 == rc ? VirtualFileSystemStatus::VFS_OK : VirtualFileSystemStatus::VFS_IOERROR;
+    }
+
+    VirtualFileSystemStatus PosixFileSystemImpl::copyRange(const URI &src, const URI &target, size_t offset, size_t length) {
+        auto fd_in = open(src.withoutPrefix().c_str(), O_RDONLY);
+        if(-1 == fd_in)
+            return VirtualFileSystemStatus::VFS_IOERROR;
+        auto fd_out = open(target.withoutPrefix().c_str(), O_WRONLY);
+        if(-1 == fd_out) {
+            close(fd_in);
+            return VirtualFileSystemStatus::VFS_IOERROR;
+        }
+
+        // syscalls may copy less than requested (e.g. sendfile at most 2GB), hence loop
+        off_t off_in = offset, off_out = offset;
+        size_t remaining = length;
+#ifdef LINUX
+        bool useCopyFileRange = true;
+#endif
+        while(remaining > 0) {
+            ssize_t n = -1;
+#ifdef LINUX
+            if(useCopyFileRange) {
+                n = copy_file_range(fd_in, &off_in, fd_out, &off_out, remaining, 0);
+                // not supported by kernel/filesystem (or cross device on older kernels) => fall back to sendfile
+                if(n < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)) {
+                    useCopyFileRange = false;
+                    continue;
+                }
+            } else {
+                // sendfile writes at the current position of fd_out
+                if(lseek(fd_out, off_out, SEEK_SET) < 0)
+                    break;
+                n = sendfile(fd_out, fd_in, &off_in, remaining);
+                if(n > 0)
+                    off_out += n;
+            }
+#else
+            char buf[64 * 1024];
+            n = pread(fd_in, buf, std::min(remaining, sizeof(buf)), off_in);
+            if(n > 0) {
+                if(pwrite(fd_out, buf, n, off_out) != n) {
+                    n = -1;
+                } else {
+                    off_in += n;
+                    off_out += n;
+                }
+            }
+#endif
+            if(n < 0 && errno == EINTR)
+                continue;
+            if(n <= 0) // error or src is shorter than expected
+                break;
+            remaining -= n;
+        }
+
+        close(fd_in);
+        close(fd_out);
+        return 0 == remaining ? VirtualFileSystemStatus::VFS_OK : VirtualFileSystemStatus::VFS_IOERROR;
+    }
+
     VirtualFileSystemStatus PosixFileSystemImpl::PosixFile::seek(int64_t delta) {
-        return fseek(this->_fh, delta, SEEK_CUR) ? VirtualFileSystemStatus::VFS_OK : VirtualFileSystemStatus::VFS_IOERROR;
+        return 0 == fseek(this->_fh, delta, SEEK_CUR) ? VirtualFileSystemStatus::VFS_OK : VirtualFileSystemStatus::VFS_IOERROR;
     }
 
     std::vector<URI> PosixFileSystemImpl::expandFolder(const URI &dir) {
@@ -0,0 +1,79 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <PrefetchedFile.h>
+#include <VirtualFileSystem.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace tuplex {
+
+    VirtualFileSystemStatus PrefetchedFile::read(void *buffer, uint64_t nbytes, size_t *bytesRead) const {
+        assert(buffer);
+        if(bytesRead)
+            *bytesRead = 0;
+
+        // buffered range
+        if(_position >= _offset && _position < _offset + _length) {
+            auto n = std::min(nbytes, static_cast<uint64_t>(_offset + _length - _position));
+            memcpy(buffer, _data.get() + (_position - _offset), n);
+            _position += n;
+            if(bytesRead)
+                *bytesRead = n;
+            return VirtualFileSystemStatus::VFS_OK;
+        }
+
+        if(_position >= _fileSize)
+            return VirtualFileSystemStatus::VFS_OK;
+
+        // outside of range, use the actual file
+        if(!_file) {
+            _file = VirtualFileSystem::open_file(_uri, VirtualFileMode::VFS_READ);
+            _filePosition = 0;
+            if(!_file)
+                return VirtualFileSystemStatus::VFS_IOERROR;
+        }
+        if(_filePosition != _position) {
+            auto rc = _file->seek(static_cast<int64_t>(_position) - static_cast<int64_t>(_filePosition));
+            _filePosition = _position;
+            if(rc != VirtualFileSystemStatus::VFS_OK)
+                return rc;
+        }
+
+        // do not read into the buffered range
+        if(_position < _offset)
+            nbytes = std::min(nbytes, static_cast<uint64_t>(_offset - _position));
+        size_t n = 0;
+        auto rc = _file->read(buffer, nbytes, &n);
+        _position += n;
+        _filePosition += n;
+        if(bytesRead)
+            *bytesRead = n;
+        return rc;
+    }
+
+    VirtualFileSystemStatus PrefetchedFile::seek(int64_t delta) {
+        if(delta < 0 && static_cast<size_t>(-delta) > _position)
+            _position = 0;
+        else
+            _position = std::min(_position + delta, _fileSize);
+        return VirtualFileSystemStatus::VFS_OK;
+    }
+
+    VirtualFileSystemStatus PrefetchedFile::close() {
+        _data.reset();
+        _length = 0;
+        if(_file)
+            _file->close();
+        _file.reset();
+        return VirtualFileSystemStatus::VFS_OK;
+    }
+}
@@ -17,7 +17,12 @@
 #include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
 #include <aws/s3/model/UploadPartRequest.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
+#include <BlockCache.h>
+#include <thread>
 #include <StringUtils.h>
+#include <aws/core/http/HttpResponse.h>
 
 
 #include <Timer.h>
@@ -51,6 +56,9 @@ namespace tuplex {
         _fileSize = 0;
         _filePosition = 0;
         _partNumber = 0; // set to 0
+        _requestPosition = 0;
+        _readChunkSize = S3FileSystemImpl::_initialReadChunkSize;
+        _numChunksRead = 0;
 
         // S3 files can only operate on read xor write mode
         if(_mode & VirtualFileMode::VFS_WRITE && _mode & VirtualFileMode::VFS_READ)
@@ -162,9 +170,34 @@ namespace tuplex {
     }
 
 
-    void S3File::uploadPart() {
-        MessageHandler& logger = Logger::instance().logger("s3fs");
+    Aws::S3::Model::UploadPartOutcome S3File::uploadPartWithRetry(S3FileSystemImpl& fs,
+                                                                   Aws::S3::Model::UploadPartRequest req,
+                                                                   const uint8_t *buffer,
+                                                                   size_t length) {
+        for(unsigned attempt = 0; ; ++attempt) {
+            // body stream needs to be recreated for each attempt
+            auto stream = std::shared_ptr<Aws::IOStream>(new boost::interprocess::bufferstream((char*)buffer, length));
+            req.SetBody(stream);
+
+            auto outcome = fs.client().UploadPart(req);
+            fs._multiPartPutRequests++;
+            if(outcome.IsSuccess()) {
+                fs._bytesTransferred += length;
+                return outcome;
+            }
 
+            if(attempt >= fs.maxUploadRetries() || !outcome.GetError().ShouldRetry())
+                return outcome;
+
+            // exponential backoff, 100ms, 200ms, 400ms, ...
+            auto backoff = std::chrono::milliseconds(100 << std::min(attempt, 10u));
+            Logger::instance().logger("s3fs").warn("upload of part " + std::to_string(req.GetPartNumber()) + " failed ("
+            + std::string(outcome.GetError().GetMessage().c_str()) + "), retrying in " + std::to_string(backoff.count()) + "ms");
+            std::this_thread::sleep_for(backoff);
+        }
+    }
+
+    void S3File::uploadPart() {
         assert(_partNumber > 0); // if this is zero, need to all init before!
         assert(_buffer);
 
@@ -172,6 +205,10 @@ namespace tuplex {
         if(_bufferLength == 0 && _partNumber > 1)
             return;
 
+        // bound memory & connections used by this file, i.e. wait for the oldest part first
+        while(_partUploads.size() >= _s3fs.uploadConcurrency())
+            waitForPart();
+
         Aws::S3::Model::UploadPartRequest req;
         //@Todo: what about content MD5???
         req.SetBucket(_uri.s3Bucket().c_str());
@@ -181,27 +218,69 @@ namespace tuplex {
         req.SetContentLength(_bufferLength);
         req.SetRequestPayer(_requestPayer);
 
-        auto stream = std::shared_ptr<Aws::IOStream>(new boost::interprocess::bufferstream((char*)_buffer, _bufferLength));
-        req.SetBody(stream);
+        // upload in background, buffer is owned by the part until it is done
+        PartUpload part;
+        part.partNumber = _partNumber;
+        part.buffer = _buffer;
+        auto fs = &_s3fs;
+        auto buffer = _buffer;
+        auto length = _bufferLength;
+        auto task = std::make_shared<std::packaged_task<Aws::S3::Model::UploadPartOutcome()>>([fs, req, buffer, length]() {
+            return uploadPartWithRetry(*fs, req, buffer, length);
+        });
+        part.outcome = task->get_future();
+        if(!_s3fs._executor->Submit([task]() { (*task)(); }))
+            (*task)(); // executor declined, upload synchronously
+        _partUploads.push_back(std::move(part));
+
+        // continue with fresh buffer
+        _buffer = _s3fs.acquirePartBuffer(_bufferSize);
+        _bufferPosition = 0;
+        _bufferLength = 0;
+        _partNumber++;
+    }
 
-        auto outcome = _s3fs.client().UploadPart(req);
-        _s3fs._multiPartPutRequests++;
-        _s3fs._bytesTransferred += _bufferLength;
+    void S3File::waitForPart() {
+        assert(!_partUploads.empty());
+        auto part = std::move(_partUploads.front());
+        _partUploads.pop_front();
+
+        auto outcome = part.outcome.get();
+        _s3fs.releasePartBuffer(part.buffer);
         if(!outcome.IsSuccess()) {
+            MessageHandler& logger = Logger::instance().logger("s3fs");
             logger.error(outcome_error_message(outcome));
+            abortMultiPartUpload();
             throw std::runtime_error(outcome_error_message(outcome));
         }
 
         // record upload
         Aws::S3::Model::CompletedPart completed_part;
         completed_part.SetETag(outcome.GetResult().GetETag());
-        completed_part.SetPartNumber(_partNumber);
+        completed_part.SetPartNumber(part.partNumber);
         _parts.emplace_back(completed_part);
+    }
 
-        // reset buffer
-        _bufferPosition = 0;
-        _bufferLength = 0;
-        _partNumber++;
+    void S3File::abortMultiPartUpload() {
+        // parts still in flight reference their buffers, wait for them
+        while(!_partUploads.empty()) {
+            auto& part = _partUploads.front();
+            part.outcome.wait();
+            _s3fs.releasePartBuffer(part.buffer);
+            _partUploads.pop_front();
+        }
+
+        Aws::S3::Model::AbortMultipartUploadRequest req;
+        req.SetBucket(_uri.s3Bucket().c_str());
+        req.SetKey(_uri.s3Key().c_str());
+        req.SetUploadId(_uploadID);
+        req.SetRequestPayer(_requestPayer);
+        auto outcome = _s3fs.client().AbortMultipartUpload(req);
+        if(!outcome.IsSuccess())
+            Logger::instance().logger("s3fs").error(outcome_error_message(outcome));
+
+        // nothing left to upload on close
+        _fileUploaded = true;
     }
 
     void S3File::completeMultiPartUpload() {
@@ -210,6 +289,11 @@ namespace tuplex {
 
         MessageHandler& logger = Logger::instance().logger("s3fs");
 
+        // all parts need to be done
+        while(!_partUploads.empty())
+            waitForPart();
+        _fileUploaded = true; // do not upload again on close, even if completing fails
+
         // issue complete upload request
         Aws::S3::Model::CompleteMultipartUploadRequest req;
         req.SetBucket(_uri.s3Bucket().c_str());
@@ -238,56 +322,36 @@ namespace tuplex {
             throw std::runtime_error("file has been already uploaded. Did you call write after close?");
         }
 
-        // two options: either buffer is empty OR full
-        if(!_buffer) {
-            // allocate new buffer with size & fill up with data
-            _buffer = new uint8_t[_bufferSize];
-            memcpy(_buffer, buffer, bufferSize);
-            _bufferLength += bufferSize;
-            _bufferPosition += bufferSize;
-        } else {
-            // two cases: there is enough space left in buffer or buffer might run full
-            if(_bufferSize - _bufferLength >= bufferSize) {
-                memcpy(_buffer + _bufferPosition, buffer, bufferSize);
-                _bufferPosition += bufferSize;
-                _bufferLength += bufferSize;
-            } else {
-                // need to do multipart upload!
+        if(!_buffer)
+            _buffer = _s3fs.acquirePartBuffer(_bufferSize);
 
+        auto src = static_cast<const uint8_t*>(buffer);
+        while(bufferSize > 0) {
+            // buffer full => upload as part in the background. Full buffers are only flushed on the next write,
+            // so files up to the buffer size get uploaded with a single put request.
+            if(_bufferLength == _bufferSize) {
                 // check if multipart was already initiated
-                if(0 == _partNumber) {
-                    // init multipart upload and upload first part
+                if(0 == _partNumber)
                     initMultiPartUpload();
-
-                    // check if limit of 10,000 was reached. If so, abort!
-                    uploadPart();
-                } else {
-                    // append another multipart upload part
-                    uploadPart();
-                }
+                uploadPart();
             }
 
-            return VirtualFileSystemStatus::VFS_NOTYETIMPLEMENTED;
+            auto n = std::min(bufferSize, (uint64_t)(_bufferSize - _bufferLength));
+            memcpy(_buffer + _bufferLength, src, n);
+            _bufferPosition += n;
+            _bufferLength += n;
+            src += n;
+            bufferSize -= n;
         }
 
         return VirtualFileSystemStatus::VFS_OK;
     }
 
 
-    // fast tiny read
-    VirtualFileSystemStatus S3File::readOnly(void *buffer, uint64_t nbytes, size_t *bytesRead) const {
-
-        // short cut for empty read
-        if(nbytes == 0) {
-            if(bytesRead)
-                *bytesRead = 0;
-            return VirtualFileSystemStatus::VFS_OK;
-        }
-
-        // simply issue here one direct request
+    size_t S3File::getRange(size_t offset, uint64_t nbytes, void *buffer) const {
         size_t retrievedBytes = 0;
         // range header
-        std::string range = "bytes=" + std::to_string(_filePosition) + "-" + std::to_string(_filePosition + nbytes - 1);
+        std::string range = "bytes=" + std::to_string(offset) + "-" + std::to_string(offset + nbytes - 1);
         // make AWS S3 part request to uri
         // check how to retrieve object in poarts
         Aws::S3::Model::GetObjectRequest req;
@@ -303,14 +367,6 @@ namespace tuplex {
 
         if (get_object_outcome.IsSuccess()) {
             auto result = get_object_outcome.GetResultWithOwnership();
-
-            // extract extracted byte range + size
-            // syntax is: start-inclend/fsize
-            auto cr = result.GetContentRange();
-            auto idxSlash = cr.find_first_of('/');
-            auto idxMinus = cr.find_first_of('-');
-            // these are kind of weird, they are already requested range I presume
-            size_t fileSize = std::strtoull(cr.substr(idxSlash + 1).c_str(), nullptr, 10);
             retrievedBytes = result.GetContentLength();
 
             // Get an Aws::IOStream reference to the retrieved file
@@ -325,6 +381,56 @@ namespace tuplex {
             logger.error(outcome_error_message(get_object_outcome));
             throw std::runtime_error(outcome_error_message(get_object_outcome));
         }
+        return retrievedBytes;
+    }
+
+    VirtualFileSystemStatus S3File::readOnlyCached(void *buffer, uint64_t nbytes, size_t *bytesRead) {
+        auto cache = _s3fs.blockCache();
+        assert(cache && !_objectKey.empty());
+        auto blockSize = cache->blockSize();
+
+        size_t end = std::min(_filePosition + nbytes, _fileSize);
+        size_t bytesCopied = 0;
+        std::unique_ptr<uint8_t[]> block(new uint8_t[blockSize]);
+        for(size_t blockStart = _filePosition - _filePosition % blockSize; blockStart < end; blockStart += blockSize) {
+            auto blockLength = std::min(blockSize, _fileSize - blockStart);
+            if(!cache->get(_objectKey, blockStart / blockSize, block.get(), blockLength)) {
+                if(getRange(blockStart, blockLength, block.get()) != blockLength)
+                    return VirtualFileSystemStatus::VFS_IOERROR;
+                cache->put(_objectKey, blockStart / blockSize, block.get(), blockLength);
+            }
+
+            auto from = std::max(_filePosition, blockStart);
+            auto to = std::min(end, blockStart + blockLength);
+            memcpy((uint8_t*)buffer + (from - _filePosition), block.get() + (from - blockStart), to - from);
+            bytesCopied += to - from;
+        }
+
+        if(bytesRead)
+            *bytesRead = bytesCopied;
+        return VirtualFileSystemStatus::VFS_OK;
+    }
+
+    // fast tiny read
+    VirtualFileSystemStatus S3File::readOnly(void *buffer, uint64_t nbytes, size_t *bytesRead) const {
+
+        // short cut for empty read
+        if(nbytes == 0) {
+            if(bytesRead)
+                *bytesRead = 0;
+            return VirtualFileSystemStatus::VFS_OK;
+        }
+
+        // samples of cached objects are read in whole blocks, so the tasks reading the object later hit the cache
+        if(_s3fs.blockCache()) {
+            auto self = const_cast<S3File*>(this);
+            self->lookupObject();
+            if(!_objectKey.empty())
+                return self->readOnlyCached(buffer, nbytes, bytesRead);
+        }
+
+        // simply issue here one direct request
+        size_t retrievedBytes = getRange(_filePosition, nbytes, buffer);
 
         if(bytesRead)
             *bytesRead = retrievedBytes;
@@ -335,56 +441,29 @@ namespace tuplex {
 
     VirtualFileSystemStatus S3File::read(void *buffer, uint64_t nbytes, size_t* outBytesRead) const {
         assert(buffer);
+        auto self = const_cast<S3File*>(this);
 
         // empty buffer? => fill!
         if(!_buffer)
-            const_cast<S3File*>(this)->fillBuffer(_bufferSize); // try to request full buffer
-
-        // check how many bytes are available in buffer
-        assert(_bufferPosition <= _bufferLength);
-        size_t bytesAvailable = _bufferLength - _bufferPosition;
-        size_t bytesRead = 0;
-        assert(_buffer);
+            self->nextChunk();
 
         uint8_t* dest = (uint8_t*)buffer;
+        size_t bytesRead = 0;
+        while(bytesRead < nbytes) {
+            assert(_bufferPosition <= _bufferLength);
+            size_t bytesAvailable = _bufferLength - _bufferPosition;
 
-        // Todo: better condition is I think filePos < fileSize
-        int64_t capacity = nbytes; // how many bytes can be written to buffer safely
-
-        // bring capacity to 0
-        while(capacity > 0) {
-            // there are more bytesAvailable than requested (capacity) => consume capacity
-            if(capacity <= bytesAvailable) {
-                memcpy(dest, _buffer + _bufferPosition, capacity);
-                bytesRead += capacity;
-                const_cast<S3File*>(this)->_bufferPosition += capacity;
-                capacity = 0;
-            } else {
-                // there are less bytesAvailable than the capacity still to fill,
-                // fill whatever is there & decrease capacity to fill by it
-                memcpy(dest, _buffer + _bufferPosition, bytesAvailable);
-                bytesRead +=  bytesAvailable; // move how many bytes were read
-                dest += bytesAvailable; // move position where to copy things
-                capacity -= bytesAvailable; // decrease capacity
-                const_cast<S3File*>(this)->_bufferPosition += bytesAvailable; // move buffer to end (necessary to avoid infinity loop)
-
-                // now there are two options: 1) file already exhausted, no need to refill
-                // 2) still data left, refill buffer
-                if(_filePosition >= _fileSize) // exhausted, leave loop
+            // buffer consumed, continue with next chunk (unless file is exhausted)
+            if(0 == bytesAvailable) {
+                if(!self->nextChunk())
                     break;
-
-                // fill buffer up again
-                // reset buffer pos & length (i.e. invalidate buffer)
-                const_cast<S3File*>(this)->_bufferPosition = 0;
-                const_cast<S3File*>(this)->_bufferLength = 0;
-                const_cast<S3File*>(this)->fillBuffer(_bufferSize); // try to request full buffer
-                bytesAvailable = _bufferLength - _bufferPosition;
-
-                assert(bytesAvailable > 0);
+                continue;
             }
 
-
-            assert(capacity >= 0);
+            auto n = std::min(bytesAvailable, nbytes - bytesRead);
+            memcpy(dest + bytesRead, _buffer + _bufferPosition, n);
+            self->_bufferPosition += n;
+            bytesRead += n;
         }
 
         // output if desired
@@ -394,81 +473,216 @@ namespace tuplex {
         return VirtualFileSystemStatus::VFS_OK;
     }
 
+    void S3File::lookupObject() {
+        if(!_s3fs.blockCache() || !_objectKey.empty())
+            return;
 
-    size_t S3File::fillBuffer(size_t bytesToRequest) {
-        bytesToRequest = std::min(_bufferSize - _bufferPosition, bytesToRequest);
-        size_t retrievedBytes = 0;
+        Aws::S3::Model::HeadObjectRequest req;
+        req.SetBucket(_uri.s3Bucket().c_str());
+        req.SetKey(_uri.s3Key().c_str());
+        req.SetRequestPayer(_requestPayer);
+        auto outcome = _s3fs.client().HeadObject(req);
+        _s3fs._headRequests++;
+        if(!outcome.IsSuccess()) {
+            // read without cache
+            Logger::instance().logger("s3fs").warn("could not retrieve etag of " + _uri.toString() + ", bypassing block cache.");
+            return;
+        }
 
-        if(0 == bytesToRequest)
-            return 0;
+        _fileSize = outcome.GetResult().GetContentLength();
+        _objectKey = BlockCache::objectKey(_uri, outcome.GetResult().GetETag().c_str(), _fileSize);
+    }
 
-        // create buffer if not existing
-        if(!_buffer) {
-            _buffer = new uint8_t[_bufferSize];
+    bool S3File::readFromCache(ReadRequest &request) {
+        auto cache = _s3fs.blockCache();
+        assert(cache && !_objectKey.empty());
+        auto blockSize = cache->blockSize();
+        assert(request.offset % blockSize == 0);
+
+        // requests cover whole blocks (the last block of the object may be shorter)
+        for(size_t pos = request.offset; pos < request.offset + request.length; pos += blockSize) {
+            auto blockLength = std::min(blockSize, _fileSize - pos);
+            if(!cache->get(_objectKey, pos / blockSize, request.data.get() + (pos - request.offset), blockLength))
+                return false;
+        }
+        return true;
+    }
 
-            _bufferPosition = 0;
-            _bufferLength = 0;
-            _fileSize = 0;
-        } else {
-            // shortcut: if eof reached, then do not perform request
-            if(_filePosition >= _fileSize)
-                return 0;
+    void S3File::writeToCache(const ReadRequest &request, size_t retrievedBytes) {
+        auto cache = _s3fs.blockCache();
+        assert(cache && !_objectKey.empty());
+
+        // store in background, the task keeps the chunk alive
+        auto key = _objectKey;
+        auto data = request.data;
+        auto offset = request.offset;
+        auto fileSize = _fileSize;
+        auto task = [cache, key, data, offset, retrievedBytes, fileSize]() {
+            auto blockSize = cache->blockSize();
+            for(size_t pos = offset; pos < offset + retrievedBytes; pos += blockSize) {
+                auto blockLength = std::min(blockSize, fileSize - pos);
+                if(pos + blockLength > offset + retrievedBytes)
+                    break;
+                cache->put(key, pos / blockSize, data.get() + (pos - offset), blockLength);
+            }
+        };
+        if(!_s3fs._executor->Submit(task))
+            task();
+    }
+
+    void S3File::issueReadRequest() {
+        // file size is known after the first request (or lookup), do not request beyond it
+        size_t length = _readChunkSize;
+        auto cache = _objectKey.empty() ? nullptr : _s3fs.blockCache();
+        if(cache) {
+            // whole blocks only
+            auto blockSize = cache->blockSize();
+            length = (length + blockSize - 1) / blockSize * blockSize;
+        }
+        if(_chunk || cache)
+            length = std::min(length, _fileSize - _requestPosition);
+        assert(length > 0);
+
+        ReadRequest request;
+        request.offset = _requestPosition;
+        request.length = length;
+        request.data = std::shared_ptr<uint8_t>(new uint8_t[length], std::default_delete<uint8_t[]>());
+        request.cached = false;
+        _requestPosition += length;
+        _readChunkSize = std::min(2 * _readChunkSize, _s3fs.maxReadChunkSize());
+
+        if(cache && readFromCache(request)) {
+            request.cached = true;
+            _readRequests.push_back(std::move(request));
+            return;
         }
 
-        // range header
-        std::string range = "bytes=" + std::to_string(_filePosition) + "-" + std::to_string(_filePosition + bytesToRequest - 1);
-        // make AWS S3 part request to uri
-        // check how to retrieve object in poarts
         Aws::S3::Model::GetObjectRequest req;
         req.SetBucket(_uri.s3Bucket().c_str());
         req.SetKey(_uri.s3Key().c_str());
         // retrieve byte range according to http://www.w3.org/Protocols/rfc2616/rfc2616-sec14.html#sec14.35
-        req.SetRange(range.c_str());
+        req.SetRange(("bytes=" + std::to_string(request.offset) + "-" + std::to_string(request.offset + length - 1)).c_str());
         req.SetRequestPayer(_requestPayer);
 
-        Timer timer;
-        // Get the object
-        // std::cout<<">> S3 read request..."; std::cout.flush();
-        auto get_object_outcome = _s3fs.client().GetObject(req);
-        // std::cout<<" done!"<<std::endl;
+        // write response directly into the chunk, the request holds a reference while in flight
+        auto data = request.data;
+        req.SetResponseStreamFactory([data, length]() {
+            return Aws::New<boost::interprocess::bufferstream>("tuplex", (char*)data.get(), length);
+        });
+
+        // executed on the shared connection pool of the filesystem
+        request.outcome = _s3fs.client().GetObjectCallable(req);
         _s3fs._getRequests++;
-#ifndef NDEBUG
-        _requestTime += timer.time();
-#endif
-        if (get_object_outcome.IsSuccess()) {
-            auto result = get_object_outcome.GetResultWithOwnership();
+        if(_numChunksRead > 0)
+            _s3fs._readAheadRequests++;
 
-            // extract extracted byte range + size
-            // syntax is: start-inclend/fsize
-            auto cr = result.GetContentRange();
-            auto idxSlash = cr.find_first_of('/');
-            auto idxMinus = cr.find_first_of('-');
-            // these are kind of weird, they are already requested range I presume
-            // size_t rangeStart = std::strtoull(cr.substr(0, idxMinus).c_str(), nullptr, 10);
-            // size_t rangeEnd = std::strtoull(cr.substr(idxMinus + 1, idxSlash).c_str(), nullptr, 10);
-            size_t fileSize = std::strtoull(cr.substr(idxSlash + 1).c_str(), nullptr, 10);
-            retrievedBytes = result.GetContentLength();
-            _fileSize = fileSize;
+        _readRequests.push_back(std::move(request));
+    }
 
-            // Get an Aws::IOStream reference to the retrieved file
-            auto &retrieved_file = result.GetBody();
-            // copy contents & move cursors
-            assert(_bufferPosition + retrievedBytes <= _bufferSize);
-            retrieved_file.read((char*)(_buffer + _bufferPosition), retrievedBytes);
-            _bufferLength += retrievedBytes;
-            _filePosition += retrievedBytes;
+    void S3File::readAhead() {
+        if(!_chunk || 0 == _s3fs.readAheadDepth())
+            return;
 
-            // in bounds check
-            assert(_bufferPosition + _bufferLength <= _bufferSize);
+        while(_readRequests.size() < _s3fs.readAheadDepth() && _requestPosition < _fileSize)
+            issueReadRequest();
+    }
 
-            // note: for ascii files there might be an issue regarding the file ending!!!
-            _s3fs._bytesReceived += retrievedBytes;
+    bool S3File::nextChunk() {
+        // where the consumer continues reading, i.e. after a seek this may lie within the first (block aligned) chunk
+        auto consumerPosition = _filePosition;
+
+        // read-ahead starts once the first chunk is consumed, i.e. small reads (samples, headers) issue a single request
+        if(_chunk) {
+            if(_readRequests.empty() && _requestPosition >= _fileSize)
+                return false;
+            readAhead();
+        }
+
+        // first request or read-ahead disabled
+        if(_readRequests.empty()) {
+            if(!_chunk) {
+                lookupObject();
+                _requestPosition = _filePosition;
+                if(!_objectKey.empty()) {
+                    // cached blocks are aligned
+                    _requestPosition -= _requestPosition % _s3fs.blockCache()->blockSize();
+
+                    // nothing to read, e.g. empty object
+                    if(_requestPosition >= _fileSize) {
+                        _chunk = std::shared_ptr<uint8_t>(new uint8_t[1], std::default_delete<uint8_t[]>());
+                        _buffer = _chunk.get();
+                        _bufferPosition = _bufferLength = 0;
+                        _filePosition = _fileSize;
+                        return false;
+                    }
+                }
+            }
+            issueReadRequest();
+        }
+
+        auto request = std::move(_readRequests.front());
+        _readRequests.pop_front();
+
+        size_t retrievedBytes = 0;
+        if(request.cached) {
+            retrievedBytes = request.length;
+            _chunk = request.data;
         } else {
-            MessageHandler& logger = Logger::instance().logger("s3fs");
-            logger.error(outcome_error_message(get_object_outcome));
-            throw std::runtime_error(outcome_error_message(get_object_outcome));
+            Timer timer;
+            auto get_object_outcome = request.outcome.get();
+            _s3fs._readAheadStallTime += static_cast<size_t>(timer.time() * 1000000.0);
+#ifndef NDEBUG
+            _requestTime += timer.time();
+#endif
+            if (get_object_outcome.IsSuccess()) {
+                auto result = get_object_outcome.GetResultWithOwnership();
+
+                // extract extracted byte range + size
+                // syntax is: start-inclend/fsize
+                auto cr = result.GetContentRange();
+                auto idxSlash = cr.find_first_of('/');
+                _fileSize = std::strtoull(cr.substr(idxSlash + 1).c_str(), nullptr, 10);
+                retrievedBytes = result.GetContentLength();
+                assert(retrievedBytes <= request.length);
+            } else if(get_object_outcome.GetError().GetResponseCode() == Aws::Http::HttpResponseCode::REQUESTED_RANGE_NOT_SATISFIABLE) {
+                // range starts at or beyond the end of the file, e.g. empty file
+                _fileSize = request.offset;
+            } else {
+                MessageHandler& logger = Logger::instance().logger("s3fs");
+                logger.error(outcome_error_message(get_object_outcome));
+                throw std::runtime_error(outcome_error_message(get_object_outcome));
+            }
+            _s3fs._bytesReceived += retrievedBytes;
+            _chunk = request.data;
+            if(!_objectKey.empty())
+                writeToCache(request, retrievedBytes);
         }
-        return retrievedBytes;
+
+        // chunk becomes the buffer
+        _buffer = _chunk.get();
+        _bufferLength = retrievedBytes;
+        _bufferPosition = consumerPosition > request.offset ? std::min(consumerPosition - request.offset, retrievedBytes) : 0;
+        _filePosition = request.offset + retrievedBytes;
+        _requestPosition = std::max(_requestPosition, _filePosition);
+        _numChunksRead++;
+
+        // issue further requests, so they're in flight while the consumer processes this chunk
+        if(_numChunksRead > 1)
+            readAhead();
+
+        return retrievedBytes > 0;
+    }
+
+    void S3File::resetReadState() {
+        // in flight requests hold their own memory, no need to wait for them
+        _readRequests.clear();
+        _chunk.reset();
+        _buffer = nullptr;
+        _bufferPosition = 0;
+        _bufferLength = 0;
+        _requestPosition = _filePosition;
+        _readChunkSize = S3FileSystemImpl::_initialReadChunkSize;
+        _numChunksRead = 0;
     }
 
     size_t S3File::size() const {
@@ -476,18 +690,21 @@ namespace tuplex {
         // check if buffer empty, if so fill initially
         if(!_buffer)
             // hack: use lazy buffer for requests
-            const_cast<S3File*>(this)->fillBuffer(_bufferSize); // try to request full buffer
+            const_cast<S3File*>(this)->nextChunk();
 
-        // after the first time fillBuffer was called, fileSize is populated
+        // after the first chunk was retrieved, fileSize is populated
         return _fileSize;
     }
 
     S3File::~S3File() {
         close();
 
-        if(_buffer)
-            delete [] _buffer;
+        // in read mode, buffer is owned by the current chunk. In write mode, it comes from the part buffer pool
+        if(_buffer && !_chunk)
+            _s3fs.releasePartBuffer(_buffer);
         _buffer = nullptr;
+        _readRequests.clear();
+        _chunk.reset();
 
         // // print
         // std::cout<<"request Time on "<<_uri.toPath()<<": "<<_requestTime<<"s "<<std::endl;
@@ -504,23 +721,26 @@ namespace tuplex {
 
     VirtualFileSystemStatus S3File::seek(int64_t delta) {
 
-        // check if buffer is valid
-        if(_buffer) {
+        // check if buffer is valid (read mode)
+        if(_chunk) {
+            // logical position of the consumer within the file
+            int64_t bufferStart = (int64_t)_filePosition - (int64_t)_bufferLength;
+            int64_t newPos = std::min((int64_t)_fileSize, std::max(bufferStart + (int64_t)_bufferPosition + delta, (int64_t)0l));
 
-        } else {
-            if(_fileSize == 0) {
-                // buffer is not active yet & fileSize neither. => best effort jump on filePosition
-                int64_t relativePos = ((int64_t)_filePosition) + delta;
-                if(relativePos < 0)
-                    relativePos = 0;
-
-                _filePosition = relativePos;
+            // within buffer? => only move cursor. Else, drop buffer & read-ahead and start over at new position.
+            if(newPos >= bufferStart && newPos <= (int64_t)_filePosition) {
+                _bufferPosition = newPos - bufferStart;
             } else {
-                // try to move buffer posisition
-                int64_t newPos = std::min((int64_t)_fileSize, std::max((int64_t)_filePosition + delta, (int64_t)0l));
-
-                EXCEPTION("nyimpl");
+                _filePosition = newPos;
+                resetReadState();
             }
+        } else if(!_buffer) {
+            // buffer is not active yet => best effort jump on filePosition
+            int64_t relativePos = ((int64_t)_filePosition) + delta;
+            if(relativePos < 0)
+                relativePos = 0;
+
+            _filePosition = relativePos;
         }
 
         return VirtualFileSystemStatus::VFS_OK;
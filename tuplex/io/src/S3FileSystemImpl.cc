@@ -17,9 +17,11 @@
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/auth/AWSCredentialsProviderChain.h>
+#include <aws/core/auth/AWSAuthSigner.h>
 
 #include <aws/s3/model/ListObjectsV2Request.h>
 #include <regex>
+#include <cstring>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/DeleteObjectsRequest.h>
 #include <aws/s3/model/CopyObjectRequest.h>
@@ -307,6 +309,47 @@ namespace tuplex {
         return VirtualFileSystemStatus::VFS_NOTYETIMPLEMENTED;
     }
 
+    VirtualFileSystemStatus S3FileSystemImpl::list(const tuplex::URI &dir, std::vector<ListingEntry> *entries) {
+        assert(entries);
+        auto bucket = dir.s3Bucket();
+        auto prefix = dir.s3Key();
+        if(!prefix.empty() && prefix.back() != '/')
+            prefix += "/";
+
+        // list a single level, common prefixes are the subdirectories
+        Aws::S3::Model::ListObjectsV2Request objects_request;
+        objects_request.WithBucket(Aws::String(bucket.c_str()));
+        objects_request.WithPrefix(Aws::String(prefix.c_str()));
+        objects_request.WithDelimiter("/");
+        objects_request.SetRequestPayer(_requestPayer);
+
+        while(true) {
+            auto list_objects_outcome = client().ListObjectsV2(objects_request);
+            _lsRequests++;
+            if(!list_objects_outcome.IsSuccess()) {
+                Logger::instance().logger("s3fs").error("listing s3://" + bucket + "/" + prefix + " failed: "
+                + std::string(list_objects_outcome.GetError().GetMessage().c_str()));
+                return VirtualFileSystemStatus::VFS_IOERROR;
+            }
+
+            auto& result = list_objects_outcome.GetResult();
+            for(const auto& cp : result.GetCommonPrefixes())
+                entries->emplace_back(URI("s3://" + bucket + "/" + cp.GetPrefix().c_str()), 0, true);
+            for(const auto& o : result.GetContents()) {
+                std::string key = o.GetKey().c_str();
+                if(key == prefix) // folder marker object
+                    continue;
+                entries->emplace_back(URI("s3://" + bucket + "/" + key), o.GetSize(), false);
+            }
+
+            if(!result.GetIsTruncated())
+                break;
+            objects_request.SetContinuationToken(result.GetNextContinuationToken());
+        }
+
+        return VirtualFileSystemStatus::VFS_OK;
+    }
+
     VirtualFileSystemStatus S3FileSystemImpl::touch(const tuplex::URI &uri, bool overwrite) {
         return VirtualFileSystemStatus::VFS_NOTYETIMPLEMENTED;
     }
@@ -351,7 +394,8 @@ namespace tuplex {
         return files;
     }
 
-    S3FileSystemImpl::S3FileSystemImpl(const std::string& access_key, const std::string& secret_key, const std::string &caFile, bool lambdaMode, bool requesterPay) {
+    S3FileSystemImpl::S3FileSystemImpl(const std::string& access_key, const std::string& secret_key, const std::string &caFile, bool lambdaMode, bool requesterPay,
+                                       const std::string& endpointOverride) {
         // Note: If current region is different than other region, use S3 transfer acceleration
         // cf. Aws::S3::Model::GetBucketAccelerateConfigurationRequest
         // and https://s3-accelerate-speedtest.s3-accelerate.amazonaws.com/en/accelerate-speed-comparsion.html
@@ -377,7 +421,27 @@ namespace tuplex {
             auto credentialsProvider = Aws::MakeShared<Aws::Auth::EnvironmentAWSCredentialsProvider>(TAG);
             credentials = credentialsProvider->GetAWSCredentials();
         }
-        _client = std::make_shared<S3::S3Client>(credentials, config);
+
+        // shared connection pool, async requests (e.g. read-ahead of files) are executed on a bounded pool
+        config.maxConnections = _connectionPoolSize;
+        _executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>("tuplex", (size_t)_connectionPoolSize);
+        config.executor = _executor;
+        if(endpointOverride.empty()) {
+            _client = std::make_shared<S3::S3Client>(credentials, config);
+        } else {
+            // S3 compatible store, buckets can't be resolved via virtual hosts there
+            auto endpoint = endpointOverride;
+            if(startsWith(endpoint, "http://")) {
+                config.scheme = Http::Scheme::HTTP;
+                endpoint = endpoint.substr(strlen("http://"));
+            } else if(startsWith(endpoint, "https://")) {
+                config.scheme = Http::Scheme::HTTPS;
+                endpoint = endpoint.substr(strlen("https://"));
+            }
+            config.endpointOverride = endpoint.c_str();
+            _client = std::make_shared<S3::S3Client>(credentials, config,
+                                                     Client::AWSAuthV4Signer::PayloadSigningPolicy::Never, false);
+        }
 
         if(requesterPay) _requestPayer = Aws::S3::Model::RequestPayer::requester;
         else _requestPayer = Aws::S3::Model::RequestPayer::NOT_SET;
@@ -388,9 +452,51 @@ namespace tuplex {
         _multiPartPutRequests = 0;
         _closeMultiPartUploadRequests = 0;
         _getRequests = 0;
+        _headRequests = 0;
         _bytesTransferred = 0;
         _bytesReceived = 0;
         _lsRequests = 0;
+        _readAheadRequests = 0;
+        _readAheadStallTime = 0;
+
+        _readAheadDepth = 4;
+        _maxReadChunkSize = 16 * 1024 * 1024;
+
+        _uploadConcurrency = 4;
+        _maxUploadRetries = 4;
+        _partBufferSize = 0;
+    }
+
+    S3FileSystemImpl::~S3FileSystemImpl() {
+        std::lock_guard<std::mutex> lock(_partBufferMutex);
+        for(auto buf : _partBuffers)
+            delete [] buf;
+        _partBuffers.clear();
+    }
+
+    uint8_t* S3FileSystemImpl::acquirePartBuffer(size_t size) {
+        {
+            std::lock_guard<std::mutex> lock(_partBufferMutex);
+            // pool holds buffers of a single size only
+            assert(_partBufferSize == 0 || _partBufferSize == size);
+            _partBufferSize = size;
+            if(!_partBuffers.empty()) {
+                auto buf = _partBuffers.back();
+                _partBuffers.pop_back();
+                return buf;
+            }
+        }
+        return new uint8_t[size];
+    }
+
+    void S3FileSystemImpl::releasePartBuffer(uint8_t *buffer) {
+        if(!buffer)
+            return;
+        std::lock_guard<std::mutex> lock(_partBufferMutex);
+        if(_partBuffers.size() < _maxPooledPartBuffers)
+            _partBuffers.push_back(buffer);
+        else
+            delete [] buffer;
     }
 
 
@@ -591,13 +697,17 @@ namespace tuplex {
         _multiPartPutRequests = 0;
         _closeMultiPartUploadRequests = 0;
         _getRequests = 0;
+        _headRequests = 0;
         _bytesTransferred = 0;
         _bytesReceived = 0;
         _lsRequests = 0;
+        _readAheadRequests = 0;
+        _readAheadStallTime = 0;
     }
 
     void S3FileSystemImpl::initTransferThreadPool(size_t numThreads) {
         // lazy init
+        std::lock_guard<std::mutex> lock(_transferMutex);
         if(!_thread_pool)
             _thread_pool = std::make_shared<Aws::Utils::Threading::PooledThreadExecutor>(numThreads, Aws::Utils::Threading::OverflowPolicy::QUEUE_TASKS_EVENLY_ACCROSS_THREADS);
 
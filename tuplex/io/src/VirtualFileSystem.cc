@@ -16,12 +16,18 @@
 #include <MessageHandler.h>
 #include <Logger.h>
 #include <PosixFileSystemImpl.h>
+#include <GlobExpander.h>
+#include <CopyEngine.h>
+#include <thread>
+#include <mutex>
+#include <pwd.h>
+#include <unistd.h>
 #ifdef BUILD_WITH_AWS
     #include <S3FileSystemImpl.h>
 #endif
 #include <string>
 #include <StringUtils.h>
-#include "MimeType.h"
+#include <Utils.h>
 
 namespace tuplex {
 
@@ -42,12 +48,101 @@ namespace tuplex {
     // init with local file system per default
     static std::unordered_map<std::string, std::shared_ptr<IFileSystemImpl>> fsRegistry = defaults();
 
+    // number of concurrent list requests per file system when expanding patterns. Remote stores are latency bound,
+    // hence use many more requests than for the local file system.
+    static std::unordered_map<std::string, size_t> listingParallelism = {{"file://", std::min(8u, std::max(std::thread::hardware_concurrency(), 1u))},
+                                                                        {"s3://", 32}};
+    static std::mutex listingParallelismMutex;
+
+    // listings shared across glob/walk queries, disabled per default (ttl=0)
+    static ListingCache listingCache;
+
+    void VirtualFileSystem::setListingParallelism(const std::string &uriPrefix, size_t parallelism) {
+        std::lock_guard<std::mutex> lock(listingParallelismMutex);
+        listingParallelism[uriPrefix] = std::max(parallelism, (size_t)1);
+    }
+
+    void VirtualFileSystem::setListingCacheTTL(double ttl) {
+        listingCache.setTTL(ttl);
+    }
+
+    void VirtualFileSystem::clearListingCache() {
+        listingCache.clear();
+    }
+
+    // replaces a leading ~ or ~user of a local path with the home directory, as glob(..., GLOB_TILDE) does
+    static std::string expandTilde(const std::string& path) {
+        if(path.empty() || path[0] != '~')
+            return path;
+        auto pos = path.find('/');
+        auto user = path.substr(1, pos == std::string::npos ? std::string::npos : pos - 1);
+        const char* home = nullptr;
+        if(user.empty()) {
+            home = getenv("HOME");
+            if(!home) {
+                auto pw = getpwuid(getuid());
+                home = pw ? pw->pw_dir : nullptr;
+            }
+        } else {
+            auto pw = getpwnam(user.c_str());
+            home = pw ? pw->pw_dir : nullptr;
+        }
+        if(!home)
+            return path; // unknown user, keep as is like glob does
+        return std::string(home) + (pos == std::string::npos ? "" : path.substr(pos));
+    }
+
+    static std::vector<ListingEntry> expandPattern(IFileSystemImpl* impl, const URI& pattern) {
+        assert(impl);
+        size_t parallelism = 1;
+        {
+            std::lock_guard<std::mutex> lock(listingParallelismMutex);
+            auto it = listingParallelism.find(pattern.prefix());
+            if(it != listingParallelism.end())
+                parallelism = it->second;
+        }
+        GlobExpander expander(impl, parallelism, &listingCache);
+        if(pattern.isLocal())
+            return expander.expand(pattern.prefix() + expandTilde(pattern.withoutPrefix()));
+        return expander.expand(pattern.toString());
+    }
+
 #ifdef BUILD_WITH_AWS
+    // local cache for blocks of remote objects, disabled per default
+    static std::shared_ptr<BlockCache> blockCache;
+
     VirtualFileSystemStatus VirtualFileSystem::addS3FileSystem(const std::string& access_key, const std::string& secret_key, const std::string &caFile, bool lambdaMode, bool requesterPay) {
 
-        auto impl = new S3FileSystemImpl(access_key, secret_key, caFile, lambdaMode, requesterPay);
+        auto impl = std::make_shared<S3FileSystemImpl>(access_key, secret_key, caFile, lambdaMode, requesterPay);
+        impl->setBlockCache(blockCache);
 
-        return VirtualFileSystem::registerFileSystem(std::make_shared<S3FileSystemImpl>(access_key, secret_key, caFile, lambdaMode, requesterPay), "s3://");
+        return VirtualFileSystem::registerFileSystem(impl, "s3://");
+    }
+
+    static void updateBlockCache() {
+        auto it = fsRegistry.find("s3://");
+        if(it == fsRegistry.end())
+            return;
+        auto s3fs = dynamic_cast<S3FileSystemImpl*>(it->second.get());
+        if(s3fs)
+            s3fs->setBlockCache(blockCache);
+    }
+
+    void VirtualFileSystem::enableBlockCache(const URI &dir, size_t capacity) {
+        // reuse cache if settings did not change, e.g. for multiple contexts
+        if(blockCache && blockCache->directory() == URI(dir.withoutPrefix()) && blockCache->capacity() == capacity)
+            return;
+        blockCache = std::make_shared<BlockCache>(dir, capacity);
+        updateBlockCache();
+    }
+
+    void VirtualFileSystem::disableBlockCache() {
+        blockCache.reset();
+        updateBlockCache();
+    }
+
+    bool VirtualFileSystem::blockCacheEnabled() {
+        return blockCache != nullptr;
     }
 
     std::map<std::string, size_t> VirtualFileSystem::s3TransferStats() {
@@ -65,10 +160,18 @@ namespace tuplex {
             // fill up values
             m["put"] = s3fs->numPuts();
             m["get"] = s3fs->numGets();
+            m["head"] = s3fs->numHeads();
             m["ls"] = s3fs->numLs();
             m["multipart"] = s3fs->numMultipart();
             m["transferred"] = s3fs->bytesTransferred();
             m["received"] = s3fs->bytesReceived();
+            m["readahead"] = s3fs->numReadAheadRequests();
+            m["readahead_stall_us"] = s3fs->readAheadStallTime();
+            if(s3fs->blockCache()) {
+                m["cache_hits"] = s3fs->blockCache()->hits();
+                m["cache_misses"] = s3fs->blockCache()->misses();
+                m["cache_size"] = s3fs->blockCache()->size();
+            }
 
         } else logger.warn("calling S3 stats, but no system registered under s3://");
 
@@ -176,6 +279,8 @@ namespace tuplex {
         if(!_impl)
             return VirtualFileSystemStatus::VFS_NOFILESYSTEM;
 
+        listingCache.invalidate(uri);
+
         // call implementation
         return _impl->create_dir(uri);
     }
@@ -185,6 +290,8 @@ namespace tuplex {
         if(!impl)
             return VirtualFileSystemStatus::VFS_NOFILESYSTEM;
 
+        listingCache.invalidate(uri);
+
         // call implementation
         return impl->remove(uri);
     }
@@ -192,6 +299,8 @@ namespace tuplex {
 
     std::unique_ptr<VirtualFile> VirtualFileSystem::open_file(const URI &uri, VirtualFileMode vfm) {
         auto impl = getFileSystemImpl(uri);
+        if(vfm & (VirtualFileMode::VFS_WRITE | VirtualFileMode::VFS_OVERWRITE | VirtualFileMode::VFS_APPEND))
+            listingCache.invalidate(uri);
         return impl ? impl->open_file(uri, vfm) : nullptr;
     }
 
@@ -216,11 +325,16 @@ namespace tuplex {
             // trim whitespace
             trim(pattern);
 
-           // call filesystems glob
+           // call filesystems glob for plain paths, expand patterns concurrently
            auto uri = URI(pattern);
            auto vfs = fromURI(uri);
-           auto subfiles = vfs.glob(uri.toString());
-           files.insert(std::end(files), std::begin(subfiles), std::end(subfiles));
+           if(!vfs._impl || !GlobExpander::hasWildcard(uri.withoutPrefix())) {
+               auto subfiles = vfs.glob(uri.toString());
+               files.insert(std::end(files), std::begin(subfiles), std::end(subfiles));
+           } else {
+               for(const auto& entry : expandPattern(vfs._impl, uri))
+                   files.push_back(entry.uri);
+           }
         });
 
         return files;
@@ -244,8 +358,20 @@ namespace tuplex {
             if(!vfs._impl)
                 throw std::runtime_error("could not find file system for prefix " + URI(pattern).prefix());
 
-            if(!vfs._impl->walkPattern(pattern, callback, userData))
-                return false;
+            URI uri(pattern);
+            if(!GlobExpander::hasWildcard(uri.withoutPrefix())) {
+                if(!vfs._impl->walkPattern(pattern, callback, userData))
+                    return false;
+                continue;
+            }
+
+            // sizes are retrieved with the listing, no need to query them per file
+            for(const auto& entry : expandPattern(vfs._impl, uri)) {
+                if(entry.isDirectory) // TODO: maybe warn user when dir is used instead of files?
+                    return false;
+                if(!callback(userData, entry.uri, entry.size))
+                    return false;
+            }
         }
 
         return true;
@@ -259,15 +385,21 @@ namespace tuplex {
     }
 
 
-    int VirtualFileSystem::copyLocalToLocal(const std::vector<std::string> &src_uris, const URI &target,
-                                            const std::string &lcp, std::vector<URI> &copied_uris, bool overwrite) {
-        using namespace std;
-        auto& logger = Logger::instance().logger("filesystem");
-        int rc = 0;
-        // simple copy via posix primitives...
-        // need to be careful regarding folder structure though...
+    // number of files/chunks copied concurrently & chunk size for large local files
+    static size_t copyParallelism = std::max(std::thread::hardware_concurrency(), 4u);
+    static size_t copyChunkSize = 32 * 1024 * 1024;
+
+    void VirtualFileSystem::setCopyParallelism(size_t parallelism, size_t chunkSize) {
+        copyParallelism = std::max(parallelism, (size_t)1);
+        copyChunkSize = chunkSize;
+    }
+
+    /*!
+     * adds local files/folders to copy engine, the folder structure below lcp is preserved under target
+     */
+    static void addLocalSources(CopyEngine& engine, const std::vector<std::string> &src_uris, const URI &target,
+                                const std::string &lcp) {
         for(auto src : src_uris) {
-            auto src_without_prefix = URI(src).withoutPrefix();
             URI target_uri = target.join_path(src.substr(lcp.size()));
 
             // when single file, just overwrite whatever the target is
@@ -278,92 +410,42 @@ namespace tuplex {
 
             // single file or folder?
             if(URI(src).isFile()) {
-                logger.debug("copying local file " + src_without_prefix + " to "
-                             + target_uri.toPath());
-                // overwrite per default
-                if(VirtualFileSystemStatus::VFS_OK != PosixFileSystemImpl::copySingleFile(src, target_uri, overwrite))
-                    return -1;
-                copied_uris.push_back(target_uri);
+                engine.add(URI(src), target_uri);
             } else {
                 // folder!
                 // expand URI
                 auto expanded_src_uris = PosixFileSystemImpl::expandFolder(src);
-                for(auto uri : expanded_src_uris) {
-                    target_uri = target.join_path(uri.withoutPrefix().substr(lcp.size()));
-                    logger.debug("copying local file " + uri.withoutPrefix() + " to "
-                                 + target_uri.toPath());
-                    // overwrite per default
-                    if(VirtualFileSystemStatus::VFS_OK != PosixFileSystemImpl::copySingleFile(uri, target_uri, overwrite))
-                        return -1;
-                    copied_uris.push_back(target_uri);
-                }
+                for(auto uri : expanded_src_uris)
+                    engine.add(uri, target.join_path(uri.withoutPrefix().substr(lcp.size())));
             }
         }
-
-        return rc;
     }
 
 #ifdef BUILD_WITH_AWS
-    int VirtualFileSystem::copyLocalToS3(const std::vector<std::string> &src_uris, const URI &target,
-                                            const std::string &lcp, std::vector<URI> &copied_uris, bool overwrite) {
-        using namespace std;
-        auto& logger = Logger::instance().logger("filesystem");
-        int rc = 0;
-        // simple copy via posix primitives...
-        // need to be careful regarding folder structure though...
-        for(auto src : src_uris) {
-            auto src_without_prefix = URI(src).withoutPrefix();
-            URI target_uri = target.join_path(src.substr(lcp.size()));
+    bool VirtualFileSystem::s3CopyFile(const URI &s3_src, const URI &s3_target) {
+        MessageHandler& logger = Logger::instance().logger("filesystem");
 
-            // when single file, just overwrite whatever the target is
-            // unless it's a separator because then copy into folder is desired...
-            if(src_uris.size() == 1 && target.toString().back() != '/') {
-                target_uri = target;
-            }
+        if(fsRegistry.find("s3://") != fsRegistry.end()) {
+            auto s3fs = dynamic_cast<S3FileSystemImpl*>(fsRegistry["s3://"].get());
 
-            // single file or folder?
-            if(URI(src).isFile()) {
-                logger.debug("copying local file " + src_without_prefix + " to "
-                             + target_uri.toPath());
-                auto content_type = detectMIMEType(URI(src).withoutPrefix());
-                assert(!content_type.empty());
-                logger.debug("uploading local file " + src_without_prefix + " to "
-                             + target_uri.toPath() + " (MIME: "+ content_type + ")");
-                auto handle = s3UploadFile(src_without_prefix, target_uri, content_type);
-                if(!handle)
-                    return -1;
-                copied_uris.push_back(target_uri);
-            } else {
-                // folder!
-                // expand URI
-                auto expanded_src_uris = PosixFileSystemImpl::expandFolder(src);
-                for(auto uri : expanded_src_uris) {
-                    target_uri = target.join_path(uri.withoutPrefix().substr(lcp.size()));
-                    logger.debug("copying local file " + uri.withoutPrefix() + " to "
-                                 + target_uri.toPath());
-                    auto content_type = detectMIMEType(URI(uri).withoutPrefix());
-                    assert(!content_type.empty());
-                    logger.debug("uploading local file " + uri.toString() + " to "
-                                 + target_uri.toPath() + " (MIME: "+ content_type + ")");
-                    auto handle = s3UploadFile(uri.withoutPrefix(), target_uri, content_type);
-                    if(!handle)
-                        return -1;
-                    copied_uris.push_back(target_uri);
-                }
+            if(!s3fs) {
+                logger.warn("under s3:// a system not called S3FileSystemImpl is registered. Can't copy file " + s3_src.toPath() + " to " + s3_target.toPath());
+                return false;
             }
-        }
 
-        return rc;
+            return s3fs->copySingleFileWithinS3(s3_src, s3_target);
+        } else logger.warn("calling S3 copyFile, but no system registered under s3://");
+
+        return false;
     }
 #endif
 
     // @TODO: add overwrite parameter??
-    VirtualFileSystemStatus VirtualFileSystem::copy(const std::string &src_pattern, const URI &target) {
+    VirtualFileSystemStatus VirtualFileSystem::copy(const std::string &src_pattern, const URI &target,
+                                                    std::function<void(const CopyProgress&)> progress) {
         using namespace std;
         auto& logger = Logger::instance().logger("filesystem");
 
-        // TODO: making VFS async could speed up things a lot!
-
 #ifndef BUILD_WITH_AWS
         if(target.prefix() == "s3://") {
             logger.error("Tuplex version was build without AWS SDK support. Can't process S3 URI " + target.toPath());
@@ -410,10 +492,8 @@ namespace tuplex {
             mapped_uris[uri.prefix()].push_back(uri.toPath());
         }
 
-        vector<URI> copied_uris;
-
-        VirtualFileSystemStatus rc = VirtualFileSystemStatus::VFS_OK;
-        // go through groups
+        // collect all files first, then copy them concurrently
+        CopyEngine engine(copyParallelism, copyChunkSize);
         for(auto kv : mapped_uris) {
             assert(!kv.first.empty());
             // find longest shared prefix
@@ -422,87 +502,41 @@ namespace tuplex {
             lcp = lcp.substr(0, lcp.rfind("/"));
 
             if(kv.first == "file://") {
-                // what is the target?
-                if(target.isLocal()) {
-                    if(0 != copyLocalToLocal(kv.second, target, lcp, copied_uris, true))
-                        goto COPY_FAILURE;
-                } else if(target.prefix() == "s3://") {
-#ifdef BUILD_WITH_AWS
-                    if(0 != copyLocalToS3(kv.second, target, lcp, copied_uris, true))
-                        goto COPY_FAILURE;
-#endif
-                }
+                addLocalSources(engine, kv.second, target, lcp);
             } else if(kv.first == "s3://") {
-                if(target.isLocal()) {
-                    // download file from S3
-                    for(auto src : kv.second) {
-                        // create dir for local files
-                        URI target_uri = target.join_path(src.substr(lcp.size()));
-
-                        // when single file, just overwrite whatever the target is
-                        // unless it's a separator because then copy into folder is desired...
-                        if(src_uris.size() == 1 && target.toString().back() != '/') {
-                            target_uri = target;
-                        }
-
-                        auto vfs = VirtualFileSystem::fromURI(target_uri);
-                        rc = vfs.create_dir(target_uri.parent());
-                        if(rc != VirtualFileSystemStatus::VFS_OK)
-                            goto COPY_FAILURE;
-#ifdef BUILD_WITH_AWS
-                        auto handle = s3DownloadFile(src, target_uri.withoutPrefix());
-                        if(!handle) {
-                            rc = VirtualFileSystemStatus::VFS_IOERROR;
-                            goto COPY_FAILURE;
-                        }
-                        //s3UploadFile(src_without_prefix, target_uri, content_type);
-#endif
-                        copied_uris.push_back(target_uri);
+                // src uris have been expanded from S3 already, thus simply iterating will work.
+                // only the target scenario needs to be figured out
+                for(auto src : kv.second) {
+                    URI target_uri = target.join_path(src.substr(lcp.size()));
+
+                    // when single file, just overwrite whatever the target is
+                    // unless it's a separator because then copy into folder is desired...
+                    if(src_uris.size() == 1 && target.toString().back() != '/') {
+                        target_uri = target;
                     }
-                } else if(target.prefix() == "s3://") {
-#ifdef BUILD_WITH_AWS
-                    // copy s3 to s3
-                    // -> there's a request for this!
-                    // https://docs.aws.amazon.com/code-samples/latest/catalog/cpp-s3-copy_object.cpp.html
-
-                    // issue copy requests
-                    // --> need to perform one for each file!
-                    // -> src uris have been expanded from S3 already, thus simply iterating will work.
-                    // only the target scenario needs to be figured out
-                    for(auto src : kv.second) {
-                        // create dir for local files
-                        URI target_uri = target.join_path(src.substr(lcp.size()));
-
-                        // when single file, just overwrite whatever the target is
-                        // unless it's a separator because then copy into folder is desired...
-                        if (src_uris.size() == 1 && target.toString().back() != '/') {
-                            target_uri = target;
-                        }
-
-                        assert(target_uri.prefix() == "s3://");
-                        auto vfs = VirtualFileSystem::fromURI(target_uri);
-                        assert(vfs._impl);
-                        auto s3sys = (S3FileSystemImpl*)vfs._impl;
-
-                        // creation of target dir not neccessary for object store
-                        if(!s3sys->copySingleFileWithinS3(src, target_uri))
-                            goto COPY_FAILURE;
-                        copied_uris.push_back(target_uri);
-                    }
-#endif
+                    engine.add(URI(src), target_uri);
                 }
             } else {
                 logger.error("unsupported file system prefix " + kv.first + " found, aborting copy operation");
-                rc = VirtualFileSystemStatus::VFS_IOERROR;
-                goto COPY_FAILURE; // ugly, but best way here...
+                return VirtualFileSystemStatus::VFS_IOERROR;
             }
         }
-        return VirtualFileSystemStatus::VFS_OK;
 
-COPY_FAILURE:
-        // remove all copied uris (s.t. this operation here becomes atomic)
-        for(auto uri : copied_uris)
-            VirtualFileSystem::remove(uri);
+        engine.setProgressCallback([&](const CopyProgress& p) {
+            logger.info("copied " + std::to_string(p.filesCopied) + "/" + pluralize(p.filesTotal, "file") + " ("
+                        + sizeToMemString(p.bytesCopied) + "/" + sizeToMemString(p.bytesTotal) + ", "
+                        + sizeToMemString(static_cast<size_t>(p.throughput())) + "/s)");
+            if(progress)
+                progress(p);
+        });
+
+        vector<URI> copied_uris;
+        auto rc = engine.run(copied_uris);
+        if(rc != VirtualFileSystemStatus::VFS_OK) {
+            // remove all copied uris (s.t. this operation here becomes atomic)
+            for(auto uri : copied_uris)
+                VirtualFileSystem::remove(uri);
+        }
         return rc;
     }
 
@@ -187,6 +187,13 @@ namespace tuplex {
          */
         boost::python::dict options() const;
 
+        /*!
+         * executes several deferred actions (cf. PythonDataSet::deferTake), reading inputs shared by them only once.
+         * @param actions list of datasets returned by deferred actions
+         * @return list with one result per action, i.e. a list of rows for take and None for file output
+         */
+        boost::python::list runAll(boost::python::list actions);
+
 
 
         // helper functions to deal with file systems
@@ -47,6 +47,8 @@ namespace tuplex {
             _dataset = dataset;
         }
 
+        DataSet* dataset() const { return _dataset; }
+
         PythonDataSet unique();
 
         /*!
@@ -129,6 +131,26 @@ namespace tuplex {
               size_t limit=std::numeric_limits<size_t>::max(),
               const std::string& null_value="",
               boost::python::object header=boost::python::object());
+
+        /*!
+         * deferred versions of take and tocsv, i.e. the action is only added. Execute it via PythonContext::runAll
+         */
+        PythonDataSet deferTake(const int64_t numRows);
+
+        PythonDataSet deferTocsv(const std::string &file_path,
+                                 const std::string &lambda_code ="",
+                                 const std::string &pickled_code = "",
+                                 size_t fileCount=0,
+                                 size_t shardSize=0,
+                                 size_t limit=std::numeric_limits<size_t>::max(),
+                                 const std::string& null_value="",
+                                 boost::python::object header=boost::python::object());
+
+        /*!
+         * converts the result of this deferred action after it was executed via PythonContext::runAll
+         * @return list of rows for take, None for file output
+         */
+        boost::python::object deferredResult(ResultSet* rs);
     };
 
     /*!
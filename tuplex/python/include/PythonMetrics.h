@@ -70,6 +70,27 @@ namespace tuplex {
             double getTotalCompilationTime() {
                 return _metrics->getTotalCompilationTime();
             }
+            /*!
+            * getter for compilation time hidden behind execution
+            * @returns a double representing compilation time of stages compiled ahead of time that did not delay execution
+            */
+            double getHiddenCompilationTime() {
+                return _metrics->getHiddenCompilationTime();
+            }
+            /*!
+            * getter for number of stages which read input files
+            * @returns a size_t representing how many stages scanned input files, over all jobs of the context
+            */
+            size_t getFileScanCount() {
+                return _metrics->getFileScanCount();
+            }
+            /*!
+            * getter for number of stages compiled ahead of time
+            * @returns a size_t representing how many stages were compiled on a background thread
+            */
+            size_t getAheadOfTimeStageCount() {
+                return _metrics->getAheadOfTimeStageCount();
+            }
 
             /*!
              * returns metrics as json string
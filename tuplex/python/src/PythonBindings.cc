@@ -54,6 +54,8 @@ PYMODULE {
             .def("columns", &tuplex::PythonDataSet::columns)
             .def("cache", &tuplex::PythonDataSet::cache)
             .def("tocsv", &tuplex::PythonDataSet::tocsv)
+            .def("deferTake", &tuplex::PythonDataSet::deferTake)
+            .def("deferTocsv", &tuplex::PythonDataSet::deferTocsv)
             .def("unique", &tuplex::PythonDataSet::unique)
             .def("aggregate", &tuplex::PythonDataSet::aggregate)
             .def("aggregateByKey", &tuplex::PythonDataSet::aggregateByKey)
@@ -67,6 +69,7 @@ PYMODULE {
             .def("parallelize", &tuplex::PythonContext::parallelize)
             .def("options", &tuplex::PythonContext::options)
             .def("getMetrics", &tuplex::PythonContext::getMetrics)
+            .def("runAll", &tuplex::PythonContext::runAll)
             .def("ls", &tuplex::PythonContext::ls)
             .def("cp", &tuplex::PythonContext::cp)
             .def("rm", &tuplex::PythonContext::rm);
@@ -76,6 +79,9 @@ PYMODULE {
             .def("getLLVMOptimizationTime", &tuplex::PythonMetrics::getLLVMOptimizationTime)
             .def("getLLVMCompilationTime", &tuplex::PythonMetrics::getLLVMCompilationTime)
             .def("getTotalCompilationTime", &tuplex::PythonMetrics::getTotalCompilationTime)
+            .def("getHiddenCompilationTime", &tuplex::PythonMetrics::getHiddenCompilationTime)
+            .def("getFileScanCount", &tuplex::PythonMetrics::getFileScanCount)
+            .def("getAheadOfTimeStageCount", &tuplex::PythonMetrics::getAheadOfTimeStageCount)
             .def("getTotalExceptionCount", &tuplex::PythonMetrics::getTotalExceptionCount)
             .def("getJSONString", &tuplex::PythonMetrics::getJSONString);
 }
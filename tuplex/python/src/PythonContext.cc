@@ -1371,6 +1371,46 @@ namespace tuplex {
         return boost::python::list(boost::python::handle<>(listObj));
     }
 
+    boost::python::list PythonContext::runAll(boost::python::list actions) {
+        std::vector<PythonDataSet> pds;
+        std::vector<DataSet*> datasets;
+        for(unsigned i = 0; i < boost::python::len(actions); ++i) {
+            PythonDataSet ds = boost::python::extract<PythonDataSet>(actions[i]);
+            assert(ds.dataset());
+            pds.push_back(ds);
+            datasets.push_back(ds.dataset());
+        }
+
+        // release GIL & hand over everything to Tuplex
+        assert(PyGILState_Check()); // make sure this thread holds the GIL!
+        python::unlockGIL();
+        std::vector<std::shared_ptr<ResultSet>> results;
+        std::string err_message = "";
+        try {
+            results = _context->runAll(datasets);
+        } catch(const std::exception& e) {
+            err_message = e.what();
+            Logger::instance().defaultLogger().error(err_message);
+        } catch(...) {
+            err_message = "unknown C++ exception occurred, please change type.";
+            Logger::instance().defaultLogger().error(err_message);
+        }
+        python::lockGIL();
+
+        // error? then each action gets the error string
+        boost::python::list L;
+        for(unsigned i = 0; i < pds.size(); ++i) {
+            if(!err_message.empty()) {
+                boost::python::list E;
+                E.append(err_message);
+                L.append(E);
+            } else
+                L.append(pds[i].deferredResult(results[i].get()));
+        }
+        Logger::instance().flushAll();
+        return L;
+    }
+
     void PythonContext::cp(const std::string &pattern, const std::string &target) const {
         throw std::runtime_error("not yet supported");
     }
@@ -14,6 +14,7 @@
 #include <CSVUtils.h>
 #include <Signals.h>
 #include <limits>
+#include <logical/LogicalOperator.h>
 
 #ifdef NDEBUG
 #define LARGE_RESULT_SIZE 1000000ul
@@ -655,6 +656,32 @@ namespace tuplex {
         return pds;
     }
 
+    // decodes the csv output options passed from python
+    static std::unordered_map<std::string, std::string> csvOutputOptions(const std::string& null_value,
+                                                                         boost::python::object header) {
+        std::unordered_map<std::string, std::string> outputOptions = defaultCSVOutputOptions();
+        outputOptions["null_value"] = null_value;
+
+        // incref
+        if(header.ptr())
+            Py_XINCREF(header.ptr());
+
+        // check what to do about the header
+        assert(header.ptr());
+        if(header.ptr() == Py_None) {
+            // nothing todo, keep defaults...
+        } else if(header.ptr() == Py_False || header.ptr() == Py_True) {
+            // if false, no header
+            outputOptions["header"] = header.ptr() == Py_False ? "false" : "true";
+        } else {
+            auto headerNames = extractFromListOfStrings(header.ptr(), "header");
+            if (!headerNames.empty())
+                outputOptions["csvHeader"] = csvToHeader(headerNames) + "\n";
+            outputOptions["header"] = "true";
+        }
+        return outputOptions;
+    }
+
     void PythonDataSet::tocsv(const std::string &file_path, const std::string &lambda_code, const std::string &pickled_code,
                          size_t fileCount, size_t shardSize, size_t limit, const std::string &null_value,
                          boost::python::object header) {
@@ -662,8 +689,6 @@ namespace tuplex {
         assert(this->_dataset);
         // ==> error handled below.
 
-        std::unordered_map<std::string, std::string> outputOptions = defaultCSVOutputOptions();
-
         // is callee error dataset? if so return list with error string
         if (this->_dataset->isError()) {
             ErrorDataSet *eds = static_cast<ErrorDataSet *>(this->_dataset);
@@ -672,25 +697,7 @@ namespace tuplex {
             Logger::instance().flushAll();
         } else {
             // decode options
-            outputOptions["null_value"] = null_value;
-
-            // incref
-            if(header.ptr())
-                Py_XINCREF(header.ptr());
-
-            // check what to do about the header
-            assert(header.ptr());
-            if(header.ptr() == Py_None) {
-                // nothing todo, keep defaults...
-            } else if(header.ptr() == Py_False || header.ptr() == Py_True) {
-                // if false, no header
-                outputOptions["header"] = header.ptr() == Py_False ? "false" : "true";
-            } else {
-                auto headerNames = extractFromListOfStrings(header.ptr(), "header");
-                if (!headerNames.empty())
-                    outputOptions["csvHeader"] = csvToHeader(headerNames) + "\n";
-                outputOptions["header"] = "true";
-            }
+            auto outputOptions = csvOutputOptions(null_value, header);
 
             // release GIL & hand over everything to Tuplex
             assert(PyGILState_Check()); // make sure this thread holds the GIL!
@@ -723,6 +730,77 @@ namespace tuplex {
         }
     }
 
+    PythonDataSet PythonDataSet::deferTake(const int64_t numRows) {
+        assert(this->_dataset);
+
+        PythonDataSet pds;
+        if (this->_dataset->isError()) {
+            pds.wrap(this->_dataset);
+            return pds;
+        }
+
+        DataSet *ds = nullptr;
+        std::string err_message = "";
+        try {
+            ds = &_dataset->deferTake(numRows);
+        } catch(const std::exception& e) {
+            err_message = e.what();
+            Logger::instance().defaultLogger().error(err_message);
+        }
+
+        if(!ds || !err_message.empty())
+            ds = &_dataset->getContext()->makeError(err_message);
+        pds.wrap(ds);
+        Logger::instance().flushAll();
+        return pds;
+    }
+
+    PythonDataSet PythonDataSet::deferTocsv(const std::string &file_path, const std::string &lambda_code,
+                                            const std::string &pickled_code, size_t fileCount, size_t shardSize,
+                                            size_t limit, const std::string &null_value, boost::python::object header) {
+        assert(this->_dataset);
+
+        PythonDataSet pds;
+        if (this->_dataset->isError()) {
+            pds.wrap(this->_dataset);
+            return pds;
+        }
+
+        auto outputOptions = csvOutputOptions(null_value, header);
+        DataSet *ds = nullptr;
+        std::string err_message = "";
+        try {
+            ds = &_dataset->deferTofile(FileFormat::OUTFMT_CSV, URI(file_path), UDF(lambda_code, pickled_code),
+                                        fileCount, shardSize, outputOptions, limit);
+        } catch(const std::exception& e) {
+            err_message = e.what();
+            Logger::instance().defaultLogger().error(err_message);
+        }
+
+        if(!ds || !err_message.empty())
+            ds = &_dataset->getContext()->makeError(err_message);
+        pds.wrap(ds);
+        Logger::instance().flushAll();
+        return pds;
+    }
+
+    boost::python::object PythonDataSet::deferredResult(ResultSet* rs) {
+        assert(this->_dataset);
+
+        if(_dataset->isError()) {
+            boost::python::list L;
+            L.append(static_cast<ErrorDataSet*>(_dataset)->getError());
+            return L;
+        }
+
+        auto op = _dataset->getOperator();
+        if(!rs || (op && op->type() == LogicalOperatorType::FILEOUTPUT))
+            return boost::python::object();
+
+        auto listObj = resultSetToCPython(rs, std::numeric_limits<size_t>::max());
+        return boost::python::object(boost::python::handle<>(listObj));
+    }
+
     void PythonDataSet::show(const int64_t numRows) {
 
         // make sure a dataset is wrapped
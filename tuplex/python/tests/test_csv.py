@@ -52,6 +52,19 @@ class TestCSV(unittest.TestCase):
         res = dataset.map(lambda a, b, c, d: d).collect()
         assert res == ["FAST ETL!", "FAST ETL!", "FAST ETL!"]
 
+    def test_run_all(self):
+        c = Context(self.conf)
+        ds = c.csv("test.csv").map(lambda a, b, c, d: a)
+        first = ds.filter(lambda x: x > 1).defer_take(5)
+        second = ds.filter(lambda x: x <= 4).defer_tocsv('run_all_output')
+        scans = c.metrics.fileScanCount
+        res = c.run_all(first, second)
+        assert c.metrics.fileScanCount - scans == 1
+        assert res[0] == [4, 7]
+        assert res[1] is None
+        assert len(c.ls('run_all_output/*.csv')) > 0
+        c.rm('run_all_output/*.csv')
+
     def test_tsv(self):
         c = Context(self.conf)
         dataset = c.csv("test.tsv", delimiter='\t')
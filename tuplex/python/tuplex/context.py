@@ -66,6 +66,8 @@ class Context:
             webui.mongodb.port (int): port for MongoDB instance
             webui.mongodb.path (str): local path where to store files for MongoDB instance to be started.
             webui.exceptionDisplayLimit (int): How many exceptions to display in UI max, must be at least 1.
+            metrics.enable (str) or (bool): whether to serve Prometheus metrics at http://127.0.0.1:<metrics.port>/metrics. By default false.
+            metrics.port (int): port of the metrics endpoint. Default: 9464
             csv.maxDetectionRows (int): maximum number of rows to determine types for CSV files.
             csv.maxDetectionMemory (str) or (int): maximum number of bytes to use when performing type detection, separator inference, etc. over CSV files.
             csv.separators (list): list of single character strings that are viable separators when autodetecting. E.g. ``[','. ';', '\t']``.
@@ -269,6 +271,21 @@ class Context:
 
         save_conf_yaml(self.options(), file_path)
 
+    def run_all(self, *actions):
+        """
+        executes several deferred actions (cf. DataSet.defer_take, DataSet.defer_tocsv) together. Inputs shared by
+        the actions are read only once.
+        Args:
+            *actions: datasets returned by deferred actions
+
+        Returns: list with one result per action, i.e. a list of rows for take and None for file output
+
+        """
+        assert self._context
+        for ds in actions:
+            assert isinstance(ds, DataSet) and ds._dataSet is not None, 'run_all expects datasets returned by deferred actions'
+        return self._context.runAll([ds._dataSet for ds in actions])
+
     def ls(self, pattern):
         """
         return a list of strings of all files found matching the pattern. The same pattern can be supplied to read inputs.
@@ -455,6 +455,55 @@ class DataSet:
 
         self._dataSet.tocsv(path, code, code_pickled, num_parts, part_size, num_rows, null_value, header)
 
+    def defer_take(self, nrows=5):
+        """ deferred version of take, i.e. the action is only added to the pipeline. Execute it together with
+        other deferred actions via ``Context.run_all``, which reads inputs shared by them only once.
+
+        Args:
+            nrows (int): number of rows to collect. Per default ``5``.
+        Returns:
+            tuplex.dataset.DataSet: A Tuplex Dataset object representing the action
+
+        """
+
+        assert isinstance(nrows, int), 'num rows must be an integer'
+        assert nrows > 0, 'please specify a number greater than zero'
+
+        assert self._dataSet is not None, 'internal API error, datasets must be created via context objects'
+
+        ds = DataSet()
+        ds._dataSet = self._dataSet.deferTake(nrows)
+        return ds
+
+    def defer_tocsv(self, path, part_size=0, num_rows=max_rows, num_parts=0, part_name_generator=None, null_value=None, header=True):
+        """ deferred version of tocsv, i.e. the action is only added to the pipeline. Execute it via
+        ``Context.run_all``. Arguments are the same as for tocsv.
+
+        Returns:
+            tuplex.dataset.DataSet: A Tuplex Dataset object representing the action
+        """
+        assert self._dataSet is not None, 'internal API error, datasets must be created via context objects'
+        assert isinstance(header, list) or isinstance(header, bool), 'header must be a list of strings, or a boolean'
+
+        code, code_pickled = '', ''
+        if part_name_generator is not None:
+            code_pickled = cloudpickle.dumps(part_name_generator)
+            try:
+                code = get_udf_source(part_name_generator)
+            except UDFCodeExtractionError as e:
+                logging.warn('Could not extract code for {}. Details:\n{}'.format(part_name_generator, e))
+
+        # clamp max rows
+        if num_rows > max_rows:
+            raise Exception('Tuplex supports at most {} rows'.format(max_rows))
+
+        if null_value is None:
+            null_value = ''
+
+        ds = DataSet()
+        ds._dataSet = self._dataSet.deferTocsv(path, code, code_pickled, num_parts, part_size, num_rows, null_value, header)
+        return ds
+
     def aggregate(self, combine, aggregate, initial_value):
         """
         Args:
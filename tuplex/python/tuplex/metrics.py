@@ -82,6 +82,36 @@ class Metrics:
         assert self._metrics
         return self._metrics.getTotalCompilationTime()
 
+    @property
+    def hiddenCompilationTime(self) -> float:
+        """
+        Retrieves the compilation time in seconds that overlapped with execution, i.e. of stages compiled ahead of time.
+        Returns:
+            float:  the hidden compilation time in seconds
+        """
+        assert self._metrics
+        return self._metrics.getHiddenCompilationTime()
+
+    @property
+    def fileScanCount(self) -> int:
+        """
+        Retrieves how many stages read input files, counted over all jobs run by the context.
+        Returns:
+            int:  the number of file scans
+        """
+        assert self._metrics
+        return self._metrics.getFileScanCount()
+
+    @property
+    def aheadOfTimeStageCount(self) -> int:
+        """
+        Retrieves how many stages were compiled on a background thread while earlier stages executed.
+        Returns:
+            int:  the number of stages compiled ahead of time
+        """
+        assert self._metrics
+        return self._metrics.getAheadOfTimeStageCount()
+
     def as_json(self) -> str:
         """
         all measurements as json encoded string
@@ -0,0 +1,185 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <gtest/gtest.h>
+
+#include <parser/Parser.h>
+#include <parser/PythonSubsetParser.h>
+#include <graphviz/GraphVizGraph.h>
+#include <Timer.h>
+#include <Logger.h>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace tuplex;
+
+// same snippets as in ANTLRParserTest
+static std::vector<std::string> parserCorpus() {
+    return {"lambda x: x * 2 * 3 - 20 - 40 << 2 | 3 ^ 1 & 0",
+            "lambda x: x.lower().upper().lower()",
+            "lambda x: x.replace('hello', '').lower().upper().replace('jdhgjh', 'kfgjk')",
+            "lambda x: '{:05}'.format(int(x['postal_code']))",
+            "lambda x: x['city'][0].upper() + x['city'][1:].lower()",
+            "lambda x: x[1:20:2]",
+            "lambda x: x[:10:2] + x[1:10:] + x[1::2]",
+            "lambda x: x[1:] + x[:20] + x[::-1]",
+            "lambda x: (x, 2, 3, (), (3, 5))",
+            "lambda x: {'a':1, 'b':2, 'c':3, 'd':(1, 2, 3), 'e':True}",
+            "lambda x: [1, 2, 'a', 'b', True]",
+            "lambda x: [y for y in range(x)]",
+            "lambda x: -x ** 2 if not x in [1, 2] else ~x // 3",
+            "lambda a, b=10: a < b <= 20 and a not in 'abc' or None",
+            "os.path.join",
+            "def extractBa(x):\n"
+            "    val = x['facts and features']\n"
+            "    max_idx = val.find(' ba')\n"
+            "    if max_idx < 0:\n"
+            "        max_idx = len(val)\n"
+            "    s = val[:max_idx]\n"
+            "\n"
+            "    # find comma before\n"
+            "    split_idx = s.rfind(',')\n"
+            "    if split_idx < 0:\n"
+            "        split_idx = 0\n"
+            "    else:\n"
+            "        split_idx += 2\n"
+            "    r = s[split_idx:]\n"
+            "    return int(r)",
+            "def extractOffer(x):\n"
+            "    offer = x['title']\n"
+            "    assert 'Sale' in offer or 'Rent' in offer or 'SOLD' in offer\n"
+            "\n"
+            "    if 'Sale' in offer:\n"
+            "        offer = 'sale'\n"
+            "    elif 'Rent' in offer:\n"
+            "        offer = 'rent'\n"
+            "    elif 'SOLD' in offer:\n"
+            "        offer = 'sold'\n"
+            "    elif 'foreclose' in offer.lower():\n"
+            "        offer = 'foreclosed'\n"
+            "\n"
+            "    return offer",
+            "def f(x):\n\ty = z = x + 2\n\treturn y",
+            "def f(x):\n\ty = 20\n\ty += x\n\treturn y",
+            "def f(x: int) :\n"
+            "    a, b = x, \\\n"
+            "        'hello' 'world'\n"
+            "    if x > 0: raise ValueError('negative') from None\n"
+            "    return (a,\n"
+            "            b)\n",
+            "for i in range(10):\n"
+            "    if i == 5:\n"
+            "        continue\n"
+            "    num = num + i\n"
+            "else:\n"
+            "    num = num * 2",
+            "while i < 10:\n"
+            "    if val[i] == 'a':\n"
+            "        break\n"
+            "    i = i + 1\n"
+            "else:\n"
+            "    found = 0"};
+}
+
+// graphviz representation, i.e. node types, labels and edges. Written to path, which gets removed again
+static std::string astToDot(ASTNode* root, const std::string& path) {
+    GraphVizGraph graph;
+    graph.createFromAST(root);
+    EXPECT_TRUE(graph.saveAsDot(path));
+    std::stringstream ss;
+    {
+        std::ifstream ifs(path);
+        ss<<ifs.rdbuf();
+    }
+    unlink(path.c_str());
+    return ss.str();
+}
+
+TEST(PythonSubsetParser, SameASTAsANTLR) {
+    // dot files go to a fresh temp dir, so concurrent test runs don't overwrite each other's files
+    auto tmp = getenv("TMPDIR");
+    std::string dirTemplate = std::string(tmp ? tmp : "/tmp") + "/tuplex_subset_parser_XXXXXX";
+    ASSERT_TRUE(mkdtemp(&dirTemplate[0]));
+    auto dotPath = dirTemplate + "/ast.dot";
+
+    for(const auto& code : parserCorpus()) {
+        PythonSubsetParser parser(code);
+        auto ast = std::unique_ptr<ASTNode>(parser.parse());
+        ASSERT_TRUE(ast.get()) << "failed to parse:\n" << code << "\n" << parser.errorMessage();
+
+        auto ref = std::unique_ptr<ASTNode>(parseToASTWithANTLR(code));
+        ASSERT_TRUE(ref.get());
+        EXPECT_EQ(ast->type(), ref->type());
+        EXPECT_EQ(astToDot(ast.get(), dotPath), astToDot(ref.get(), dotPath)) << "AST mismatch for:\n" << code;
+    }
+    rmdir(dirTemplate.c_str());
+}
+
+TEST(PythonSubsetParser, Tokenize) {
+    std::vector<Token> tokens;
+    std::string err;
+    ASSERT_TRUE(PythonSubsetParser::tokenize("def f(x):\n    return x[1:] ** 2\n", tokens, err));
+    std::vector<TokenType> ref{TokenType::DEF, TokenType::IDENTIFIER, TokenType::LPAR, TokenType::IDENTIFIER,
+                               TokenType::RPAR, TokenType::COLON, TokenType::NEWLINE, TokenType::INDENT,
+                               TokenType::RETURN, TokenType::IDENTIFIER, TokenType::LSQB, TokenType::NUMBER,
+                               TokenType::COLON, TokenType::RSQB, TokenType::DOUBLESTAR, TokenType::NUMBER,
+                               TokenType::NEWLINE, TokenType::DEDENT, TokenType::ENDOFFILE};
+    ASSERT_EQ(tokens.size(), ref.size());
+    for(size_t i = 0; i < ref.size(); ++i)
+        EXPECT_EQ(tokens[i].getType(), ref[i]) << "token " << i;
+
+    EXPECT_FALSE(PythonSubsetParser::tokenize("lambda x: 'unterminated", tokens, err));
+    EXPECT_FALSE(err.empty());
+}
+
+TEST(PythonSubsetParser, UnsupportedSyntaxFallsBack) {
+    // outside of the subset, parseToAST hands these to the full grammar
+    std::vector<std::string> codes{"lambda x: x is None",
+                                   "lambda x: int(x, base=16)",
+                                   "class A:\n    x = 1"};
+    for(const auto& code : codes) {
+        PythonSubsetParser parser(code);
+        auto ast = std::unique_ptr<ASTNode>(parser.parse());
+        EXPECT_FALSE(ast.get()) << code;
+        EXPECT_FALSE(parser.errorMessage().empty());
+    }
+
+    auto ast = std::unique_ptr<ASTNode>(parseToAST("lambda x: x is None"));
+    EXPECT_TRUE(ast.get());
+
+    // invalid code fails in both
+    PythonSubsetParser parser("lambda x: (x + ");
+    EXPECT_FALSE(parser.parse());
+    EXPECT_FALSE(parser.errorMessage().empty());
+}
+
+TEST(PythonSubsetParser, Benchmark) {
+    auto corpus = parserCorpus();
+    const size_t numRounds = 100;
+
+    Timer timer;
+    for(size_t i = 0; i < numRounds; ++i)
+        for(const auto& code : corpus)
+            delete PythonSubsetParser(code).parse();
+    double subsetTime = timer.time();
+
+    timer.reset();
+    for(size_t i = 0; i < numRounds; ++i)
+        for(const auto& code : corpus)
+            delete parseToASTWithANTLR(code);
+    double antlrTime = timer.time();
+
+    // timings only, no assertion. They depend on the machine and load
+    Logger::instance().defaultLogger().info("parsing " + std::to_string(numRounds * corpus.size()) + " snippets took "
+                                            + std::to_string(subsetTime) + "s (subset parser) vs. "
+                                            + std::to_string(antlrTime) + "s (ANTLR)");
+}
@@ -279,6 +279,39 @@ TEST_F(AggregateTest, AggregateByKeyBasic) {
     EXPECT_EQ(columns2[2], "");
 }
 
+TEST_F(AggregateTest, AggregateByKeyHeavyHitter) {
+    // most rows share one key, whose bucket tasks keep outside of the hash table. Results must not change
+    using namespace tuplex;
+    auto opt = testOptions();
+    opt.set("tuplex.hotKeyRows", "2");
+    Context c(opt);
+
+    std::vector<Row> strRows, intRows;
+    for(int i = 0; i < 50; ++i) {
+        strRows.push_back(Row(i, "hot"));
+        intRows.push_back(Row(i, 7));
+    }
+    strRows.push_back(Row(100, "cold"));
+    intRows.push_back(Row(100, 8));
+
+    auto combine = UDF("lambda a, b: a + b");
+    auto agg = UDF("lambda a, x: a + x[0]");
+
+    auto v1 = c.parallelize(strRows, {"col0", "col1"}).aggregateByKey(combine, agg, Row(0), {"col1"}).collectAsVector();
+    ASSERT_EQ(v1.size(), 2);
+    std::vector<std::string> res1{v1[0].toPythonString(), v1[1].toPythonString()};
+    std::sort(res1.begin(), res1.end());
+    EXPECT_EQ(res1[0], "('cold',100)");
+    EXPECT_EQ(res1[1], "('hot',1225)");
+
+    auto v2 = c.parallelize(intRows, {"col0", "col1"}).aggregateByKey(combine, agg, Row(0), {"col1"}).collectAsVector();
+    ASSERT_EQ(v2.size(), 2);
+    std::vector<std::string> res2{v2[0].toPythonString(), v2[1].toPythonString()};
+    std::sort(res2.begin(), res2.end());
+    EXPECT_EQ(res2[0], "(7,1225)");
+    EXPECT_EQ(res2[1], "(8,100)");
+}
+
 TEST_F(AggregateTest, AggregateByKeyMultipleColumns) {
     using namespace tuplex;
     auto opt = testOptions();
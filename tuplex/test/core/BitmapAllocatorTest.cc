@@ -0,0 +1,58 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <mutex>
+#include <Logger.h>
+#include <Utils.h>
+#include <BitmapAllocator.h>
+
+using namespace tuplex;
+
+static void checkAllocations(BitmapAllocator& allocator) {
+    auto blockSize = allocator.blockSize();
+
+    auto a = (uint8_t*)allocator.alloc(blockSize);
+    auto b = (uint8_t*)allocator.alloc(2 * blockSize + 1); // 3 blocks
+    ASSERT_TRUE(a);
+    ASSERT_TRUE(b);
+    EXPECT_EQ(allocator.allocatedSize(a), blockSize);
+    EXPECT_EQ(allocator.allocatedSize(b), 3 * blockSize);
+
+    memset(a, 'a', blockSize);
+    memset(b, 'b', 3 * blockSize);
+    EXPECT_EQ(a[blockSize - 1], 'a');
+    EXPECT_EQ(b[0], 'b');
+
+    // arena has 8 blocks, 4 are in use
+    EXPECT_FALSE(allocator.alloc(5 * blockSize));
+    allocator.free(b);
+    auto c = (uint8_t*)allocator.alloc(5 * blockSize);
+    ASSERT_TRUE(c);
+    EXPECT_EQ(c[0], 0); // allocations are zeroed
+    allocator.free(c);
+    allocator.free(a);
+}
+
+TEST(BitmapAllocator, MallocArena) {
+    BitmapAllocator allocator(8 * 64 * 1024, 64 * 1024);
+    checkAllocations(allocator);
+}
+
+TEST(BitmapAllocator, MappedArena) {
+    // huge pages might not be available, the arena falls back to regular pages then
+    ArenaPolicy policy;
+    policy.hugePages = true;
+    policy.prefault = true;
+    BitmapAllocator allocator(8 * 2 * 1024 * 1024, 2 * 1024 * 1024, policy);
+    allocator.startPrefault();
+    checkAllocations(allocator);
+}
@@ -0,0 +1,58 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include "TestUtils.h"
+#include <physical/CSVSplitter.h>
+#include <VirtualFileSystem.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+
+using namespace tuplex;
+
+TEST(CSVSplitter, MultiLineFields) {
+    // every third row has a quoted field spanning several lines, some containing escaped quotes
+    auto dir = testTempDir();
+    std::string path = dir + "/multiline.csv";
+    std::string content = "a,b\n";
+    std::vector<size_t> rowStarts;
+    for(int i = 0; i < 5000; ++i) {
+        rowStarts.push_back(content.size());
+        if(i % 3 == 0)
+            content += std::to_string(i) + ",\"line\n\"\"quoted\"\"\nnext,line\"\n";
+        else
+            content += std::to_string(i) + ",plain\n";
+    }
+    stringToFile(URI(path), content);
+
+    size_t splitSize = 1000;
+    auto offsets = csvSplitOffsets(URI(path), content.size(), splitSize, '"', 4);
+    boost::filesystem::remove_all(dir);
+
+    ASSERT_GT(offsets.size(), 1u);
+    EXPECT_EQ(offsets.front(), 0u);
+    for(size_t i = 1; i < offsets.size(); ++i) {
+        EXPECT_LT(offsets[i - 1], offsets[i]);
+        // each split starts at a row, i.e. never within a multi-line field
+        EXPECT_TRUE(std::binary_search(rowStarts.begin(), rowStarts.end(), offsets[i])) << "offset " << offsets[i];
+        // ...and at the first row within its chunk
+        size_t chunkStart = offsets[i] / splitSize * splitSize;
+        auto it = std::lower_bound(rowStarts.begin(), rowStarts.end(), chunkStart);
+        EXPECT_EQ(*it, offsets[i]);
+    }
+}
+
+TEST(CSVSplitter, SmallFile) {
+    auto dir = testTempDir();
+    std::string path = dir + "/small.csv";
+    stringToFile(URI(path), "1,2\n3,4\n");
+    auto offsets = csvSplitOffsets(URI(path), 8, 1024);
+    boost::filesystem::remove_all(dir);
+    EXPECT_EQ(offsets, std::vector<size_t>{0});
+}
@@ -0,0 +1,137 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include "TestUtils.h"
+#include <Context.h>
+#include <Signals.h>
+#include <csignal>
+#include <physical/CSVReader.h>
+#include <physical/JITCompiledCSVReader.h>
+#include <physical/TextReader.h>
+#include <physical/TransformTask.h>
+
+class CancellationTest : public PyTest {
+protected:
+    static const size_t numLines = 200000;
+
+    // numbered lines, several blocks for every reader
+    tuplex::URI writeLines() {
+        using namespace tuplex;
+        std::string content;
+        for(size_t i = 0; i < numLines; ++i)
+            content += std::to_string(i) + "," + std::to_string(2 * i) + "\n";
+        URI uri(testName + ".csv");
+        stringToFile(uri, content);
+        return uri;
+    }
+
+    void TearDown() override {
+        tuplex::reset_signals();
+        PyTest::TearDown();
+    }
+
+    std::string testName = std::string("cancellation_") + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+};
+
+struct BlockCounter {
+    size_t numBlocks = 0;
+    size_t numLines = 0;
+};
+
+// consumes all complete lines of a block
+static int64_t countLines(void* userData, const uint8_t* buf, int64_t size, int64_t* normalRows, int64_t* badRows,
+                          int8_t ignoreLastRow) {
+    auto counter = static_cast<BlockCounter*>(userData);
+    counter->numBlocks++;
+    int64_t consumed = 0;
+    for(int64_t i = 0; i < size; ++i)
+        if(buf[i] == '\n') {
+            counter->numLines++;
+            (*normalRows)++;
+            consumed = i + 1;
+        }
+    return ignoreLastRow ? consumed : size;
+}
+
+static int64_t countRow(void* userData, int64_t rowNumber, char** cells, int64_t* cell_sizes) {
+    static_cast<BlockCounter*>(userData)->numLines++;
+    return 0;
+}
+
+TEST_F(CancellationTest, JITCompiledCSVReaderStopsEarly) {
+    using namespace tuplex;
+    auto uri = writeLines();
+
+    BlockCounter counter;
+    JITCompiledCSVReader reader(&counter, countLines, 2, ',', '"', 64 * 1024);
+    reader.setCancellationCheck([&counter]() { return counter.numBlocks > 0; });
+    reader.read(uri);
+    EXPECT_EQ(counter.numBlocks, 1u);
+    EXPECT_LT(counter.numLines, numLines);
+}
+
+TEST_F(CancellationTest, TextReaderStopsEarly) {
+    using namespace tuplex;
+    auto uri = writeLines();
+
+    BlockCounter counter;
+    TextReader reader(&counter, countLines, 64 * 1024);
+    reader.setCancellationCheck([&counter]() { return counter.numBlocks > 0; });
+    reader.read(uri);
+    EXPECT_EQ(counter.numBlocks, 1u);
+    EXPECT_LT(counter.numLines, numLines);
+
+    // without cancellation all lines are read
+    BlockCounter full;
+    TextReader fullReader(&full, countLines, 64 * 1024);
+    fullReader.read(uri);
+    EXPECT_EQ(full.numLines, numLines);
+}
+
+TEST_F(CancellationTest, CSVReaderStopsEarly) {
+    using namespace tuplex;
+    Context c(microTestOptions()); // the reader frees runtime memory per row
+    auto uri = writeLines();
+
+    // the cancellation check runs every codegen::cancellationCheckInterval rows
+    BlockCounter counter;
+    CSVReader reader(&counter, countRow, 2, ',');
+    reader.setCancellationCheck([&counter]() { return counter.numLines > 0; });
+    reader.read(uri);
+    EXPECT_GT(counter.numLines, 0u);
+    EXPECT_LE(counter.numLines, (size_t)codegen::cancellationCheckInterval);
+}
+
+TEST_F(CancellationTest, InterruptStopsTask) {
+    using namespace tuplex;
+    auto uri = writeLines();
+    ASSERT_TRUE(install_signal_handlers());
+
+    // SIGINT arrives while the first block is processed, the task's check stops the reader at the next block
+    TransformTask task;
+    BlockCounter counter;
+    JITCompiledCSVReader reader(&counter, countLines, 2, ',', '"', 64 * 1024);
+    reader.setCancellationCheck([&]() {
+        if(counter.numBlocks == 1 && !check_interrupted())
+            std::raise(SIGINT);
+        return task.checkStop();
+    });
+    reader.read(uri);
+    EXPECT_TRUE(check_interrupted());
+    EXPECT_TRUE(task.stoppedEarly());
+    EXPECT_EQ(counter.numBlocks, 1u);
+    EXPECT_LT(counter.numLines, numLines);
+
+    // once the signal is handled, tasks run to completion again
+    reset_signals();
+    TransformTask other;
+    EXPECT_FALSE(other.checkStop());
+}
@@ -10,7 +10,12 @@
 
 #include "gtest/gtest.h"
 #include <Context.h>
+#include <ee/local/LocalBackend.h>
 #include "TestUtils.h"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
 
 TEST(Context, parallelizationI) {
     using namespace tuplex;
@@ -64,6 +69,244 @@ TEST(Context, multiPartitionResultset) {
     python::closeInterpreter();
 }
 
+TEST(Context, multiJob) {
+    using namespace tuplex;
+
+    python::initInterpreter();
+    python::unlockGIL();
+
+    // two jobs collected at the same time from different threads share the executors
+    ContextOptions co = microTestOptions();
+    co.set("tuplex.executorCount", "4");
+    co.set("tuplex.partitionSize", "256B");
+    co.set("tuplex.scheduler.multiJob", "true");
+    co.set("tuplex.scheduler.jobMemoryQuota", "16KB");
+    Context c(co);
+    auto backend = dynamic_cast<LocalBackend*>(c.backend());
+    ASSERT_TRUE(backend);
+    // executors are shared with earlier contexts
+    auto numEvictionsBefore = backend->numQuotaEvictions();
+
+    const int N = 20000;
+    std::vector<Row> numbers, words;
+    for(int i = 0; i < N; ++i) {
+        numbers.push_back(Row(i));
+        words.push_back(Row("w" + std::to_string(i)));
+    }
+
+    // datasets are defined upfront, only the actions run concurrently
+    auto& dsBatch = c.parallelize(numbers).map(UDF("lambda x: x * x"));
+    auto& dsInteractive = c.parallelize(words).map(UDF("lambda x: x.upper()"));
+
+    // both jobs start at the same time and have many tasks each, i.e. they overlap
+    std::atomic_int numReady(0);
+    auto startTogether = [&numReady]() {
+        numReady++;
+        while(numReady < 2)
+            std::this_thread::yield();
+        return std::chrono::steady_clock::now();
+    };
+    std::vector<Row> batch, interactive;
+    std::chrono::steady_clock::time_point batchStart, batchEnd, interactiveStart, interactiveEnd;
+    std::thread tBatch([&]() {
+        c.setJobWeight(1.0);
+        batchStart = startTogether();
+        batch = dsBatch.collectAsVector();
+        batchEnd = std::chrono::steady_clock::now();
+    });
+    std::thread tInteractive([&]() {
+        c.setJobWeight(4.0);
+        interactiveStart = startTogether();
+        interactive = dsInteractive.collectAsVector();
+        interactiveEnd = std::chrono::steady_clock::now();
+    });
+    tBatch.join();
+    tInteractive.join();
+    EXPECT_LT(batchStart, interactiveEnd);
+    EXPECT_LT(interactiveStart, batchEnd);
+
+    // each job holds more than its quota in output partitions, i.e. the executors evicted some of them
+    EXPECT_GT(backend->numQuotaEvictions(), numEvictionsBefore);
+
+    ASSERT_EQ(batch.size(), numbers.size());
+    ASSERT_EQ(interactive.size(), words.size());
+    for(int i = 0; i < N; ++i) {
+        EXPECT_EQ(batch[i].getInt(0), (int64_t)i * i);
+        EXPECT_EQ(interactive[i].getString(0), "W" + std::to_string(i));
+    }
+
+    EXPECT_THROW(c.setJobWeight(0.0), std::runtime_error);
+
+    // the results are consumed, the next job frees the drivers of both job threads
+    EXPECT_EQ(c.parallelize({Row(1)}).map(UDF("lambda x: x + 1")).collectAsVector().size(), 1u);
+    EXPECT_EQ(backend->numJobDrivers(), 0u);
+
+    python::lockGIL();
+    python::closeInterpreter();
+}
+
+TEST(Context, multiJobAggregates) {
+    using namespace tuplex;
+
+    python::initInterpreter();
+    python::unlockGIL();
+
+    // the partial aggregates belong to a stage, i.e. aggregates of jobs running at the same time don't mix
+    ContextOptions co = microTestOptions();
+    co.set("tuplex.executorCount", "4");
+    co.set("tuplex.partitionSize", "256B");
+    co.set("tuplex.scheduler.multiJob", "true");
+    Context c(co);
+
+    const int N = 10000;
+    std::vector<Row> numbers, pairs;
+    for(int i = 0; i < N; ++i) {
+        numbers.push_back(Row(i));
+        pairs.push_back(Row(i % 3, 1));
+    }
+
+    auto& dsSum = c.parallelize(numbers).aggregate(UDF("lambda a, b: a + b"), UDF("lambda a, x: a + x"), Row(0));
+    auto& dsCounts = c.parallelize(pairs, {"key", "one"})
+                      .aggregateByKey(UDF("lambda a, b: a + b"), UDF("lambda a, x: a + x[1]"), Row(0), {"key"});
+
+    std::vector<Row> sum, counts;
+    std::thread tSum([&]() { sum = dsSum.collectAsVector(); });
+    std::thread tCounts([&]() { counts = dsCounts.collectAsVector(); });
+    tSum.join();
+    tCounts.join();
+
+    ASSERT_EQ(sum.size(), 1u);
+    EXPECT_EQ(sum.front().getInt(0), (int64_t)N * (N - 1) / 2);
+    ASSERT_EQ(counts.size(), 3u);
+    std::map<int64_t, int64_t> countsByKey;
+    for(const auto& r : counts)
+        countsByKey[r.getInt(0)] = r.getInt(1);
+    EXPECT_EQ(countsByKey, (std::map<int64_t, int64_t>{{0, 3334}, {1, 3333}, {2, 3333}}));
+
+    python::lockGIL();
+    python::closeInterpreter();
+}
+
+TEST(Context, multiJobFairShares) {
+    using namespace tuplex;
+
+    // executors get split in proportion to the job weights
+    EXPECT_EQ(LocalBackend::fairShares(5, {1.0, 4.0}, {100, 100}), (std::vector<size_t>{1, 4}));
+    EXPECT_EQ(LocalBackend::fairShares(6, {1.0, 1.0, 1.0}, {100, 100, 100}), (std::vector<size_t>{2, 2, 2}));
+    // at least one executor for each job, even with a small weight
+    EXPECT_EQ(LocalBackend::fairShares(2, {0.1, 10.0}, {100, 100}), (std::vector<size_t>{1, 1}));
+    // a job with fewer tasks than its share leaves the remaining executors to the others
+    EXPECT_EQ(LocalBackend::fairShares(6, {1.0, 4.0}, {100, 2}), (std::vector<size_t>{4, 2}));
+    // executors nobody needs still get spread, so drained queues don't keep them idle
+    EXPECT_EQ(LocalBackend::fairShares(4, {1.0, 1.0}, {1, 1}), (std::vector<size_t>{2, 2}));
+    // ties are broken by round
+    EXPECT_EQ(LocalBackend::fairShares(1, {1.0, 1.0}, {10, 10}, 0), (std::vector<size_t>{1, 0}));
+    EXPECT_EQ(LocalBackend::fairShares(1, {1.0, 1.0}, {10, 10}, 1), (std::vector<size_t>{0, 1}));
+}
+
+TEST(Executor, jobQuotaKeepsLockedPartitions) {
+    using namespace tuplex;
+
+    // a job allocating past its quota must not evict partitions it still holds (the partition mutex is recursive)
+    auto dir = testTempDir();
+    {
+        Executor exec(memStringToSize("8MB"), memStringToSize("256KB"), memStringToSize("1MB"), memStringToSize("256KB"), URI(dir));
+        exec.setJobMemoryQuota(memStringToSize("512KB"));
+        Executor::setCurrentJob(7);
+
+        auto schema = Schema(Schema::MemoryLayout::ROW, python::Type::I64);
+        auto writeValue = [](Partition* p, int64_t value) {
+            auto ptr = reinterpret_cast<int64_t*>(p->lockWriteRaw());
+            ptr[0] = 1;
+            ptr[1] = value;
+            return ptr;
+        };
+
+        // held e.g. as the current output partition of a task
+        auto held = exec.allocWritablePartition(1000, schema, 100);
+        auto heldPtr = writeValue(held, 42);
+
+        auto other = exec.allocWritablePartition(1000, schema, 100);
+        writeValue(other, 43);
+        other->unlockWrite();
+        ASSERT_EQ(exec.usedMemory(), held->size() + other->size());
+
+        // quota exceeded => the job's unlocked partition goes, although the held one is less recently used
+        auto next = exec.allocWritablePartition(1000, schema, 100);
+        ASSERT_TRUE(next);
+        EXPECT_EQ(exec.usedMemory(), held->size() + next->size());
+        EXPECT_EQ(exec.numQuotaEvictions(), 1u);
+        EXPECT_EQ(heldPtr[1], 42);
+        EXPECT_EQ(reinterpret_cast<const int64_t*>(held->lockRaw())[1], 42);
+        held->unlock();
+        EXPECT_EQ(heldPtr, reinterpret_cast<const int64_t*>(held->lockRaw()));
+        held->unlock();
+
+        // only locked partitions of the job left => allocation goes past the quota instead of evicting them
+        writeValue(next, 44);
+        heldPtr = writeValue(held, 42);
+        auto last = exec.allocWritablePartition(1000, schema, 100);
+        ASSERT_TRUE(last);
+        EXPECT_EQ(exec.usedMemory(), held->size() + next->size() + last->size());
+        EXPECT_EQ(exec.numQuotaEvictions(), 1u);
+        EXPECT_EQ(heldPtr[1], 42);
+        held->unlockWrite();
+        next->unlockWrite();
+
+        // the evicted partition is restored on access
+        EXPECT_EQ(reinterpret_cast<const int64_t*>(other->lockRaw())[1], 43);
+        other->unlock();
+
+        for(auto p : {held, other, next, last})
+            p->invalidate();
+        Executor::setCurrentJob(-1);
+    }
+    boost::filesystem::remove_all(dir);
+}
+
+TEST(Executor, evictionKeepsLockedPartitions) {
+    using namespace tuplex;
+
+    // executor memory runs out while the allocating thread holds its least recently used partition
+    auto dir = testTempDir();
+    {
+        Executor exec(memStringToSize("768KB"), memStringToSize("256KB"), memStringToSize("1MB"), memStringToSize("256KB"), URI(dir));
+        auto schema = Schema(Schema::MemoryLayout::ROW, python::Type::I64);
+        auto writeValue = [](Partition* p, int64_t value) {
+            auto ptr = reinterpret_cast<int64_t*>(p->lockWriteRaw());
+            ptr[0] = 1;
+            ptr[1] = value;
+            return ptr;
+        };
+
+        auto held = exec.allocWritablePartition(1000, schema, 100);
+        auto heldPtr = writeValue(held, 42);
+        auto other = exec.allocWritablePartition(1000, schema, 100);
+        writeValue(other, 43);
+        other->unlockWrite();
+        auto recent = exec.allocWritablePartition(1000, schema, 100);
+        writeValue(recent, 44);
+
+        // memory is full => the only unlocked partition goes
+        auto next = exec.allocWritablePartition(1000, schema, 100);
+        ASSERT_TRUE(next);
+        EXPECT_EQ(exec.usedMemory(), held->size() + recent->size() + next->size());
+        EXPECT_EQ(heldPtr[1], 42);
+        held->unlockWrite();
+        recent->unlockWrite();
+
+        // the evicted partition is restored on access, evicting an unlocked one in turn
+        EXPECT_EQ(reinterpret_cast<const int64_t*>(other->lockRaw())[1], 43);
+        other->unlock();
+        EXPECT_EQ(reinterpret_cast<const int64_t*>(held->lockRaw())[1], 42);
+        held->unlock();
+
+        for(auto p : {held, other, recent, next})
+            p->invalidate();
+    }
+    boost::filesystem::remove_all(dir);
+}
+
 TEST(ResultSet, EmptyResultSetI) {
     using namespace tuplex;
 
@@ -10,6 +10,7 @@
 
 #include "gtest/gtest.h"
 #include "TestUtils.h"
+#include <algorithm>
 #include <fstream>
 #include <Context.h>
 #include <DataSet.h>
@@ -382,4 +383,152 @@ TEST_F(DataFrameTest, FolderOutput) {
     // load file from disk
     auto content = fileToString(URI("output/part0.csv"));
     EXPECT_EQ(content, "A,B\n11,20\n11,40\n");
-}
\ No newline at end of file
+}
+
+TEST_F(DataFrameTest, StreamedFolderOutput) {
+    // tasks write their part files directly, resolved rows go to parts after them
+    using namespace tuplex;
+    auto co = microTestOptions();
+    co.set("tuplex.streamFileOutput", "true");
+    Context c(co);
+
+    c.parallelize({Row(10, 20), Row(0, 30), Row(10, 40)})
+     .map(UDF("lambda a, b: {'A' : b // a, 'B' : b}"))
+     .resolve(ExceptionCode::ZERODIVISIONERROR, UDF("lambda a, b: {'A' : -1, 'B' : b}"))
+     .tocsv(URI("streamed_output"));
+
+    ASSERT_TRUE(URI("streamed_output/part0.csv").exists());
+
+    // concatenate all parts in order
+    std::string content;
+    std::string lastPart;
+    for(int i = 0; URI("streamed_output/part" + std::to_string(i) + ".csv").exists(); ++i) {
+        lastPart = fileToString(URI("streamed_output/part" + std::to_string(i) + ".csv"));
+        content += lastPart;
+    }
+
+    // each part carries the header, hence check the rows only. The resolved row is not in input order but in the
+    // part written after the streamed ones.
+    EXPECT_NE(content.find("2,20\n"), std::string::npos);
+    EXPECT_NE(content.find("4,40\n"), std::string::npos);
+    EXPECT_LT(content.find("2,20\n"), content.find("4,40\n"));
+    EXPECT_GT(content.find("-1,30\n"), content.find("4,40\n"));
+    EXPECT_EQ(lastPart, "A,B\n-1,30\n");
+}
+
+TEST_F(DataFrameTest, StreamedFolderOutputNumParts) {
+    // a number of output files needs the whole output, i.e. output is collected in memory and split into parts
+    using namespace tuplex;
+    auto co = microTestOptions();
+    co.set("tuplex.streamFileOutput", "true");
+    Context c(co);
+
+    std::vector<Row> rows;
+    std::string expected;
+    for(int i = 0; i < 1000; ++i) {
+        rows.push_back(Row(i));
+        expected += std::to_string(i + 1) + "\n";
+    }
+    c.parallelize(rows)
+     .map(UDF("lambda x: {'A' : x + 1}"))
+     .tofile(FileFormat::OUTFMT_CSV, URI("streamed_output_numparts"), UDF(""), 3, 0, defaultCSVOutputOptions());
+
+    EXPECT_TRUE(URI("streamed_output_numparts/part0.csv").exists());
+    EXPECT_TRUE(URI("streamed_output_numparts/part2.csv").exists());
+    EXPECT_FALSE(URI("streamed_output_numparts/part3.csv").exists());
+
+    // rows are in order over all parts
+    std::string content;
+    for(int i = 0; i < 3; ++i) {
+        auto part = fileToString(URI("streamed_output_numparts/part" + std::to_string(i) + ".csv"));
+        auto headerEnd = part.find('\n');
+        content += headerEnd == std::string::npos ? part : part.substr(headerEnd + 1);
+    }
+    EXPECT_EQ(content, expected);
+}
+
+TEST_F(DataFrameTest, StreamedFolderOutputSplitSize) {
+    // parts do not exceed the split size (partitions of 256B are not split)
+    using namespace tuplex;
+    auto co = microTestOptions();
+    co.set("tuplex.streamFileOutput", "true");
+    Context c(co);
+
+    std::vector<Row> rows;
+    for(int i = 0; i < 1000; ++i)
+        rows.push_back(Row(i));
+    c.parallelize(rows)
+     .map(UDF("lambda x: {'A' : x + 1}"))
+     .tofile(FileFormat::OUTFMT_CSV, URI("streamed_output_splitsize"), UDF(""), 0, 1024, defaultCSVOutputOptions());
+
+    int numParts = 0;
+    size_t numLines = 0;
+    for(; URI("streamed_output_splitsize/part" + std::to_string(numParts) + ".csv").exists(); ++numParts) {
+        auto part = fileToString(URI("streamed_output_splitsize/part" + std::to_string(numParts) + ".csv"));
+        EXPECT_LE(part.size(), 1024u);
+        numLines += std::count(part.begin(), part.end(), '\n') - 1; // header
+    }
+    EXPECT_GT(numParts, 1);
+    EXPECT_EQ(numLines, 1000u);
+}
+
+TEST_F(DataFrameTest, StreamedFolderOutputWithoutResolve) {
+    // no exceptions, i.e. all rows are in the streamed part files
+    using namespace tuplex;
+    auto co = microTestOptions();
+    co.set("tuplex.streamFileOutput", "true");
+    Context c(co);
+
+    std::vector<Row> rows;
+    for(int i = 0; i < 100; ++i)
+        rows.push_back(Row(i, i * 10));
+    c.parallelize(rows)
+     .map(UDF("lambda a, b: {'A' : a + 1, 'B' : b}"))
+     .tocsv(URI("streamed_output_noresolve"));
+
+    ASSERT_TRUE(URI("streamed_output_noresolve/part0.csv").exists());
+
+    std::string content;
+    for(int i = 0; URI("streamed_output_noresolve/part" + std::to_string(i) + ".csv").exists(); ++i)
+        content += fileToString(URI("streamed_output_noresolve/part" + std::to_string(i) + ".csv"));
+    for(int i = 0; i < 100; ++i)
+        EXPECT_NE(content.find(std::to_string(i + 1) + "," + std::to_string(i * 10) + "\n"), std::string::npos);
+}
+
+TEST_F(DataFrameTest, SharedScanRunAll) {
+    // two deferred actions on the same csv pipeline, the csv file is only scanned once
+    using namespace tuplex;
+    using namespace std;
+
+    URI uri("shared_scan.csv");
+    stringToFile(uri, "a,b\n1,10\n2,20\n3,30\n4,40\n");
+    Context c(microTestOptions());
+
+    auto& ds = c.csv(uri.toPath()).map(UDF("lambda a, b: (a * 2, b + 1)"));
+    auto& first = ds.filter(UDF("lambda x: x[0] > 4")).deferTake();
+    auto& second = ds.filter(UDF("lambda x: x[0] <= 4")).deferTocsv(URI("shared_scan_output"));
+    auto scansBefore = c.metrics().getFileScanCount();
+    auto results = c.runAll({&first, &second});
+    EXPECT_EQ(c.metrics().getFileScanCount() - scansBefore, 1);
+
+    // executed one after another, each action scans the file
+    scansBefore = c.metrics().getFileScanCount();
+    ds.filter(UDF("lambda x: x[0] > 4")).collectAsVector();
+    ds.filter(UDF("lambda x: x[0] <= 4")).collectAsVector();
+    EXPECT_EQ(c.metrics().getFileScanCount() - scansBefore, 2);
+
+    ASSERT_EQ(results.size(), 2);
+    ASSERT_TRUE(results[0]);
+    vector<Row> v;
+    while(results[0]->hasNextRow())
+        v.push_back(results[0]->getNextRow());
+    ASSERT_EQ(v.size(), 2);
+    EXPECT_EQ(v[0].toPythonString(), "(6,31)");
+    EXPECT_EQ(v[1].toPythonString(), "(8,41)");
+
+    ASSERT_TRUE(URI("shared_scan_output/part0.csv").exists());
+    auto content = fileToString(URI("shared_scan_output/part0.csv"));
+    EXPECT_NE(content.find("2,11\n"), std::string::npos);
+    EXPECT_NE(content.find("4,21\n"), std::string::npos);
+    EXPECT_EQ(content.find("6,31\n"), std::string::npos);
+}
@@ -0,0 +1,107 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <gtest/gtest.h>
+#include <physical/ExceptionCounts.h>
+#include <set>
+#include <thread>
+
+using namespace tuplex;
+
+TEST(ExceptionCounts, IndexCoversAllCodes) {
+    ExceptionCountIndex index({7, 3, 12});
+
+    std::vector<ExceptionCode> codes{ExceptionCode::SUCCESS, ExceptionCode::NORMALCASEVIOLATION,
+                                     ExceptionCode::BADPARSE_STRING_INPUT, ExceptionCode::ZERODIVISIONERROR,
+                                     ExceptionCode::KEYERROR, ExceptionCode::RE_ERROR};
+    std::set<int64_t> slots;
+    for(auto opID : {3, 7, 12})
+        for(auto ec : codes) {
+            auto slot = index.slot(opID, ec);
+            ASSERT_GE(slot, 0);
+            EXPECT_LT(static_cast<size_t>(slot), index.size());
+            EXPECT_EQ(index.key(slot), std::make_tuple((int64_t)opID, ec));
+            slots.insert(slot);
+        }
+    EXPECT_EQ(slots.size(), 3 * codes.size());
+
+    // unknown operator or code
+    EXPECT_EQ(index.slot(4, ExceptionCode::ZERODIVISIONERROR), -1);
+    EXPECT_EQ(index.slot(3, ExceptionCode::UNKNOWN), -1);
+}
+
+TEST(ExceptionCounts, MergeTaskCounts) {
+    auto index = std::make_shared<ExceptionCountIndex>(std::vector<int64_t>{1, 2});
+
+    ExceptionCounts a(index), b(index);
+    EXPECT_TRUE(a.empty());
+    a.inc(1, ExceptionCode::ZERODIVISIONERROR);
+    a.inc(1, ExceptionCode::ZERODIVISIONERROR);
+    b.inc(1, ExceptionCode::ZERODIVISIONERROR);
+    b.inc(2, ExceptionCode::VALUEERROR);
+    b.inc(42, ExceptionCode::TYPEERROR); // not in index
+    EXPECT_FALSE(a.empty());
+
+    // accumulator without index adopts the one of the tasks
+    ExceptionCounts total;
+    total.add(a);
+    total.add(b);
+    auto m = total.toMap();
+    EXPECT_EQ(m.size(), 3u);
+    EXPECT_EQ(m[std::make_tuple(1, ExceptionCode::ZERODIVISIONERROR)], 3u);
+    EXPECT_EQ(m[std::make_tuple(2, ExceptionCode::VALUEERROR)], 1u);
+    EXPECT_EQ(m[std::make_tuple(42, ExceptionCode::TYPEERROR)], 1u);
+
+    // the first task merged has pairs outside of the index, the index still gets adopted
+    ExceptionCounts totalOverflowFirst;
+    totalOverflowFirst.add(b);
+    EXPECT_EQ(totalOverflowFirst.index(), index);
+    totalOverflowFirst.add(a);
+    EXPECT_EQ(totalOverflowFirst.toMap(), total.toMap());
+
+    // counts of another stage
+    auto otherIndex = std::make_shared<ExceptionCountIndex>(std::vector<int64_t>{2, 5});
+    ExceptionCounts c(otherIndex);
+    c.inc(5, ExceptionCode::INDEXERROR, 4);
+    total.add(c);
+    m = total.toMap();
+    EXPECT_EQ(m.size(), 4u);
+    EXPECT_EQ(m[std::make_tuple(5, ExceptionCode::INDEXERROR)], 4u);
+}
+
+TEST(ExceptionCounts, ConcurrentAdd) {
+    auto index = std::make_shared<ExceptionCountIndex>(std::vector<int64_t>{1, 2});
+    ConcurrentExceptionCounts live(index);
+
+    const size_t numThreads = 8;
+    const size_t numTasks = 100;
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < numThreads; ++t)
+        threads.emplace_back([&]() {
+            for(size_t i = 0; i < numTasks; ++i) {
+                ExceptionCounts counts(index);
+                counts.inc(1, ExceptionCode::ZERODIVISIONERROR);
+                counts.inc(2, ExceptionCode::KEYERROR, 2);
+                counts.inc(3, ExceptionCode::TYPEERROR); // not in index
+                live.add(counts);
+            }
+        });
+    for(auto& t : threads)
+        t.join();
+
+    auto m = live.snapshot();
+    EXPECT_EQ(m.size(), 3u);
+    EXPECT_EQ(m[std::make_tuple(1, ExceptionCode::ZERODIVISIONERROR)], numThreads * numTasks);
+    EXPECT_EQ(m[std::make_tuple(2, ExceptionCode::KEYERROR)], 2 * numThreads * numTasks);
+    EXPECT_EQ(m[std::make_tuple(3, ExceptionCode::TYPEERROR)], numThreads * numTasks);
+
+    live.reset();
+    EXPECT_TRUE(live.snapshot().empty());
+}
@@ -0,0 +1,54 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <gtest/gtest.h>
+#include <physical/HeavyHitterSketch.h>
+
+using namespace tuplex;
+
+TEST(HeavyHitterSketch, ExactBelowCapacity) {
+    HeavyHitterSketch sketch(4);
+    sketch.add("a");
+    sketch.add("b", 3);
+    sketch.add("a");
+
+    EXPECT_EQ(sketch.total(), 5);
+    EXPECT_EQ(sketch.estimate("a"), 2);
+    EXPECT_EQ(sketch.estimate("b"), 3);
+    EXPECT_EQ(sketch.estimate("c"), 0);
+
+    auto hh = sketch.heavyHitters(2);
+    ASSERT_EQ(hh.size(), 2);
+    EXPECT_EQ(hh[0].key, "b");
+    EXPECT_EQ(hh[1].key, "a");
+    EXPECT_EQ(hh[1].error, 0);
+}
+
+TEST(HeavyHitterSketch, FindsSkewedKey) {
+    // 30% of the stream is one key, the rest are distinct keys => more than the sketch can hold
+    HeavyHitterSketch sketch(16);
+    size_t hotCount = 0;
+    for(int i = 0; i < 10000; ++i) {
+        if(i % 10 < 3) {
+            sketch.add("hot");
+            hotCount++;
+        } else
+            sketch.add("key" + std::to_string(i));
+    }
+
+    auto hh = sketch.heavyHitters();
+    ASSERT_FALSE(hh.empty());
+    EXPECT_EQ(hh.front().key, "hot");
+
+    // estimate is an upper bound, off by at most the error
+    EXPECT_GE(hh.front().count, hotCount);
+    EXPECT_LE(hh.front().count - hh.front().error, hotCount);
+    EXPECT_LE(hh.front().error, sketch.total() / 16);
+}
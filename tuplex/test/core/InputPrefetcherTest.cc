@@ -0,0 +1,101 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include "TestUtils.h"
+#include <ee/local/InputPrefetcher.h>
+#include <VirtualFileSystem.h>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace tuplex;
+
+class InputPrefetcherTest : public ::testing::Test {
+protected:
+    std::string dir;
+    std::string path;
+    std::string content;
+
+    void SetUp() override {
+        dir = testTempDir();
+        path = dir + "/input.txt";
+        for(int i = 0; i < 10000; ++i)
+            content += std::to_string(i) + "\n";
+        stringToFile(URI(path), content);
+    }
+
+    void TearDown() override {
+        boost::filesystem::remove_all(dir);
+    }
+
+    static std::string readAll(VirtualFile* file, size_t offset, size_t length) {
+        std::string s(length, '\0');
+        file->seek(offset);
+        size_t pos = 0;
+        while(pos < length && !file->eof()) {
+            size_t bytesRead = 0;
+            file->read(&s[pos], std::min((size_t)100, length - pos), &bytesRead);
+            pos += bytesRead;
+        }
+        s.resize(pos);
+        return s;
+    }
+};
+
+TEST_F(InputPrefetcherTest, RangesWithinBudget) {
+    // budget fits ~2 ranges, i.e. IO threads need to wait for tasks to release loaded ranges
+    size_t rangeSize = 4096;
+    InputPrefetcher prefetcher(2, 2 * rangeSize);
+    std::vector<size_t> ids;
+    for(size_t offset = 0; offset < content.size(); offset += rangeSize)
+        ids.push_back(prefetcher.add(URI(path), content.size(), offset, rangeSize));
+    prefetcher.start();
+
+    // ranges are claimed in order, i.e. once any bytes are loaded the first range is loading or loaded
+    while(prefetcher.bytesLoaded() == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    size_t offset = 0;
+    for(auto id : ids) {
+        auto file = prefetcher.acquire(id);
+        if(file) {
+            // reads beyond the loaded range fall back to the file
+            EXPECT_EQ(readAll(file.get(), offset, rangeSize + 100), content.substr(offset, rangeSize + 100));
+        }
+        offset += rangeSize;
+    }
+    EXPECT_EQ(prefetcher.numHits() + prefetcher.numMisses(), ids.size());
+    EXPECT_GT(prefetcher.numHits(), 0u);
+}
+
+TEST_F(InputPrefetcherTest, RangeLargerThanBudget) {
+    InputPrefetcher prefetcher(1, 1024);
+    auto id = prefetcher.add(URI(path), content.size(), 0, content.size());
+    prefetcher.start();
+    // never loaded, task reads the file itself
+    EXPECT_FALSE(prefetcher.acquire(id));
+    EXPECT_EQ(prefetcher.numMisses(), 1u);
+}
+
+TEST_F(InputPrefetcherTest, FileOutlivesPrefetcher) {
+    std::unique_ptr<VirtualFile> file;
+    {
+        InputPrefetcher prefetcher(1, content.size());
+        auto id = prefetcher.add(URI(path), content.size(), 0, content.size());
+        prefetcher.start();
+        while(prefetcher.bytesLoaded() == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        file = prefetcher.acquire(id);
+    }
+    // buffer releases its memory on destruction, prefetcher is gone by now
+    ASSERT_TRUE(file);
+    EXPECT_EQ(readAll(file.get(), 0, 100), content.substr(0, 100));
+    file.reset();
+}
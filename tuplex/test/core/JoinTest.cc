@@ -10,6 +10,7 @@
 
 #include <Context.h>
 #include "TestUtils.h"
+#include <algorithm>
 
 
 // following tests should work when integer keys are supported (postponed)
@@ -278,6 +279,85 @@ TEST_F(JoinTest, InnerJoinTwoTimes) {
     EXPECT_EQ(res2[1].toPythonString(), "('JFK','New York','ATL','Atlanta',5)");
 }
 
+TEST_F(JoinTest, ConcurrentStages) {
+    // build sides of both joins are independent stages => run them at the same time, result must not change
+    using namespace tuplex;
+    using namespace std;
+    auto opt = microTestOptions();
+    opt.set("tuplex.optimizer.filterPushdown", "false"); // no filter pushdown so codegen works properly!
+    opt.set("tuplex.concurrentStages", "true");
+
+    // without executors, stages must run one after another on the driver
+    for(auto executorCount : {"4", "0"}) {
+        opt.set("tuplex.executorCount", executorCount);
+        Context c(opt);
+
+        auto& ds = c.parallelize({Row("ATL", "FRA", 20), Row("FRA", "BOS", 10), Row("JFK", "ATL", 5), Row("BOS", "JFK", 0)},
+                                 vector<string>{"Origin", "Dest", "Delay"});
+        auto& dsOrigin = c.parallelize({Row("ATL", "Atlanta"), Row("FRA", "Frankfurt"), Row("JFK", "New York")}, vector<string>{"Code", "Name"});
+        auto& dsDest = c.parallelize({Row("ATL", "Atlanta"), Row("FRA", "Frankfurt"),
+                                      Row("JFK", "New York"), Row("LAX", "Los Angeles")}, vector<string>{"Code", "Name"});
+
+        auto res = ds.join(dsOrigin, string("Origin"), string("Code"), string(""), string(""), string("Origin"))
+                .join(dsDest, string("Dest"), string("Code"), string(""), string(""), string("Dest"))
+                .selectColumns(std::vector<std::string>{"Origin", "OriginName", "Dest", "DestName", "Delay"}).collectAsVector();
+        ASSERT_EQ(res.size(), 2);
+        EXPECT_EQ(res[0].toPythonString(), "('ATL','Atlanta','FRA','Frankfurt',20)");
+        EXPECT_EQ(res[1].toPythonString(), "('JFK','New York','ATL','Atlanta',5)");
+
+        // the stages start together, each takes at least the time to compile it. Hence with executors
+        // some of them overlap, without none do.
+        vector<pair<double, double>> stageTimes;
+        for(int stageNo = 0; stageNo < 64; ++stageNo) {
+            auto times = c.metrics().getStageTimes(stageNo);
+            if(times.second > 0.0)
+                stageTimes.push_back(times);
+        }
+        ASSERT_GE(stageTimes.size(), 3u);
+        bool overlap = false;
+        for(unsigned i = 0; i < stageTimes.size(); ++i)
+            for(unsigned j = i + 1; j < stageTimes.size(); ++j)
+                overlap |= stageTimes[i].first < stageTimes[j].second && stageTimes[j].first < stageTimes[i].second;
+        EXPECT_EQ(overlap, string(executorCount) != "0");
+    }
+}
+
+TEST_F(JoinTest, HeavyHitterKey) {
+    // one key holds most rows of the build side, its bucket is kept outside of the hash table but the result must not change
+    using namespace tuplex;
+    using namespace std;
+    auto opt = microTestOptions();
+    opt.set("tuplex.optimizer.filterPushdown", "false"); // no filter pushdown so codegen works properly!
+    opt.set("tuplex.hotKeyRows", "2");
+    Context c(opt);
+
+    vector<Row> rows;
+    for(int i = 0; i < 10; ++i)
+        rows.push_back(Row("hot", i));
+    rows.push_back(Row("cold", 100));
+
+    auto& dsA = c.parallelize({Row("hot", "A"), Row("cold", "B"), Row("none", "C")}, vector<string>{"key", "name"});
+    auto& dsB = c.parallelize(rows, vector<string>{"k", "value"});
+
+    auto res = dsA.join(dsB, string("key"), string("k")).collectAsVector();
+    ASSERT_EQ(res.size(), 11);
+    vector<string> hot;
+    int numCold = 0;
+    for(const auto& r : res) {
+        if(r.getString(1) == "cold") {
+            EXPECT_EQ(r.toPythonString(), "('B','cold',100)");
+            numCold++;
+        } else {
+            EXPECT_EQ(r.getString(1), "hot");
+            hot.push_back(r.toPythonString());
+        }
+    }
+    EXPECT_EQ(numCold, 1);
+    std::sort(hot.begin(), hot.end());
+    for(int i = 0; i < 10; ++i)
+        EXPECT_EQ(hot[i], "('A','hot'," + std::to_string(i) + ")");
+}
+
 // write extensive tests for joins here
 TEST_F(JoinTest, SimpleLeftJoin) {
     // join two times...
@@ -12,6 +12,9 @@
 #include <Context.h>
 #include <PythonHelpers.h>
 #include <logical/FilterOperator.h>
+#include <logical/TakeOperator.h>
+#include <logical/WithColumnOperator.h>
+#include <logical/LogicalPlan.h>
 #include <FilterBreakdownVisitor.h>
 #include <parser/Parser.h>
 #include <TypeAnnotatorVisitor.h>
@@ -37,6 +40,107 @@ TEST_F(LogicalOptimizerTest, SimpleFilterPushdown) {
     // pushed result should be parallelize.filter.ignore.withcolumn.collectAsVector
 }
 
+TEST_F(LogicalOptimizerTest, CostBasedReordering) {
+    using namespace tuplex;
+
+    auto conf = microTestOptions();
+    conf.set("tuplex.optimizer.filterPushdown", "false");
+    conf.set("tuplex.optimizer.operatorReordering", "true");
+    Context c(conf);
+
+    std::vector<Row> rows;
+    for(int i = 0; i < 100; ++i)
+        rows.push_back(Row(i));
+
+    // both filters are independent of the new column, hence get evaluated before the withColumn. The last filter
+    // is cheaper and more selective than the first one, hence moves to the front
+    std::string expensiveFilter = "lambda x: sum(range(200)) > 0 and x['a'] % 2 == 0";
+    std::string selectiveFilter = "lambda x: x['a'] < 10";
+    auto& ds = c.parallelize(rows, {"a"})
+            .withColumn("b", UDF("lambda x: str(x['a']) * 10"))
+            .filter(UDF(expensiveFilter))
+            .filter(UDF(selectiveFilter));
+
+    auto take = new TakeOperator(ds.getOperator(), -1);
+    LogicalPlan plan(take);
+    plan.optimize(c);
+    auto op = plan.getAction()->parent();
+    // parallelize -> selective filter -> expensive filter -> withColumn
+    ASSERT_EQ(op->type(), LogicalOperatorType::WITHCOLUMN);
+    ASSERT_EQ(op->parent()->type(), LogicalOperatorType::FILTER);
+    ASSERT_EQ(op->parent()->parent()->type(), LogicalOperatorType::FILTER);
+    EXPECT_EQ(dynamic_cast<FilterOperator*>(op->parent())->getUDF().getCode(), expensiveFilter);
+    EXPECT_EQ(dynamic_cast<FilterOperator*>(op->parent()->parent())->getUDF().getCode(), selectiveFilter);
+    EXPECT_EQ(op->parent()->parent()->parent()->type(), LogicalOperatorType::PARALLELIZE);
+    ds.getOperator()->setChildren({});
+    take->setParents({});
+    delete take;
+
+    auto v = ds.collectAsVector();
+    ASSERT_EQ(v.size(), 5);
+    for(int i = 0; i < 5; ++i) {
+        EXPECT_EQ(v[i].getInt(0), 2 * i);
+        EXPECT_EQ(v[i].getString(1).size(), 10 * std::to_string(2 * i).size());
+    }
+}
+
+TEST_F(LogicalOptimizerTest, DeadColumnElimination) {
+    using namespace tuplex;
+
+    Context c(microTestOptions());
+
+    std::vector<Row> rows;
+    for(int i = 0; i < 100; ++i)
+        rows.push_back(Row(i, i + 1, "x" + std::to_string(i)));
+
+    // column c is dropped by the select, hence its operator gets removed
+    auto& ds = c.parallelize(rows, {"a", "b", "s"})
+            .withColumn("c", UDF("lambda x: x['a'] * 3 + x['b']"))
+            .withColumn("d", UDF("lambda x: x['a'] + x['b']"))
+            .selectColumns(std::vector<std::string>{"a", "d"});
+    ASSERT_EQ(ds.getOperator()->parent()->getOutputSchema().getRowType().parameters().size(), 5);
+
+    auto take = new TakeOperator(ds.getOperator(), -1);
+    LogicalPlan plan(take);
+    plan.optimize(c);
+    auto op = plan.getAction()->parent()->parent();
+    ASSERT_EQ(op->type(), LogicalOperatorType::WITHCOLUMN);
+    EXPECT_EQ(op->columns(), std::vector<std::string>({"a", "b", "s", "d"}));
+    EXPECT_EQ(op->getOutputSchema().getRowType().parameters().size(), 4);
+    EXPECT_EQ(dynamic_cast<WithColumnOperator*>(op)->getColumnIndex(), 3);
+    EXPECT_EQ(op->parent()->type(), LogicalOperatorType::PARALLELIZE);
+    ds.getOperator()->setChildren({});
+    take->setParents({});
+    delete take;
+
+    auto v = ds.collectAsVector();
+    ASSERT_EQ(v.size(), 100);
+    for(int i = 0; i < 100; ++i) {
+        EXPECT_EQ(v[i].getInt(0), i);
+        EXPECT_EQ(v[i].getInt(1), 2 * i + 1);
+    }
+}
+
+TEST_F(LogicalOptimizerTest, DeadColumnRaising) {
+    using namespace tuplex;
+
+    // dead columns which may raise are still computed. Rows for which they raise become exceptions as without the select
+    Context c(microTestOptions());
+
+    std::vector<Row> rows;
+    for(int i = 0; i < 100; ++i)
+        rows.push_back(Row(i, i % 10));
+
+    auto v = c.parallelize(rows, {"a", "b"})
+            .withColumn("c", UDF("lambda x: x['a'] // x['b']"))
+            .selectColumns(std::vector<std::string>{"a"})
+            .collectAsVector();
+    ASSERT_EQ(v.size(), 90);
+    EXPECT_EQ(c.metrics().totalExceptionCount, 10);
+    for(const auto& r : v)
+        EXPECT_NE(r.getInt(0) % 10, 0);
+}
+
 TEST_F(LogicalOptimizerTest, FilterBreakdownVisitor) {
     using namespace tuplex;
 
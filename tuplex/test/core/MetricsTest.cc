@@ -11,6 +11,12 @@
 #include "TestUtils.h"
 #include <Context.h>
 #include <PythonHelpers.h>
+#include <ee/local/LocalBackend.h>
+#include <RuntimeMetrics.h>
+#include <physical/ExceptionCounts.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
 #include "gtest/gtest.h"
 
 class MetricsTest : public PyTest {};
@@ -61,4 +67,153 @@ TEST_F(MetricsTest, JsonStats) {
     auto json_str = c.metrics().to_json();
 
     EXPECT_NO_THROW(nlohmann::json::parse(json_str));
-}
\ No newline at end of file
+}
+
+TEST_F(MetricsTest, AheadOfTimeCompilation) {
+    // a join has a build and a probe stage => probe stage gets compiled while build stage executes
+    using namespace tuplex;
+    using namespace std;
+
+    auto opt = microTestOptions();
+    opt.set("tuplex.optimizer.filterPushdown", "false");
+    opt.set("tuplex.aotCompileThreads", "2");
+    Context c(opt);
+
+    auto& dsA = c.parallelize({Row("a", 1), Row("b", 2), Row("c", 3)}, vector<string>{"key", "valA"});
+    auto& dsB = c.parallelize({Row("b", 20), Row("c", 30), Row("d", 40)}, vector<string>{"key", "valB"});
+
+    auto res = dsA.join(dsB, string("key"), string("key")).collectAsVector();
+    ASSERT_EQ(res.size(), 2);
+
+    // the background thread claims the probe stage before the build stage runs, the executing thread waits for it
+    auto metrics = c.getMetrics();
+    EXPECT_GT(metrics->getLLVMCompilationTime(), 0.0);
+    EXPECT_GT(metrics->getAheadOfTimeStageCount(), 0u);
+}
+
+// plain blocking HTTP GET against localhost, returns the whole response incl. header
+static std::string httpGet(uint16_t port, const std::string& path) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT_GE(fd, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return "";
+    }
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    send(fd, request.data(), request.size(), 0);
+    std::string response;
+    char buf[4096];
+    ssize_t n = 0;
+    while((n = recv(fd, buf, sizeof(buf), 0)) > 0)
+        response.append(buf, n);
+    close(fd);
+    return response;
+}
+
+// value of an unlabeled metric in Prometheus text format, -1 if not found
+static double metricValue(const std::string& text, const std::string& name) {
+    auto pos = text.find("\n" + name + " ");
+    if(pos == std::string::npos)
+        return -1.0;
+    return std::stod(text.substr(pos + name.size() + 2));
+}
+
+TEST_F(MetricsTest, PrometheusEndpoint) {
+    using namespace tuplex;
+    using namespace std;
+
+    auto opt = microTestOptions();
+    opt.set("tuplex.metrics.enable", "true");
+    opt.set("tuplex.metrics.port", "0");
+    Context c(opt);
+
+    // the context's endpoint listens on a port picked by the OS
+    auto backend = dynamic_cast<LocalBackend*>(c.backend());
+    ASSERT_TRUE(backend);
+    auto port = backend->metricsPort();
+    ASSERT_GT(port, 0);
+
+    // metrics are process wide, i.e. other tests may have contributed. Hence compare before & after
+    auto before = httpGet(port, "/metrics");
+    ASSERT_EQ(before.find("HTTP/1.1 200 OK"), 0u);
+
+    auto res = c.parallelize({Row(1), Row(0), Row(2)}).map(UDF("lambda x: 10 // x")).collectAsVector();
+    ASSERT_EQ(res.size(), 2u);
+
+    auto response = httpGet(port, "/metrics");
+    EXPECT_EQ(response.find("HTTP/1.1 200 OK"), 0u);
+    EXPECT_NE(response.find("text/plain; version=0.0.4"), string::npos);
+    EXPECT_NE(response.find("# TYPE tuplex_tasks_completed_total counter"), string::npos);
+    EXPECT_NE(response.find("tuplex_task_duration_seconds_bucket{type=\"transform\",le=\"+Inf\"}"), string::npos);
+    EXPECT_NE(response.find("tuplex_executor_memory_used_bytes"), string::npos);
+
+    EXPECT_GT(metricValue(response, "tuplex_tasks_completed_total{type=\"transform\"}"),
+              metricValue(before, "tuplex_tasks_completed_total{type=\"transform\"}"));
+    EXPECT_EQ(metricValue(response, "tuplex_jobs_completed_total"), metricValue(before, "tuplex_jobs_completed_total") + 1.0);
+    EXPECT_GT(metricValue(response, "tuplex_stage_compile_seconds_count"),
+              metricValue(before, "tuplex_stage_compile_seconds_count"));
+    EXPECT_GE(metricValue(response, "tuplex_exceptions_total{exception=\"ZeroDivisionError\"}"),
+              std::max(metricValue(before, "tuplex_exceptions_total{exception=\"ZeroDivisionError\"}"), 0.0) + 1.0);
+    // all tasks of the job are done
+    EXPECT_EQ(metricValue(response, "tuplex_tasks_running"), metricValue(before, "tuplex_tasks_running"));
+    EXPECT_EQ(metricValue(response, "tuplex_tasks_queued"), metricValue(before, "tuplex_tasks_queued"));
+
+    EXPECT_EQ(httpGet(port, "/").find("HTTP/1.1 404"), 0u);
+}
+
+TEST_F(MetricsTest, SharedExecutorsCountedOnce) {
+    using namespace tuplex;
+
+    auto opt = microTestOptions();
+    opt.set("tuplex.metrics.enable", "true");
+    opt.set("tuplex.metrics.port", "0");
+
+    Context c1(opt);
+    auto& metrics = RuntimeMetrics::instance();
+    auto text = metrics.toPrometheusText();
+    auto numExecutors = metricValue(text, "tuplex_executors");
+    auto executorMemory = metricValue(text, "tuplex_executor_memory_bytes");
+    auto driverMemory = metricValue(text, "tuplex_driver_memory_used_bytes");
+    EXPECT_GE(numExecutors, 1.0);
+    EXPECT_GT(executorMemory, 0.0);
+
+    // the second context gets the executors and the driver of the first one from the local engine
+    {
+        Context c2(opt);
+        text = metrics.toPrometheusText();
+        EXPECT_EQ(metricValue(text, "tuplex_executors"), numExecutors);
+        EXPECT_EQ(metricValue(text, "tuplex_executor_memory_bytes"), executorMemory);
+        EXPECT_EQ(metricValue(text, "tuplex_driver_memory_used_bytes"), driverMemory);
+    }
+
+    // gauges of the first context are still there
+    text = metrics.toPrometheusText();
+    EXPECT_EQ(metricValue(text, "tuplex_executors"), numExecutors);
+    EXPECT_EQ(metricValue(text, "tuplex_executor_memory_bytes"), executorMemory);
+}
+
+TEST_F(MetricsTest, RunningStageExceptions) {
+    using namespace tuplex;
+
+    auto index = std::make_shared<ExceptionCountIndex>(std::vector<int64_t>{1, 2});
+    ConcurrentExceptionCounts live(index);
+    ExceptionCounts counts(index);
+    counts.inc(1, ExceptionCode::ZERODIVISIONERROR, 2);
+    counts.inc(2, ExceptionCode::ZERODIVISIONERROR);
+    counts.inc(2, ExceptionCode::KEYERROR);
+    live.add(counts);
+
+    auto& metrics = RuntimeMetrics::instance();
+    metrics.addStageExceptionCounts(&live, &live);
+    auto text = metrics.toPrometheusText();
+    EXPECT_EQ(metricValue(text, "tuplex_running_stage_exceptions{exception=\"ZeroDivisionError\"}"), 3.0);
+    EXPECT_EQ(metricValue(text, "tuplex_running_stage_exceptions{exception=\"KeyError\"}"), 1.0);
+
+    metrics.removeStageExceptionCounts(&live);
+    text = metrics.toPrometheusText();
+    EXPECT_EQ(metricValue(text, "tuplex_running_stage_exceptions{exception=\"ZeroDivisionError\"}"), -1.0);
+}
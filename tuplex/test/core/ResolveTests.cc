@@ -11,6 +11,7 @@
 #include <Context.h>
 #include "TestUtils.h"
 #include <random>
+#include <sstream>
 
 using namespace tuplex;
 
@@ -1209,4 +1210,88 @@ TEST_F(Resolve, UpcastResolverType) {
     EXPECT_EQ(v[1].toPythonString(), Row(7.0).toPythonString());
 }
 
+// integer column where row 300 holds a string. The sample only covers the first 100 rows, hence neither the normal
+// nor the general case can decode that row.
+static std::string writeUndecodableCSV() {
+    std::stringstream ss;
+    ss<<"a\n";
+    for(int i = 1; i <= 400; ++i)
+        ss<<(i == 300 ? std::string("abc") : std::to_string(i))<<"\n";
+    auto path = testTempDir() + "/undecodable.csv";
+    stringToFile(URI(path), ss.str());
+    return path;
+}
+
+static size_t totalExceptionCount(const tuplex::JobMetrics& metrics) {
+    size_t total = 0;
+    for(const auto& keyval : metrics.getExceptionCounts())
+        total += keyval.second;
+    return total;
+}
+
+TEST_F(Resolve, UndecodableRowReachesInterpreter) {
+    using namespace tuplex;
+
+    auto opt = microTestOptions();
+    opt.set("tuplex.resolveWithInterpreterOnly", "false");
+    opt.set("tuplex.csv.maxDetectionRows", "100");
+    // a compiled general-case path exists with null-value optimization, but can't decode the string either
+    opt.set("tuplex.optimizer.nullValueOptimization", "true");
+    Context c(opt);
+    auto path = writeUndecodableCSV();
+
+    auto res = c.csv(path).map(UDF("lambda x: str(x['a'] * 2)")).collectAsVector();
+    ASSERT_EQ(res.size(), 400u);
+    EXPECT_EQ(res[298].getString(0), "598");
+    EXPECT_EQ(res[299].getString(0), "abcabc");
+    EXPECT_EQ(res[300].getString(0), "602");
+    EXPECT_EQ(totalExceptionCount(c.metrics()), 0u);
+    EXPECT_EQ(c.metrics().getSlowPathCompiledRowCount(), 0u);
+    EXPECT_EQ(c.metrics().getSlowPathInterpreterRowCount(), 1u);
+}
+
+TEST_F(Resolve, NullRowsResolvedInCompiledGeneralCase) {
+    using namespace tuplex;
+
+    // every 20th value is missing, i.e. the normal case is i64 and the general case Option[i64]
+    std::stringstream ss;
+    ss<<"a\n";
+    for(int i = 1; i <= 400; ++i)
+        ss<<(i % 20 == 0 ? std::string("") : std::to_string(i))<<"\n";
+    auto path = testTempDir() + "/nulls.csv";
+    stringToFile(URI(path), ss.str());
+
+    auto opt = microTestOptions();
+    opt.set("tuplex.resolveWithInterpreterOnly", "false");
+    opt.set("tuplex.optimizer.nullValueOptimization", "true");
+    Context c(opt);
+
+    // no resolvers, the rows violating the normal case run in the compiled general-case path
+    auto res = c.csv(path).map(UDF("lambda x: -1 if x['a'] is None else x['a'] * 2")).collectAsVector();
+    ASSERT_EQ(res.size(), 400u);
+    for(int i = 1; i <= 400; ++i)
+        EXPECT_EQ(res[i - 1].getInt(0), i % 20 == 0 ? -1 : 2 * i);
+    EXPECT_EQ(totalExceptionCount(c.metrics()), 0u);
+    EXPECT_EQ(c.metrics().getSlowPathCompiledRowCount(), 20u);
+    EXPECT_EQ(c.metrics().getSlowPathInterpreterRowCount(), 0u);
+}
+
+TEST_F(Resolve, RowFailingInBothPathsCountedOnce) {
+    using namespace tuplex;
+
+    auto opt = microTestOptions();
+    opt.set("tuplex.resolveWithInterpreterOnly", "false");
+    opt.set("tuplex.csv.maxDetectionRows", "100");
+    opt.set("tuplex.optimizer.nullValueOptimization", "true");
+    Context c(opt);
+    auto path = writeUndecodableCSV();
+
+    // the compiled general case can't decode the string, the interpreter raises a TypeError for it
+    auto res = c.csv(path).map(UDF("lambda x: 1000 // x['a']")).collectAsVector();
+    ASSERT_EQ(res.size(), 399u);
+    EXPECT_EQ(res[298].getInt(0), 1000 / 299);
+    EXPECT_EQ(res[299].getInt(0), 1000 / 301);
+    EXPECT_EQ(totalExceptionCount(c.metrics()), 1u);
+}
+
 // @TODO: nested
\ No newline at end of file
@@ -0,0 +1,68 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include "gtest/gtest.h"
+#include <Context.h>
+#include <physical/TransformTask.h>
+#include "TestUtils.h"
+
+class TakeTest : public PyTest {};
+
+TEST_F(TakeTest, StopsEarly) {
+    using namespace tuplex;
+
+    // many small partitions, tasks after the first few stop once the limit is reached
+    Context c(microTestOptions());
+
+    std::vector<Row> numbers;
+    for(int i = 0; i < 5000; ++i)
+        numbers.push_back(Row(i));
+
+    auto res = c.parallelize(numbers).filter(UDF("lambda x: x % 3 == 0")).map(UDF("lambda x: x + 1")).takeAsVector(20);
+    ASSERT_EQ(res.size(), 20u);
+    for(int i = 0; i < 20; ++i)
+        EXPECT_EQ(res[i].getInt(0), 3 * i + 1);
+
+    EXPECT_GT(c.metrics().getTasksStoppedEarly(), 0u);
+}
+
+TEST_F(TakeTest, ExceptionsBeforeLimit) {
+    using namespace tuplex;
+
+    // the first tasks only produce exception rows, these must not count against the limit
+    Context c(microTestOptions());
+
+    std::vector<Row> numbers;
+    for(int i = 0; i < 1000; ++i)
+        numbers.push_back(Row(0));
+    for(int i = 1; i <= 4000; ++i)
+        numbers.push_back(Row(i));
+
+    auto res = c.parallelize(numbers).map(UDF("lambda x: 100000 // x")).takeAsVector(20);
+    ASSERT_EQ(res.size(), 20u);
+    for(int i = 0; i < 20; ++i)
+        EXPECT_EQ(res[i].getInt(0), 100000 / (i + 1));
+}
+
+TEST(TaskOutputLimit, CutoffAfterPrecedingTasksDone) {
+    using namespace tuplex;
+
+    TaskOutputLimit limit(10);
+    limit.taskDone(2, 100);
+    // tasks 0 and 1 are not done yet, hence the output of task 2 might still be needed
+    EXPECT_FALSE(limit.exceeded(2));
+    EXPECT_FALSE(limit.exceeded(3));
+    limit.taskDone(0, 4);
+    EXPECT_FALSE(limit.exceeded(3));
+    limit.taskDone(1, 7);
+    EXPECT_FALSE(limit.exceeded(1));
+    EXPECT_TRUE(limit.exceeded(2));
+    EXPECT_TRUE(limit.exceeded(3));
+}
@@ -37,6 +37,7 @@
 #endif
 
 #include <boost/filesystem/operations.hpp>
+#include <unistd.h>
 
 // helper functions to faciliate test writing
 extern tuplex::Row execRow(const tuplex::Row& input, tuplex::UDF udf=tuplex::UDF("lambda x: x"));
@@ -118,6 +119,18 @@ inline void compareStrArrays(std::vector<std::string> arr_A, std::vector<std::st
     ASSERT_EQ(arr_A.size(), arr_B.size());
 }
 
+/*!
+ * scratch directory of the currently running test, created if missing. Unique per test and process, i.e. concurrently
+ * running test binaries do not collide. Callers remove it when done.
+ */
+inline std::string testTempDir() {
+    auto info = ::testing::UnitTest::GetInstance()->current_test_info();
+    auto name = std::string("tuplex_") + info->test_case_name() + "_" + info->name() + "_" + std::to_string(getpid());
+    auto dir = boost::filesystem::temp_directory_path() / name;
+    boost::filesystem::create_directories(dir);
+    return dir.string();
+}
+
 // helper class to not have to write always the python interpreter startup stuff
 // need for these tests a running python interpreter, so spin it up
 class PyTest : public ::testing::Test {
@@ -58,4 +58,45 @@ TEST_F(TextParse, NULLValues) {
     EXPECT_EQ(res[4].toPythonString(), "('test',)");
     EXPECT_EQ(res[5].toPythonString(), "(None,)");
     EXPECT_EQ(res[6].toPythonString(), "('how is everything?',)");
-}
\ No newline at end of file
+}
+
+TEST_F(TextParse, SplitsAndLineEndings) {
+    // small split size forces many ranges per file, lines must neither be lost nor duplicated
+    auto opt = microTestOptions();
+    opt.set("tuplex.inputSplitSize", "256B");
+    Context c(opt);
+
+    std::stringstream ss;
+    int N = 1000;
+    for(int i = 0; i < N; ++i) {
+        ss<<"line"<<i;
+        ss<<(i % 3 == 0 ? "\r\n" : "\n");
+    }
+    stringToFile("test.txt", ss.str());
+
+    auto res = c.text("test.txt").collectAsVector();
+    ASSERT_EQ(res.size(), N);
+    for(int i = 0; i < N; ++i)
+        EXPECT_EQ(res[i].getString(0), "line" + std::to_string(i));
+}
+
+TEST_F(TextParse, AdaptiveSplits) {
+    // first wave uses the small split size, rest of the file is split based on the measured throughput (>= 1MB)
+    auto opt = microTestOptions();
+    opt.set("tuplex.inputSplitSize", "4KB");
+    opt.set("tuplex.adaptiveSplits", "true");
+    Context c(opt);
+
+    std::stringstream ss;
+    int N = 300000;
+    for(int i = 0; i < N; ++i)
+        ss<<"line"<<i<<"\n";
+    stringToFile("test.txt", ss.str());
+
+    auto res = c.text("test.txt").collectAsVector();
+    ASSERT_EQ(res.size(), N);
+    int numMismatches = 0;
+    for(int i = 0; i < N; ++i)
+        numMismatches += res[i].getString(0) != "line" + std::to_string(i);
+    EXPECT_EQ(numMismatches, 0);
+}
@@ -364,6 +364,45 @@ TEST(UDF, ModuleCall) {
     EXPECT_EQ(desc, "(Option[matchobject])");
 }
 
+TEST(UDF, Memoization) {
+    using namespace tuplex;
+
+    UDF::clearMemo();
+    auto schema = Schema(Schema::MemoryLayout::ROW, python::Type::propagateToTupleType(python::Type::I64));
+
+    // formatting differs, AST is the same
+    UDF udf1("lambda x: x * 2 + 1");
+    UDF udf2("lambda x:   x*2   + 1");
+    UDF udf3("lambda x: x * 2 + 2");
+    ASSERT_TRUE(udf1.hintInputSchema(schema));
+    EXPECT_EQ(UDF::memoSize(), 1);
+    ASSERT_TRUE(udf2.hintInputSchema(schema));
+    EXPECT_EQ(UDF::memoSize(), 1);
+    EXPECT_EQ(udf2.getInputSchema().getRowType(), udf1.getInputSchema().getRowType());
+    EXPECT_EQ(udf2.getOutputSchema().getRowType(), udf1.getOutputSchema().getRowType());
+    ASSERT_TRUE(udf3.hintInputSchema(schema));
+    EXPECT_EQ(UDF::memoSize(), 2);
+
+    // a different input type is typed separately
+    UDF udf4("lambda x: x * 2 + 1");
+    ASSERT_TRUE(udf4.hintInputSchema(Schema(Schema::MemoryLayout::ROW,
+                                            python::Type::propagateToTupleType(python::Type::F64))));
+    EXPECT_EQ(UDF::memoSize(), 3);
+    EXPECT_EQ(udf4.getOutputSchema().getRowType().desc(), "(f64)");
+
+    // generated function is reused within the module
+    codegen::LLVMEnvironment env;
+    auto cf1 = udf1.compile(env, true, true);
+    auto cf2 = udf2.compile(env, true, true);
+    auto cf3 = udf3.compile(env, true, true);
+    ASSERT_TRUE(cf1.function);
+    EXPECT_EQ(cf1.function, cf2.function);
+    EXPECT_NE(cf1.function, cf3.function);
+
+    UDF::clearMemo();
+    EXPECT_EQ(UDF::memoSize(), 0);
+}
+
 // this test fails, postponed for now. There're more important things todo.
 //TEST(UDF, RewriteSlice) {
 //    UDF udf5("lambda x: x[1:3:0]");
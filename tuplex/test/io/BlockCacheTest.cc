@@ -0,0 +1,95 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <gtest/gtest.h>
+#include <BlockCache.h>
+#include <boost/filesystem.hpp>
+#include <unistd.h>
+
+using namespace tuplex;
+
+class BlockCacheTest : public ::testing::Test {
+protected:
+    std::string root;
+
+    void SetUp() override {
+        root = "/tmp/tuplex_blockcache_test_" + std::to_string(getpid()) + "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        boost::filesystem::remove_all(root);
+    }
+
+    void TearDown() override {
+        boost::filesystem::remove_all(root);
+    }
+};
+
+TEST_F(BlockCacheTest, PutGet) {
+    BlockCache cache(root, 1024, 64);
+    auto key = BlockCache::objectKey(URI("s3://bucket/data.csv"), "\"etag1\"", 100);
+
+    std::vector<uint8_t> block(64), out(64);
+    for(int i = 0; i < 64; ++i)
+        block[i] = i;
+
+    EXPECT_FALSE(cache.get(key, 0, out.data(), 64));
+    cache.put(key, 0, block.data(), 64);
+    cache.put(key, 1, block.data(), 36); // last block is shorter
+    EXPECT_EQ(cache.size(), 100);
+    ASSERT_TRUE(cache.get(key, 0, out.data(), 64));
+    EXPECT_EQ(out, block);
+    EXPECT_TRUE(cache.get(key, 1, out.data(), 36));
+
+    // length mismatch is a miss
+    EXPECT_FALSE(cache.get(key, 1, out.data(), 64));
+
+    // changed object (different etag) does not hit
+    auto otherKey = BlockCache::objectKey(URI("s3://bucket/data.csv"), "\"etag2\"", 100);
+    EXPECT_NE(key, otherKey);
+    EXPECT_FALSE(cache.get(otherKey, 0, out.data(), 64));
+
+    EXPECT_EQ(cache.hits(), 2);
+    EXPECT_EQ(cache.misses(), 3);
+}
+
+TEST_F(BlockCacheTest, LRUEviction) {
+    BlockCache cache(root, 256, 64);
+    auto key = BlockCache::objectKey(URI("s3://bucket/data.csv"), "\"etag\"", 64 * 8);
+    std::vector<uint8_t> block(64, 42), out(64);
+
+    for(int i = 0; i < 4; ++i)
+        cache.put(key, i, block.data(), 64);
+    EXPECT_EQ(cache.size(), 256);
+
+    // touch block 0, then adding a block evicts block 1
+    EXPECT_TRUE(cache.get(key, 0, out.data(), 64));
+    cache.put(key, 4, block.data(), 64);
+    EXPECT_EQ(cache.size(), 256);
+    EXPECT_TRUE(cache.get(key, 0, out.data(), 64));
+    EXPECT_FALSE(cache.get(key, 1, out.data(), 64));
+    EXPECT_TRUE(cache.get(key, 4, out.data(), 64));
+}
+
+TEST_F(BlockCacheTest, PersistsAcrossInstances) {
+    auto key = BlockCache::objectKey(URI("s3://bucket/data.csv"), "\"etag\"", 128);
+    std::vector<uint8_t> block(64, 7), out(64);
+    {
+        BlockCache cache(root, 1024, 64);
+        cache.put(key, 0, block.data(), 64);
+        cache.put(key, 1, block.data(), 64);
+    }
+
+    BlockCache cache(root, 1024, 64);
+    EXPECT_EQ(cache.size(), 128);
+    ASSERT_TRUE(cache.get(key, 1, out.data(), 64));
+    EXPECT_EQ(out, block);
+
+    // smaller capacity evicts on startup
+    BlockCache smallCache(root, 64, 64);
+    EXPECT_EQ(smallCache.size(), 64);
+}
@@ -0,0 +1,123 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <gtest/gtest.h>
+#include <VirtualFileSystem.h>
+#include <CopyEngine.h>
+#include <Logger.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <boost/filesystem.hpp>
+#include <thread>
+#include <unistd.h>
+
+using namespace tuplex;
+
+class CopyTest : public ::testing::Test {
+protected:
+    std::string root;
+    std::stringstream logStream;
+
+    void SetUp() override {
+        // log to stdout and a stream instead of the default log file in the working directory
+        Logger::init({std::make_shared<spdlog::sinks::ansicolor_stdout_sink_mt>(),
+                      std::make_shared<spdlog::sinks::ostream_sink_mt>(logStream)});
+
+        root = "/tmp/tuplex_copy_test_" + std::to_string(getpid()) + "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        boost::filesystem::remove_all(root);
+        boost::filesystem::create_directories(root + "/src/sub");
+    }
+
+    void TearDown() override {
+        VirtualFileSystem::setCopyParallelism(std::max(std::thread::hardware_concurrency(), 4u));
+        boost::filesystem::remove_all(root);
+        Logger::instance().reset();
+    }
+};
+
+TEST_F(CopyTest, ManyFiles) {
+    for(int i = 0; i < 50; ++i)
+        stringToFile(URI(root + "/src/sub/part" + std::to_string(i) + ".csv"), "file " + std::to_string(i));
+    stringToFile(URI(root + "/src/empty.csv"), "");
+
+    VirtualFileSystem::setCopyParallelism(8);
+    size_t numCallbacks = 0;
+    CopyProgress last{0, 0, 0, 0, 0.0};
+    auto rc = VirtualFileSystem::copy(root + "/src/*", URI(root + "/dest/"), [&](const CopyProgress& p) {
+        numCallbacks++;
+        last = p;
+    });
+    ASSERT_EQ(rc, VirtualFileSystemStatus::VFS_OK);
+
+    for(int i = 0; i < 50; ++i)
+        EXPECT_EQ(fileToString(URI(root + "/dest/sub/part" + std::to_string(i) + ".csv")), "file " + std::to_string(i));
+    EXPECT_TRUE(URI(root + "/dest/empty.csv").exists());
+
+    // final progress is always reported
+    EXPECT_GE(numCallbacks, 1);
+    EXPECT_EQ(last.filesCopied, 51);
+    EXPECT_EQ(last.filesTotal, 51);
+    EXPECT_EQ(last.bytesCopied, last.bytesTotal);
+}
+
+TEST_F(CopyTest, ChunkedLargeFile) {
+    // not a multiple of the chunk size
+    std::string content;
+    for(int i = 0; i < 100000; ++i)
+        content += std::to_string(i) + "\n";
+    stringToFile(URI(root + "/src/large.txt"), content);
+
+    CopyEngine engine(4, 4096);
+    engine.add(URI(root + "/src/large.txt"), URI(root + "/dest/large.txt"));
+    std::vector<URI> targets;
+    ASSERT_EQ(engine.run(targets), VirtualFileSystemStatus::VFS_OK);
+    ASSERT_EQ(targets.size(), 1);
+    EXPECT_EQ(fileToString(targets.front()), content);
+
+    auto p = engine.progress();
+    EXPECT_EQ(p.filesCopied, 1);
+    EXPECT_EQ(p.bytesCopied, content.size());
+}
+
+TEST_F(CopyTest, MissingSource) {
+    stringToFile(URI(root + "/src/a.csv"), "a");
+    CopyEngine engine(2);
+    engine.add(URI(root + "/src/a.csv"), URI(root + "/dest/a.csv"));
+    engine.add(URI(root + "/src/missing.csv"), URI(root + "/dest/missing.csv"));
+    std::vector<URI> targets;
+    EXPECT_NE(engine.run(targets), VirtualFileSystemStatus::VFS_OK);
+    EXPECT_NE(logStream.str().find("missing.csv"), std::string::npos);
+}
+
+TEST_F(CopyTest, SameFile) {
+    stringToFile(URI(root + "/src/a.csv"), "source content");
+    ASSERT_EQ(0, link((root + "/src/a.csv").c_str(), (root + "/src/hardlink.csv").c_str()));
+    ASSERT_EQ(0, symlink((root + "/src/a.csv").c_str(), (root + "/src/symlink.csv").c_str()));
+
+    // a hard link has its own path, copying onto it is refused
+    {
+        CopyEngine engine(2);
+        engine.add(URI(root + "/src/a.csv"), URI(root + "/src/hardlink.csv"));
+        std::vector<URI> targets;
+        EXPECT_NE(engine.run(targets), VirtualFileSystemStatus::VFS_OK);
+        EXPECT_TRUE(targets.empty());
+        EXPECT_EQ(fileToString(URI(root + "/src/a.csv")), "source content");
+        EXPECT_NE(logStream.str().find("both refer to the same file"), std::string::npos);
+    }
+
+    // symlinks and differently spelled paths resolve to the source, i.e. nothing to copy
+    for(const auto& target : {root + "/src/symlink.csv", root + "/src/sub/../a.csv"}) {
+        CopyEngine engine(2);
+        engine.add(URI(root + "/src/a.csv"), URI(target));
+        std::vector<URI> targets;
+        EXPECT_EQ(engine.run(targets), VirtualFileSystemStatus::VFS_OK);
+        EXPECT_TRUE(targets.empty());
+        EXPECT_EQ(fileToString(URI(root + "/src/a.csv")), "source content");
+    }
+}
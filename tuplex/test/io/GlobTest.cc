@@ -0,0 +1,137 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <gtest/gtest.h>
+#include <VirtualFileSystem.h>
+#include <GlobExpander.h>
+#include <PosixFileSystemImpl.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <unistd.h>
+
+using namespace tuplex;
+
+class GlobTest : public ::testing::Test {
+protected:
+    std::string root;
+
+    void SetUp() override {
+        root = "/tmp/tuplex_glob_test_" + std::to_string(getpid()) + "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        boost::filesystem::remove_all(root);
+
+        // date partitioned layout year=*/month=*/*.csv
+        for(int year = 2019; year <= 2020; ++year)
+            for(int month = 1; month <= 3; ++month) {
+                auto dir = root + "/year=" + std::to_string(year) + "/month=0" + std::to_string(month);
+                boost::filesystem::create_directories(dir);
+                stringToFile(URI(dir + "/part0.csv"), std::to_string(year) + std::to_string(month));
+                stringToFile(URI(dir + "/readme.txt"), "txt");
+                stringToFile(URI(dir + "/.hidden.csv"), "hidden");
+            }
+    }
+
+    void TearDown() override {
+        VirtualFileSystem::setListingCacheTTL(0);
+        boost::filesystem::remove_all(root);
+    }
+};
+
+TEST_F(GlobTest, PartitionedLayout) {
+    auto uris = VirtualFileSystem::globAll(root + "/year=*/month=0[12]/*.csv");
+    ASSERT_EQ(uris.size(), 4);
+    EXPECT_EQ(uris[0].toPath(), root + "/year=2019/month=01/part0.csv");
+    EXPECT_EQ(uris[1].toPath(), root + "/year=2019/month=02/part0.csv");
+    EXPECT_EQ(uris[2].toPath(), root + "/year=2020/month=01/part0.csv");
+    EXPECT_EQ(uris[3].toPath(), root + "/year=2020/month=02/part0.csv");
+
+    // literal component after wildcard, comma separated patterns
+    uris = VirtualFileSystem::globAll(root + "/year=2019/*/part0.csv, " + root + "/year=2020/month=03/*");
+    ASSERT_EQ(uris.size(), 5);
+    EXPECT_EQ(uris[3].toPath(), root + "/year=2020/month=03/part0.csv");
+    EXPECT_EQ(uris[4].toPath(), root + "/year=2020/month=03/readme.txt");
+
+    // no match
+    EXPECT_TRUE(VirtualFileSystem::globAll(root + "/year=2021/*/*.csv").empty());
+
+    // walk delivers sizes from listing
+    size_t totalSize = 0;
+    size_t numFiles = 0;
+    EXPECT_TRUE(VirtualFileSystem::walkPattern(URI(root + "/year=*/month=*/*.csv"), [&](void*, const URI& uri, size_t size) {
+        totalSize += size;
+        numFiles++;
+        return true;
+    }));
+    EXPECT_EQ(numFiles, 6);
+    EXPECT_EQ(totalSize, 6 * 5);
+}
+
+TEST_F(GlobTest, ParallelismAndListingCount) {
+    PosixFileSystemImpl fs;
+    auto pattern = "file://" + root + "/year=*/month=*/*.csv";
+
+    GlobExpander sequential(&fs, 1);
+    auto expected = sequential.expand(pattern);
+    EXPECT_EQ(expected.size(), 6);
+    // root + 2 years + 6 months
+    EXPECT_EQ(sequential.numListings(), 9);
+
+    GlobExpander parallel(&fs, 8);
+    auto res = parallel.expand(pattern);
+    ASSERT_EQ(res.size(), expected.size());
+    for(unsigned i = 0; i < res.size(); ++i) {
+        EXPECT_EQ(res[i].uri, expected[i].uri);
+        EXPECT_EQ(res[i].size, expected[i].size);
+        EXPECT_FALSE(res[i].isDirectory);
+    }
+    EXPECT_EQ(parallel.numListings(), 9);
+}
+
+TEST_F(GlobTest, ListingCache) {
+    PosixFileSystemImpl fs;
+    auto pattern = "file://" + root + "/year=*/month=01/*.csv";
+
+    ListingCache cache(60.0);
+    GlobExpander expander(&fs, 4, &cache);
+    EXPECT_EQ(expander.expand(pattern).size(), 2);
+    EXPECT_EQ(expander.numListings(), 3);
+    EXPECT_EQ(expander.expand(pattern).size(), 2);
+    EXPECT_EQ(expander.numListings(), 0);
+    EXPECT_EQ(cache.hits(), 3);
+
+    // changes outside the VFS are not visible until invalidated
+    std::ofstream ofs(root + "/year=2019/month=01/part1.csv");
+    ofs << "test";
+    ofs.close();
+    EXPECT_EQ(expander.expand(pattern).size(), 2);
+    cache.invalidate(URI(root + "/year=2019/month=01/part1.csv"));
+    EXPECT_EQ(expander.expand(pattern).size(), 3);
+    EXPECT_EQ(expander.numListings(), 2);
+
+    // VFS writes invalidate the global cache
+    VirtualFileSystem::setListingCacheTTL(60.0);
+    EXPECT_EQ(VirtualFileSystem::globAll(root + "/year=*/month=01/*.csv").size(), 3);
+    stringToFile(URI(root + "/year=2020/month=01/part1.csv"), "test");
+    EXPECT_EQ(VirtualFileSystem::globAll(root + "/year=*/month=01/*.csv").size(), 4);
+}
+
+TEST_F(GlobTest, TildeExpansion) {
+    // patterns with wildcards starting with ~ are expanded relative to the home directory, like glob(GLOB_TILDE)
+    auto oldHome = getenv("HOME") ? std::string(getenv("HOME")) : std::string();
+    setenv("HOME", root.c_str(), 1);
+    auto uris = VirtualFileSystem::globAll("~/year=2019/month=0[12]/*.csv");
+    if(oldHome.empty())
+        unsetenv("HOME");
+    else
+        setenv("HOME", oldHome.c_str(), 1);
+
+    ASSERT_EQ(uris.size(), 2);
+    EXPECT_EQ(uris[0].toPath(), root + "/year=2019/month=01/part0.csv");
+    EXPECT_EQ(uris[1].toPath(), root + "/year=2019/month=02/part0.csv");
+}
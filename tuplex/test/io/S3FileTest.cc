@@ -0,0 +1,325 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifdef BUILD_WITH_AWS
+#include <gtest/gtest.h>
+#include <S3FileSystemImpl.h>
+#include <BlockCache.h>
+#include <CopyEngine.h>
+#include <VirtualFileSystem.h>
+#include <aws/core/Aws.h>
+#include <algorithm>
+#include <cstdlib>
+#include <unistd.h>
+#include <boost/filesystem.hpp>
+#include "S3StandIn.h"
+
+using namespace tuplex;
+
+class S3FileTest : public ::testing::Test {
+protected:
+    std::unique_ptr<S3StandIn> s3;
+    std::unique_ptr<S3FileSystemImpl> fs;
+
+    void SetUp() override {
+        static bool sdkInitialized = false;
+        if(!sdkInitialized) {
+            // no instance metadata lookups, all requests go to the stand-in
+            setenv("AWS_EC2_METADATA_DISABLED", "true", 1);
+            Aws::SDKOptions options;
+            Aws::InitAPI(options);
+            sdkInitialized = true;
+        }
+        s3.reset(new S3StandIn());
+        fs.reset(new S3FileSystemImpl("test", "test", "", false, false, s3->endpoint()));
+    }
+
+    void TearDown() override {
+        fs.reset();
+        s3.reset();
+    }
+
+    // deterministic, non-repeating content so misplaced bytes are detected
+    static std::string testData(size_t size) {
+        std::string data(size, '\0');
+        uint32_t x = 42;
+        for(size_t i = 0; i < size; ++i) {
+            x = x * 1664525u + 1013904223u;
+            data[i] = static_cast<char>(x >> 24);
+        }
+        return data;
+    }
+
+    static std::string readBytes(VirtualFile* file, size_t n) {
+        std::string res(n, '\0');
+        size_t bytesRead = 0;
+        file->read(&res[0], n, &bytesRead);
+        res.resize(bytesRead);
+        return res;
+    }
+};
+
+TEST_F(S3FileTest, SequentialReadAhead) {
+    // 1MB requests, i.e. several chunks with read-ahead in flight
+    fs->setReadAhead(3, 1024 * 1024);
+    auto data = testData(5 * 1024 * 1024 + 12345);
+    s3->putObject("bucket", "data.csv", data);
+
+    auto file = fs->open_file(URI("s3://bucket/data.csv"), VirtualFileMode::VFS_READ);
+    ASSERT_TRUE(file);
+
+    // odd read size, so reads straddle chunk boundaries
+    std::string res;
+    while(!file->eof()) {
+        auto part = readBytes(file.get(), 100003);
+        if(part.empty())
+            break;
+        res += part;
+    }
+    EXPECT_EQ(file->size(), data.size());
+    ASSERT_EQ(res.size(), data.size());
+    EXPECT_TRUE(res == data);
+    EXPECT_GT(fs->numReadAheadRequests(), 0u);
+
+    // ranges cover the object exactly once
+    auto ranges = s3->getRanges();
+    std::sort(ranges.begin(), ranges.end());
+    size_t pos = 0;
+    for(const auto& r : ranges) {
+        EXPECT_EQ(r.first, pos);
+        pos = r.first + r.second;
+    }
+    EXPECT_EQ(pos, data.size());
+    EXPECT_EQ(s3->numGets(), ranges.size());
+}
+
+TEST_F(S3FileTest, Seek) {
+    fs->setReadAhead(2, 1024 * 1024);
+    auto data = testData(4 * 1024 * 1024 + 7);
+    s3->putObject("bucket", "data.csv", data);
+
+    auto file = fs->open_file(URI("s3://bucket/data.csv"), VirtualFileMode::VFS_READ);
+    ASSERT_TRUE(file);
+
+    // seek before the first request
+    file->seek(100);
+    EXPECT_EQ(readBytes(file.get(), 1000), data.substr(100, 1000));
+
+    // within the current chunk
+    file->seek(500);
+    EXPECT_EQ(readBytes(file.get(), 100), data.substr(1600, 100));
+
+    // far ahead, read-ahead starts over with a small request, i.e. this read spans several chunks
+    size_t target = 2 * 1024 * 1024 - 50000;
+    size_t n = 1500000;
+    file->seek(static_cast<int64_t>(target) - 1700);
+    EXPECT_TRUE(readBytes(file.get(), n) == data.substr(target, n));
+
+    // backwards, before the current chunk
+    file->seek(-static_cast<int64_t>(target + n - 10));
+    EXPECT_EQ(readBytes(file.get(), 5000), data.substr(10, 5000));
+
+    // beyond the end
+    file->seek(static_cast<int64_t>(data.size()));
+    EXPECT_TRUE(readBytes(file.get(), 100).empty());
+    EXPECT_TRUE(file->eof());
+}
+
+TEST_F(S3FileTest, MultipartUpload) {
+    fs->setUploadConcurrency(2);
+    // S3File uploads 32MB parts, i.e. three parts
+    auto data = testData(2 * 32 * 1024 * 1024 + 4321);
+
+    auto file = fs->open_file(URI("s3://bucket/out/part0.csv"), VirtualFileMode::VFS_WRITE);
+    ASSERT_TRUE(file);
+    for(size_t pos = 0; pos < data.size(); pos += 1000003)
+        file->write(data.data() + pos, std::min((size_t)1000003, data.size() - pos));
+    file->close();
+
+    EXPECT_EQ(s3->numPartUploads(), 3u);
+    EXPECT_EQ(s3->numOpenUploads(), 0u);
+    ASSERT_TRUE(s3->hasObject("bucket", "out/part0.csv"));
+    EXPECT_TRUE(s3->getObject("bucket", "out/part0.csv") == data);
+
+    // round trip through read path
+    auto in = fs->open_file(URI("s3://bucket/out/part0.csv"), VirtualFileMode::VFS_READ);
+    EXPECT_TRUE(readBytes(in.get(), data.size()) == data);
+}
+
+TEST_F(S3FileTest, MultipartUploadAbort) {
+    fs->setUploadConcurrency(2);
+    s3->failPart(2); // denied, i.e. not retried
+    auto data = testData(2 * 32 * 1024 * 1024 + 4321);
+
+    auto file = fs->open_file(URI("s3://bucket/out/part0.csv"), VirtualFileMode::VFS_WRITE);
+    ASSERT_TRUE(file);
+    EXPECT_THROW({
+        for(size_t pos = 0; pos < data.size(); pos += 1000003)
+            file->write(data.data() + pos, std::min((size_t)1000003, data.size() - pos));
+        file->close();
+    }, std::runtime_error);
+    file.reset(); // must not upload anything on destruction
+
+    EXPECT_EQ(s3->numAborts(), 1u);
+    EXPECT_EQ(s3->numOpenUploads(), 0u);
+    EXPECT_FALSE(s3->hasObject("bucket", "out/part0.csv"));
+}
+
+TEST_F(S3FileTest, BlockCacheCountsHeadSeparately) {
+    auto cacheDir = "/tmp/tuplex_s3file_test_" + std::to_string(getpid()) + "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    boost::filesystem::remove_all(cacheDir);
+    fs->setReadAhead(2, 1024 * 1024);
+    fs->setBlockCache(std::make_shared<BlockCache>(URI(cacheDir), 16 * 1024 * 1024, 1024 * 1024));
+    auto data = testData(3 * 1024 * 1024 + 99);
+    s3->putObject("bucket", "data.csv", data);
+
+    // first read fills the cache, second one is served from it
+    for(int i = 0; i < 2; ++i) {
+        auto file = fs->open_file(URI("s3://bucket/data.csv"), VirtualFileMode::VFS_READ);
+        ASSERT_TRUE(file);
+        EXPECT_TRUE(readBytes(file.get(), data.size()) == data);
+    }
+
+    // the etag lookup is a HEAD request, not a GET
+    EXPECT_EQ(s3->numHeads(), 2u);
+    EXPECT_EQ(fs->numHeads(), s3->numHeads());
+    EXPECT_EQ(fs->numGets(), s3->numGets());
+    boost::filesystem::remove_all(cacheDir);
+}
+TEST_F(S3FileTest, BlockCacheServesReadOnly) {
+    // samples are read via readOnly, they fill the cache with whole blocks which later reads are served from
+    auto cacheDir = "/tmp/tuplex_s3file_test_" + std::to_string(getpid()) + "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    boost::filesystem::remove_all(cacheDir);
+    fs->setReadAhead(0, 1024 * 1024);
+    fs->setBlockCache(std::make_shared<BlockCache>(URI(cacheDir), 16 * 1024 * 1024, 1024 * 1024));
+    auto data = testData(2 * 1024 * 1024 + 17);
+    s3->putObject("bucket", "data.csv", data);
+
+    for(int i = 0; i < 2; ++i) {
+        auto file = fs->open_file(URI("s3://bucket/data.csv"), VirtualFileMode::VFS_READ);
+        ASSERT_TRUE(file);
+        std::string sample(256 * 1024, '\0');
+        size_t bytesRead = 0;
+        ASSERT_EQ(file->readOnly(&sample[0], sample.size(), &bytesRead), VirtualFileSystemStatus::VFS_OK);
+        EXPECT_EQ(bytesRead, sample.size());
+        EXPECT_TRUE(sample == data.substr(0, sample.size()));
+    }
+    // the first sample requested the whole first block, the second one was served from the cache
+    ASSERT_EQ(s3->numGets(), 1u);
+    EXPECT_EQ(s3->getRanges().front(), std::make_pair((size_t)0, (size_t)1024 * 1024));
+
+    // a full read requests only the blocks not cached yet
+    auto file = fs->open_file(URI("s3://bucket/data.csv"), VirtualFileMode::VFS_READ);
+    ASSERT_TRUE(file);
+    EXPECT_TRUE(readBytes(file.get(), data.size()) == data);
+    auto ranges = s3->getRanges();
+    for(unsigned i = 1; i < ranges.size(); ++i)
+        EXPECT_GE(ranges[i].first, 1024u * 1024u);
+    boost::filesystem::remove_all(cacheDir);
+}
+
+TEST_F(S3FileTest, DownloadThroughBlockCache) {
+    // with a block cache, copying an object to local disk reads it through the cache
+    auto cacheDir = "/tmp/tuplex_s3file_test_" + std::to_string(getpid()) + "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    auto localDir = cacheDir + "_local";
+    boost::filesystem::remove_all(cacheDir);
+    boost::filesystem::remove_all(localDir);
+    auto impl = std::make_shared<S3FileSystemImpl>("test", "test", "", false, false, s3->endpoint());
+    ASSERT_EQ(VirtualFileSystem::registerFileSystem(impl, "s3://"), VirtualFileSystemStatus::VFS_OK);
+    VirtualFileSystem::enableBlockCache(URI(cacheDir), 16 * 1024 * 1024);
+    auto data = testData(3 * 1024 * 1024 + 5);
+    s3->putObject("bucket", "data.csv", data);
+
+    for(int i = 0; i < 2; ++i) {
+        CopyEngine engine(2);
+        auto target = URI(localDir + "/copy" + std::to_string(i) + ".csv");
+        engine.add(URI("s3://bucket/data.csv"), target);
+        std::vector<URI> targets;
+        ASSERT_EQ(engine.run(targets), VirtualFileSystemStatus::VFS_OK);
+        EXPECT_EQ(engine.progress().bytesCopied, data.size());
+
+        auto file = VirtualFileSystem::open_file(target, VirtualFileMode::VFS_READ);
+        ASSERT_TRUE(file);
+        EXPECT_TRUE(readBytes(file.get(), data.size() + 1) == data);
+    }
+    // blocks are stored in the background, hence only the first download surely went to S3
+    EXPECT_GT(impl->blockCache()->hits() + impl->blockCache()->misses(), 0u);
+
+    VirtualFileSystem::disableBlockCache();
+    boost::filesystem::remove_all(cacheDir);
+    boost::filesystem::remove_all(localDir);
+}
+TEST_F(S3FileTest, ListWithPrefixAndDelimiter) {
+    // a single level below the prefix, keys in subfolders are rolled up into common prefixes
+    s3->putObject("bucket", "data/", "");
+    s3->putObject("bucket", "data/a.csv", "abc");
+    s3->putObject("bucket", "data/b.csv", "defgh");
+    s3->putObject("bucket", "data/sub/c.csv", "ij");
+    s3->putObject("bucket", "data_other.csv", "k");
+    s3->putObject("bucket", "other/d.csv", "lmn");
+
+    IFileSystemImpl& impl = *fs;
+    std::vector<ListingEntry> entries;
+    ASSERT_EQ(impl.list(URI("s3://bucket/data"), &entries), VirtualFileSystemStatus::VFS_OK);
+    std::map<std::string, std::pair<size_t, bool>> listed;
+    for(const auto& e : entries)
+        listed[e.uri.toString()] = std::make_pair(e.size, e.isDirectory);
+
+    // the folder marker object is not listed
+    std::map<std::string, std::pair<size_t, bool>> expected{{"s3://bucket/data/a.csv", {3, false}},
+                                                           {"s3://bucket/data/b.csv", {5, false}},
+                                                           {"s3://bucket/data/sub/", {0, true}}};
+    EXPECT_EQ(listed, expected);
+    EXPECT_EQ(s3->numLists(), 1u);
+    EXPECT_EQ(fs->numLs(), 1u);
+}
+
+TEST_F(S3FileTest, ListPaginated) {
+    // listings larger than a page are continued, common prefixes count towards the page size as well
+    s3->setMaxKeys(2);
+    for(int i = 0; i < 5; ++i)
+        s3->putObject("bucket", "data/part" + std::to_string(i) + ".csv", std::string(i + 1, 'x'));
+    for(int i = 0; i < 2; ++i)
+        s3->putObject("bucket", "data/sub" + std::to_string(i) + "/part0.csv", "y");
+
+    IFileSystemImpl& impl = *fs;
+    std::vector<ListingEntry> entries;
+    ASSERT_EQ(impl.list(URI("s3://bucket/data/"), &entries), VirtualFileSystemStatus::VFS_OK);
+    ASSERT_EQ(entries.size(), 7u);
+    std::vector<std::string> files;
+    size_t numDirs = 0;
+    for(const auto& e : entries) {
+        if(e.isDirectory)
+            numDirs++;
+        else {
+            files.push_back(e.uri.toString());
+            EXPECT_EQ(e.size, files.size()); // partN.csv holds N + 1 bytes and comes N-th
+        }
+    }
+    EXPECT_EQ(numDirs, 2u);
+    EXPECT_EQ(files.front(), "s3://bucket/data/part0.csv");
+    EXPECT_EQ(files.back(), "s3://bucket/data/part4.csv");
+
+    // 7 entries in pages of 2
+    EXPECT_EQ(s3->numLists(), 4u);
+    EXPECT_EQ(fs->numLs(), 4u);
+
+    // pattern expansion lists level by level, each level paginated
+    auto before = s3->numLists();
+    auto uris = impl.glob("s3://bucket/data/*.csv");
+    std::vector<std::string> globbed;
+    for(const auto& uri : uris)
+        globbed.push_back(uri.toString());
+    std::sort(globbed.begin(), globbed.end());
+    EXPECT_EQ(globbed, files);
+    EXPECT_GT(s3->numLists() - before, 2u);
+}
+
+#endif
@@ -0,0 +1,527 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TUPLEX_S3STANDIN_H
+#define TUPLEX_S3STANDIN_H
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tuplex {
+
+    /*!
+     * in-process stand-in for S3 on 127.0.0.1, enough to test S3File without network access: objects can be read
+     * (incl. ranged GET/HEAD), put, uploaded in parts and listed (ListObjectsV2 with prefix, delimiter and
+     * pagination). Requests are path-style, i.e. /bucket/key, and are not
+     * authenticated. Connections are served concurrently, one thread per connection.
+     */
+    class S3StandIn {
+    public:
+        S3StandIn() : _fd(-1), _port(0), _done(false), _nextUploadID(0), _numGets(0), _numHeads(0),
+                      _numPartUploads(0), _numAborts(0), _numLists(0), _failingPart(0), _maxKeys(1000) {
+            _fd = socket(AF_INET, SOCK_STREAM, 0);
+            if(_fd < 0)
+                throw std::runtime_error("could not create socket for S3 stand-in");
+            sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+            socklen_t len = sizeof(addr);
+            if(bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(_fd, 64) != 0
+               || getsockname(_fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+                close(_fd);
+                throw std::runtime_error("could not bind S3 stand-in");
+            }
+            _port = ntohs(addr.sin_port);
+            _thread = std::thread(&S3StandIn::serve, this);
+        }
+
+        ~S3StandIn() {
+            _done = true;
+            if(_thread.joinable())
+                _thread.join();
+            std::vector<std::thread> connections;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                connections.swap(_connections);
+            }
+            for(auto& t : connections)
+                t.join();
+            close(_fd);
+        }
+
+        S3StandIn(const S3StandIn& other) = delete;
+        S3StandIn& operator = (const S3StandIn& other) = delete;
+
+        std::string endpoint() const { return "http://127.0.0.1:" + std::to_string(_port); }
+
+        void putObject(const std::string& bucket, const std::string& key, const std::string& data) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _objects["/" + bucket + "/" + key] = data;
+        }
+
+        bool hasObject(const std::string& bucket, const std::string& key) const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _objects.count("/" + bucket + "/" + key) > 0;
+        }
+
+        std::string getObject(const std::string& bucket, const std::string& key) const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _objects.find("/" + bucket + "/" + key);
+            return it != _objects.end() ? it->second : "";
+        }
+
+        //! uploads of this part number are denied (403, not retryable), 0 to disable
+        void failPart(int partNumber) { _failingPart = partNumber; }
+
+        //! maximum number of keys and common prefixes per list response, i.e. page size (S3 uses 1000)
+        void setMaxKeys(size_t maxKeys) { _maxKeys = maxKeys; }
+
+        //! ranges of GET requests, in order of arrival
+        std::vector<std::pair<size_t, size_t>> getRanges() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _getRanges;
+        }
+
+        size_t numGets() const { return _numGets; }
+        size_t numHeads() const { return _numHeads; }
+        size_t numPartUploads() const { return _numPartUploads; }
+        size_t numAborts() const { return _numAborts; }
+        size_t numLists() const { return _numLists; }
+
+        //! multipart uploads neither completed nor aborted
+        size_t numOpenUploads() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _uploads.size();
+        }
+
+    private:
+        struct Request {
+            std::string method;
+            std::string path;
+            std::map<std::string, std::string> query;
+            std::map<std::string, std::string> headers; //! lower case names
+            std::string body;
+        };
+
+        struct Response {
+            int status = 200;
+            std::string reason = "OK";
+            std::map<std::string, std::string> headers;
+            std::string body;
+        };
+
+        int _fd;
+        uint16_t _port;
+        std::atomic_bool _done;
+        std::thread _thread;
+
+        mutable std::mutex _mutex;
+        std::vector<std::thread> _connections;
+        std::map<std::string, std::string> _objects; //! /bucket/key -> data
+        std::map<std::string, std::map<int, std::string>> _uploads; //! upload id -> part number -> data
+        size_t _nextUploadID;
+        std::vector<std::pair<size_t, size_t>> _getRanges;
+        std::atomic<size_t> _numGets;
+        std::atomic<size_t> _numHeads;
+        std::atomic<size_t> _numPartUploads;
+        std::atomic<size_t> _numAborts;
+        std::atomic<size_t> _numLists;
+        std::atomic<int> _failingPart;
+        std::atomic<size_t> _maxKeys;
+
+        void serve() {
+            while(!_done) {
+                pollfd pfd{_fd, POLLIN, 0};
+                if(poll(&pfd, 1, 50) <= 0 || !(pfd.revents & POLLIN))
+                    continue;
+                int fd = accept(_fd, nullptr, nullptr);
+                if(fd < 0)
+                    continue;
+                std::lock_guard<std::mutex> lock(_mutex);
+                _connections.emplace_back([this, fd]() {
+                    handleConnection(fd);
+                    close(fd);
+                });
+            }
+        }
+
+        static bool readUntil(int fd, std::string& buf, const std::string& delim, size_t& pos) {
+            char tmp[64 * 1024];
+            while((pos = buf.find(delim)) == std::string::npos) {
+                auto n = recv(fd, tmp, sizeof(tmp), 0);
+                if(n <= 0)
+                    return false;
+                buf.append(tmp, n);
+            }
+            return true;
+        }
+
+        static bool readBytes(int fd, std::string& buf, size_t n) {
+            char tmp[64 * 1024];
+            while(buf.size() < n) {
+                auto r = recv(fd, tmp, sizeof(tmp), 0);
+                if(r <= 0)
+                    return false;
+                buf.append(tmp, r);
+            }
+            return true;
+        }
+
+        static bool sendAll(int fd, const std::string& data) {
+            size_t sent = 0;
+            while(sent < data.size()) {
+                auto n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                if(n <= 0)
+                    return false;
+                sent += n;
+            }
+            return true;
+        }
+
+        static std::string lower(std::string s) {
+            std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+            return s;
+        }
+
+        static std::string urlDecode(const std::string& s) {
+            std::string res;
+            for(size_t i = 0; i < s.size(); ++i) {
+                if(s[i] == '%' && i + 2 < s.size()) {
+                    res += static_cast<char>(std::stoi(s.substr(i + 1, 2), nullptr, 16));
+                    i += 2;
+                } else
+                    res += s[i];
+            }
+            return res;
+        }
+
+        // decodes aws-chunked content encoding: <hex size>[;chunk-signature=...]\r\n<data>\r\n ... 0...\r\n
+        static std::string decodeChunks(const std::string& data) {
+            std::string res;
+            size_t pos = 0;
+            while(pos < data.size()) {
+                auto eol = data.find("\r\n", pos);
+                if(eol == std::string::npos)
+                    break;
+                auto size = std::stoull(data.substr(pos, data.find_first_of(";\r", pos) - pos), nullptr, 16);
+                if(0 == size)
+                    break;
+                res += data.substr(eol + 2, size);
+                pos = eol + 2 + size + 2;
+            }
+            return res;
+        }
+
+        // reads one request from the connection, the connection is closed after the response
+        bool readRequest(int fd, Request& req) {
+            std::string buf;
+            size_t headerEnd = 0;
+            if(!readUntil(fd, buf, "\r\n\r\n", headerEnd))
+                return false;
+
+            std::stringstream ss(buf.substr(0, headerEnd));
+            std::string line, target, version;
+            std::getline(ss, line);
+            std::stringstream requestLine(line);
+            requestLine >> req.method >> target >> version;
+            while(std::getline(ss, line)) {
+                if(!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                auto colon = line.find(':');
+                if(colon == std::string::npos)
+                    continue;
+                auto value = line.substr(colon + 1);
+                value.erase(0, value.find_first_not_of(' '));
+                req.headers[lower(line.substr(0, colon))] = value;
+            }
+
+            auto q = target.find('?');
+            req.path = urlDecode(target.substr(0, q));
+            if(q != std::string::npos) {
+                std::stringstream qs(target.substr(q + 1));
+                std::string param;
+                while(std::getline(qs, param, '&')) {
+                    auto eq = param.find('=');
+                    req.query[urlDecode(param.substr(0, eq))] = eq == std::string::npos ? "" : urlDecode(param.substr(eq + 1));
+                }
+            }
+
+            if(lower(req.headers["expect"]) == "100-continue")
+                sendAll(fd, "HTTP/1.1 100 Continue\r\n\r\n");
+
+            std::string body = buf.substr(headerEnd + 4);
+            if(lower(req.headers["transfer-encoding"]) == "chunked") {
+                // <hex size>\r\n<data>\r\n ... 0\r\n<trailers>\r\n
+                std::string decoded;
+                while(true) {
+                    size_t eol = 0;
+                    if(!readUntil(fd, body, "\r\n", eol))
+                        return false;
+                    auto size = std::stoull(body.substr(0, eol), nullptr, 16);
+                    body = body.substr(eol + 2);
+                    if(0 == size) {
+                        size_t end = 0;
+                        while(readUntil(fd, body, "\r\n", end) && end > 0) // skip trailers
+                            body = body.substr(end + 2);
+                        break;
+                    }
+                    if(!readBytes(fd, body, size + 2))
+                        return false;
+                    decoded += body.substr(0, size);
+                    body = body.substr(size + 2);
+                }
+                body = decoded;
+            } else if(req.headers.count("content-length")) {
+                auto length = std::stoull(req.headers["content-length"]);
+                if(!readBytes(fd, body, length))
+                    return false;
+                body.resize(length);
+            }
+            if(req.headers["content-encoding"].find("aws-chunked") != std::string::npos)
+                body = decodeChunks(body);
+            req.body = body;
+            return true;
+        }
+
+        static Response error(int status, const std::string& reason, const std::string& code) {
+            Response res;
+            res.status = status;
+            res.reason = reason;
+            res.headers["Content-Type"] = "application/xml";
+            res.body = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<Error><Code>" + code + "</Code><Message>"
+                       + reason + "</Message></Error>";
+            return res;
+        }
+
+        static std::string etag(const std::string& data) {
+            return "\"" + std::to_string(std::hash<std::string>()(data)) + "\"";
+        }
+
+        static std::string xmlEscape(const std::string& s) {
+            std::string res;
+            for(auto c : s) {
+                switch(c) {
+                    case '&': res += "&amp;"; break;
+                    case '<': res += "&lt;"; break;
+                    case '>': res += "&gt;"; break;
+                    case '"': res += "&quot;"; break;
+                    default: res += c;
+                }
+            }
+            return res;
+        }
+
+        static std::string queryOr(const Request& req, const std::string& name, const std::string& alt) {
+            auto it = req.query.find(name);
+            return it != req.query.end() ? it->second : alt;
+        }
+
+        // ListObjectsV2: keys are in lexicographic order, with a delimiter keys containing it after the prefix are
+        // rolled up into common prefixes. Keys and common prefixes count both towards the page size, the
+        // continuation token is the last key or common prefix returned.
+        Response listObjects(const Request& req, const std::string& bucket) {
+            _numLists++;
+            auto prefix = queryOr(req, "prefix", "");
+            auto delimiter = queryOr(req, "delimiter", "");
+            auto token = queryOr(req, "continuation-token", "");
+            size_t maxKeys = std::min(static_cast<size_t>(std::stoull(queryOr(req, "max-keys", "1000"))), _maxKeys.load());
+
+            std::stringstream contents;
+            std::vector<std::string> commonPrefixes;
+            size_t keyCount = 0;
+            bool truncated = false;
+            std::string last;
+            auto bucketPath = "/" + bucket + "/";
+            for(auto it = _objects.lower_bound(bucketPath + prefix); it != _objects.end(); ++it) {
+                if(it->first.compare(0, bucketPath.size() + prefix.size(), bucketPath + prefix) != 0)
+                    break;
+                auto key = it->first.substr(bucketPath.size());
+
+                // roll up into a common prefix?
+                auto entry = key;
+                if(!delimiter.empty()) {
+                    auto pos = key.find(delimiter, prefix.size());
+                    if(pos != std::string::npos)
+                        entry = key.substr(0, pos + delimiter.size());
+                }
+                if((!token.empty() && entry <= token) || entry == last)
+                    continue;
+                if(keyCount == maxKeys) {
+                    truncated = true;
+                    break;
+                }
+                if(entry != key)
+                    commonPrefixes.push_back(entry);
+                else
+                    contents<<"<Contents><Key>"<<xmlEscape(key)<<"</Key><LastModified>2021-01-01T00:00:00.000Z</LastModified>"
+                            <<"<ETag>"<<xmlEscape(etag(it->second))<<"</ETag><Size>"<<it->second.size()
+                            <<"</Size><StorageClass>STANDARD</StorageClass></Contents>";
+                last = entry;
+                keyCount++;
+            }
+
+            Response res;
+            res.headers["Content-Type"] = "application/xml";
+            std::stringstream ss;
+            ss<<"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+              <<"<Name>"<<xmlEscape(bucket)<<"</Name><Prefix>"<<xmlEscape(prefix)<<"</Prefix>"
+              <<"<KeyCount>"<<keyCount<<"</KeyCount><MaxKeys>"<<maxKeys<<"</MaxKeys>";
+            if(!delimiter.empty())
+                ss<<"<Delimiter>"<<xmlEscape(delimiter)<<"</Delimiter>";
+            ss<<"<IsTruncated>"<<(truncated ? "true" : "false")<<"</IsTruncated>";
+            if(!token.empty())
+                ss<<"<ContinuationToken>"<<xmlEscape(token)<<"</ContinuationToken>";
+            if(truncated)
+                ss<<"<NextContinuationToken>"<<xmlEscape(last)<<"</NextContinuationToken>";
+            ss<<contents.str();
+            for(const auto& cp : commonPrefixes)
+                ss<<"<CommonPrefixes><Prefix>"<<xmlEscape(cp)<<"</Prefix></CommonPrefixes>";
+            ss<<"</ListBucketResult>";
+            res.body = ss.str();
+            return res;
+        }
+
+        Response handle(const Request& req) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto slash = req.path.find('/', 1);
+            auto bucket = req.path.substr(1, slash == std::string::npos ? std::string::npos : slash - 1);
+            auto key = slash == std::string::npos ? "" : req.path.substr(slash + 1);
+            Response res;
+
+            if(req.query.count("uploads") && req.method == "POST") {
+                auto id = "upload" + std::to_string(_nextUploadID++);
+                _uploads[id];
+                res.headers["Content-Type"] = "application/xml";
+                res.body = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<InitiateMultipartUploadResult><Bucket>" + bucket
+                           + "</Bucket><Key>" + key + "</Key><UploadId>" + id + "</UploadId></InitiateMultipartUploadResult>";
+                return res;
+            }
+
+            if(req.query.count("uploadId")) {
+                auto it = _uploads.find(req.query.at("uploadId"));
+                if(it == _uploads.end())
+                    return error(404, "Not Found", "NoSuchUpload");
+
+                if(req.method == "PUT") {
+                    auto partNumber = std::stoi(req.query.at("partNumber"));
+                    _numPartUploads++;
+                    if(partNumber == _failingPart)
+                        return error(403, "Forbidden", "AccessDenied");
+                    it->second[partNumber] = req.body;
+                    res.headers["ETag"] = etag(req.body);
+                    return res;
+                }
+                if(req.method == "POST") {
+                    std::string data;
+                    for(const auto& part : it->second)
+                        data += part.second;
+                    _objects[req.path] = data;
+                    _uploads.erase(it);
+                    res.headers["Content-Type"] = "application/xml";
+                    res.body = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<CompleteMultipartUploadResult><Bucket>" + bucket
+                               + "</Bucket><Key>" + key + "</Key><ETag>" + etag(data) + "</ETag></CompleteMultipartUploadResult>";
+                    return res;
+                }
+                if(req.method == "DELETE") {
+                    _numAborts++;
+                    _uploads.erase(it);
+                    res.status = 204;
+                    res.reason = "No Content";
+                    return res;
+                }
+            }
+
+            if(req.method == "GET" && req.query.count("list-type"))
+                return listObjects(req, bucket);
+
+            if(req.method == "PUT") {
+                _objects[req.path] = req.body;
+                res.headers["ETag"] = etag(req.body);
+                return res;
+            }
+
+            if(req.method == "GET" || req.method == "HEAD") {
+                auto it = _objects.find(req.path);
+                if(it == _objects.end())
+                    return error(404, "Not Found", "NoSuchKey");
+                const auto& data = it->second;
+                res.headers["ETag"] = etag(data);
+                if(req.method == "HEAD") {
+                    _numHeads++;
+                    res.headers["Content-Length"] = std::to_string(data.size());
+                    return res;
+                }
+
+                _numGets++;
+                auto range = req.headers.count("range") ? req.headers.at("range") : "";
+                if(range.empty()) {
+                    _getRanges.emplace_back(0, data.size());
+                    res.body = data;
+                    return res;
+                }
+
+                // bytes=start-end, end inclusive
+                auto dash = range.find('-');
+                size_t start = std::stoull(range.substr(strlen("bytes="), dash - strlen("bytes=")));
+                size_t end = std::stoull(range.substr(dash + 1));
+                _getRanges.emplace_back(start, end + 1 - start);
+                if(start >= data.size())
+                    return error(416, "Requested Range Not Satisfiable", "InvalidRange");
+                end = std::min(end, data.size() - 1);
+                res.status = 206;
+                res.reason = "Partial Content";
+                res.headers["Content-Range"] = "bytes " + std::to_string(start) + "-" + std::to_string(end) + "/"
+                                               + std::to_string(data.size());
+                res.body = data.substr(start, end + 1 - start);
+                return res;
+            }
+
+            return error(405, "Method Not Allowed", "MethodNotAllowed");
+        }
+
+        void handleConnection(int fd) {
+            timeval timeout{5, 0};
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            Request req;
+            if(!readRequest(fd, req))
+                return;
+            auto res = handle(req);
+
+            std::stringstream ss;
+            ss<<"HTTP/1.1 "<<res.status<<" "<<res.reason<<"\r\n";
+            for(const auto& h : res.headers)
+                ss<<h.first<<": "<<h.second<<"\r\n";
+            if(!res.headers.count("Content-Length"))
+                ss<<"Content-Length: "<<res.body.size()<<"\r\n";
+            ss<<"Connection: close\r\n\r\n";
+            if(req.method != "HEAD")
+                ss<<res.body;
+            sendAll(fd, ss.str());
+        }
+    };
+}
+
+#endif //TUPLEX_S3STANDIN_H
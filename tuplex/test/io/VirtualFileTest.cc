@@ -0,0 +1,46 @@
+//--------------------------------------------------------------------------------------------------------------------//
+//                                                                                                                    //
+//                                      Tuplex: Blazing Fast Python Data Science                                      //
+//                                                                                                                    //
+//                                                                                                                    //
+//  (c) 2017 - 2021, Tuplex team                                                                                      //
+//  Created by Leonhard Spiegelberg first on 1/1/2021                                                                 //
+//  License: Apache 2.0                                                                                               //
+//--------------------------------------------------------------------------------------------------------------------//
+
+#include <gtest/gtest.h>
+#include <VirtualFileSystem.h>
+#include <VirtualFile.h>
+#include <boost/filesystem.hpp>
+#include <climits>
+#include <unistd.h>
+
+using namespace tuplex;
+
+TEST(VirtualFile, VectoredWrite) {
+    auto path = "/tmp/tuplex_writev_test_" + std::to_string(getpid()) + ".txt";
+
+    // more buffers than a single writev call accepts, mixed with empty & large buffers
+    std::vector<std::string> parts;
+    for(int i = 0; i < IOV_MAX + 100; ++i)
+        parts.push_back(i % 7 == 0 ? "" : std::to_string(i) + ",");
+    parts.push_back(std::string(1024 * 1024, 'x'));
+
+    std::string expected = "header\n";
+    std::vector<std::pair<const void*, uint64_t>> buffers;
+    for(const auto& part : parts) {
+        buffers.emplace_back(part.data(), part.size());
+        expected += part;
+    }
+
+    auto file = VirtualFileSystem::open_file(URI(path), VirtualFileMode::VFS_OVERWRITE);
+    ASSERT_TRUE(file);
+    EXPECT_EQ(file->reserve(expected.size()), VirtualFileSystemStatus::VFS_OK);
+    // buffered write followed by vectored write keeps order
+    EXPECT_EQ(file->write("header\n", 7), VirtualFileSystemStatus::VFS_OK);
+    EXPECT_EQ(file->writev(buffers), VirtualFileSystemStatus::VFS_OK);
+    file->close();
+
+    EXPECT_EQ(fileToString(URI(path)), expected);
+    boost::filesystem::remove(path);
+}
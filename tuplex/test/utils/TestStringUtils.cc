@@ -195,6 +195,34 @@ TEST(CSVUtils, csvFindLineStart) {
     EXPECT_EQ(0, csvFindLineStart(test_strVIII.c_str(), test_strVIII.length() + 1, 110));
 }
 
+TEST(CSVUtils, chunkParity) {
+    using namespace std;
+    using namespace tuplex;
+
+    // quoted field with newlines and escaped quotes
+    string test_str = "1,\"a\n\"\"b\"\"\nc\"\n2,d\n3,\"e\"\n";
+    auto info = csvChunkParity(test_str.c_str(), test_str.length());
+    EXPECT_EQ(info.size, test_str.length());
+    EXPECT_EQ(info.numQuotes, 8);
+    EXPECT_EQ(info.firstLineEnd[0], test_str.find("c\"\n") + 2);
+    EXPECT_EQ(info.firstLineEnd[1], test_str.find("\n"));
+
+    // split at every position, combined info must match
+    for(int i = 0; i <= test_str.length(); ++i) {
+        auto combined = combineChunkParity(csvChunkParity(test_str.c_str(), i),
+                                           csvChunkParity(test_str.c_str() + i, test_str.length() - i));
+        EXPECT_EQ(combined.numQuotes, info.numQuotes);
+        EXPECT_EQ(combined.firstLineEnd[0], info.firstLineEnd[0]);
+        EXPECT_EQ(combined.firstLineEnd[1], info.firstLineEnd[1]);
+    }
+
+    // no newline outside quotes
+    string test_strII = "\"abc\ndef\"";
+    auto infoII = csvChunkParity(test_strII.c_str(), test_strII.length());
+    EXPECT_EQ(infoII.firstLineEnd[0], -1);
+    EXPECT_EQ(infoII.firstLineEnd[1], -1);
+}
+
 TEST(CSVUtils, I64ToString) {
     char buf[21];
     EXPECT_EQ(i64toa_sse2(100,buf), 3);
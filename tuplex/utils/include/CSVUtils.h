@@ -173,6 +173,29 @@ namespace tuplex {
      */
     extern int csvOffsetToNextLine(const char *buffer, size_t buffer_size, char delimiter = ',', char quotechar = '"');
 
+    /*!
+     * quote statistics of a chunk of a CSV file, used to find exact row boundaries without knowing whether the chunk
+     * starts within a quoted field. Chunk infos can be computed independently and combined left to right.
+     */
+    struct CSVChunkParity {
+        size_t size; //! bytes in chunk
+        size_t numQuotes; //! number of quotechars in chunk, even if a chunk leaves quote state unchanged
+        int64_t firstLineEnd[2]; //! offset of first '\n' outside of quotes when the chunk starts outside (0) or inside (1) a quoted field, -1 if there is none
+
+        CSVChunkParity() : size(0), numQuotes(0), firstLineEnd{-1, -1} {}
+    };
+
+    /*!
+     * computes quote parity & first unquoted newlines of a buffer. Escaped quotes ("") count twice, hence do not change
+     * parity.
+     */
+    extern CSVChunkParity csvChunkParity(const char *buffer, size_t buffer_size, char quotechar = '"');
+
+    /*!
+     * combines chunk info of two adjacent chunks (a directly followed by b)
+     */
+    extern CSVChunkParity combineChunkParity(const CSVChunkParity& a, const CSVChunkParity& b);
+
     /*!
      * creates string (without newline delimiter!) of header
      * @param columns
@@ -116,6 +116,18 @@ namespace tuplex {
         BADPARSE_STRING_INPUT=70 // used to signal that parsing didn't work, exception input will be then stored as length/string field.
     };
 
+    //! ranges of the codes above, e.g. to index dense arrays by exception code. Adjust when adding codes.
+    const int32_t EXCEPTION_CODE_FRAMEWORK_END = 71; //! framework codes are in [0, 71)
+    const int32_t EXCEPTION_CODE_PYTHON_BEGIN = 100;
+    const int32_t EXCEPTION_CODE_PYTHON_END = 166; //! python exception classes are in [100, 166), re.error excluded
+    static_assert(static_cast<int32_t>(ExceptionCode::BADPARSE_STRING_INPUT) < EXCEPTION_CODE_FRAMEWORK_END,
+                  "framework exception code outside of EXCEPTION_CODE_FRAMEWORK_END");
+    static_assert(static_cast<int32_t>(ExceptionCode::BASEEXCEPTION) == EXCEPTION_CODE_PYTHON_BEGIN
+                  && static_cast<int32_t>(ExceptionCode::CONNECTIONRESETERROR) + 1 == EXCEPTION_CODE_PYTHON_END,
+                  "python exception codes do not match EXCEPTION_CODE_PYTHON_BEGIN/END");
+    static_assert(static_cast<int32_t>(ExceptionCode::RE_ERROR) >= EXCEPTION_CODE_PYTHON_END,
+                  "re.error overlaps with python exception codes");
+
 
     inline int32_t ecToI32(const ExceptionCode& ec) { return static_cast<int32_t >(ec); }
     inline ExceptionCode i32ToEC(const int32_t i) { return static_cast<ExceptionCode>(i); }
@@ -18,6 +18,9 @@
 #include <Utils.h>
 
 #include <boost/algorithm/string.hpp>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace tuplex {
 
@@ -1601,6 +1604,72 @@ parse_error:
     }
 
 
+    CSVChunkParity csvChunkParity(const char *buffer, size_t buffer_size, char quotechar) {
+        CSVChunkParity info;
+        info.size = buffer_size;
+
+        // parity of quotes seen so far, i.e. the quote state relative to the one at chunk start.
+        // A newline is a row end when the absolute quote state (start state ^ parity) is outside.
+        unsigned parity = 0;
+        size_t i = 0;
+#ifdef __SSE2__
+        const __m128i quotes16 = _mm_set1_epi8(quotechar);
+        const __m128i newlines16 = _mm_set1_epi8('\n');
+        for(; i + 16 <= buffer_size; i += 16) {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+            unsigned quotes = _mm_movemask_epi8(_mm_cmpeq_epi8(block, quotes16));
+            unsigned newlines = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newlines16));
+
+            // once both start states have their row end, counting quotes suffices
+            if(newlines && (info.firstLineEnd[0] < 0 || info.firstLineEnd[1] < 0)) {
+                // prefix xor, bit k holds parity ^ number of quotes at positions <= k
+                unsigned state = quotes;
+                state ^= state << 1u;
+                state ^= state << 2u;
+                state ^= state << 4u;
+                state ^= state << 8u;
+                state = (parity ? ~state : state) & 0xFFFFu;
+
+                if(info.firstLineEnd[0] < 0 && (newlines & ~state))
+                    info.firstLineEnd[0] = i + __builtin_ctz(newlines & ~state);
+                if(info.firstLineEnd[1] < 0 && (newlines & state))
+                    info.firstLineEnd[1] = i + __builtin_ctz(newlines & state);
+            }
+
+            auto numQuotes = __builtin_popcount(quotes);
+            info.numQuotes += numQuotes;
+            parity ^= numQuotes & 0x1u;
+        }
+#endif
+        // remaining bytes
+        for(; i < buffer_size; ++i) {
+            if(buffer[i] == quotechar) {
+                info.numQuotes++;
+                parity ^= 0x1u;
+            } else if(buffer[i] == '\n' && info.firstLineEnd[parity] < 0)
+                info.firstLineEnd[parity] = i;
+        }
+
+        return info;
+    }
+
+    CSVChunkParity combineChunkParity(const CSVChunkParity& a, const CSVChunkParity& b) {
+        CSVChunkParity info;
+        info.size = a.size + b.size;
+        info.numQuotes = a.numQuotes + b.numQuotes;
+        for(unsigned state = 0; state < 2; ++state) {
+            if(a.firstLineEnd[state] >= 0)
+                info.firstLineEnd[state] = a.firstLineEnd[state];
+            else {
+                // b starts in the state a leaves behind
+                auto bstate = state ^ (a.numQuotes & 0x1u);
+                if(b.firstLineEnd[bstate] >= 0)
+                    info.firstLineEnd[state] = a.size + b.firstLineEnd[bstate];
+            }
+        }
+        return info;
+    }
+
     std::string csvToHeader(const std::vector<std::string>& columns, const char separator) {
         if(columns.empty())
             return "";